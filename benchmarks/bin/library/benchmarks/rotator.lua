@@ -0,0 +1,25 @@
+-- -----------------------------------------------------------------------------
+--
+-- meta
+--
+-- -----------------------------------------------------------------------------
+
+---@class rotator_meta
+---@field speed number
+
+local M = {}
+
+---@param meta rotator_meta
+---@param go gobject
+function M.on_start(meta, go)
+    meta.speed = 1
+end
+
+---@param meta rotator_meta
+---@param go gobject
+function M.on_update(meta, go)
+    local node = go.actor.node
+    node.rotation = node.rotation + meta.speed * the_engine.delta_time
+end
+
+return M
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "common.hpp"
+
+#include <new>
+#include <cstdlib>
+
+namespace
+{
+    std::atomic<std::uint64_t> allocation_count{0u};
+    std::atomic<std::uint64_t> allocation_bytes{0u};
+
+    void* counted_allocate(std::size_t size) {
+        allocation_count.fetch_add(1u, std::memory_order_relaxed);
+        allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+        if ( void* ptr = std::malloc(size ? size : 1u) ) {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* counted_allocate(std::size_t size, const std::nothrow_t&) noexcept {
+        try {
+            return counted_allocate(size);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+}
+
+void* operator new(std::size_t size) {
+    return counted_allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return counted_allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept {
+    return counted_allocate(size, tag);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return counted_allocate(size, tag);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace e2d_benchmarks
+{
+    allocation_stats current_allocation_stats() noexcept {
+        return {
+            allocation_count.load(std::memory_order_relaxed),
+            allocation_bytes.load(std::memory_order_relaxed)};
+    }
+}
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include <enduro2d/enduro2d.hpp>
+
+namespace e2d_benchmarks
+{
+    using namespace e2d;
+
+    //
+    // options
+    //
+
+    struct options {
+        u32 seed{42u};
+        u32 frames{600u};
+        u32 warmup_frames{30u};
+
+        u32 sprites{1000u};
+        u32 spines{50u};
+        u32 labels{200u};
+        u32 layouts{50u};
+        u32 behaviours{200u};
+        u32 renderables{0u};
+        u32 lookups{0u};
+        u32 prefab_nodes{0u};
+
+        str record;
+        str replay;
+
+        str output{"benchmarks.json"};
+        str baseline;
+        f32 threshold{0.1f};
+
+        // negative disables the check
+        i64 max_frame_allocations{-1};
+    };
+
+    bool parse_options(int argc, char *argv[], options& opts);
+
+    //
+    // allocations
+    //
+
+    struct allocation_stats {
+        u64 count{0u};
+        u64 bytes{0u};
+    };
+
+    allocation_stats current_allocation_stats() noexcept;
+
+    //
+    // report
+    //
+
+    struct scope_timing {
+        u64 calls{0u};
+        u64 total_us{0u};
+        u64 max_us{0u};
+    };
+
+    struct frame_sample {
+        allocation_stats allocations;
+        render::statistics render_stats;
+    };
+
+    struct lookup_stats {
+        u64 count{0u};
+        u64 raw_us{0u};
+        u64 uncached_us{0u};
+        u64 cached_us{0u};
+    };
+
+    struct prefab_stats {
+        u64 nodes{0u};
+        u64 parse_us{0u};
+        u64 parse_insitu_us{0u};
+        u64 load_us{0u};
+    };
+
+    struct report {
+        options opts;
+        flat_map<str, scope_timing> scopes;
+        vector<frame_sample> frames;
+        lookup_stats lookups;
+        prefab_stats prefabs;
+    };
+
+    str report_to_json(const report& r);
+    bool compare_with_baseline(const report& r, str_view baseline_json, f32 threshold);
+    bool check_frame_allocations(const report& r, u64 max_frame_allocations);
+
+    //
+    // scenes
+    //
+
+    bool create_scene(const options& opts);
+
+    //
+    // lookups
+    //
+
+    lookup_stats run_lookups(const options& opts);
+
+    //
+    // prefabs
+    //
+
+    bool run_prefabs(const options& opts, prefab_stats& stats);
+}
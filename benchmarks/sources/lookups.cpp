@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "common.hpp"
+
+namespace
+{
+    using namespace e2d;
+    using namespace e2d_benchmarks;
+
+    vector<gobject> collect_scene_gobjects() {
+        vector<gobject> result;
+        the<world>().registry().for_each_component<actor>([&result](
+            const ecs::const_entity&,
+            const actor& a)
+        {
+            if ( a.node() && a.node()->owner() ) {
+                result.push_back(a.node()->owner());
+            }
+        });
+        return result;
+    }
+
+    template < typename F >
+    u64 measure_lookups_us(u32 count, F&& f) {
+        const auto begin_us = time::now_us<u64>();
+        for ( u32 i = 0; i < count; ++i ) {
+            f(i);
+        }
+        return (time::now_us<u64>() - begin_us).value;
+    }
+}
+
+namespace e2d_benchmarks
+{
+    lookup_stats run_lookups(const options& opts) {
+        lookup_stats stats;
+        if ( !opts.lookups ) {
+            return stats;
+        }
+
+        vector<gobject> gobjects = collect_scene_gobjects();
+        if ( gobjects.empty() ) {
+            return stats;
+        }
+
+        vector<gcomponent<actor>> handles;
+        handles.reserve(gobjects.size());
+        for ( gobject& go : gobjects ) {
+            handles.emplace_back(go);
+        }
+
+        // keeps the lookups from being optimized out
+        std::size_t found = 0u;
+
+        stats.count = opts.lookups;
+
+        stats.raw_us = measure_lookups_us(opts.lookups, [&gobjects, &found](u32 i){
+            gobject& go = gobjects[i % gobjects.size()];
+            found += !!go.raw_component<actor>().find();
+        });
+
+        stats.uncached_us = measure_lookups_us(opts.lookups, [&gobjects, &found](u32 i){
+            gcomponent<actor> a{gobjects[i % gobjects.size()]};
+            found += !!a.find();
+        });
+
+        stats.cached_us = measure_lookups_us(opts.lookups, [&handles, &found](u32 i){
+            gcomponent<actor>& a = handles[i % handles.size()];
+            found += !!a.find();
+        });
+
+        if ( found != stats.count * 3u ) {
+            the<debug>().warning("BENCHMARKS: Unexpected lookup results:\n"
+                "--> Expected: %0\n"
+                "--> Found: %1",
+                stats.count * 3u,
+                found);
+        }
+
+        return stats;
+    }
+}
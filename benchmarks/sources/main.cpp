@@ -0,0 +1,279 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "common.hpp"
+
+using namespace e2d;
+using namespace e2d_benchmarks;
+
+namespace
+{
+    //
+    // collector
+    //
+
+    class collector final : private noncopyable {
+    public:
+        collector(const options& opts)
+        : main_thread_(std::this_thread::get_id()) {
+            report_.opts = opts;
+            report_.frames.reserve(opts.frames);
+        }
+
+        void on_scope_begin(const profiler::begin_scope_info& info) {
+            if ( info.tid == main_thread_ ) {
+                scopes_.emplace_back(info.name, info.tp);
+            }
+        }
+
+        void on_scope_end(const profiler::end_scope_info& info) {
+            if ( info.tid != main_thread_ || scopes_.empty() ) {
+                return;
+            }
+            if ( recording_ ) {
+                const u64 duration_us = math::numeric_cast<u64>(
+                    (info.tp - scopes_.back().second).count());
+                scope_timing& timing = report_.scopes[scopes_.back().first];
+                timing.calls += 1u;
+                timing.total_us += duration_us;
+                timing.max_us = math::max(timing.max_us, duration_us);
+            }
+            scopes_.pop_back();
+        }
+
+        bool on_frame_finalize() {
+            const allocation_stats allocs = current_allocation_stats();
+            if ( recording_ ) {
+                frame_sample sample;
+                sample.allocations.count = allocs.count - last_allocs_.count;
+                sample.allocations.bytes = allocs.bytes - last_allocs_.bytes;
+                sample.render_stats = the<render>().frame_statistics();
+                report_.frames.push_back(sample);
+            }
+            last_allocs_ = allocs;
+            the<render>().reset_frame_statistics();
+
+            ++frame_index_;
+            recording_ = frame_index_ >= report_.opts.warmup_frames;
+            return frame_index_ < report_.opts.warmup_frames + report_.opts.frames;
+        }
+
+        void on_lookups(const lookup_stats& stats) {
+            report_.lookups = stats;
+        }
+
+        void on_prefabs(const prefab_stats& stats) {
+            report_.prefabs = stats;
+        }
+
+        const report& result() const noexcept {
+            return report_;
+        }
+    private:
+        report report_;
+        std::thread::id main_thread_;
+        vector<std::pair<str, std::chrono::microseconds>> scopes_;
+        allocation_stats last_allocs_;
+        u32 frame_index_{0u};
+        bool recording_{false};
+    };
+
+    //
+    // timing_sink
+    //
+
+    class timing_sink final : public profiler::sink {
+    public:
+        timing_sink(collector& c)
+        : collector_(c) {}
+
+        void on_event(const profiler::event_info& event) noexcept final {
+            try {
+                std::visit(utils::overloaded {
+                    [this](const profiler::begin_scope_info& e){
+                        collector_.on_scope_begin(e);
+                    },
+                    [this](const profiler::end_scope_info& e){
+                        collector_.on_scope_end(e);
+                    },
+                    [](const auto&){}
+                }, event);
+            } catch (...) {
+                // nothing
+            }
+        }
+    private:
+        collector& collector_;
+    };
+
+    //
+    // benchmark_system
+    //
+
+    class benchmark_system final
+        : public ecs::system<ecs::after<systems::frame_finalize_event>> {
+    public:
+        benchmark_system(collector& c)
+        : collector_(c) {}
+
+        void process(
+            ecs::registry& owner,
+            const ecs::after<systems::frame_finalize_event>& trigger) override
+        {
+            E2D_UNUSED(owner, trigger);
+            if ( !collector_.on_frame_finalize() ) {
+                the<window>().set_should_close(true);
+            }
+        }
+    private:
+        collector& collector_;
+    };
+
+    //
+    // benchmark
+    //
+
+    class benchmark final : public starter::application {
+    public:
+        benchmark(collector& c, const options& opts)
+        : collector_(c)
+        , options_(opts) {}
+
+        bool initialize() final {
+            prefab_stats prefabs;
+            if ( !run_prefabs(options_, prefabs) ) {
+                return false;
+            }
+            collector_.on_prefabs(prefabs);
+
+            if ( !create_scene(options_) ) {
+                the<debug>().error("BENCHMARKS: Failed to create scene");
+                return false;
+            }
+
+            collector_.on_lookups(run_lookups(options_));
+
+            ecs::registry_filler(the<world>().registry())
+            .feature<struct benchmark_feature>(ecs::feature()
+                .add_system<benchmark_system>(collector_));
+
+            sink_ = &the<profiler>().register_sink<timing_sink>(collector_);
+            return start_capture();
+        }
+
+        void shutdown() noexcept final {
+            finish_capture();
+            if ( sink_ ) {
+                the<profiler>().unregister_sink(*sink_);
+                sink_ = nullptr;
+            }
+        }
+    private:
+        bool start_capture() {
+            if ( !options_.replay.empty() ) {
+                input_capture capture;
+                if ( !input_captures::try_load_capture(capture, make_read_file(options_.replay)) ) {
+                    the<debug>().error("BENCHMARKS: Failed to load input capture:\n"
+                        "--> Path: %0",
+                        options_.replay);
+                    return false;
+                }
+                the<input>().start_replaying(std::move(capture));
+            }
+
+            if ( !options_.record.empty() ) {
+                the<input>().start_recording();
+            }
+
+            return true;
+        }
+
+        void finish_capture() noexcept {
+            the<input>().stop_replaying();
+
+            if ( options_.record.empty() ) {
+                return;
+            }
+
+            input_capture capture;
+            if ( !the<input>().stop_recording(capture)
+                || !input_captures::try_save_capture(capture, make_write_file(options_.record, false)) )
+            {
+                the<debug>().error("BENCHMARKS: Failed to save input capture:\n"
+                    "--> Path: %0",
+                    options_.record);
+            }
+        }
+    private:
+        collector& collector_;
+        options options_;
+        timing_sink* sink_{nullptr};
+    };
+
+    bool write_report(const report& r) {
+        const str json = report_to_json(r);
+        if ( !filesystem::try_write_all(json, r.opts.output, false) ) {
+            the<debug>().error("BENCHMARKS: Failed to write report:\n"
+                "--> Path: %0",
+                r.opts.output);
+            return false;
+        }
+
+        the<debug>().trace("BENCHMARKS: Report written:\n"
+            "--> Path: %0",
+            r.opts.output);
+        return true;
+    }
+
+    bool compare_report(const report& r) {
+        if ( r.opts.baseline.empty() ) {
+            return true;
+        }
+
+        str baseline;
+        if ( !filesystem::try_read_all(baseline, r.opts.baseline) ) {
+            the<debug>().error("BENCHMARKS: Failed to read baseline:\n"
+                "--> Path: %0",
+                r.opts.baseline);
+            return false;
+        }
+
+        return compare_with_baseline(r, baseline, r.opts.threshold);
+    }
+
+    bool check_allocations(const report& r) {
+        if ( r.opts.max_frame_allocations < 0 ) {
+            return true;
+        }
+        return check_frame_allocations(r, static_cast<u64>(r.opts.max_frame_allocations));
+    }
+}
+
+int e2d_main(int argc, char *argv[]) {
+    options opts;
+    if ( !parse_options(argc, argv, opts) ) {
+        return 1;
+    }
+
+    const auto starter_params = starter::parameters(
+        engine::parameters("benchmarks", "enduro2d")
+            .window_params(engine::window_parameters()
+                .size({1024, 768}))
+            .timer_params(engine::timer_parameters()
+                .maximal_framerate(60)
+                .deterministic(true)));
+
+    collector c(opts);
+    modules::initialize<starter>(argc, argv, starter_params);
+
+    const bool success = the<starter>().start<benchmark>(c, opts)
+        && write_report(c.result())
+        && compare_report(c.result())
+        && check_allocations(c.result());
+
+    modules::shutdown<starter>();
+    return success ? 0 : 1;
+}
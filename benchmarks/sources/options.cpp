@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "common.hpp"
+
+#include <cstdio>
+
+namespace
+{
+    using namespace e2d;
+    using namespace e2d_benchmarks;
+
+    const char* usage_text =
+        "usage: benchmarks [options]\n"
+        "  --seed N           random seed for scene generation (42)\n"
+        "  --frames N         number of measured frames (600)\n"
+        "  --warmup N         number of skipped frames before measuring (30)\n"
+        "  --sprites N        number of sprites (1000)\n"
+        "  --spines N         number of spine players (50)\n"
+        "  --labels N         number of labels (200)\n"
+        "  --layouts N        number of layouts with 8 items each (50)\n"
+        "  --behaviours N     number of lua behaviours (200)\n"
+        "  --renderables N    number of static sprites in groups of 16 (0),\n"
+        "                     e.g. 50000 to measure the render queue\n"
+        "  --lookups N        number of component lookups to measure (0)\n"
+        "  --prefab-nodes N   number of nodes in a generated prefab to load (0),\n"
+        "                     e.g. 10000 to measure json parsing and prefab loading\n"
+        "  --record PATH      input capture file to record the session to\n"
+        "  --replay PATH      input capture file to replay the session from\n"
+        "  --output PATH      report file (benchmarks.json)\n"
+        "  --baseline PATH    baseline report to compare with\n"
+        "  --threshold F      allowed relative slowdown (0.1)\n"
+        "  --max-allocs N     allowed heap allocations per measured frame (off),\n"
+        "                     e.g. 0 with --spines 0 --behaviours 0 to check\n"
+        "                     the steady state of the label, touch and render paths\n";
+
+    template < typename T >
+    bool parse_value(str_view name, const char* value, T& dst) {
+        if ( !value || !strings::try_parse(value, dst) ) {
+            std::fprintf(stderr, "invalid value for option '%s'\n%s",
+                str(name).c_str(), usage_text);
+            return false;
+        }
+        return true;
+    }
+
+    bool parse_value(str_view name, const char* value, str& dst) {
+        if ( !value ) {
+            std::fprintf(stderr, "missing value for option '%s'\n%s",
+                str(name).c_str(), usage_text);
+            return false;
+        }
+        dst = value;
+        return true;
+    }
+}
+
+namespace e2d_benchmarks
+{
+    bool parse_options(int argc, char *argv[], options& opts) {
+        for ( int i = 1; i < argc; ++i ) {
+            const str_view name = argv[i];
+            const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+            bool success = false;
+            if ( name == "--seed" ) {
+                success = parse_value(name, value, opts.seed);
+            } else if ( name == "--frames" ) {
+                success = parse_value(name, value, opts.frames);
+            } else if ( name == "--warmup" ) {
+                success = parse_value(name, value, opts.warmup_frames);
+            } else if ( name == "--sprites" ) {
+                success = parse_value(name, value, opts.sprites);
+            } else if ( name == "--spines" ) {
+                success = parse_value(name, value, opts.spines);
+            } else if ( name == "--labels" ) {
+                success = parse_value(name, value, opts.labels);
+            } else if ( name == "--layouts" ) {
+                success = parse_value(name, value, opts.layouts);
+            } else if ( name == "--behaviours" ) {
+                success = parse_value(name, value, opts.behaviours);
+            } else if ( name == "--renderables" ) {
+                success = parse_value(name, value, opts.renderables);
+            } else if ( name == "--lookups" ) {
+                success = parse_value(name, value, opts.lookups);
+            } else if ( name == "--prefab-nodes" ) {
+                success = parse_value(name, value, opts.prefab_nodes);
+            } else if ( name == "--record" ) {
+                success = parse_value(name, value, opts.record);
+            } else if ( name == "--replay" ) {
+                success = parse_value(name, value, opts.replay);
+            } else if ( name == "--output" ) {
+                success = parse_value(name, value, opts.output);
+            } else if ( name == "--baseline" ) {
+                success = parse_value(name, value, opts.baseline);
+            } else if ( name == "--threshold" ) {
+                success = parse_value(name, value, opts.threshold);
+            } else if ( name == "--max-allocs" ) {
+                success = parse_value(name, value, opts.max_frame_allocations);
+            } else {
+                std::fprintf(stderr, "unknown option '%s'\n%s",
+                    argv[i], usage_text);
+            }
+
+            if ( !success ) {
+                return false;
+            }
+            ++i;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "common.hpp"
+
+#include <3rdparty/rapidjson/writer.h>
+#include <3rdparty/rapidjson/stringbuffer.h>
+
+namespace
+{
+    using namespace e2d;
+    using namespace e2d_benchmarks;
+
+    using writer_t = rapidjson::Writer<rapidjson::StringBuffer>;
+
+    const u32 generated_prefab_fanout = 16u;
+    const char* generated_prefab_address = "benchmarks/generated_prefab.json";
+    const char* generated_prefab_url = "resources://bin/library/benchmarks/generated_prefab.json";
+
+    // writes a subtree of 'nodes' nodes shaped like a big ui prefab,
+    // every node is a named widget with up to 16 children
+    void write_prefab_node(writer_t& writer, u32& index, u32 nodes) {
+        const str name = strings::rformat("node_%0", index++);
+
+        writer.StartObject();
+        writer.Key("components");
+        writer.StartObject();
+        {
+            writer.Key("named");
+            writer.StartObject();
+            writer.Key("name"); writer.String(name.c_str());
+            writer.EndObject();
+
+            writer.Key("actor");
+            writer.StartObject();
+            writer.Key("translation");
+            writer.StartArray();
+            writer.Double(static_cast<f64>(index % 100u));
+            writer.Double(static_cast<f64>(index / 100u));
+            writer.EndArray();
+            writer.EndObject();
+
+            writer.Key("widget");
+            writer.StartObject();
+            writer.Key("size");
+            writer.StartArray();
+            writer.Double(32.0);
+            writer.Double(32.0);
+            writer.EndArray();
+            writer.EndObject();
+        }
+        writer.EndObject();
+
+        if ( nodes > 1u ) {
+            const u32 children_nodes = nodes - 1u;
+            const u32 fanout = math::min(generated_prefab_fanout, children_nodes);
+
+            writer.Key("children");
+            writer.StartArray();
+            for ( u32 i = 0; i < fanout; ++i ) {
+                write_prefab_node(
+                    writer,
+                    index,
+                    children_nodes / fanout + (i < children_nodes % fanout ? 1u : 0u));
+            }
+            writer.EndArray();
+        }
+
+        writer.EndObject();
+    }
+
+    str generate_prefab(u32 nodes) {
+        rapidjson::StringBuffer buffer;
+        writer_t writer(buffer);
+
+        u32 index = 0u;
+        write_prefab_node(writer, index, nodes);
+
+        return str(buffer.GetString(), buffer.GetSize());
+    }
+
+    template < typename F >
+    u64 measure_us(F&& f) {
+        const auto begin_us = time::now_us<u64>();
+        f();
+        return (time::now_us<u64>() - begin_us).value;
+    }
+}
+
+namespace e2d_benchmarks
+{
+    bool run_prefabs(const options& opts, prefab_stats& stats) {
+        if ( !opts.prefab_nodes ) {
+            return true;
+        }
+
+        const str source = generate_prefab(opts.prefab_nodes);
+
+        // parsing alone, the library load below adds validation and filling
+        stats.parse_us = measure_us([&source](){
+            rapidjson::Document doc;
+            if ( doc.Parse(source.c_str(), source.size()).HasParseError() ) {
+                the<debug>().error("BENCHMARKS: Failed to parse generated prefab");
+            }
+        });
+
+        stats.parse_insitu_us = measure_us([&source](){
+            if ( !json_utils::parse_insitu(source) ) {
+                the<debug>().error("BENCHMARKS: Failed to parse generated prefab in-situ");
+            }
+        });
+
+        if ( !streams::try_write_tail(source, the<vfs>().write(url(generated_prefab_url), false)) ) {
+            the<debug>().error("BENCHMARKS: Failed to write generated prefab:\n"
+                "--> Url: %0",
+                generated_prefab_url);
+            return false;
+        }
+
+        prefab_asset::load_result prefab_res;
+        stats.load_us = measure_us([&prefab_res](){
+            prefab_res = the<library>().load_asset<prefab_asset>(generated_prefab_address);
+        });
+
+        if ( !prefab_res ) {
+            the<debug>().error("BENCHMARKS: Failed to load generated prefab:\n"
+                "--> Address: %0",
+                generated_prefab_address);
+            return false;
+        }
+
+        stats.nodes = opts.prefab_nodes;
+        return true;
+    }
+}
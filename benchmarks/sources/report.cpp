@@ -0,0 +1,277 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "common.hpp"
+
+#include <3rdparty/rapidjson/document.h>
+#include <3rdparty/rapidjson/prettywriter.h>
+#include <3rdparty/rapidjson/stringbuffer.h>
+
+namespace
+{
+    using namespace e2d;
+    using namespace e2d_benchmarks;
+
+    // scopes faster than this are too noisy to be compared
+    const f64 min_significant_scope_us = 10.0;
+
+    struct frame_summary {
+        f64 allocations_mean{0.0};
+        u64 allocations_max{0u};
+        u64 allocations_total{0u};
+        u64 allocated_bytes_total{0u};
+
+        f64 draw_calls_mean{0.0};
+        u32 draw_calls_max{0u};
+        f64 drawn_indices_mean{0.0};
+        f64 clear_calls_mean{0.0};
+        f64 buffer_updates_mean{0.0};
+        f64 texture_updates_mean{0.0};
+    };
+
+    frame_summary summarize_frames(const vector<frame_sample>& frames) noexcept {
+        frame_summary s;
+        if ( frames.empty() ) {
+            return s;
+        }
+
+        for ( const frame_sample& f : frames ) {
+            s.allocations_total += f.allocations.count;
+            s.allocated_bytes_total += f.allocations.bytes;
+            s.allocations_max = math::max(s.allocations_max, f.allocations.count);
+
+            s.draw_calls_mean += f.render_stats.draw_calls;
+            s.draw_calls_max = math::max(s.draw_calls_max, f.render_stats.draw_calls);
+            s.drawn_indices_mean += static_cast<f64>(f.render_stats.drawn_indices);
+            s.clear_calls_mean += f.render_stats.clear_calls;
+            s.buffer_updates_mean += f.render_stats.buffer_updates;
+            s.texture_updates_mean += f.render_stats.texture_updates;
+        }
+
+        const f64 count = static_cast<f64>(frames.size());
+        s.allocations_mean = static_cast<f64>(s.allocations_total) / count;
+        s.draw_calls_mean /= count;
+        s.drawn_indices_mean /= count;
+        s.clear_calls_mean /= count;
+        s.buffer_updates_mean /= count;
+        s.texture_updates_mean /= count;
+        return s;
+    }
+
+    f64 scope_mean_us(const scope_timing& timing) noexcept {
+        return timing.calls
+            ? static_cast<f64>(timing.total_us) / static_cast<f64>(timing.calls)
+            : 0.0;
+    }
+
+    bool is_regression(f64 current, f64 baseline, f32 threshold) noexcept {
+        return current > baseline * (1.0 + static_cast<f64>(threshold))
+            && !math::approximately(current, baseline);
+    }
+
+    f64 lookups_per_second(u64 count, u64 us) noexcept {
+        return us
+            ? static_cast<f64>(count) * 1000000.0 / static_cast<f64>(us)
+            : 0.0;
+    }
+
+    // metrics missing from the baseline are new, not regressions
+    std::optional<f64> find_number(
+        const rapidjson::Value& root,
+        const char* object,
+        const char* member) noexcept
+    {
+        if ( !root.HasMember(object) || !root[object].IsObject() ) {
+            return std::nullopt;
+        }
+        const rapidjson::Value& obj = root[object];
+        return obj.HasMember(member) && obj[member].IsNumber()
+            ? std::make_optional(obj[member].GetDouble())
+            : std::nullopt;
+    }
+}
+
+namespace e2d_benchmarks
+{
+    str report_to_json(const report& r) {
+        using writer_t = rapidjson::PrettyWriter<rapidjson::StringBuffer>;
+
+        rapidjson::StringBuffer buffer;
+        writer_t writer(buffer);
+
+        const frame_summary summary = summarize_frames(r.frames);
+
+        writer.StartObject();
+        {
+            writer.Key("config");
+            writer.StartObject();
+            writer.Key("seed"); writer.Uint(r.opts.seed);
+            writer.Key("frames"); writer.Uint(r.opts.frames);
+            writer.Key("warmup_frames"); writer.Uint(r.opts.warmup_frames);
+            writer.Key("sprites"); writer.Uint(r.opts.sprites);
+            writer.Key("spines"); writer.Uint(r.opts.spines);
+            writer.Key("labels"); writer.Uint(r.opts.labels);
+            writer.Key("layouts"); writer.Uint(r.opts.layouts);
+            writer.Key("behaviours"); writer.Uint(r.opts.behaviours);
+            writer.Key("renderables"); writer.Uint(r.opts.renderables);
+            writer.Key("lookups"); writer.Uint(r.opts.lookups);
+            writer.Key("prefab_nodes"); writer.Uint(r.opts.prefab_nodes);
+            writer.Key("replay"); writer.String(r.opts.replay.c_str());
+            writer.EndObject();
+        }
+        {
+            writer.Key("scopes");
+            writer.StartObject();
+            for ( const auto& [name, timing] : r.scopes ) {
+                writer.Key(name.c_str(), math::numeric_cast<rapidjson::SizeType>(name.size()));
+                writer.StartObject();
+                writer.Key("calls"); writer.Uint64(timing.calls);
+                writer.Key("total_us"); writer.Uint64(timing.total_us);
+                writer.Key("mean_us"); writer.Double(scope_mean_us(timing));
+                writer.Key("max_us"); writer.Uint64(timing.max_us);
+                writer.EndObject();
+            }
+            writer.EndObject();
+        }
+        {
+            writer.Key("allocations");
+            writer.StartObject();
+            writer.Key("total"); writer.Uint64(summary.allocations_total);
+            writer.Key("total_bytes"); writer.Uint64(summary.allocated_bytes_total);
+            writer.Key("per_frame_mean"); writer.Double(summary.allocations_mean);
+            writer.Key("per_frame_max"); writer.Uint64(summary.allocations_max);
+            writer.EndObject();
+        }
+        {
+            writer.Key("render");
+            writer.StartObject();
+            writer.Key("draw_calls_mean"); writer.Double(summary.draw_calls_mean);
+            writer.Key("draw_calls_max"); writer.Uint(summary.draw_calls_max);
+            writer.Key("drawn_indices_mean"); writer.Double(summary.drawn_indices_mean);
+            writer.Key("clear_calls_mean"); writer.Double(summary.clear_calls_mean);
+            writer.Key("buffer_updates_mean"); writer.Double(summary.buffer_updates_mean);
+            writer.Key("texture_updates_mean"); writer.Double(summary.texture_updates_mean);
+            writer.EndObject();
+        }
+        if ( r.prefabs.nodes ) {
+            writer.Key("prefabs");
+            writer.StartObject();
+            writer.Key("nodes"); writer.Uint64(r.prefabs.nodes);
+            writer.Key("parse_ms"); writer.Double(static_cast<f64>(r.prefabs.parse_us) / 1000.0);
+            writer.Key("parse_insitu_ms"); writer.Double(static_cast<f64>(r.prefabs.parse_insitu_us) / 1000.0);
+            writer.Key("load_ms"); writer.Double(static_cast<f64>(r.prefabs.load_us) / 1000.0);
+            writer.EndObject();
+        }
+        if ( r.lookups.count ) {
+            writer.Key("lookups");
+            writer.StartObject();
+            writer.Key("count"); writer.Uint64(r.lookups.count);
+            writer.Key("raw_per_second"); writer.Double(
+                lookups_per_second(r.lookups.count, r.lookups.raw_us));
+            writer.Key("uncached_per_second"); writer.Double(
+                lookups_per_second(r.lookups.count, r.lookups.uncached_us));
+            writer.Key("cached_per_second"); writer.Double(
+                lookups_per_second(r.lookups.count, r.lookups.cached_us));
+            writer.EndObject();
+        }
+        writer.EndObject();
+
+        return str(buffer.GetString(), buffer.GetSize());
+    }
+
+    bool compare_with_baseline(const report& r, str_view baseline_json, f32 threshold) {
+        rapidjson::Document baseline;
+        if ( baseline.Parse(baseline_json.data(), baseline_json.size()).HasParseError()
+            || !baseline.IsObject() )
+        {
+            the<debug>().error("BENCHMARKS: Failed to parse baseline json");
+            return false;
+        }
+
+        std::size_t regressions = 0u;
+        const frame_summary summary = summarize_frames(r.frames);
+
+        if ( baseline.HasMember("scopes") && baseline["scopes"].IsObject() ) {
+            const rapidjson::Value& scopes = baseline["scopes"];
+            for ( const auto& [name, timing] : r.scopes ) {
+                const f64 current = scope_mean_us(timing);
+                if ( current < min_significant_scope_us ) {
+                    continue;
+                }
+                const std::optional<f64> base = find_number(scopes, name.c_str(), "mean_us");
+                if ( !base ) {
+                    the<debug>().trace("BENCHMARKS: New scope:\n"
+                        "--> Scope: %0\n"
+                        "--> Current: %1 us",
+                        name, current);
+                    continue;
+                }
+                if ( is_regression(current, *base, threshold) ) {
+                    ++regressions;
+                    the<debug>().warning("BENCHMARKS: Scope regression:\n"
+                        "--> Scope: %0\n"
+                        "--> Baseline: %1 us\n"
+                        "--> Current: %2 us",
+                        name, *base, current);
+                }
+            }
+        }
+
+        const auto check_metric = [&baseline, &regressions, threshold](
+            const char* object, const char* member, f64 current)
+        {
+            const std::optional<f64> base = find_number(baseline, object, member);
+            if ( !base ) {
+                the<debug>().trace("BENCHMARKS: New metric:\n"
+                    "--> Metric: %0.%1\n"
+                    "--> Current: %2",
+                    object, member, current);
+                return;
+            }
+            if ( is_regression(current, *base, threshold) ) {
+                ++regressions;
+                the<debug>().warning("BENCHMARKS: Metric regression:\n"
+                    "--> Metric: %0.%1\n"
+                    "--> Baseline: %2\n"
+                    "--> Current: %3",
+                    object, member, *base, current);
+            }
+        };
+
+        check_metric("allocations", "per_frame_mean", summary.allocations_mean);
+        check_metric("render", "draw_calls_mean", summary.draw_calls_mean);
+        check_metric("render", "buffer_updates_mean", summary.buffer_updates_mean);
+        check_metric("render", "texture_updates_mean", summary.texture_updates_mean);
+
+        if ( r.prefabs.nodes ) {
+            check_metric("prefabs", "parse_insitu_ms", static_cast<f64>(r.prefabs.parse_insitu_us) / 1000.0);
+            check_metric("prefabs", "load_ms", static_cast<f64>(r.prefabs.load_us) / 1000.0);
+        }
+
+        if ( regressions ) {
+            the<debug>().error("BENCHMARKS: Found %0 regression(s) against baseline", regressions);
+            return false;
+        }
+
+        the<debug>().trace("BENCHMARKS: No regressions against baseline");
+        return true;
+    }
+
+    bool check_frame_allocations(const report& r, u64 max_frame_allocations) {
+        const frame_summary summary = summarize_frames(r.frames);
+        if ( summary.allocations_max > max_frame_allocations ) {
+            the<debug>().error("BENCHMARKS: Too many heap allocations per frame:\n"
+                "--> Allowed: %0\n"
+                "--> Max: %1\n"
+                "--> Mean: %2",
+                max_frame_allocations,
+                summary.allocations_max,
+                summary.allocations_mean);
+            return false;
+        }
+        return true;
+    }
+}
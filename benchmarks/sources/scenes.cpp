@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "common.hpp"
+
+#include <random>
+
+namespace
+{
+    using namespace e2d;
+    using namespace e2d_benchmarks;
+
+    class scene_builder final {
+    public:
+        scene_builder(u32 seed, const node_iptr& root)
+        : random_(seed)
+        , root_(root) {}
+
+        template < typename F >
+        bool spawn(str_view address, u32 count, f32 scale, F&& f) {
+            if ( !count ) {
+                return true;
+            }
+
+            const auto prefab_res = the<library>().load_asset<prefab_asset>(address);
+            if ( !prefab_res ) {
+                the<debug>().error("BENCHMARKS: Failed to load prefab:\n"
+                    "--> Address: %0",
+                    address);
+                return false;
+            }
+
+            for ( u32 i = 0; i < count; ++i ) {
+                gobject inst = the<world>().instantiate(
+                    prefab_res->content(),
+                    root_,
+                    random_transform(scale));
+                if ( !inst.valid() ) {
+                    return false;
+                }
+                f(inst, i);
+            }
+
+            return true;
+        }
+
+        bool spawn(str_view address, u32 count, f32 scale) {
+            return spawn(address, count, scale, [](gobject&, u32){});
+        }
+
+        // instances are nested into groups to make the hierarchy deeper
+        bool spawn_grouped(str_view address, u32 count, u32 group_size, f32 scale) {
+            const node_iptr root = root_;
+            E2D_DEFER([this, &root](){ root_ = root; });
+
+            for ( u32 i = 0; i < count; i += group_size ) {
+                gobject group_i = the<world>().instantiate(root, random_transform(1.f));
+                if ( !group_i.valid() ) {
+                    return false;
+                }
+                root_ = group_i.component<actor>()->node();
+                if ( !spawn(address, math::min(group_size, count - i), scale) ) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    private:
+        t2f random_transform(f32 scale) {
+            std::uniform_real_distribution<f32> x_dist(-480.f, 480.f);
+            std::uniform_real_distribution<f32> y_dist(-360.f, 360.f);
+            std::uniform_real_distribution<f32> r_dist(0.f, math::two_pi<f32>().value);
+            const f32 x = x_dist(random_);
+            const f32 y = y_dist(random_);
+            const f32 r = r_dist(random_);
+            return make_trs2(v2f(x, y), r, v2f(scale));
+        }
+    private:
+        std::mt19937 random_;
+        node_iptr root_;
+    };
+}
+
+namespace e2d_benchmarks
+{
+    bool create_scene(const options& opts) {
+        gobject scene_i = the<world>().instantiate();
+        scene_i.component<scene>().assign();
+        scene_i.component<named>().assign("scene");
+
+        scene_builder builder(opts.seed, scene_i.component<actor>()->node());
+
+        return builder.spawn("prefabs/camera_prefab.json", 1u, 1.f)
+            && builder.spawn("benchmarks/sprite_prefab.json", opts.sprites, 0.5f)
+            && builder.spawn("prefabs/raptor_prefab.json", opts.spines, 0.2f)
+            && builder.spawn("prefabs/label_sdf_prefab.json", opts.labels, 0.5f,
+                [](gobject& inst, u32 index){
+                    inst.component<label>()->text(strings::rformat("Label #%0", index));
+                })
+            && builder.spawn("benchmarks/layout_prefab.json", opts.layouts, 0.5f)
+            && builder.spawn("benchmarks/behaviour_prefab.json", opts.behaviours, 0.5f)
+            && builder.spawn_grouped("benchmarks/sprite_prefab.json", opts.renderables, 16u, 0.1f);
+    }
+}
@@ -111,6 +111,8 @@
 
 #define E2D_AUDIO_MODE_NONE 1
 #define E2D_AUDIO_MODE_BASS 2
+// software mixing into a null sink, picked by E2D_BUILD_WITH_NULL_BACKENDS
+#define E2D_AUDIO_MODE_SOFT 3
 
 #ifndef E2D_AUDIO_MODE
 #  if defined(E2D_PLATFORM) && E2D_PLATFORM == E2D_PLATFORM_IOS
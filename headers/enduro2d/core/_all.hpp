@@ -20,4 +20,5 @@
 #include "render.hpp"
 #include "render.inl"
 #include "vfs.hpp"
+#include "voice_manager.hpp"
 #include "window.hpp"
@@ -53,6 +53,8 @@ namespace e2d
     class index_declaration;
     class vertex_declaration;
     class vfs;
+    class voice_manager;
+    class sound_voice;
     class window;
 }
 
@@ -39,6 +39,8 @@ namespace e2d
         const internal_state& state() const noexcept;
     public:
         explicit sound_stream(internal_state_uptr);
+
+        [[nodiscard]] f32 duration() const noexcept;
     private:
         internal_state_uptr state_;
     };
@@ -11,9 +11,26 @@
 namespace e2d
 {
     class deferrer final : public module<deferrer> {
+    public:
+        class context
+            : private e2d::noncopyable
+            , public ref_counter<context> {
+        public:
+            context() = default;
+            virtual ~context() noexcept = default;
+        };
+        using context_iptr = intrusive_ptr<context>;
+
+        class context_scope final : private e2d::noncopyable {
+        public:
+            context_scope(context_iptr ctx) noexcept;
+            ~context_scope() noexcept;
+        private:
+            context_iptr prev_ctx_;
+        };
     public:
         deferrer();
-        ~deferrer() noexcept final = default;
+        ~deferrer() noexcept final;
 
         stdex::jobber& worker() noexcept;
         const stdex::jobber& worker() const noexcept;
@@ -35,6 +52,16 @@ namespace e2d
         void active_safe_wait_promise(const stdex::promise<T>& promise) noexcept;
 
         void frame_tick() noexcept;
+    public:
+        // the context of the current thread follows tasks scheduled
+        // through the deferrer and continuations of their promises
+        static const context_iptr& current_context() noexcept;
+
+        template < typename T >
+        static stdex::promise<T> bind_context(stdex::promise<T> promise);
+    private:
+        template < typename F >
+        static auto bind_context_(F&& f);
     private:
         stdex::jobber worker_;
         stdex::scheduler scheduler_;
@@ -45,12 +72,22 @@ namespace e2d
 {
     template < typename F , typename... Args , typename R >
     stdex::promise<R> deferrer::do_in_main_thread(F&& f, Args&&... args) {
-        return scheduler_.schedule(std::forward<F>(f), std::forward<Args>(args)...);
+        if ( !current_context() ) {
+            return scheduler_.schedule(std::forward<F>(f), std::forward<Args>(args)...);
+        }
+        return bind_context(scheduler_.schedule(
+            bind_context_(std::forward<F>(f)),
+            std::forward<Args>(args)...));
     }
 
     template < typename F , typename... Args , typename R >
     stdex::promise<R> deferrer::do_in_worker_thread(F&& f, Args&&... args) {
-        return worker_.async(std::forward<F>(f), std::forward<Args>(args)...);
+        if ( !current_context() ) {
+            return worker_.async(std::forward<F>(f), std::forward<Args>(args)...);
+        }
+        return bind_context(worker_.async(
+            bind_context_(std::forward<F>(f)),
+            std::forward<Args>(args)...));
     }
 
     template < typename T >
@@ -64,4 +101,32 @@ namespace e2d
             }
         }
     }
+
+    template < typename T >
+    stdex::promise<T> deferrer::bind_context(stdex::promise<T> promise) {
+        context_iptr ctx = current_context();
+        if ( !ctx ) {
+            return promise;
+        }
+        stdex::promise<T> result;
+        promise.then([result, ctx](auto&&... value) mutable {
+            context_scope scope(ctx);
+            result.resolve(std::forward<decltype(value)>(value)...);
+        }).except([result, ctx](std::exception_ptr e) mutable {
+            context_scope scope(ctx);
+            result.reject(e);
+        });
+        return result;
+    }
+
+    template < typename F >
+    auto deferrer::bind_context_(F&& f) {
+        return [
+            ctx = current_context(),
+            f = std::forward<F>(f)
+        ](auto&&... args) mutable -> decltype(auto) {
+            context_scope scope(ctx);
+            return std::invoke(f, std::forward<decltype(args)>(args)...);
+        };
+    }
 }
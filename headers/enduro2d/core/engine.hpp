@@ -22,6 +22,7 @@ namespace e2d
         class debug_parameters;
         class window_parameters;
         class timer_parameters;
+        class render_parameters;
         class parameters;
     public:
         engine(int argc, char *argv[], const parameters& params);
@@ -37,6 +38,15 @@ namespace e2d
         u32 frame_rate() const noexcept;
         u32 frame_count() const noexcept;
         f32 realtime_time() const noexcept;
+
+        // fixed update mode, see timer_parameters::fixed_update_rate
+
+        bool fixed_update() const noexcept;
+        f32 fixed_delta_time() const noexcept;
+
+        u32 tick_count() const noexcept;
+        u32 frame_tick_count() const noexcept;
+        f32 tick_alpha() const noexcept;
     private:
         class internal_state;
         std::unique_ptr<internal_state> state_;
@@ -108,12 +118,42 @@ namespace e2d
     public:
         timer_parameters& minimal_framerate(u32 value) noexcept;
         timer_parameters& maximal_framerate(u32 value) noexcept;
+        timer_parameters& deterministic(bool value) noexcept;
+
+        // with a non-zero fixed update rate the game is simulated with
+        // a constant time step, the frame runs as many ticks as the elapsed
+        // time needs, but not more than maximal_update_steps, and the rest
+        // of the time is kept for the next frames as the tick alpha
+        timer_parameters& fixed_update_rate(u32 value) noexcept;
+        timer_parameters& maximal_update_steps(u32 value) noexcept;
 
         u32 minimal_framerate() const noexcept;
         u32 maximal_framerate() const noexcept;
+        bool deterministic() const noexcept;
+        u32 fixed_update_rate() const noexcept;
+        u32 maximal_update_steps() const noexcept;
     private:
         u32 minimal_framerate_{15u};
         u32 maximal_framerate_{1000u};
+        bool deterministic_{false};
+        u32 fixed_update_rate_{0u};
+        u32 maximal_update_steps_{5u};
+    };
+
+    //
+    // engine::render_parameters
+    //
+
+    class engine::render_parameters {
+    public:
+        render_parameters& render_thread(bool value) noexcept;
+        render_parameters& max_queued_frames(u32 value) noexcept;
+
+        bool render_thread() const noexcept;
+        u32 max_queued_frames() const noexcept;
+    private:
+        bool render_thread_{false};
+        u32 max_queued_frames_{1u};
     };
 
     //
@@ -133,6 +173,7 @@ namespace e2d
         parameters& debug_params(debug_parameters value) noexcept;
         parameters& window_params(window_parameters value) noexcept;
         parameters& timer_params(timer_parameters value) noexcept;
+        parameters& render_params(render_parameters value) noexcept;
 
         str& game_name() noexcept;
         str& company_name() noexcept;
@@ -142,6 +183,7 @@ namespace e2d
         debug_parameters& debug_params() noexcept;
         window_parameters& window_params() noexcept;
         timer_parameters& timer_params() noexcept;
+        render_parameters& render_params() noexcept;
 
         const str& game_name() const noexcept;
         const str& company_name() const noexcept;
@@ -151,6 +193,7 @@ namespace e2d
         const debug_parameters& debug_params() const noexcept;
         const window_parameters& window_params() const noexcept;
         const timer_parameters& timer_params() const noexcept;
+        const render_parameters& render_params() const noexcept;
     private:
         str game_name_{"noname"};
         str company_name_{"noname"};
@@ -160,6 +203,7 @@ namespace e2d
         debug_parameters debug_params_;
         window_parameters window_params_;
         timer_parameters timer_params_;
+        render_parameters render_params_;
     };
 }
 
@@ -10,6 +10,8 @@
 
 namespace e2d
 {
+    class input_capture;
+
     class mouse final : private noncopyable {
     public:
         mouse();
@@ -114,8 +116,87 @@ namespace e2d
         void post_event(keyboard_key_event evt) noexcept;
 
         void frame_tick() noexcept;
+
+        // the capture starts with the current cursor position and pressed
+        // buttons and keys, the frames are closed by frame_tick
+        void start_recording();
+        bool stop_recording(input_capture& dst);
+        bool is_recording() const noexcept;
+
+        // live events are ignored while replaying, the replay stops
+        // by itself after the last captured frame
+        void start_replaying(input_capture capture);
+        void stop_replaying() noexcept;
+        bool is_replaying() const noexcept;
+
+        // records the delta time of the current frame or returns
+        // the captured one while replaying
+        microseconds<u64> frame_delta_time(microseconds<u64> delta_time) noexcept;
     private:
         class internal_state;
         std::unique_ptr<internal_state> state_;
     };
+
+    //
+    // input_capture
+    //
+
+    class input_capture final {
+    public:
+        using event = std::variant<
+            input::input_char_event,
+            input::move_cursor_event,
+            input::mouse_scroll_event,
+            input::mouse_button_event,
+            input::keyboard_key_event>;
+
+        struct frame {
+            microseconds<u64> delta_time;
+            vector<event> events;
+        };
+    public:
+        input_capture() = default;
+
+        input_capture(input_capture&& other) noexcept = default;
+        input_capture& operator=(input_capture&& other) noexcept = default;
+
+        input_capture(const input_capture& other) = default;
+        input_capture& operator=(const input_capture& other) = default;
+
+        void swap(input_capture& other) noexcept;
+        void clear() noexcept;
+        bool empty() const noexcept;
+
+        input_capture& add_frame(frame f);
+        input_capture& add_frame(microseconds<u64> delta_time, vector<event> events);
+
+        std::size_t frame_count() const noexcept;
+        const frame& frame_at(std::size_t index) const noexcept;
+        const vector<frame>& frames() const noexcept;
+    private:
+        vector<frame> frames_;
+    };
+
+    void swap(input_capture& l, input_capture& r) noexcept;
+    bool operator==(const input_capture& l, const input_capture& r) noexcept;
+    bool operator!=(const input_capture& l, const input_capture& r) noexcept;
+}
+
+namespace e2d::input_captures
+{
+    bool try_load_capture(
+        input_capture& dst,
+        buffer_view src) noexcept;
+
+    bool try_load_capture(
+        input_capture& dst,
+        const input_stream_uptr& src) noexcept;
+
+    bool try_save_capture(
+        const input_capture& src,
+        buffer& dst) noexcept;
+
+    bool try_save_capture(
+        const input_capture& src,
+        const output_stream_uptr& dst) noexcept;
 }
@@ -57,7 +57,7 @@ namespace e2d
     public:
         class auto_scope final : private e2d::noncopyable {
         public:
-            auto_scope(profiler* profiler, str name);
+            auto_scope(profiler* profiler, str_view name);
             auto_scope(profiler* profiler, str name, args_t args);
             ~auto_scope() noexcept;
         private:
@@ -93,10 +93,15 @@ namespace e2d
         T& register_sink(Args&&... args);
         sink& register_sink(sink_uptr sink);
         void unregister_sink(const sink& sink) noexcept;
+
+        // scopes without sinks skip building their names,
+        // so steady frames don't allocate while nobody records
+        bool has_sinks() const noexcept;
     private:
         deferrer& deferrer_;
         std::size_t depth_{0u};
         vector<sink_uptr> sinks_;
+        std::atomic<std::size_t> sink_count_{0u};
         std::recursive_mutex rmutex_;
     };
 }
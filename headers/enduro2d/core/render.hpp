@@ -161,6 +161,7 @@ namespace e2d
             u8 columns = 0;
             attribute_type type = attribute_type::floating_point;
             bool normalized = false;
+            u32 divisor = 0;
         public:
             attribute_info() = default;
             ~attribute_info() noexcept = default;
@@ -174,7 +175,8 @@ namespace e2d
                 u8 rows,
                 u8 columns,
                 attribute_type type,
-                bool normalized) noexcept;
+                bool normalized,
+                u32 divisor) noexcept;
 
             std::size_t row_size() const noexcept;
         };
@@ -189,6 +191,10 @@ namespace e2d
         vertex_declaration& add_attribute(str_hash name) noexcept;
         vertex_declaration& normalized() noexcept;
 
+        // the last attribute advances once per divisor instances
+        // instead of once per vertex, see draw_instanced_command
+        vertex_declaration& per_instance(u32 divisor = 1u) noexcept;
+
         vertex_declaration& skip_bytes(
             std::size_t bytes) noexcept;
 
@@ -202,6 +208,7 @@ namespace e2d
         const attribute_info& attribute(std::size_t index) const noexcept;
         std::size_t attribute_count() const noexcept;
         std::size_t bytes_per_vertex() const noexcept;
+        bool has_per_instance_attributes() const noexcept;
     private:
         constexpr static std::size_t max_attribute_count = 8;
         std::array<attribute_info, max_attribute_count> attributes_;
@@ -236,6 +243,8 @@ namespace e2d
     public:
         explicit shader(internal_state_uptr);
         ~shader() noexcept;
+    public:
+        bool has_attribute(str_hash name) const noexcept;
     private:
         internal_state_uptr state_;
     };
@@ -779,6 +788,48 @@ namespace e2d
             const property_block* properties_ = nullptr;
         };
 
+        class draw_instanced_command final {
+        public:
+            draw_instanced_command() = delete;
+            draw_instanced_command(
+                const material& mat,
+                const geometry& geo,
+                const vertex_buffer_ptr& instances,
+                std::size_t instance_count) noexcept;
+            draw_instanced_command(
+                const material& mat,
+                const geometry& geo,
+                const property_block& props,
+                const vertex_buffer_ptr& instances,
+                std::size_t instance_count) noexcept;
+
+            draw_instanced_command& index_range(std::size_t first, std::size_t count) noexcept;
+
+            draw_instanced_command& first_index(std::size_t value) noexcept;
+            draw_instanced_command& index_count(std::size_t value) noexcept;
+            draw_instanced_command& instance_count(std::size_t value) noexcept;
+            draw_instanced_command& material_ref(const material& value) noexcept;
+            draw_instanced_command& geometry_ref(const geometry& value) noexcept;
+            draw_instanced_command& properties_ref(const property_block& value);
+            draw_instanced_command& instances(const vertex_buffer_ptr& value) noexcept;
+
+            std::size_t first_index() const noexcept;
+            std::size_t index_count() const noexcept;
+            std::size_t instance_count() const noexcept;
+            const material& material_ref() const noexcept;
+            const geometry& geometry_ref() const noexcept;
+            const property_block& properties_ref() const noexcept;
+            const vertex_buffer_ptr& instances() const noexcept;
+        private:
+            std::size_t first_index_ = 0;
+            std::size_t index_count_ = std::size_t(-1);
+            std::size_t instance_count_ = 0;
+            const material* material_ = nullptr;
+            const geometry* geometry_ = nullptr;
+            const property_block* properties_ = nullptr;
+            vertex_buffer_ptr instances_;
+        };
+
         class clear_command final {
         public:
             ENUM_HPP_CLASS_DECL(buffer, u8,
@@ -851,6 +902,7 @@ namespace e2d
         using command_value = std::variant<
             zero_command,
             draw_command,
+            draw_instanced_command,
             clear_command,
             target_command,
             viewport_command>;
@@ -899,6 +951,7 @@ namespace e2d
             bool render_target_supported = false;
 
             bool element_index_uint = false;
+            bool instancing_supported = false;
 
             bool depth16_supported = false;
             bool depth24_supported = false;
@@ -911,6 +964,15 @@ namespace e2d
             bool pvrtc_compression_supported = false;
             bool pvrtc2_compression_supported = false;
         };
+
+        struct statistics {
+            u32 draw_calls = 0;
+            u32 clear_calls = 0;
+            u32 buffer_updates = 0;
+            u32 texture_updates = 0;
+            std::size_t drawn_indices = 0;
+            std::size_t drawn_instances = 0;
+        };
     public:
         render(debug& d, window& w);
         ~render() noexcept final;
@@ -951,6 +1013,7 @@ namespace e2d
         render& execute(const command_value& command);
 
         render& execute(const draw_command& command);
+        render& execute(const draw_instanced_command& command);
         render& execute(const clear_command& command);
         render& execute(const target_command& command);
         render& execute(const viewport_command& command);
@@ -977,11 +1040,29 @@ namespace e2d
 
         const device_caps& device_capabilities() const noexcept;
         bool is_pixel_supported(const pixel_declaration& decl) const noexcept;
+        bool is_image_format_supported(image_data_format format) const noexcept;
         bool is_index_supported(const index_declaration& decl) const noexcept;
         bool is_vertex_supported(const vertex_declaration& decl) const noexcept;
+
+        const statistics& frame_statistics() const noexcept;
+        render& reset_frame_statistics() noexcept;
+
+        // in the pipelined mode the calls of other threads are recorded into
+        // frame snapshots and submitted by the render thread one frame later,
+        // resource creation waits for the render thread
+        bool start_render_thread(std::size_t max_queued_frames);
+        void stop_render_thread() noexcept;
+        bool is_render_thread_active() const noexcept;
+        bool is_in_render_thread() const noexcept;
+
+        // presents the frame or queues the recorded snapshot to the render thread
+        render& submit_frame();
+        render& wait_for_render_thread() noexcept;
     private:
         class internal_state;
         std::unique_ptr<internal_state> state_;
+        class pipeline_state;
+        std::unique_ptr<pipeline_state> pipeline_;
     };
 
     ENUM_HPP_REGISTER_TRAITS(render::topology)
@@ -122,11 +122,17 @@ namespace e2d
 
     template < typename T >
     void render::property_map<T>::merge(const property_map& other) {
-        if ( this != &other ) {
-            other.foreach([this](str_hash name, const T& value){
-                assign(name, value);
-            });
+        if ( this == &other || other.values_.empty() ) {
+            return;
         }
+        if ( values_.empty() ) {
+            // reuses the capacity without per-property insertions
+            values_ = other.values_;
+            return;
+        }
+        other.foreach([this](str_hash name, const T& value){
+            assign(name, value);
+        });
     }
 
     template < typename T >
@@ -33,8 +33,18 @@ namespace e2d
             virtual input_stream_uptr read(str_view path) const = 0;
             virtual output_stream_uptr write(str_view path, bool append) const = 0;
             virtual bool trace(str_view path, filesystem::trace_func func) const = 0;
+            virtual bool watch(str_view path) const;
+            virtual void poll_changes(vector<str>& changed_paths) const;
+            virtual bool prefetch(str_view path) const;
         };
         using file_source_uptr = std::unique_ptr<file_source>;
+
+        class change_listener : private e2d::noncopyable {
+        public:
+            virtual ~change_listener() noexcept = default;
+            virtual void on_change(const url& url) noexcept = 0;
+        };
+        using change_listener_uptr = std::unique_ptr<change_listener>;
     public:
         vfs();
         ~vfs() noexcept final;
@@ -66,6 +76,21 @@ namespace e2d
         bool trace(const url& url, filesystem::trace_func func) const;
 
         url resolve_scheme_aliases(const url& url) const;
+
+        // watched files are reported to change listeners by frame_tick
+        bool watch(const url& url) const;
+
+        // makes a remote file available locally, a manifest is a text file
+        // with a path relative to the manifest directory on every line
+        bool prefetch(const url& url) const;
+        stdex::promise<void> prefetch_async(const url& manifest_url) const;
+
+        template < typename T, typename... Args >
+        T& register_change_listener(Args&&... args);
+        change_listener& register_change_listener(change_listener_uptr listener);
+        void unregister_change_listener(const change_listener& listener) noexcept;
+
+        void frame_tick() noexcept;
     private:
         class state;
         std::unique_ptr<state> state_;
@@ -94,6 +119,34 @@ namespace e2d
         input_stream_uptr read(str_view path) const final;
         output_stream_uptr write(str_view path, bool append) const final;
         bool trace(str_view path, filesystem::trace_func func) const final;
+        bool watch(str_view path) const final;
+        void poll_changes(vector<str>& changed_paths) const final;
+    private:
+        class state;
+        std::unique_ptr<state> state_;
+    };
+
+    //
+    // http_file_source
+    //
+    // Paths are remote urls without the scheme. Files are read by range
+    // requests, sequentially read and prefetched files are kept in the cache
+    // directory and validated by their ETags. Requires the network module.
+    //
+
+    class http_file_source final : public vfs::file_source {
+    public:
+        http_file_source(str scheme, str cache_directory);
+        ~http_file_source() noexcept final;
+        bool valid() const noexcept final;
+        bool exists(str_view path) const final;
+        input_stream_uptr read(str_view path) const final;
+        output_stream_uptr write(str_view path, bool append) const final;
+        bool trace(str_view path, filesystem::trace_func func) const final;
+        bool prefetch(str_view path) const final;
+    private:
+        class state;
+        std::shared_ptr<state> state_;
     };
 }
 
@@ -106,6 +159,12 @@ namespace e2d
             std::make_unique<T>(std::forward<Args>(args)...));
     }
 
+    template < typename T, typename... Args >
+    T& vfs::register_change_listener(Args&&... args) {
+        return static_cast<T&>(
+            register_change_listener(std::make_unique<T>(std::forward<Args>(args)...)));
+    }
+
     template < typename Iter >
     bool vfs::extract(const url& url, Iter result_iter) const {
         return trace(url, [&result_iter](str_view filename, bool directory){
@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_core.hpp"
+
+#include "audio.hpp"
+
+namespace e2d
+{
+    class sound_voice;
+    using sound_voice_ptr = std::shared_ptr<sound_voice>;
+
+    //
+    // sound_voice
+    //
+    // Playback handle that owns a real sound source only while it is
+    // audible and wins its category limit, otherwise it is virtual and
+    // only its playback time is tracked.
+    //
+
+    class sound_voice final : noncopyable {
+    public:
+        enum class states : u8 {
+            stopped,
+            playing,
+            paused
+        };
+    public:
+        sound_voice(
+            const sound_stream_ptr& stream,
+            str_hash category,
+            i32 priority);
+        ~sound_voice() noexcept;
+
+        [[nodiscard]] const sound_stream_ptr& stream() const noexcept;
+        [[nodiscard]] str_hash category() const noexcept;
+        [[nodiscard]] i32 priority() const noexcept;
+
+        void play() noexcept;
+        void stop() noexcept;
+        void pause() noexcept;
+        void resume() noexcept;
+        [[nodiscard]] states state() const noexcept;
+        [[nodiscard]] bool playing() const noexcept;
+
+        void looping(bool value) noexcept;
+        [[nodiscard]] bool looping() const noexcept;
+
+        void volume(f32 value) noexcept;
+        [[nodiscard]] f32 volume() const noexcept;
+
+        // distance to the listener, attenuated by the category max distance
+        void distance(f32 value) noexcept;
+        [[nodiscard]] f32 distance() const noexcept;
+
+        void position(f32 value) noexcept;
+        [[nodiscard]] f32 position() const noexcept;
+        [[nodiscard]] f32 duration() const noexcept;
+
+        [[nodiscard]] bool is_virtual() const noexcept;
+        [[nodiscard]] f32 audibility() const noexcept;
+
+        // won the ranking at the last frame tick, such voices
+        // are real whenever the audio backend gives them a source
+        [[nodiscard]] bool audible() const noexcept;
+    private:
+        void release_source_() noexcept;
+    private:
+        friend class voice_manager;
+        sound_stream_ptr stream_;
+        sound_source_ptr source_;
+        str_hash category_;
+        i32 priority_{0};
+        states state_{states::stopped};
+        bool looping_{false};
+        bool audible_{false};
+        f32 volume_{1.f};
+        f32 distance_{0.f};
+        f32 position_{0.f};
+        f32 duration_{0.f};
+        f32 audibility_{0.f};
+        f32 source_gain_{-1.f};
+    };
+
+    //
+    // voice_manager
+    //
+
+    class voice_manager final : public module<voice_manager> {
+    public:
+        class category final {
+        public:
+            category& max_voices(u32 value) noexcept;
+            category& volume(f32 value) noexcept;
+            category& max_distance(f32 value) noexcept;
+
+            [[nodiscard]] u32 max_voices() const noexcept;
+            [[nodiscard]] f32 volume() const noexcept;
+            [[nodiscard]] f32 max_distance() const noexcept;
+        private:
+            u32 max_voices_{16u};
+            f32 volume_{1.f};
+            f32 max_distance_{0.f};
+        };
+
+        struct statistics {
+            std::size_t voices{0u};
+            std::size_t audible_voices{0u};
+            std::size_t real_voices{0u};
+            std::size_t virtual_voices{0u};
+            std::size_t realized_voices{0u};
+            std::size_t virtualized_voices{0u};
+        };
+    public:
+        voice_manager(debug& d, audio& a);
+        ~voice_manager() noexcept final;
+
+        // voices are kept alive by the manager until they stop,
+        // looping voices are stopped when their last handle is dropped
+        [[nodiscard]] sound_voice_ptr create_voice(
+            const sound_stream_ptr& stream,
+            str_hash category = str_hash(),
+            i32 priority = 0);
+
+        voice_manager& register_category(str_hash name, const category& params);
+        [[nodiscard]] const category& find_category(str_hash name) const noexcept;
+
+        // the number of audible voices, whether they are real or not
+        voice_manager& max_real_voices(u32 value) noexcept;
+        [[nodiscard]] u32 max_real_voices() const noexcept;
+
+        // voices quieter than the threshold are always virtual
+        voice_manager& audibility_threshold(f32 value) noexcept;
+        [[nodiscard]] f32 audibility_threshold() const noexcept;
+
+        [[nodiscard]] const statistics& stats() const noexcept;
+
+        void frame_tick(f32 dt) noexcept;
+    private:
+        class internal_state;
+        std::unique_ptr<internal_state> state_;
+    };
+}
@@ -79,6 +79,7 @@ namespace e2d
         void set_should_close(bool yesno) noexcept;
 
         void bind_context() noexcept;
+        void unbind_context() noexcept;
         void swap_buffers() noexcept;
         static bool poll_events() noexcept;
 
@@ -64,13 +64,16 @@
 #include "systems/render_system.hpp"
 #include "systems/script_system.hpp"
 #include "systems/spine_system.hpp"
+#include "systems/streaming_system.hpp"
 #include "systems/touch_system.hpp"
 #include "systems/world_system.hpp"
 
 #include "address.hpp"
 #include "asset.hpp"
 #include "asset.inl"
+#include "dynamic_atlas.hpp"
 #include "editor.hpp"
+#include "event_stream.hpp"
 #include "factory.hpp"
 #include "factory.inl"
 #include "gobject.hpp"
@@ -82,4 +85,5 @@
 #include "node.hpp"
 #include "node.inl"
 #include "starter.hpp"
+#include "streamer.hpp"
 #include "world.hpp"
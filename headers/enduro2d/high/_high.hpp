@@ -84,6 +84,7 @@ namespace e2d
     class render_system;
     class script_system;
     class spine_system;
+    class streaming_system;
     class touch_system;
     class world_system;
 
@@ -97,12 +98,18 @@ namespace e2d
     class asset_group;
     class asset_dependencies;
 
+    class dynamic_atlas;
     class editor;
     class inspector;
     class luasol;
     class starter;
+    class streamer;
     class world;
 
+    class event_stream_base;
+    template < typename E >
+    class event_stream;
+
     class node;
     class gobject;
     template < typename T >
@@ -129,36 +136,6 @@ namespace sol
     };
 }
 
-namespace e2d::ecsex
-{
-    template < typename T, typename Disposer, typename... Opts >
-    void remove_all_components_with_disposer(
-        ecs::registry& owner,
-        Disposer&& disposer,
-        Opts&&... opts)
-    {
-        static thread_local vector<ecs::entity> to_remove_components;
-        E2D_DEFER([](){ to_remove_components.clear(); });
-
-        owner.for_each_component<T>([](const ecs::entity& e, const T&){
-            to_remove_components.push_back(e);
-        }, std::forward<Opts>(opts)...);
-
-        for ( ecs::entity& e : to_remove_components ) {
-            std::invoke(disposer, e, e.get_component<T>());
-            e.remove_component<T>();
-        }
-    }
-
-    template < typename T, typename... Opts >
-    void remove_all_components(ecs::registry& owner, Opts&&... opts) {
-        remove_all_components_with_disposer<T>(
-            owner,
-            null_disposer(),
-            std::forward<Opts>(opts)...);
-    }
-}
-
 namespace e2d::ecsex
 {
     template < typename... Ts, typename Iter, typename... Opts >
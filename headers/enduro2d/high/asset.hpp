@@ -59,6 +59,7 @@ namespace e2d
 
         void fill(Content content);
         void fill(Content content, nested_content nested_content);
+        void fill(content_asset&& other);
 
         const Content& content() const noexcept;
 
@@ -100,6 +101,7 @@ namespace e2d
 
             asset_ptr find(str_hash address) const noexcept;
             void store(str_hash address, const asset_ptr& asset);
+            asset_ptr remove(str_hash address) noexcept;
 
             std::size_t asset_count() const noexcept override;
             std::size_t unload_unused_assets() noexcept override;
@@ -123,6 +125,9 @@ namespace e2d
         template < typename Asset >
         typename Asset::ptr find(str_hash address) const noexcept;
 
+        template < typename Asset >
+        typename Asset::ptr remove(str_hash address) noexcept;
+
         template < typename Asset >
         std::size_t asset_count() const noexcept;
         std::size_t asset_count() const noexcept;
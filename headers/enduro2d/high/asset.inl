@@ -47,6 +47,12 @@ namespace e2d
         nested_content_ = std::move(nested_content);
     }
 
+    template < typename Asset, typename Content >
+    void content_asset<Asset, Content>::fill(content_asset&& other) {
+        content_ = std::move(other.content_);
+        nested_content_ = std::move(other.nested_content_);
+    }
+
     template < typename Asset, typename Content >
     const Content& content_asset<Asset, Content>::content() const noexcept {
         return content_;
@@ -89,6 +95,17 @@ namespace e2d
             assets_[address] = asset;
         }
 
+        template < typename T >
+        typename typed_asset_cache<T>::asset_ptr typed_asset_cache<T>::remove(str_hash address) noexcept {
+            const auto iter = assets_.find(address);
+            if ( iter == assets_.end() ) {
+                return nullptr;
+            }
+            asset_ptr asset = std::move(iter->second);
+            assets_.erase(iter);
+            return asset;
+        }
+
         template < typename T >
         std::size_t typed_asset_cache<T>::asset_count() const noexcept {
             return assets_.size();
@@ -139,6 +156,17 @@ namespace e2d
             : nullptr;
     }
 
+    template < typename Asset >
+    typename Asset::ptr asset_store::remove(str_hash address) noexcept {
+        const auto iter = caches_.find(utils::type_family<Asset>::id());
+        impl::typed_asset_cache<Asset>* cache = iter != caches_.end() && iter->second
+            ? static_cast<impl::typed_asset_cache<Asset>*>(iter->second.get())
+            : nullptr;
+        return cache
+            ? cache->remove(address)
+            : nullptr;
+    }
+
     template < typename Asset >
     std::size_t asset_store::asset_count() const noexcept {
         const auto iter = caches_.find(utils::type_family<Asset>::id());
@@ -17,5 +17,17 @@ namespace e2d
     public:
         static const char* type_name() noexcept { return "json_asset"; }
         static load_async_result load_async(const library& library, str_view address);
+    public:
+        using content_asset<json_asset, json_uptr>::create;
+        static load_result create(json_uptr content, const sha256_digest& content_digest);
+
+        // empty if the source text of the document is unknown
+        const std::optional<sha256_digest>& content_digest() const noexcept;
+
+        // successful results are cached by schema and content digest,
+        // so reloading an unchanged document skips the validation
+        bool validate(const rapidjson::SchemaDocument& schema, str_view address) const;
+    private:
+        std::optional<sha256_digest> content_digest_;
     };
 }
@@ -78,12 +78,30 @@ namespace e2d
         spine_player& materials(flat_map<str_hash, material_asset::ptr> value) noexcept;
         const flat_map<str_hash, material_asset::ptr>& materials() const noexcept;
         material_asset::ptr find_material(str_hash name) const noexcept;
+
+        spine_player& use_pose_cache(bool value) noexcept;
+        spine_player& pose_sample_rate(f32 value) noexcept;
+
+        bool use_pose_cache() const noexcept;
+        f32 pose_sample_rate() const noexcept;
+        bool has_custom_attachments() const noexcept;
+
+        // set by the spine system, nullptr while the skeleton is evaluated by the runtime
+        spine_player& baked_pose(
+            spine_pose_cache::baked_animation_ptr animation,
+            const spine_pose_cache::pose* pose) noexcept;
+        const spine_pose_cache::pose* baked_pose() const noexcept;
     private:
         spine_asset::ptr spine_;
         clipping_ptr clipping_;
         skeleton_ptr skeleton_;
         animation_ptr animation_;
         flat_map<str_hash, material_asset::ptr> materials_;
+        bool use_pose_cache_{false};
+        bool custom_attachments_{false};
+        f32 pose_sample_rate_{spine_pose_cache::default_sample_rate};
+        spine_pose_cache::baked_animation_ptr baked_animation_;
+        const spine_pose_cache::pose* baked_pose_{nullptr};
     };
 }
 
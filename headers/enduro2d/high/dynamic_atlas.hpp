@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_high.hpp"
+
+#include "resources/sprite.hpp"
+
+namespace e2d
+{
+    //
+    // dynamic_atlas
+    //
+    // Copies small loose images into shared texture pages at runtime,
+    // so sprites from different images can be batched together.
+    // When all pages are full, pages without external references are evicted.
+    // Insertion uploads texture data and must be called from the main thread.
+    //
+
+    class dynamic_atlas final : public module<dynamic_atlas> {
+    public:
+        class parameters {
+        public:
+            parameters() = default;
+
+            parameters& page_size(const v2u& value) noexcept;
+            parameters& max_pages(std::size_t value) noexcept;
+            parameters& max_image_size(const v2u& value) noexcept;
+
+            // edge texels of every image are extruded into its padding
+            parameters& padding(u32 value) noexcept;
+
+            const v2u& page_size() const noexcept;
+            std::size_t max_pages() const noexcept;
+            const v2u& max_image_size() const noexcept;
+            u32 padding() const noexcept;
+        private:
+            v2u page_size_{1024u, 1024u};
+            std::size_t max_pages_{4u};
+            v2u max_image_size_{256u, 256u};
+            u32 padding_{2u};
+        };
+
+        struct statistics {
+            std::size_t pages{0u};
+            std::size_t images{0u};
+            std::size_t evictions{0u};
+            std::size_t rejections{0u};
+            f32 occupancy{0.f};
+        };
+    public:
+        dynamic_atlas();
+        explicit dynamic_atlas(const parameters& params);
+        ~dynamic_atlas() noexcept final;
+
+        bool is_suitable(const image& img) const noexcept;
+
+        bool find(str_hash key, sprite& dst) const;
+
+        bool try_insert(
+            str_hash key,
+            const image& img,
+            sprite& dst);
+
+        // texrects are in pixels of the source image
+        bool try_insert(
+            str_hash key,
+            const image& img,
+            const b2f& inner_texrect,
+            const b2f& outer_texrect,
+            sprite& dst);
+
+        std::size_t evict_unused_pages();
+
+        statistics stats() const;
+    private:
+        class internal_state;
+        std::unique_ptr<internal_state> state_;
+    };
+}
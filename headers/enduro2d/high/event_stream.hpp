@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_high.hpp"
+
+#include "components/events.hpp"
+
+namespace e2d
+{
+    //
+    // event_stream_base
+    //
+
+    class event_stream_base : private noncopyable {
+    public:
+        virtual ~event_stream_base() noexcept = default;
+        virtual void clear() noexcept = 0;
+        virtual std::size_t size() const noexcept = 0;
+    };
+
+    //
+    // event_stream
+    //
+    // Append-only sequence of (target, event) records of one event type,
+    // the records keep their storage between clears, so the stream doesn't
+    // allocate once it has grown to the usual amount of events per frame.
+    //
+    // Targets that already have an events<E> component get their events
+    // appended to it too, the component is a per-entity view for the code
+    // that used to consume it and isn't created by the stream.
+    //
+
+    template < typename E >
+    class event_stream final : public event_stream_base {
+    public:
+        struct record {
+            ecs::entity target;
+            E event;
+        };
+    public:
+        event_stream() = default;
+        ~event_stream() noexcept final = default;
+
+        event_stream& add(ecs::entity target, E event);
+
+        void clear() noexcept final;
+        [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] std::size_t size() const noexcept final;
+
+        [[nodiscard]] const vector<record>& records() const noexcept;
+
+        // F: void(const ecs::entity& target, const E& event)
+        // the callback must not add events to the same stream
+
+        template < typename F, typename... Opts >
+        void for_each(F&& f, Opts&&... opts) const;
+
+        template < typename F >
+        void for_each_by_target(const ecs::const_entity& target, F&& f) const;
+    private:
+        void update_target_index_() const;
+    private:
+        vector<record> records_;
+        vector<ecs::entity> view_targets_;
+        mutable vector<std::pair<ecs::entity_id, std::size_t>> target_index_;
+        mutable bool target_index_dirty_{false};
+    };
+}
+
+namespace e2d
+{
+    template < typename E >
+    event_stream<E>& event_stream<E>::add(ecs::entity target, E event) {
+        if ( events<E>* view = target.find_component<events<E>>() ) {
+            view->add(event);
+            view_targets_.push_back(target);
+        }
+        records_.push_back({std::move(target), std::move(event)});
+        target_index_dirty_ = true;
+        return *this;
+    }
+
+    template < typename E >
+    void event_stream<E>::clear() noexcept {
+        for ( ecs::entity& target : view_targets_ ) {
+            if ( target.valid() ) {
+                if ( events<E>* view = target.find_component<events<E>>() ) {
+                    view->clear();
+                }
+            }
+        }
+        view_targets_.clear();
+        records_.clear();
+        target_index_.clear();
+        target_index_dirty_ = false;
+    }
+
+    template < typename E >
+    bool event_stream<E>::empty() const noexcept {
+        return records_.empty();
+    }
+
+    template < typename E >
+    std::size_t event_stream<E>::size() const noexcept {
+        return records_.size();
+    }
+
+    template < typename E >
+    const vector<typename event_stream<E>::record>& event_stream<E>::records() const noexcept {
+        return records_;
+    }
+
+    template < typename E >
+    template < typename F, typename... Opts >
+    void event_stream<E>::for_each(F&& f, Opts&&... opts) const {
+        for ( std::size_t i = 0, e = records_.size(); i < e; ++i ) {
+            const record& r = records_[i];
+            if ( !r.target.valid() ) {
+                continue;
+            }
+            if ( (... && std::invoke(opts, ecs::const_entity(r.target))) ) {
+                std::invoke(f, r.target, r.event);
+            }
+        }
+    }
+
+    template < typename E >
+    template < typename F >
+    void event_stream<E>::for_each_by_target(const ecs::const_entity& target, F&& f) const {
+        update_target_index_();
+
+        const auto range = std::equal_range(
+            target_index_.begin(),
+            target_index_.end(),
+            std::make_pair(target.id(), std::size_t(0)),
+            [](const auto& l, const auto& r) noexcept {
+                return l.first < r.first;
+            });
+
+        for ( auto iter = range.first; iter != range.second; ++iter ) {
+            const record& r = records_[iter->second];
+            std::invoke(f, r.target, r.event);
+        }
+    }
+
+    template < typename E >
+    void event_stream<E>::update_target_index_() const {
+        if ( !target_index_dirty_ ) {
+            return;
+        }
+
+        target_index_.clear();
+        target_index_.reserve(records_.size());
+        for ( std::size_t i = 0, e = records_.size(); i < e; ++i ) {
+            target_index_.emplace_back(records_[i].target.id(), i);
+        }
+
+        // stable to keep the events of one target in the order of addition
+        std::stable_sort(
+            target_index_.begin(),
+            target_index_.end(),
+            [](const auto& l, const auto& r) noexcept {
+                return l.first < r.first;
+            });
+
+        target_index_dirty_ = false;
+    }
+}
@@ -66,6 +66,8 @@ namespace e2d
         class factory_creator;
         using factory_creator_iptr = intrusive_ptr<factory_creator>;
 
+        // creators are shared by concurrent prefab loading jobs, the schema
+        // is compiled once on registration and isn't changed after that
         class factory_creator
             : private noncopyable
             , public ref_counter<factory_creator> {
@@ -25,10 +25,45 @@ namespace e2d
         public:
             virtual ~state() noexcept {}
             virtual void destroy() noexcept = 0;
-            virtual bool destroyed() const noexcept = 0;
-            virtual bool invalided() const noexcept = 0;
-            virtual ecs::entity raw_entity() noexcept = 0;
-            virtual ecs::const_entity raw_entity() const noexcept = 0;
+        public:
+            // non-virtual to keep component lookups cheap
+
+            bool destroyed() const noexcept {
+                return math::check_any_flags(flags_, fm_destroyed);
+            }
+
+            bool invalided() const noexcept {
+                return math::check_any_flags(flags_, fm_invalided);
+            }
+
+            ecs::entity raw_entity() noexcept {
+                E2D_ASSERT(!invalided());
+                return entity_;
+            }
+
+            ecs::const_entity raw_entity() const noexcept {
+                E2D_ASSERT(!invalided());
+                return entity_;
+            }
+        protected:
+            explicit state(ecs::entity entity) noexcept
+            : entity_(std::move(entity)) {}
+
+            void mark_destroyed() noexcept {
+                math::set_flags_inplace(flags_, fm_destroyed);
+            }
+
+            void mark_invalided() noexcept {
+                math::set_flags_inplace(flags_, fm_invalided);
+            }
+        private:
+            enum flag_masks : u32 {
+                fm_destroyed = 1u << 0,
+                fm_invalided = 1u << 1,
+            };
+        private:
+            ecs::entity entity_;
+            u32 flags_{0u};
         };
         using state_iptr = intrusive_ptr<state>;
         const state_iptr& internal_state() const noexcept;
@@ -55,6 +90,23 @@ namespace e2d
         ecs::component<T> raw_component() noexcept;
         template < typename T >
         ecs::const_component<T> raw_component() const noexcept;
+    public:
+        // changes after any gobject creation or destruction and
+        // after any T component addition or removal through gcomponent
+        // or ecsex, gcomponent handles cache the component pointer until
+        // it changes, so other raw ecs changes must be marked too
+        template < typename T >
+        static u32 structure_version() noexcept;
+
+        static void mark_structure_changed() noexcept;
+
+        template < typename T >
+        static void mark_structure_changed() noexcept;
+    private:
+        static std::atomic<u32>& structure_counter_() noexcept;
+
+        template < typename T >
+        static std::atomic<u32>& component_structure_counter_() noexcept;
     private:
         state_iptr state_;
     };
@@ -100,8 +152,14 @@ namespace e2d
 
         template < typename U >
         const_gcomponent<U> component() const noexcept;
+    private:
+        T* find_cached_() const noexcept;
+        void reset_cache_() noexcept;
     private:
         gobject owner_;
+        mutable T* cached_{nullptr};
+        mutable u32 cached_version_{0u};
+        mutable bool cache_valid_{false};
     };
 
     template < typename T >
@@ -125,8 +183,13 @@ namespace e2d
 
         template < typename U >
         const_gcomponent<U> component() const noexcept;
+    private:
+        const T* find_cached_() const noexcept;
     private:
         gobject owner_;
+        mutable const T* cached_{nullptr};
+        mutable u32 cached_version_{0u};
+        mutable bool cache_valid_{false};
     };
 }
 
@@ -153,6 +216,23 @@ namespace e2d
         E2D_ASSERT(valid());
         return ecs::const_component<T>(raw_entity());
     }
+
+    template < typename T >
+    u32 gobject::structure_version() noexcept {
+        return structure_counter_().load(std::memory_order_acquire)
+            + component_structure_counter_<T>().load(std::memory_order_acquire);
+    }
+
+    template < typename T >
+    void gobject::mark_structure_changed() noexcept {
+        component_structure_counter_<T>().fetch_add(1u, std::memory_order_acq_rel);
+    }
+
+    template < typename T >
+    std::atomic<u32>& gobject::component_structure_counter_() noexcept {
+        static std::atomic<u32> counter{0u};
+        return counter;
+    }
 }
 
 namespace e2d
@@ -168,55 +248,65 @@ namespace e2d
 
     template < typename T >
     bool gcomponent<T>::exists() const noexcept {
-        return owner_.valid()
-            && owner_.raw_component<T>().exists();
+        return !!find_cached_();
     }
 
     template < typename T >
     template < typename... Args >
     T& gcomponent<T>::assign(Args&&... args) {
         E2D_ASSERT(owner_.valid());
-        return owner_.raw_component<T>().assign(std::forward<Args>(args)...);
+        T& result = owner_.raw_component<T>().assign(std::forward<Args>(args)...);
+        gobject::mark_structure_changed<T>();
+        reset_cache_();
+        return result;
     }
 
     template < typename T >
     template < typename... Args >
     T& gcomponent<T>::ensure(Args&&... args) {
         E2D_ASSERT(owner_.valid());
-        return owner_.raw_component<T>().ensure(std::forward<Args>(args)...);
+        if ( T* component = find_cached_() ) {
+            return *component;
+        }
+        return assign(std::forward<Args>(args)...);
     }
 
     template < typename T >
     bool gcomponent<T>::remove() noexcept {
-        return owner_.valid()
-            ? owner_.raw_component<T>().remove()
-            : false;
+        if ( !owner_.valid() || !owner_.raw_component<T>().remove() ) {
+            return false;
+        }
+        gobject::mark_structure_changed<T>();
+        reset_cache_();
+        return true;
     }
 
     template < typename T >
     T& gcomponent<T>::get() {
         E2D_ASSERT(owner_.valid());
+        if ( T* component = find_cached_() ) {
+            return *component;
+        }
         return owner_.raw_component<T>().get();
     }
 
     template < typename T >
     const T& gcomponent<T>::get() const {
         E2D_ASSERT(owner_.valid());
+        if ( const T* component = find_cached_() ) {
+            return *component;
+        }
         return owner_.raw_component<T>().get();
     }
 
     template < typename T >
     T* gcomponent<T>::find() noexcept {
-        return owner_.valid()
-            ? owner_.raw_component<T>().find()
-            : nullptr;
+        return find_cached_();
     }
 
     template < typename T >
     const T* gcomponent<T>::find() const noexcept {
-        return owner_.valid()
-            ? owner_.raw_component<T>().find()
-            : nullptr;
+        return find_cached_();
     }
 
     template < typename T >
@@ -260,6 +350,32 @@ namespace e2d
     const_gcomponent<U> gcomponent<T>::component() const noexcept {
         return owner_.component<U>();
     }
+
+    template < typename T >
+    T* gcomponent<T>::find_cached_() const noexcept {
+        // any gobject destruction changes the version too,
+        // so a cached pointer never outlives its owner
+        const u32 version = gobject::structure_version<T>();
+        if ( !cache_valid_ || cached_version_ != version ) {
+            cached_ = owner_.valid()
+                ? const_cast<T*>(owner_.raw_component<T>().find())
+                : nullptr;
+            cached_version_ = version;
+            cache_valid_ = true;
+            return cached_;
+        }
+        // debug builds verify the cache hits only
+        E2D_ASSERT_MSG(
+            cached_ == (owner_.valid() ? owner_.raw_component<T>().find() : nullptr),
+            "raw ecs component changes must be marked by gobject::mark_structure_changed<T>");
+        return cached_;
+    }
+
+    template < typename T >
+    void gcomponent<T>::reset_cache_() noexcept {
+        cached_ = nullptr;
+        cache_valid_ = false;
+    }
 }
 
 namespace e2d
@@ -279,21 +395,21 @@ namespace e2d
 
     template < typename T >
     bool const_gcomponent<T>::exists() const noexcept {
-        return owner_.valid()
-            && owner_.raw_component<T>().exists();
+        return !!find_cached_();
     }
 
     template < typename T >
     const T& const_gcomponent<T>::get() const {
         E2D_ASSERT(owner_.valid());
+        if ( const T* component = find_cached_() ) {
+            return *component;
+        }
         return owner_.raw_component<T>().get();
     }
 
     template < typename T >
     const T* const_gcomponent<T>::find() const noexcept {
-        return owner_.valid()
-            ? owner_.raw_component<T>().find()
-            : nullptr;
+        return find_cached_();
     }
 
     template < typename T >
@@ -321,4 +437,101 @@ namespace e2d
     const_gcomponent<U> const_gcomponent<T>::component() const noexcept {
         return owner_.component<U>();
     }
+
+    template < typename T >
+    const T* const_gcomponent<T>::find_cached_() const noexcept {
+        const u32 version = gobject::structure_version<T>();
+        if ( !cache_valid_ || cached_version_ != version ) {
+            cached_ = owner_.valid()
+                ? owner_.raw_component<T>().find()
+                : nullptr;
+            cached_version_ = version;
+            cache_valid_ = true;
+            return cached_;
+        }
+        E2D_ASSERT_MSG(
+            cached_ == (owner_.valid() ? owner_.raw_component<T>().find() : nullptr),
+            "raw ecs component changes must be marked by gobject::mark_structure_changed<T>");
+        return cached_;
+    }
+}
+
+namespace e2d::ecsex
+{
+    //
+    // raw ecs changes of the engine go through these,
+    // so gcomponent caches never see a stale structure
+    //
+
+    inline ecs::entity create_entity(ecs::registry& owner, const ecs::prototype& proto) {
+        ecs::entity result = owner.create_entity(proto);
+        gobject::mark_structure_changed();
+        return result;
+    }
+
+    inline void destroy_entity(ecs::entity e) noexcept {
+        e.destroy();
+        gobject::mark_structure_changed();
+    }
+
+    template < typename T, typename... Args >
+    T& assign_component(ecs::entity e, Args&&... args) {
+        T& result = e.assign_component<T>(std::forward<Args>(args)...);
+        gobject::mark_structure_changed<T>();
+        return result;
+    }
+
+    template < typename T, typename... Args >
+    T& ensure_component(ecs::entity e, Args&&... args) {
+        if ( T* component = e.find_component<T>() ) {
+            return *component;
+        }
+        return assign_component<T>(e, std::forward<Args>(args)...);
+    }
+
+    template < typename T >
+    bool remove_component(ecs::entity e) {
+        if ( !e.remove_component<T>() ) {
+            return false;
+        }
+        gobject::mark_structure_changed<T>();
+        return true;
+    }
+
+    template < typename T, typename Disposer, typename... Opts >
+    void remove_all_components_with_disposer(
+        ecs::registry& owner,
+        Disposer&& disposer,
+        Opts&&... opts)
+    {
+        static thread_local vector<ecs::entity> to_remove_components;
+        E2D_DEFER([](){ to_remove_components.clear(); });
+
+        owner.for_each_component<T>([](const ecs::entity& e, const T&){
+            to_remove_components.push_back(e);
+        }, std::forward<Opts>(opts)...);
+
+        for ( ecs::entity& e : to_remove_components ) {
+            std::invoke(disposer, e, e.get_component<T>());
+            e.remove_component<T>();
+        }
+
+        if ( !to_remove_components.empty() ) {
+            gobject::mark_structure_changed<T>();
+        }
+    }
+
+    template < typename T, typename... Opts >
+    void remove_all_components(ecs::registry& owner, Opts&&... opts) {
+        if constexpr ( sizeof...(Opts) == 0 ) {
+            if ( owner.remove_all_components<T>() ) {
+                gobject::mark_structure_changed<T>();
+            }
+        } else {
+            remove_all_components_with_disposer<T>(
+                owner,
+                null_disposer(),
+                std::forward<Opts>(opts)...);
+        }
+    }
 }
@@ -201,6 +201,10 @@ namespace e2d
         void show_for(
             gobject go,
             component_inspector<>::gizmos_context& ctx);
+
+        bool has_component(
+            gobject go,
+            str_view type) const;
     private:
         struct inspector_impl {
             impl::inspector_drawer_iptr drawer;
@@ -23,12 +23,49 @@ namespace e2d
         }
     };
 
+    //
+    // loading_token
+    //
+
+    class loading_token;
+    using loading_token_iptr = intrusive_ptr<loading_token>;
+
+    class loading_token final
+        : private noncopyable
+        , public ref_counter<loading_token> {
+    public:
+        loading_token(i32 priority = 0) noexcept;
+        ~loading_token() noexcept = default;
+
+        // can be changed while requested assets are queued
+        loading_token& priority(i32 value) noexcept;
+        i32 priority() const noexcept;
+
+        void cancel() noexcept;
+        bool cancelled() const noexcept;
+    private:
+        std::atomic<i32> priority_{0};
+        std::atomic<bool> cancelled_{false};
+    };
+
     //
     // loading_asset
     //
 
     namespace impl
     {
+        struct library_asset_key {
+            utils::type_family_id family{0u};
+            str_hash address;
+        };
+
+        struct library_asset_key_hash {
+            std::size_t operator()(const library_asset_key& key) const noexcept;
+        };
+
+        bool operator<(const library_asset_key& l, const library_asset_key& r) noexcept;
+        bool operator==(const library_asset_key& l, const library_asset_key& r) noexcept;
+
         class loading_asset;
         using loading_asset_iptr = intrusive_ptr<loading_asset>;
 
@@ -36,12 +73,40 @@ namespace e2d
             : private noncopyable
             , public ref_counter<loading_asset> {
         public:
-            loading_asset() = default;
+            enum class states : u8 {
+                queued,
+                loading,
+                loaded,
+                cancelled
+            };
+        public:
+            loading_asset(const library_asset_key& key) noexcept;
             virtual ~loading_asset() noexcept = default;
 
+            virtual void start(const library& library) = 0;
             virtual void cancel() noexcept = 0;
-            virtual str_hash address() const noexcept = 0;
-            virtual void wait(deferrer& deferrer) const noexcept = 0;
+
+            // finished assets don't use the library anymore
+            void finish() noexcept;
+            void wait(deferrer& deferrer) const noexcept;
+
+            const library_asset_key& key() const noexcept;
+
+            states state() const noexcept;
+            void state(states value) noexcept;
+
+            // requests without tokens and parents can't be cancelled
+            void add_requester(const loading_token_iptr& token, const loading_asset_iptr& parent);
+
+            i32 priority() const noexcept;
+            bool cancelled() const noexcept;
+        private:
+            library_asset_key key_;
+            stdex::promise<void> finished_;
+            states state_{states::queued};
+            bool pinned_{false};
+            vector<loading_token_iptr> tokens_;
+            vector<loading_asset_iptr> parents_;
         };
 
         template < typename Asset >
@@ -50,18 +115,63 @@ namespace e2d
             using ptr = intrusive_ptr<typed_loading_asset>;
             using promise_type = typename Asset::load_async_result;
         public:
-            typed_loading_asset(str_hash address, promise_type promise);
+            typed_loading_asset(const library_asset_key& key, str main_address);
             ~typed_loading_asset() noexcept override = default;
 
+            void start(const library& library) override;
             void cancel() noexcept override;
-            str_hash address() const noexcept override;
-            void wait(deferrer& deferrer) const noexcept override;
 
+            const str& main_address() const noexcept;
             const promise_type& promise() const noexcept;
         private:
-            str_hash address_;
+            str main_address_;
             promise_type promise_;
         };
+
+        class loading_context final : public deferrer::context {
+        public:
+            loading_context(loading_asset_iptr asset) noexcept;
+            const library_asset_key& key() const noexcept;
+            const loading_asset_iptr& asset() const noexcept;
+        private:
+            loading_asset_iptr asset_;
+        };
+    }
+
+    //
+    // asset_reloader
+    //
+
+    namespace impl
+    {
+        class asset_reloader;
+        using asset_reloader_iptr = intrusive_ptr<asset_reloader>;
+
+        class asset_reloader
+            : private noncopyable
+            , public ref_counter<asset_reloader> {
+        public:
+            asset_reloader() = default;
+            virtual ~asset_reloader() noexcept = default;
+
+            virtual bool is_stored(const asset_store& store) const noexcept = 0;
+            virtual asset_ptr unstore(asset_store& store) const noexcept = 0;
+            virtual void reload(const library& library) const = 0;
+        };
+
+        template < typename Asset >
+        class typed_asset_reloader : public asset_reloader {
+        public:
+            typed_asset_reloader(str main_address);
+            ~typed_asset_reloader() noexcept override = default;
+
+            bool is_stored(const asset_store& store) const noexcept override;
+            asset_ptr unstore(asset_store& store) const noexcept override;
+            void reload(const library& library) const override;
+        private:
+            str main_address_;
+            str_hash main_address_hash_;
+        };
     }
 
     //
@@ -76,40 +186,87 @@ namespace e2d
         const url& root() const noexcept;
         const asset_store& store() const noexcept;
 
+        const image_conversion_options& image_conversion() const noexcept;
+        bool expand_rgb_images() const noexcept;
+
         std::size_t unload_unused_assets() noexcept;
         std::size_t loading_asset_count() const noexcept;
 
+        // queued assets of the type wait while the limit is reached,
+        // dependencies of loading assets are never queued
+        template < typename Asset >
+        library& max_loading_assets(std::size_t value);
+
+        template < typename Asset >
+        std::size_t max_loading_assets() const noexcept;
+
+        // rejects cancelled loadings and starts queued ones
+        void frame_tick() noexcept;
+
+        // reloads stored assets with the address and assets depending on them,
+        // dependencies are tracked only with the hot reload library parameter
+        std::size_t reload_assets(str_view address) const;
+
         template < typename Asset >
         typename Asset::load_result load_main_asset(str_view address) const;
 
         template < typename Asset >
-        typename Asset::load_async_result load_main_asset_async(str_view address) const;
+        typename Asset::load_async_result load_main_asset_async(
+            str_view address,
+            const loading_token_iptr& token = nullptr) const;
 
         template < typename Asset, typename Nested = Asset >
         typename Nested::load_result load_asset(str_view address) const;
 
         template < typename Asset, typename Nested = Asset >
-        typename Nested::load_async_result load_asset_async(str_view address) const;
+        typename Nested::load_async_result load_asset_async(
+            str_view address,
+            const loading_token_iptr& token = nullptr) const;
     private:
         template < typename Asset >
-        vector<impl::loading_asset_iptr>::iterator
-        find_loading_asset_iter_(str_hash address) const noexcept;
+        friend class impl::typed_loading_asset;
 
         template < typename Asset >
-        typename impl::typed_loading_asset<Asset>::ptr
-        find_loading_asset_(str_hash address) const noexcept;
+        void start_loading_asset_(const typename impl::typed_loading_asset<Asset>::ptr& asset) const;
 
-        template < typename Asset >
-        void remove_loading_asset_(str_hash address) const noexcept;
+        void start_loading_(const impl::loading_asset_iptr& asset) const;
+        void finish_loading_(const impl::loading_asset_iptr& asset) const noexcept;
+        void start_queued_loadings_() const;
+        void cancel_loadings_(bool all) const noexcept;
+        bool can_start_loading_(utils::type_family_id family) const noexcept;
 
         void wait_all_loading_assets_() noexcept;
     private:
+        template < typename Asset >
+        typename Asset::ptr take_reloading_asset_(const impl::library_asset_key& key) const noexcept;
+
+        template < typename Asset >
+        void register_reloader_(const impl::library_asset_key& key, const str& main_address) const;
+
+        void track_dependency_(const impl::library_asset_key& key) const;
+        void watch_address_(const str& main_address) const noexcept;
+        void reload_changed_url_(const url& url) const;
+    private:
+        class file_watcher;
         starter::library_parameters params_;
         std::atomic<bool> cancelled_{false};
+        vfs::change_listener* file_watcher_{nullptr};
     private:
         mutable asset_store store_;
         mutable std::recursive_mutex mutex_;
-        mutable vector<impl::loading_asset_iptr> loading_assets_;
+        mutable vector<impl::loading_asset_iptr> loading_queue_;
+        mutable vector<impl::loading_asset_iptr> cancelled_loadings_;
+        mutable flat_map<utils::type_family_id, std::size_t> loading_counts_;
+        flat_map<utils::type_family_id, std::size_t> loading_limits_;
+        mutable hash_map<
+            impl::library_asset_key,
+            impl::loading_asset_iptr,
+            impl::library_asset_key_hash> loading_assets_;
+    private:
+        mutable hash_map<url, str> watched_urls_;
+        mutable flat_map<impl::library_asset_key, asset_ptr> reloading_;
+        mutable flat_map<impl::library_asset_key, impl::asset_reloader_iptr> reloaders_;
+        mutable flat_map<impl::library_asset_key, flat_set<impl::library_asset_key>> dependents_;
     };
 
     //
@@ -152,7 +309,9 @@ namespace e2d
             virtual ~asset_dependency() noexcept = default;
 
             virtual const str& main_address() const noexcept = 0;
-            virtual stdex::promise<asset_ptr> load_async(const library& library) = 0;
+            virtual stdex::promise<asset_ptr> load_async(
+                const library& library,
+                const loading_token_iptr& token) = 0;
         };
 
         template < typename Asset >
@@ -165,7 +324,9 @@ namespace e2d
             ~typed_asset_dependency() noexcept override;
 
             const str& main_address() const noexcept override;
-            stdex::promise<asset_ptr> load_async(const library& library) override;
+            stdex::promise<asset_ptr> load_async(
+                const library& library,
+                const loading_token_iptr& token) override;
         private:
             str main_address_;
         };
@@ -182,7 +343,11 @@ namespace e2d
 
         template < typename Asset, typename Nested = Asset >
         asset_dependencies& add_dependency(str_view address);
-        stdex::promise<asset_group> load_async(const library& library) const;
+        asset_dependencies& merge(asset_dependencies&& other);
+
+        stdex::promise<asset_group> load_async(
+            const library& library,
+            const loading_token_iptr& token = nullptr) const;
     private:
         flat_multimap<str, impl::asset_dependency_iptr> dependencies_;
     };
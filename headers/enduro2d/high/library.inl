@@ -11,15 +11,134 @@
 namespace e2d
 {
     //
-    // typed_loading_asset
+    // loading_token
+    //
+
+    inline loading_token::loading_token(i32 priority) noexcept
+    : priority_(priority) {}
+
+    inline loading_token& loading_token::priority(i32 value) noexcept {
+        priority_.store(value);
+        return *this;
+    }
+
+    inline i32 loading_token::priority() const noexcept {
+        return priority_.load();
+    }
+
+    inline void loading_token::cancel() noexcept {
+        cancelled_.store(true);
+    }
+
+    inline bool loading_token::cancelled() const noexcept {
+        return cancelled_.load();
+    }
+
+    //
+    // loading_asset
     //
 
     namespace impl
     {
+        inline std::size_t library_asset_key_hash::operator()(const library_asset_key& key) const noexcept {
+            return utils::hash_combine(
+                std::hash<utils::type_family_id>()(key.family),
+                std::hash<str_hash>()(key.address));
+        }
+
+        inline bool operator<(const library_asset_key& l, const library_asset_key& r) noexcept {
+            return l.family < r.family
+                || (l.family == r.family && l.address < r.address);
+        }
+
+        inline bool operator==(const library_asset_key& l, const library_asset_key& r) noexcept {
+            return l.family == r.family
+                && l.address == r.address;
+        }
+
+        inline loading_asset::loading_asset(const library_asset_key& key) noexcept
+        : key_(key) {}
+
+        inline void loading_asset::finish() noexcept {
+            finished_.resolve();
+        }
+
+        inline void loading_asset::wait(deferrer& deferrer) const noexcept {
+            deferrer.active_safe_wait_promise(finished_);
+        }
+
+        inline const library_asset_key& loading_asset::key() const noexcept {
+            return key_;
+        }
+
+        inline loading_asset::states loading_asset::state() const noexcept {
+            return state_;
+        }
+
+        inline void loading_asset::state(states value) noexcept {
+            state_ = value;
+        }
+
+        inline void loading_asset::add_requester(
+            const loading_token_iptr& token,
+            const loading_asset_iptr& parent)
+        {
+            if ( token ) {
+                tokens_.push_back(token);
+            }
+            if ( parent && parent.get() != this ) {
+                parents_.push_back(parent);
+            }
+            if ( !token && !parent ) {
+                pinned_ = true;
+            }
+        }
+
+        inline i32 loading_asset::priority() const noexcept {
+            i32 result = pinned_ || (tokens_.empty() && parents_.empty())
+                ? 0
+                : std::numeric_limits<i32>::min();
+            for ( const loading_token_iptr& token : tokens_ ) {
+                if ( !token->cancelled() ) {
+                    result = math::max(result, token->priority());
+                }
+            }
+            for ( const loading_asset_iptr& parent : parents_ ) {
+                if ( !parent->cancelled() ) {
+                    result = math::max(result, parent->priority());
+                }
+            }
+            return result;
+        }
+
+        inline bool loading_asset::cancelled() const noexcept {
+            switch ( state_ ) {
+                case states::loaded:
+                    return false;
+                case states::cancelled:
+                    return true;
+                default:
+                    break;
+            }
+            if ( pinned_ || (tokens_.empty() && parents_.empty()) ) {
+                return false;
+            }
+            return std::all_of(tokens_.begin(), tokens_.end(), [](const loading_token_iptr& t){
+                return t->cancelled();
+            }) && std::all_of(parents_.begin(), parents_.end(), [](const loading_asset_iptr& p){
+                return p->cancelled();
+            });
+        }
+
         template < typename Asset >
-        typed_loading_asset<Asset>::typed_loading_asset(str_hash address, promise_type promise)
-        : address_(address)
-        , promise_(std::move(promise)) {}
+        typed_loading_asset<Asset>::typed_loading_asset(const library_asset_key& key, str main_address)
+        : loading_asset(key)
+        , main_address_(std::move(main_address)) {}
+
+        template < typename Asset >
+        void typed_loading_asset<Asset>::start(const library& library) {
+            library.start_loading_asset_<Asset>(ptr(this));
+        }
 
         template < typename Asset >
         void typed_loading_asset<Asset>::cancel() noexcept {
@@ -27,8 +146,8 @@ namespace e2d
         }
 
         template < typename Asset >
-        str_hash typed_loading_asset<Asset>::address() const noexcept {
-            return address_;
+        const str& typed_loading_asset<Asset>::main_address() const noexcept {
+            return main_address_;
         }
 
         template < typename Asset >
@@ -37,21 +156,91 @@ namespace e2d
             return promise_;
         }
 
+        inline loading_context::loading_context(loading_asset_iptr asset) noexcept
+        : asset_(std::move(asset)) {}
+
+        inline const library_asset_key& loading_context::key() const noexcept {
+            return asset_->key();
+        }
+
+        inline const loading_asset_iptr& loading_context::asset() const noexcept {
+            return asset_;
+        }
+    }
+
+    //
+    // asset_reloader
+    //
+
+    namespace impl
+    {
+        template < typename Asset >
+        typed_asset_reloader<Asset>::typed_asset_reloader(str main_address)
+        : main_address_(std::move(main_address))
+        , main_address_hash_(make_hash(main_address_)) {}
+
+        template < typename Asset >
+        bool typed_asset_reloader<Asset>::is_stored(const asset_store& store) const noexcept {
+            return !!store.find<Asset>(main_address_hash_);
+        }
+
+        template < typename Asset >
+        asset_ptr typed_asset_reloader<Asset>::unstore(asset_store& store) const noexcept {
+            return store.remove<Asset>(main_address_hash_);
+        }
+
         template < typename Asset >
-        void typed_loading_asset<Asset>::wait(deferrer& deferrer) const noexcept {
-            deferrer.active_safe_wait_promise(promise_);
+        void typed_asset_reloader<Asset>::reload(const library& library) const {
+            library.load_main_asset_async<Asset>(main_address_);
         }
     }
 
+    //
+    // library::file_watcher
+    //
+
+    class library::file_watcher final : public vfs::change_listener {
+    public:
+        file_watcher(const library& library) noexcept
+        : library_(library) {}
+
+        void on_change(const url& url) noexcept final {
+            try {
+                library_.reload_changed_url_(url);
+            } catch ( const std::exception& e ) {
+                the<debug>().error("LIBRARY: Failed to reload changed assets:\n"
+                    "--> Url: %0\n"
+                    "--> Exception: %1",
+                    url.schemepath(),
+                    e.what());
+            } catch (...) {
+                the<debug>().error("LIBRARY: Failed to reload changed assets:\n"
+                    "--> Url: %0\n"
+                    "--> Exception: unexpected",
+                    url.schemepath());
+            }
+        }
+    private:
+        const library& library_;
+    };
+
     //
     // library
     //
 
     inline library::library(starter::library_parameters params)
-    : params_(std::move(params)) {}
+    : params_(std::move(params)) {
+        if ( params_.hot_reload() ) {
+            file_watcher_ = &the<vfs>().register_change_listener<file_watcher>(*this);
+        }
+    }
 
     inline library::~library() noexcept {
+        if ( file_watcher_ ) {
+            the<vfs>().unregister_change_listener(*file_watcher_);
+        }
         cancelled_.store(true);
+        cancel_loadings_(true);
         wait_all_loading_assets_();
     }
 
@@ -63,8 +252,26 @@ namespace e2d
         return store_;
     }
 
+    inline const image_conversion_options& library::image_conversion() const noexcept {
+        return params_.image_conversion();
+    }
+
+    inline bool library::expand_rgb_images() const noexcept {
+        return params_.expand_rgb_images();
+    }
+
     inline std::size_t library::unload_unused_assets() noexcept {
-        return store_.unload_unused_assets();
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        const std::size_t result = store_.unload_unused_assets();
+        for ( auto iter = reloaders_.begin(); iter != reloaders_.end(); ) {
+            if ( iter->second->is_stored(store_) || reloading_.count(iter->first) ) {
+                ++iter;
+            } else {
+                dependents_.erase(iter->first);
+                iter = reloaders_.erase(iter);
+            }
+        }
+        return result;
     }
 
     inline std::size_t library::loading_asset_count() const noexcept {
@@ -72,6 +279,85 @@ namespace e2d
         return loading_assets_.size();
     }
 
+    template < typename Asset >
+    library& library::max_loading_assets(std::size_t value) {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        loading_limits_[utils::type_family<Asset>::id()] = value;
+        start_queued_loadings_();
+        return *this;
+    }
+
+    template < typename Asset >
+    std::size_t library::max_loading_assets() const noexcept {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+        const auto iter = loading_limits_.find(utils::type_family<Asset>::id());
+        return iter != loading_limits_.end()
+            ? iter->second
+            : 0u;
+    }
+
+    inline void library::frame_tick() noexcept {
+        E2D_PROFILER_SCOPE("library.frame_tick");
+        cancel_loadings_(false);
+        try {
+            std::lock_guard<std::recursive_mutex> guard(mutex_);
+            start_queued_loadings_();
+        } catch ( const std::exception& e ) {
+            the<debug>().error("LIBRARY: Failed to start queued loadings:\n"
+                "--> Exception: %0",
+                e.what());
+        }
+    }
+
+    inline std::size_t library::reload_assets(str_view address) const {
+        const str_hash main_address_hash = make_hash(address::parent(address));
+
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+        if ( cancelled_ ) {
+            return 0u;
+        }
+
+        vector<impl::library_asset_key> keys;
+        for ( const auto& [key, reloader] : reloaders_ ) {
+            if ( key.address == main_address_hash ) {
+                keys.push_back(key);
+            }
+        }
+
+        for ( std::size_t i = 0; i < keys.size(); ++i ) {
+            const auto iter = dependents_.find(keys[i]);
+            if ( iter == dependents_.end() ) {
+                continue;
+            }
+            for ( const impl::library_asset_key& dependent : iter->second ) {
+                if ( std::find(keys.begin(), keys.end(), dependent) == keys.end() ) {
+                    keys.push_back(dependent);
+                }
+            }
+        }
+
+        // all assets leave the store before loading,
+        // so dependents can't catch old versions of dependencies
+        vector<impl::asset_reloader_iptr> reloaders;
+        for ( const impl::library_asset_key& key : keys ) {
+            const auto iter = reloaders_.find(key);
+            if ( iter == reloaders_.end() || reloading_.count(key) ) {
+                continue;
+            }
+            if ( asset_ptr asset = iter->second->unstore(store_) ) {
+                reloading_.emplace(key, std::move(asset));
+                reloaders.push_back(iter->second);
+            }
+        }
+
+        for ( const impl::asset_reloader_iptr& reloader : reloaders ) {
+            reloader->reload(*this);
+        }
+
+        return reloaders.size();
+    }
+
     template < typename Asset >
     typename Asset::load_result library::load_main_asset(str_view address) const {
         auto p = load_main_asset_async<Asset>(address);
@@ -80,9 +366,14 @@ namespace e2d
     }
 
     template < typename Asset >
-    typename Asset::load_async_result library::load_main_asset_async(str_view address) const {
+    typename Asset::load_async_result library::load_main_asset_async(
+        str_view address,
+        const loading_token_iptr& token) const
+    {
         const str main_address = address::parent(address);
-        const str_hash main_address_hash = make_hash(main_address);
+        const impl::library_asset_key key{
+            utils::type_family<Asset>::id(),
+            make_hash(main_address)};
 
         std::lock_guard<std::recursive_mutex> guard(mutex_);
 
@@ -90,59 +381,45 @@ namespace e2d
             return stdex::make_rejected_promise<typename Asset::load_result>(library_cancelled_exception());
         }
 
-        if ( auto stored_asset = store_.find<Asset>(main_address_hash) ) {
-            return stdex::make_resolved_promise(std::move(stored_asset));
+        if ( params_.hot_reload() ) {
+            track_dependency_(key);
         }
 
-        if ( auto asset = find_loading_asset_<Asset>(main_address_hash) )  {
-            return asset->promise();
+        if ( auto stored_asset = store_.find<Asset>(key.address) ) {
+            return stdex::make_resolved_promise(std::move(stored_asset));
         }
 
-        auto p = Asset::load_async(*this, main_address)
-        .then([
-            this,
-            main_address_hash
-        ](const typename Asset::load_result& new_asset){
-            std::lock_guard<std::recursive_mutex> guard(mutex_);
-            store_.store<Asset>(main_address_hash, new_asset);
-            remove_loading_asset_<Asset>(main_address_hash);
-            return new_asset;
-        }).except([
-            this,
-            main_address,
-            main_address_hash
-        ](std::exception_ptr e) -> typename Asset::load_result {
-            {
-                std::lock_guard<std::recursive_mutex> guard(mutex_);
-                remove_loading_asset_<Asset>(main_address_hash);
-            }
-            try {
-                std::rethrow_exception(e);
-            } catch ( const std::exception& ee ) {
-                the<debug>().error("LIBRARY: Failed to load asset:\n"
-                    "--> Asset: %0\n"
-                    "--> Address: %1\n"
-                    "--> Exception: %2",
-                    Asset::type_name(),
-                    main_address,
-                    ee.what());
-            } catch (...) {
-                the<debug>().error("LIBRARY: Failed to load asset:\n"
-                    "--> Asset: %0\n"
-                    "--> Address: %1\n"
-                    "--> Exception: unexpected",
-                    Asset::type_name(),
-                    main_address);
+        // dependencies inherit priority and cancellation of loading assets
+        const auto* context = dynamic_cast<const impl::loading_context*>(
+            deferrer::current_context().get());
+        const impl::loading_asset_iptr parent = context
+            && context->asset()->state() != impl::loading_asset::states::loaded
+            ? context->asset()
+            : nullptr;
+
+        const auto loading_iter = loading_assets_.find(key);
+        if ( loading_iter != loading_assets_.end() ) {
+            auto asset = static_pointer_cast<impl::typed_loading_asset<Asset>>(loading_iter->second);
+            asset->add_requester(token, parent);
+            if ( parent && asset->state() == impl::loading_asset::states::queued ) {
+                loading_queue_.erase(std::remove(
+                    loading_queue_.begin(), loading_queue_.end(), asset), loading_queue_.end());
+                start_loading_(asset);
             }
-            std::rethrow_exception(e);
-        });
+            return deferrer::bind_context(asset->promise());
+        }
+
+        auto asset = make_intrusive<impl::typed_loading_asset<Asset>>(key, main_address);
+        asset->add_requester(token, parent);
+        loading_assets_.emplace(key, asset);
 
-        const auto zero_us = time::to_chrono(make_microseconds(0));
-        if ( p.wait_for(zero_us) == stdex::promise_wait_status::timeout ) {
-            loading_assets_.push_back(new impl::typed_loading_asset<Asset>(main_address_hash, p));
+        if ( parent || can_start_loading_(key.family) ) {
+            start_loading_(asset);
+        } else {
+            loading_queue_.push_back(asset);
         }
 
-        return p;
+        return deferrer::bind_context(asset->promise());
     }
 
     template < typename Asset, typename Nested >
@@ -153,8 +430,11 @@ namespace e2d
     }
 
     template < typename Asset, typename Nested >
-    typename Nested::load_async_result library::load_asset_async(str_view address) const {
-        return load_main_asset_async<Asset>(address)
+    typename Nested::load_async_result library::load_asset_async(
+        str_view address,
+        const loading_token_iptr& token) const
+    {
+        return load_main_asset_async<Asset>(address, token)
         .then([
             address = str(address),
             nested_address = address::nested(address)
@@ -177,40 +457,258 @@ namespace e2d
     }
 
     template < typename Asset >
-    vector<impl::loading_asset_iptr>::iterator
-    library::find_loading_asset_iter_(str_hash address) const noexcept {
-        return std::find_if(
-            loading_assets_.begin(), loading_assets_.end(),
-            [address](const impl::loading_asset_iptr& asset) noexcept {
-                return asset->address() == address
-                    && dynamic_pointer_cast<impl::typed_loading_asset<Asset>>(asset);
+    void library::start_loading_asset_(const typename impl::typed_loading_asset<Asset>::ptr& asset) const {
+        typename Asset::ptr reloading_asset = take_reloading_asset_<Asset>(asset->key());
+
+        typename Asset::load_async_result p = [this, &asset](){
+            deferrer::context_scope scope(make_intrusive<impl::loading_context>(asset));
+            return Asset::load_async(*this, asset->main_address());
+        }();
+
+        if ( reloading_asset ) {
+            p = p.then([reloading_asset](const typename Asset::load_result& new_asset){
+                // live users of the asset get the new content in place
+                return the<deferrer>().do_in_main_thread([reloading_asset, new_asset](){
+                    reloading_asset->fill(std::move(*new_asset));
+                    return reloading_asset;
+                });
             });
+        }
+
+        p.then([
+            this,
+            asset
+        ](const typename Asset::load_result& new_asset){
+            {
+                std::lock_guard<std::recursive_mutex> guard(mutex_);
+                store_.store<Asset>(asset->key().address, new_asset);
+                register_reloader_<Asset>(asset->key(), asset->main_address());
+            }
+            finish_loading_(asset);
+            typename Asset::load_async_result result = asset->promise();
+            result.resolve(new_asset);
+            asset->finish();
+        }).except([
+            this,
+            asset,
+            reloading_asset
+        ](std::exception_ptr e){
+            if ( reloading_asset ) {
+                std::lock_guard<std::recursive_mutex> guard(mutex_);
+                store_.store<Asset>(asset->key().address, reloading_asset);
+            }
+            finish_loading_(asset);
+            try {
+                std::rethrow_exception(e);
+            } catch ( const library_cancelled_exception& ) {
+                // cancellation is not an error
+            } catch ( const std::exception& ee ) {
+                the<debug>().error("LIBRARY: Failed to load asset:\n"
+                    "--> Asset: %0\n"
+                    "--> Address: %1\n"
+                    "--> Exception: %2",
+                    Asset::type_name(),
+                    asset->main_address(),
+                    ee.what());
+            } catch (...) {
+                the<debug>().error("LIBRARY: Failed to load asset:\n"
+                    "--> Asset: %0\n"
+                    "--> Address: %1\n"
+                    "--> Exception: unexpected",
+                    Asset::type_name(),
+                    asset->main_address());
+            }
+            typename Asset::load_async_result result = asset->promise();
+            result.reject(e);
+            asset->finish();
+        });
+    }
+
+    inline void library::start_loading_(const impl::loading_asset_iptr& asset) const {
+        asset->state(impl::loading_asset::states::loading);
+        ++loading_counts_[asset->key().family];
+        asset->start(*this);
+    }
+
+    inline void library::finish_loading_(const impl::loading_asset_iptr& asset) const noexcept {
+        std::lock_guard<std::recursive_mutex> guard(mutex_);
+
+        if ( asset->state() == impl::loading_asset::states::loaded ) {
+            return;
+        }
+        asset->state(impl::loading_asset::states::loaded);
+
+        const auto loading_iter = loading_assets_.find(asset->key());
+        if ( loading_iter != loading_assets_.end() && loading_iter->second == asset ) {
+            loading_assets_.erase(loading_iter);
+        }
+
+        cancelled_loadings_.erase(std::remove(
+            cancelled_loadings_.begin(), cancelled_loadings_.end(), asset), cancelled_loadings_.end());
+
+        const auto count_iter = loading_counts_.find(asset->key().family);
+        if ( count_iter != loading_counts_.end() && count_iter->second > 0u ) {
+            --count_iter->second;
+        }
+
+        try {
+            start_queued_loadings_();
+        } catch ( const std::exception& e ) {
+            the<debug>().error("LIBRARY: Failed to start queued loadings:\n"
+                "--> Exception: %0",
+                e.what());
+        }
+    }
+
+    inline void library::start_queued_loadings_() const {
+        while ( !loading_queue_.empty() && !cancelled_ ) {
+            impl::loading_asset_iptr next;
+            i32 next_priority = 0;
+            for ( const impl::loading_asset_iptr& asset : loading_queue_ ) {
+                if ( asset->cancelled() ) {
+                    next = asset;
+                    break;
+                }
+                if ( !can_start_loading_(asset->key().family) ) {
+                    continue;
+                }
+                const i32 priority = asset->priority();
+                if ( !next || priority > next_priority ) {
+                    next = asset;
+                    next_priority = priority;
+                }
+            }
+
+            if ( !next ) {
+                break;
+            }
+
+            loading_queue_.erase(std::find(
+                loading_queue_.begin(), loading_queue_.end(), next));
+
+            if ( next->cancelled() ) {
+                loading_assets_.erase(next->key());
+                next->state(impl::loading_asset::states::cancelled);
+                next->cancel();
+                next->finish();
+            } else {
+                start_loading_(next);
+            }
+        }
+    }
+
+    inline void library::cancel_loadings_(bool all_queued) const noexcept {
+        vector<std::pair<impl::loading_asset_iptr, bool>> cancelled;
+        {
+            std::lock_guard<std::recursive_mutex> guard(mutex_);
+            for ( auto iter = loading_assets_.begin(); iter != loading_assets_.end(); ) {
+                const impl::loading_asset_iptr& asset = iter->second;
+                const bool queued = asset->state() == impl::loading_asset::states::queued;
+                if ( (all_queued && queued) || asset->cancelled() ) {
+                    if ( !queued ) {
+                        cancelled_loadings_.push_back(asset);
+                    }
+                    asset->state(impl::loading_asset::states::cancelled);
+                    cancelled.emplace_back(asset, queued);
+                    iter = loading_assets_.erase(iter);
+                } else {
+                    ++iter;
+                }
+            }
+            loading_queue_.erase(std::remove_if(
+                loading_queue_.begin(), loading_queue_.end(),
+                [](const impl::loading_asset_iptr& asset){
+                    return asset->state() == impl::loading_asset::states::cancelled;
+                }), loading_queue_.end());
+        }
+
+        // loading assets are rejected at once, their loadings are finished in background
+        for ( const auto& [asset, queued] : cancelled ) {
+            asset->cancel();
+            if ( queued ) {
+                asset->finish();
+            }
+        }
+    }
+
+    inline bool library::can_start_loading_(utils::type_family_id family) const noexcept {
+        const auto limit_iter = loading_limits_.find(family);
+        if ( limit_iter == loading_limits_.end() || !limit_iter->second ) {
+            return true;
+        }
+        const auto count_iter = loading_counts_.find(family);
+        return count_iter == loading_counts_.end()
+            || count_iter->second < limit_iter->second;
     }
 
     template < typename Asset >
-    typename impl::typed_loading_asset<Asset>::ptr
-    library::find_loading_asset_(str_hash address) const noexcept {
-        auto iter = find_loading_asset_iter_<Asset>(address);
-        return iter != loading_assets_.end()
-            ? static_pointer_cast<impl::typed_loading_asset<Asset>>(*iter)
-            : nullptr;
+    typename Asset::ptr library::take_reloading_asset_(const impl::library_asset_key& key) const noexcept {
+        const auto iter = reloading_.find(key);
+        if ( iter == reloading_.end() ) {
+            return nullptr;
+        }
+        typename Asset::ptr asset = static_pointer_cast<Asset>(iter->second);
+        reloading_.erase(iter);
+        return asset;
     }
 
     template < typename Asset >
-    void library::remove_loading_asset_(str_hash address) const noexcept {
-        auto iter = find_loading_asset_iter_<Asset>(address);
-        if ( iter != loading_assets_.end() ) {
-            loading_assets_.erase(iter);
+    void library::register_reloader_(const impl::library_asset_key& key, const str& main_address) const {
+        if ( !params_.hot_reload() || reloaders_.count(key) ) {
+            return;
+        }
+        reloaders_.emplace(key, make_intrusive<impl::typed_asset_reloader<Asset>>(main_address));
+        watch_address_(main_address);
+    }
+
+    inline void library::track_dependency_(const impl::library_asset_key& key) const {
+        const auto* requester = dynamic_cast<const impl::loading_context*>(
+            deferrer::current_context().get());
+        if ( requester && !(requester->key() == key) ) {
+            dependents_[key].insert(requester->key());
+        }
+    }
+
+    inline void library::watch_address_(const str& main_address) const noexcept {
+        try {
+            url asset_url = the<vfs>().resolve_scheme_aliases(root() / main_address);
+            if ( !watched_urls_.count(asset_url) && the<vfs>().watch(asset_url) ) {
+                watched_urls_.emplace(std::move(asset_url), main_address);
+            }
+        } catch (...) {
+            // assets from unwatchable sources are not reloaded
+        }
+    }
+
+    inline void library::reload_changed_url_(const url& url) const {
+        str main_address;
+        {
+            std::lock_guard<std::recursive_mutex> guard(mutex_);
+            const auto iter = watched_urls_.find(url);
+            if ( iter == watched_urls_.end() ) {
+                return;
+            }
+            main_address = iter->second;
+        }
+        const std::size_t reloaded = reload_assets(main_address);
+        if ( reloaded > 0u ) {
+            the<debug>().trace("LIBRARY: Reload changed assets:\n"
+                "--> Address: %0\n"
+                "--> Assets: %1",
+                main_address,
+                reloaded);
         }
     }
 
     inline void library::wait_all_loading_assets_() noexcept {
         while ( true ) {
             std::unique_lock<std::recursive_mutex> lock(mutex_);
-            if ( loading_assets_.empty() ) {
+            if ( loading_assets_.empty() && cancelled_loadings_.empty() ) {
                 break;
             }
-            const auto loading_asset_copy = loading_assets_.back();
+            const auto loading_asset_copy = !loading_assets_.empty()
+                ? loading_assets_.begin()->second
+                : cancelled_loadings_.back();
             lock.unlock();
             loading_asset_copy->wait(the<deferrer>());
         }
@@ -279,8 +777,11 @@ namespace e2d
         }
 
         template < typename Asset >
-        stdex::promise<asset_ptr> typed_asset_dependency<Asset>::load_async(const library& library) {
-            return library.load_main_asset_async<Asset>(main_address_)
+        stdex::promise<asset_ptr> typed_asset_dependency<Asset>::load_async(
+            const library& library,
+            const loading_token_iptr& token)
+        {
+            return library.load_main_asset_async<Asset>(main_address_, token)
             .then([](const typename Asset::load_result& main_asset){
                 return asset_ptr(main_asset);
             });
@@ -299,11 +800,22 @@ namespace e2d
         return *this;
     }
 
-    inline stdex::promise<asset_group> asset_dependencies::load_async(const library& library) const {
+    inline asset_dependencies& asset_dependencies::merge(asset_dependencies&& other) {
+        for ( auto& dp : other.dependencies_ ) {
+            dependencies_.emplace(dp.first, std::move(dp.second));
+        }
+        other.dependencies_.clear();
+        return *this;
+    }
+
+    inline stdex::promise<asset_group> asset_dependencies::load_async(
+        const library& library,
+        const loading_token_iptr& token) const
+    {
         vector<stdex::promise<std::pair<str, asset_ptr>>> promises;
         promises.reserve(dependencies_.size());
         for ( const auto& dp : dependencies_ ) {
-            promises.push_back(dp.second->load_async(library).then([
+            promises.push_back(dp.second->load_async(library, token).then([
                 dep = dp.second
             ](const asset_ptr& asset){
                 return std::make_pair(dep->main_address(), asset);
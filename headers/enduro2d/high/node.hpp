@@ -146,6 +146,10 @@ namespace e2d
 
         std::pair<std::size_t, bool> child_index(
             const const_node_iptr& child) const noexcept;
+    public:
+        // changes after any child insertion, removal, reordering
+        // or owner replacement of any node
+        static u32 hierarchy_version() noexcept;
     protected:
         node() = default;
         node(gobject owner);
@@ -158,6 +162,7 @@ namespace e2d
         void mark_dirty_world_matrix_() noexcept;
         void update_local_matrix_() const noexcept;
         void update_world_matrix_() const noexcept;
+        static void mark_hierarchy_changed_() noexcept;
     private:
         t2f transform_;
         gobject owner_;
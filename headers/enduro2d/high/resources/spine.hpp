@@ -9,6 +9,10 @@
 #include "../_high.hpp"
 
 struct spAtlas;
+struct spAtlasPage;
+struct spSkin;
+struct spEvent;
+struct spAnimation;
 struct spSkeletonData;
 struct spAnimationStateData;
 
@@ -21,11 +25,14 @@ namespace e2d
         }
     };
 
+    class spine_pose_cache;
+
     class spine final {
     public:
         using atlas_ptr = std::shared_ptr<spAtlas>;
         using skeleton_data_ptr = std::shared_ptr<spSkeletonData>;
         using animation_data_ptr = std::shared_ptr<spAnimationStateData>;
+        using pose_cache_ptr = std::shared_ptr<spine_pose_cache>;
     public:
         spine() = default;
         ~spine() noexcept = default;
@@ -54,13 +61,113 @@ namespace e2d
         const atlas_ptr& atlas() const noexcept;
         const skeleton_data_ptr& skeleton() const noexcept;
         const animation_data_ptr& animation() const noexcept;
+        const pose_cache_ptr& pose_cache() const noexcept;
     private:
         atlas_ptr atlas_;
         skeleton_data_ptr skeleton_;
         animation_data_ptr animation_;
+        pose_cache_ptr pose_cache_;
     };
 
     void swap(spine& l, spine& r) noexcept;
     bool operator==(const spine& l, const spine& r) noexcept;
     bool operator!=(const spine& l, const spine& r) noexcept;
 }
+
+namespace e2d
+{
+    //
+    // spine_pose_cache
+    //
+    // Animations baked into per-sample skeleton space vertices, shared by
+    // all players of the same skeleton that play a single unmixed track.
+    // Baked players skip applying timelines, their events are fired
+    // from the baked event list instead.
+    //
+
+    class spine_pose_cache final : private noncopyable {
+    public:
+        struct mesh {
+            const spAtlasPage* page{nullptr};
+            int blend_mode{0};
+            color tint{color::white()};
+            u32 first_vertex{0u};
+            u32 vertex_count{0u};
+            u32 first_index{0u};
+            u32 index_count{0u};
+        };
+
+        struct pose {
+            vector<mesh> meshes;
+            vector<v2f> vertices;
+            vector<v2f> uvs;
+            vector<u16> indices;
+        };
+
+        class baked_animation final : private noncopyable {
+        public:
+            baked_animation(
+                f32 duration,
+                f32 sample_rate,
+                vector<pose> poses,
+                vector<const spEvent*> events);
+
+            f32 duration() const noexcept;
+            f32 sample_rate() const noexcept;
+            std::size_t pose_count() const noexcept;
+            std::size_t memory_usage() const noexcept;
+
+            const pose& pose_at(f32 time) const noexcept;
+
+            // sorted by time, owned by the skeleton data
+            const vector<const spEvent*>& events() const noexcept;
+        private:
+            f32 duration_{0.f};
+            f32 sample_rate_{0.f};
+            vector<pose> poses_;
+            vector<const spEvent*> events_;
+            std::size_t memory_usage_{0u};
+        };
+        using baked_animation_ptr = std::shared_ptr<const baked_animation>;
+
+        struct statistics {
+            std::size_t baked_animations{0u};
+            std::size_t baked_poses{0u};
+            std::size_t memory_usage{0u};
+            std::size_t pending_animations{0u};
+            u64 baking_time_us{0u};
+            u64 cached_updates{0u};
+            u64 evaluated_updates{0u};
+        };
+    public:
+        static constexpr f32 default_sample_rate = 30.f;
+    public:
+        explicit spine_pose_cache(spine::skeleton_data_ptr skeleton);
+        ~spine_pose_cache() noexcept;
+
+        // lazily bakes on the first request, skin can be null (default skin)
+        baked_animation_ptr find_or_bake(
+            const spAnimation* animation,
+            const spSkin* skin,
+            f32 sample_rate);
+
+        // never blocks on baking, schedules it to a worker thread instead
+        // and returns nullptr until it's done, so the caller poses live
+        baked_animation_ptr find_or_bake_async(
+            const spAnimation* animation,
+            const spSkin* skin,
+            f32 sample_rate);
+
+        // for baking at load time, empty skin name means default skin
+        baked_animation_ptr find_or_bake(
+            str_view animation,
+            str_view skin,
+            f32 sample_rate);
+
+        void register_update(bool cached) noexcept;
+        statistics stats() const;
+    private:
+        class internal_state;
+        std::shared_ptr<internal_state> state_;
+    };
+}
@@ -49,9 +49,19 @@ namespace e2d
     class starter::library_parameters {
     public:
         library_parameters& root(url value) noexcept;
+        library_parameters& image_conversion(image_conversion_options value) noexcept;
+        library_parameters& expand_rgb_images(bool value) noexcept;
+        library_parameters& hot_reload(bool value) noexcept;
+
         const url& root() const noexcept;
+        const image_conversion_options& image_conversion() const noexcept;
+        bool expand_rgb_images() const noexcept;
+        bool hot_reload() const noexcept;
     private:
         url root_{"resources://bin/library"};
+        image_conversion_options image_conversion_;
+        bool expand_rgb_images_{false};
+        bool hot_reload_{false};
     };
 
     //
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_high.hpp"
+
+#include "library.hpp"
+
+namespace e2d
+{
+    //
+    // streamer
+    //
+    // Keeps named asset groups resident while the focus points (usually
+    // cameras) are near their regions or while their scenes are active.
+    // Groups are prefetched in the background inside the load radius and
+    // released outside the release radius only.
+    //
+
+    class streamer final : public module<streamer> {
+    public:
+        enum class group_states : u8 {
+            unloaded,
+            loading,
+            loaded,
+            failed
+        };
+
+        class group final {
+        public:
+            group() = default;
+
+            group& assets(asset_dependencies value) noexcept;
+
+            // region groups are resident while any focus point is in the radius
+            group& region(const v2f& center, f32 radius) noexcept;
+            group& release_radius(f32 value) noexcept;
+
+            // scene groups are resident while the scene is active
+            group& scene(str_view value);
+
+            group& priority(i32 value) noexcept;
+            group& memory_size(std::size_t value) noexcept;
+
+            [[nodiscard]] const asset_dependencies& assets() const noexcept;
+            [[nodiscard]] const v2f& center() const noexcept;
+            [[nodiscard]] f32 radius() const noexcept;
+            [[nodiscard]] f32 release_radius() const noexcept;
+            [[nodiscard]] const str& scene() const noexcept;
+            [[nodiscard]] i32 priority() const noexcept;
+            [[nodiscard]] std::size_t memory_size() const noexcept;
+        private:
+            asset_dependencies assets_;
+            v2f center_;
+            f32 radius_{0.f};
+            f32 release_radius_{0.f};
+            str scene_;
+            i32 priority_{0};
+            std::size_t memory_size_{0u};
+        };
+
+        struct statistics {
+            std::size_t groups{0u};
+            std::size_t resident_groups{0u};
+            std::size_t loading_groups{0u};
+            std::size_t resident_memory{0u};
+            std::size_t loaded_groups{0u};
+            std::size_t released_groups{0u};
+            f32 last_load_latency{0.f};
+            f32 max_load_latency{0.f};
+        };
+    public:
+        streamer(debug& d, library& l);
+        ~streamer() noexcept final;
+
+        streamer& add_group(str_view name, const group& params);
+        bool remove_group(str_view name);
+
+        [[nodiscard]] bool has_group(str_view name) const noexcept;
+        [[nodiscard]] group_states group_state(str_view name) const noexcept;
+
+        // loaded assets of the group or an empty group when it isn't resident
+        [[nodiscard]] asset_group group_assets(str_view name) const;
+
+        // zero budget means unlimited
+        streamer& memory_budget(std::size_t value) noexcept;
+        [[nodiscard]] std::size_t memory_budget() const noexcept;
+
+        streamer& focus(vector<v2f> points);
+        [[nodiscard]] const vector<v2f>& focus() const noexcept;
+
+        streamer& activate_scene(str_view name);
+        streamer& deactivate_scene(str_view name);
+        [[nodiscard]] bool is_scene_active(str_view name) const noexcept;
+
+        [[nodiscard]] const statistics& stats() const noexcept;
+
+        void frame_tick() noexcept;
+    private:
+        class internal_state;
+        std::unique_ptr<internal_state> state_;
+    };
+}
@@ -13,16 +13,22 @@ namespace e2d::systems
     struct update_event {
         f32 dt{0.f};
         f32 time{0.f};
+        u32 tick{0u};
+        f32 alpha{1.f};
     };
 
     struct pre_update_event {
         f32 dt{0.f};
         f32 time{0.f};
+        u32 tick{0u};
+        f32 alpha{1.f};
     };
 
     struct post_update_event {
         f32 dt{0.f};
         f32 time{0.f};
+        u32 tick{0u};
+        f32 alpha{1.f};
     };
 
     struct render_event {
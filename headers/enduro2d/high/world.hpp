@@ -10,6 +10,7 @@
 
 #include "node.hpp"
 #include "gobject.hpp"
+#include "event_stream.hpp"
 
 #include "resources/prefab.hpp"
 
@@ -20,6 +21,9 @@ namespace e2d
         world() = default;
         ~world() noexcept final;
 
+        // gcomponent handles cache component pointers by structure versions,
+        // so entities and components must be added and removed through
+        // gcomponent or ecsex wrappers, or marked by mark_structure_changed
         ecs::registry& registry() noexcept;
         const ecs::registry& registry() const noexcept;
 
@@ -37,8 +41,26 @@ namespace e2d
 
         void destroy_instance(gobject inst) noexcept;
         void finalize_instances() noexcept;
+
+        template < typename E >
+        event_stream<E>& stream();
     private:
         ecs::registry registry_;
         gobject::destroying_states destroying_states_;
+        flat_map<utils::type_family_id, std::unique_ptr<event_stream_base>> streams_;
     };
 }
+
+namespace e2d
+{
+    template < typename E >
+    event_stream<E>& world::stream() {
+        const utils::type_family_id family = utils::type_family<E>::id();
+        if ( auto iter = streams_.find(family); iter != streams_.end() ) {
+            return static_cast<event_stream<E>&>(*iter->second);
+        }
+        return static_cast<event_stream<E>&>(*streams_.emplace(
+            family,
+            std::make_unique<event_stream<E>>()).first->second);
+    }
+}
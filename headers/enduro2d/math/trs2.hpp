@@ -7,6 +7,7 @@
 #pragma once
 
 #include "_math.hpp"
+#include "trig.hpp"
 #include "vec2.hpp"
 
 namespace e2d
@@ -127,6 +128,24 @@ namespace e2d::math
         return { vec2<T>::zero(), T(0), s };
     }
 
+    template < typename T >
+    std::enable_if_t<std::is_floating_point_v<T>, trs2<T>>
+    lerp(const trs2<T>& l, const trs2<T>& r, T v) noexcept {
+        // rotation goes along the shortest arc, 6.2 to 0.1 passes through 2pi
+        const T pi = math::pi<T>().value;
+        const T two_pi = math::two_pi<T>().value;
+        T rotation_delta = math::mod(r.rotation - l.rotation, two_pi);
+        if ( rotation_delta > pi ) {
+            rotation_delta -= two_pi;
+        } else if ( rotation_delta < -pi ) {
+            rotation_delta += two_pi;
+        }
+        return {
+            math::lerp(l.translation, r.translation, v),
+            l.rotation + rotation_delta * v,
+            math::lerp(l.scale, r.scale, v)};
+    }
+
     template < typename T >
     bool approximately(
         const trs2<T>& l,
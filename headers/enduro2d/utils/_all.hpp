@@ -13,9 +13,11 @@
 #include "color.hpp"
 #include "color32.hpp"
 #include "defer.hpp"
+#include "digest.hpp"
 #include "filesystem.hpp"
 #include "filesystem.inl"
 #include "font.hpp"
+#include "frame_allocator.hpp"
 #include "image.hpp"
 #include "imgui_utils.hpp"
 #include "intrusive_list.hpp"
@@ -24,7 +26,9 @@
 #include "mesh.hpp"
 #include "module.hpp"
 #include "path.hpp"
+#include "rect_packer.hpp"
 #include "shape.hpp"
+#include "sound_mixer.hpp"
 #include "streams.hpp"
 #include "streams.inl"
 #include "strfmts.hpp"
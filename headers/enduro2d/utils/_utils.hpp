@@ -20,9 +20,12 @@ namespace e2d
     class read_file;
     class write_file;
     class font;
+    class frame_arena;
     class image;
     class mesh;
+    class rect_packer;
     class shape;
+    class sound_mixer;
     class input_stream;
     class output_stream;
     class input_sequence;
@@ -32,6 +35,9 @@ namespace e2d
     template < typename T >
     class module;
 
+    template < typename T >
+    class frame_allocator;
+
     template < typename T >
     class intrusive_ptr;
 
@@ -109,7 +115,7 @@ namespace e2d::utils
         // http://www.cse.yorku.ca/~oz/hash.html
 
         template < typename Char >
-        u32 sdbm_hash_impl(u32 init, const Char* str) noexcept {
+        constexpr u32 sdbm_hash_impl(u32 init, const Char* str) noexcept {
             while ( Char c = *str++ ) {
                 init = c + (init << 6u) + (init << 16u) - init;
             }
@@ -117,7 +123,7 @@ namespace e2d::utils
         }
 
         template < typename Iter >
-        u32 sdbm_hash_impl(u32 init, Iter first, Iter last) noexcept {
+        constexpr u32 sdbm_hash_impl(u32 init, Iter first, Iter last) noexcept {
             while ( first != last ) {
                 init = (*first++) + (init << 6u) + (init << 16u) - init;
             }
@@ -126,34 +132,34 @@ namespace e2d::utils
     }
 
     template < typename Char >
-    u32 sdbm_hash(const Char* str) noexcept {
+    constexpr u32 sdbm_hash(const Char* str) noexcept {
         E2D_ASSERT(str);
         return impl::sdbm_hash_impl(0u, str);
     }
 
     template < typename Char, typename Traits >
-    u32 sdbm_hash(basic_string_view<Char, Traits> str) noexcept {
+    constexpr u32 sdbm_hash(basic_string_view<Char, Traits> str) noexcept {
         return impl::sdbm_hash_impl(0u, str.cbegin(), str.cend());
     }
 
     template < typename Iter >
-    u32 sdbm_hash(Iter first, Iter last) noexcept {
+    constexpr u32 sdbm_hash(Iter first, Iter last) noexcept {
         return impl::sdbm_hash_impl(0u, first, last);
     }
 
     template < typename Char >
-    u32 sdbm_hash(u32 init, const Char* str) noexcept {
+    constexpr u32 sdbm_hash(u32 init, const Char* str) noexcept {
         E2D_ASSERT(str);
         return impl::sdbm_hash_impl(init, str);
     }
 
     template < typename Char, typename Traits >
-    u32 sdbm_hash(u32 init, basic_string_view<Char, Traits> str) noexcept {
+    constexpr u32 sdbm_hash(u32 init, basic_string_view<Char, Traits> str) noexcept {
         return impl::sdbm_hash_impl(init, str.cbegin(), str.cend());
     }
 
     template < typename Iter >
-    u32 sdbm_hash(u32 init, Iter first, Iter last) noexcept {
+    constexpr u32 sdbm_hash(u32 init, Iter first, Iter last) noexcept {
         return impl::sdbm_hash_impl(init, first, last);
     }
 
@@ -0,0 +1,21 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_utils.hpp"
+#include "buffer_view.hpp"
+
+namespace e2d
+{
+    using sha256_digest = std::array<u8, 32>;
+}
+
+namespace e2d::digests
+{
+    sha256_digest sha256(buffer_view src) noexcept;
+    sha256_digest sha256(str_view src) noexcept;
+}
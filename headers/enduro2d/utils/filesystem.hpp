@@ -45,6 +45,9 @@ namespace e2d::filesystem
     bool remove_file(str_view path);
     bool remove_directory(str_view path);
 
+    // replaces the destination file if it exists
+    bool rename_file(str_view from, str_view to);
+
     bool file_exists(str_view path);
     bool directory_exists(str_view path);
 
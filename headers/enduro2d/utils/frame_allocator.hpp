@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_utils.hpp"
+
+namespace e2d
+{
+    class bad_frame_allocation final : public exception {
+    public:
+        const char* what() const noexcept final {
+            return "bad frame allocation";
+        }
+    };
+
+    //
+    // frame_arena
+    //
+    // Linear (bump) allocator for transient per-frame data.
+    // Memory is valid until the end of the current frame. Deallocation
+    // only rewinds the arena when it releases the most recent allocation,
+    // everything else is reclaimed at once by reset() at the frame boundary.
+    //
+
+    class frame_arena final : private noncopyable {
+    public:
+        struct statistics {
+            std::size_t used_bytes{0u};
+            std::size_t live_allocations{0u};
+            std::size_t frame_peak_bytes{0u};
+            std::size_t peak_bytes{0u};
+            std::size_t capacity_bytes{0u};
+            std::size_t block_allocations{0u};
+            std::size_t outlived_allocations{0u};
+        };
+    public:
+        static constexpr std::size_t default_block_size = 64u * 1024u;
+    public:
+        frame_arena() = default;
+        explicit frame_arena(std::size_t block_size);
+        ~frame_arena() noexcept = default;
+
+        void* allocate(std::size_t size, std::size_t alignment);
+        void deallocate(void* ptr, std::size_t size) noexcept;
+
+        // coalesces the blocks, so the next frame of the same size allocates
+        // nothing, all allocations must be released before the call,
+        // the ones still alive are asserted in debug and counted as outlived
+        void reset();
+
+        const statistics& stats() const noexcept;
+    public:
+        // arena of the calling thread, lazily reset on the first use
+        // after frame_arena::next_frame(), frame allocations must not
+        // outlive the frame, e.g. in a job that crosses the frame boundary
+        static frame_arena& thread_local_arena();
+
+        // called by the engine at the end of each frame
+        static void next_frame() noexcept;
+        static u64 frame_number() noexcept;
+    private:
+        struct block {
+            std::unique_ptr<u8[]> data;
+            std::size_t size{0u};
+        };
+        bool try_allocate_from_(block& b, std::size_t size, std::size_t alignment, void*& result) noexcept;
+    private:
+        vector<block> blocks_;
+        std::size_t block_index_{0u};
+        std::size_t block_offset_{0u};
+        std::size_t block_size_{default_block_size};
+        statistics stats_;
+        u64 frame_number_{0u};
+    };
+
+    //
+    // frame_allocator
+    //
+    // STL-compatible adaptor over a frame arena (the thread local one by default).
+    //
+
+    template < typename T >
+    class frame_allocator {
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+    public:
+        frame_allocator()
+        : arena_(&frame_arena::thread_local_arena()) {}
+
+        explicit frame_allocator(frame_arena& arena) noexcept
+        : arena_(&arena) {}
+
+        template < typename U >
+        frame_allocator(const frame_allocator<U>& other) noexcept
+        : arena_(&other.arena()) {}
+
+        T* allocate(std::size_t n) {
+            if ( n > std::numeric_limits<std::size_t>::max() / sizeof(T) ) {
+                throw bad_frame_allocation();
+            }
+            return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept {
+            arena_->deallocate(p, n * sizeof(T));
+        }
+
+        frame_arena& arena() const noexcept {
+            return *arena_;
+        }
+    private:
+        frame_arena* arena_{nullptr};
+    };
+
+    template < typename T, typename U >
+    bool operator==(const frame_allocator<T>& l, const frame_allocator<U>& r) noexcept {
+        return &l.arena() == &r.arena();
+    }
+
+    template < typename T, typename U >
+    bool operator!=(const frame_allocator<T>& l, const frame_allocator<U>& r) noexcept {
+        return !(l == r);
+    }
+
+    template < typename T >
+    using frame_vector = std::vector<T, frame_allocator<T>>;
+}
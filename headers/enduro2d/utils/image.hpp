@@ -55,6 +55,12 @@ namespace e2d
         (rgba_pvrtc4_v2))
     ENUM_HPP_REGISTER_TRAITS(image_data_format)
 
+    ENUM_HPP_CLASS_DECL(image_compression_quality, u8,
+        (fast)
+        (normal)
+        (best))
+    ENUM_HPP_REGISTER_TRAITS(image_compression_quality)
+
     class bad_image_access final : public exception {
     public:
         const char* what() const noexcept final {
@@ -100,6 +106,36 @@ namespace e2d
     void swap(image& l, image& r) noexcept;
     bool operator==(const image& l, const image& r) noexcept;
     bool operator!=(const image& l, const image& r) noexcept;
+
+    //
+    // image_conversion_options
+    //
+    // Pixel operations applied in the following order:
+    // unpremultiply, srgb to linear, linear to srgb, red/blue swap, premultiply.
+    //
+
+    class image_conversion_options final {
+    public:
+        image_conversion_options& premultiply_alpha(bool value) noexcept;
+        image_conversion_options& unpremultiply_alpha(bool value) noexcept;
+        image_conversion_options& srgb_to_linear(bool value) noexcept;
+        image_conversion_options& linear_to_srgb(bool value) noexcept;
+        image_conversion_options& swap_red_blue(bool value) noexcept;
+
+        bool premultiply_alpha() const noexcept;
+        bool unpremultiply_alpha() const noexcept;
+        bool srgb_to_linear() const noexcept;
+        bool linear_to_srgb() const noexcept;
+        bool swap_red_blue() const noexcept;
+
+        bool empty() const noexcept;
+    private:
+        bool premultiply_alpha_ = false;
+        bool unpremultiply_alpha_ = false;
+        bool srgb_to_linear_ = false;
+        bool linear_to_srgb_ = false;
+        bool swap_red_blue_ = false;
+    };
 }
 
 namespace e2d::images
@@ -125,4 +161,54 @@ namespace e2d::images
     bool check_save_image_support(
         const image& src,
         image_file_format format) noexcept;
+
+    // runs job(0) ... job(count - 1) and returns when all of them are done,
+    // compression and decompression hand their rows of blocks to it
+    using block_jobs_executor = std::function<void(
+        std::size_t count,
+        const std::function<void(std::size_t)>& job)>;
+
+    // the engine installs its worker threads here,
+    // without an executor the jobs run on the calling thread
+    void set_block_jobs_executor(block_jobs_executor executor);
+
+    // encodes uncompressed images to dxt1/3/5, etc1, etc2 rgb or etc2 rgba,
+    // rows of blocks are processed by the block jobs executor
+    bool try_compress_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        image_compression_quality quality = image_compression_quality::normal) noexcept;
+
+    bool check_compress_image_support(
+        const image& src,
+        image_data_format format) noexcept;
+
+    // decodes dxt1/3/5 and etc1/etc2 images to rgb8 (opaque etc formats) or rgba8
+    bool try_decompress_image(
+        image& dst,
+        const image& src) noexcept;
+
+    bool check_decompress_image_support(
+        const image& src) noexcept;
+
+    // converts between compressed formats through decompression,
+    // the decompressed result is used as is when it matches the format
+    bool try_transcode_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        image_compression_quality quality = image_compression_quality::normal) noexcept;
+
+    // converts between a8, l8, la8, rgb8 and rgba8 formats,
+    // missing color channels are filled by white and missing alpha by opaque
+    bool try_convert_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        const image_conversion_options& options = image_conversion_options()) noexcept;
+
+    bool check_convert_image_support(
+        const image& src,
+        image_data_format format) noexcept;
 }
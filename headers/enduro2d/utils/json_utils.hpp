@@ -16,6 +16,13 @@ namespace e2d::json_utils
     void add_common_schema_definitions(rapidjson::Document& schema);
 }
 
+namespace e2d::json_utils
+{
+    // parses in-situ over the moved-in buffer with a pooled allocator,
+    // the returned document keeps both of them alive
+    std::shared_ptr<rapidjson::Document> parse_insitu(str content);
+}
+
 namespace e2d::json_utils
 {
     bool try_parse_value(const rapidjson::Value& root, v2i& v) noexcept;
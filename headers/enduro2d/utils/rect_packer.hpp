@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_utils.hpp"
+
+namespace e2d
+{
+    //
+    // rect_packer
+    //
+    // MaxRects bin packer (best short side fit). Works both for offline
+    // atlas building (pack) and for incremental runtime insertion (insert).
+    // Padding is kept between packed rects, but not at the bin borders.
+    //
+
+    class rect_packer final {
+    public:
+        rect_packer() = default;
+        ~rect_packer() noexcept = default;
+
+        rect_packer(rect_packer&& other) noexcept = default;
+        rect_packer& operator=(rect_packer&& other) noexcept = default;
+
+        rect_packer(const rect_packer& other) = default;
+        rect_packer& operator=(const rect_packer& other) = default;
+
+        explicit rect_packer(const v2u& size, u32 padding = 0u);
+
+        void clear() noexcept;
+        void reset(const v2u& size, u32 padding = 0u);
+
+        bool insert(const v2u& size, b2u& result);
+
+        // packs all sizes in one go (largest first) and writes the results
+        // in the order of the input, returns false and keeps the packer
+        // state untouched if not every rect fits
+        bool pack(const vector<v2u>& sizes, vector<b2u>& results);
+
+        const v2u& size() const noexcept;
+        u32 padding() const noexcept;
+
+        std::size_t rect_count() const noexcept;
+        u64 used_area() const noexcept;
+        f32 occupancy() const noexcept;
+    private:
+        bool find_position_(const v2u& size, b2u& result) const noexcept;
+        void split_free_rects_(const b2u& used);
+        void prune_free_rects_();
+    private:
+        v2u size_;
+        u32 padding_{0u};
+        vector<b2u> free_rects_;
+        vector<b2u> split_rects_;
+        std::size_t rect_count_{0u};
+        u64 used_area_{0u};
+    };
+}
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "_utils.hpp"
+#include "streams.hpp"
+
+namespace e2d
+{
+    class sound_decoder;
+    using sound_decoder_uptr = std::unique_ptr<sound_decoder>;
+
+    class sound_sink;
+    using sound_sink_uptr = std::unique_ptr<sound_sink>;
+
+    //
+    // sound_decoder
+    //
+    // Pulls interleaved f32 frames from an encoded sound stream.
+    //
+
+    class sound_decoder : private noncopyable {
+    public:
+        virtual ~sound_decoder() noexcept = default;
+        virtual u32 channels() const noexcept = 0;
+        virtual u32 sample_rate() const noexcept = 0;
+        virtual std::size_t frame_count() const noexcept = 0;
+        virtual std::size_t read(f32* dst, std::size_t frames) = 0;
+        virtual void seek(std::size_t frame) = 0;
+    };
+
+    //
+    // sound_sink
+    //
+    // Receives interleaved stereo f32 frames produced by a mixer.
+    //
+
+    class sound_sink : private noncopyable {
+    public:
+        virtual ~sound_sink() noexcept = default;
+        virtual void write(const f32* frames, std::size_t frame_count) = 0;
+    };
+
+    // 8/16/24/32 bit integer or 32 bit float pcm wave files, mono or stereo
+    sound_decoder_uptr make_wav_sound_decoder(input_stream_uptr stream) noexcept;
+
+    // ogg vorbis files, mono or stereo, the compressed data is kept in memory,
+    // always returns null without the E2D_BUILD_WITH_VORBIS cmake option
+    sound_decoder_uptr make_vorbis_sound_decoder(input_stream_uptr stream) noexcept;
+
+    // picks the wav or vorbis decoder by the signature of the stream
+    sound_decoder_uptr make_sound_decoder(input_stream_uptr stream) noexcept;
+
+    // discards all frames, used for headless mixing
+    sound_sink_uptr make_null_sound_sink() noexcept;
+
+    // writes a 16 bit stereo wave file, sizes are patched on destruction
+    sound_sink_uptr make_wav_sound_sink(output_stream_uptr stream, u32 sample_rate) noexcept;
+
+    //
+    // sound_mixer
+    //
+    // Software mixer of decoded voices. Each voice streams its decoder
+    // through a small window of frames, resamples it to the output rate
+    // and accumulates it into the stereo output with its gain and pan.
+    //
+
+    class sound_mixer final : private noncopyable {
+    public:
+        using voice_id = u32;
+        static constexpr voice_id invalid_voice = 0u;
+    public:
+        class parameters {
+        public:
+            parameters& sample_rate(u32 value) noexcept;
+            parameters& block_frames(u32 value) noexcept;
+            parameters& window_frames(u32 value) noexcept;
+            parameters& max_voices(u32 value) noexcept;
+
+            u32 sample_rate() const noexcept;
+            u32 block_frames() const noexcept;
+            u32 window_frames() const noexcept;
+            u32 max_voices() const noexcept;
+        private:
+            u32 sample_rate_{44100u};
+            u32 block_frames_{256u};
+            u32 window_frames_{1024u};
+            u32 max_voices_{32u};
+        };
+
+        struct statistics {
+            std::size_t voices{0u};
+            std::size_t playing_voices{0u};
+            std::size_t rejected_voices{0u};
+            std::size_t mixed_frames{0u};
+            std::size_t decoded_frames{0u};
+        };
+    public:
+        sound_mixer();
+        explicit sound_mixer(const parameters& params);
+        ~sound_mixer() noexcept;
+
+        const parameters& params() const noexcept;
+        statistics stats() const noexcept;
+
+        // returns invalid_voice when the voice limit is reached
+        voice_id create_voice(sound_decoder_uptr decoder);
+        void destroy_voice(voice_id voice) noexcept;
+        bool valid_voice(voice_id voice) const noexcept;
+
+        void play(voice_id voice) noexcept;
+        void stop(voice_id voice) noexcept;
+        void pause(voice_id voice) noexcept;
+        void resume(voice_id voice) noexcept;
+        bool playing(voice_id voice) const noexcept;
+
+        void looping(voice_id voice, bool value) noexcept;
+        bool looping(voice_id voice) const noexcept;
+
+        void volume(voice_id voice, f32 value) noexcept;
+        f32 volume(voice_id voice) const noexcept;
+
+        // -1 is full left, 1 is full right
+        void pan(voice_id voice, f32 value) noexcept;
+        f32 pan(voice_id voice) const noexcept;
+
+        void pitch(voice_id voice, f32 value) noexcept;
+        f32 pitch(voice_id voice) const noexcept;
+
+        void position(voice_id voice, f32 value) noexcept;
+        f32 position(voice_id voice) const noexcept;
+        f32 duration(voice_id voice) const noexcept;
+
+        void master_volume(f32 value) noexcept;
+        f32 master_volume() const noexcept;
+
+        // overwrites frame_count interleaved stereo frames of dst
+        void mix(f32* dst, std::size_t frame_count) noexcept;
+
+        // mixes by blocks of block_frames and passes them to the sink
+        void render(sound_sink& sink, std::size_t frame_count);
+    private:
+        class internal_state;
+        std::unique_ptr<internal_state> state_;
+    };
+}
@@ -13,13 +13,13 @@ namespace e2d
     template < typename Char >
     class basic_string_hash final {
     public:
-        basic_string_hash() noexcept = default;
+        constexpr basic_string_hash() noexcept = default;
         ~basic_string_hash() noexcept = default;
 
-        basic_string_hash(basic_string_hash&& other) noexcept;
+        constexpr basic_string_hash(basic_string_hash&& other) noexcept;
         basic_string_hash& operator=(basic_string_hash&& other) noexcept;
 
-        basic_string_hash(const basic_string_hash& other) noexcept;
+        constexpr basic_string_hash(const basic_string_hash& other) noexcept;
         basic_string_hash& operator=(const basic_string_hash& other) noexcept;
 
         basic_string_hash(const Char* str) noexcept;
@@ -34,9 +34,15 @@ namespace e2d
         void clear() noexcept;
         bool empty() const noexcept;
 
-        u32 hash() const noexcept;
+        constexpr u32 hash() const noexcept;
+
+        // hashes at compile time, bypassing the debug collision registry
+        static constexpr basic_string_hash make_constexpr(basic_string_view<Char> str) noexcept;
     private:
-        static u32 empty_hash() noexcept;
+        struct constexpr_tag {};
+        constexpr basic_string_hash(constexpr_tag, u32 hash) noexcept;
+
+        static constexpr u32 empty_hash() noexcept;
         static u32 calculate_hash(basic_string_view<Char> str) noexcept;
         static void debug_check_collisions(u32 hash, basic_string_view<Char> str) noexcept;
     private:
@@ -47,13 +53,27 @@ namespace e2d
     void swap(basic_string_hash<Char>& l, basic_string_hash<Char>& r) noexcept;
 
     template < typename Char >
-    bool operator<(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept;
+    constexpr bool operator<(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept;
 
     template < typename Char >
-    bool operator==(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept;
+    constexpr bool operator==(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept;
 
     template < typename Char >
-    bool operator!=(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept;
+    constexpr bool operator!=(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept;
+}
+
+namespace e2d
+{
+    inline namespace literals
+    {
+        inline namespace string_hash_literals
+        {
+            constexpr str_hash operator""_hash(const char* str, std::size_t len) noexcept;
+            constexpr wstr_hash operator""_hash(const wchar_t* str, std::size_t len) noexcept;
+            constexpr str16_hash operator""_hash(const char16_t* str, std::size_t len) noexcept;
+            constexpr str32_hash operator""_hash(const char32_t* str, std::size_t len) noexcept;
+        }
+    }
 }
 
 namespace e2d
@@ -8,13 +8,83 @@
 
 #include "strings.hpp"
 
+namespace e2d::impl
+{
+    // Debug registry of hashed strings. It is sharded by the hash and
+    // shards are prepended without locks, so hashing on worker threads
+    // doesn't serialize. Registered strings are never removed.
+
+    template < typename Char >
+    class string_hash_registry final : private noncopyable {
+    public:
+        static string_hash_registry& instance() {
+            static string_hash_registry registry;
+            return registry;
+        }
+
+        ~string_hash_registry() noexcept {
+            for ( std::atomic<node*>& shard : shards_ ) {
+                node* n = shard.load(std::memory_order_acquire);
+                while ( n ) {
+                    delete std::exchange(n, n->next);
+                }
+            }
+        }
+
+        // returns false if the hash is registered for another string
+        bool check(u32 hash, basic_string_view<Char> str) {
+            std::atomic<node*>& shard = shards_[hash % shard_count];
+            node* head = shard.load(std::memory_order_acquire);
+            if ( const node* n = find_(head, nullptr, hash) ) {
+                return n->str == str;
+            }
+
+            auto new_node = std::make_unique<node>(node{hash, basic_string<Char>(str), head});
+            while ( !shard.compare_exchange_weak(
+                new_node->next, new_node.get(),
+                std::memory_order_release,
+                std::memory_order_acquire) )
+            {
+                // only nodes added since the last search can have the same hash
+                if ( const node* n = find_(new_node->next, head, hash) ) {
+                    return n->str == str;
+                }
+                head = new_node->next;
+            }
+
+            new_node.release();
+            return true;
+        }
+    private:
+        struct node {
+            u32 hash{0u};
+            basic_string<Char> str;
+            node* next{nullptr};
+        };
+
+        static const node* find_(const node* first, const node* last, u32 hash) noexcept {
+            for ( ; first != last; first = first->next ) {
+                if ( first->hash == hash ) {
+                    return first;
+                }
+            }
+            return nullptr;
+        }
+    private:
+        string_hash_registry() = default;
+    private:
+        static constexpr std::size_t shard_count = 64u;
+        std::array<std::atomic<node*>, shard_count> shards_{};
+    };
+}
+
 namespace e2d
 {
     template < typename Char >
-    basic_string_hash<Char>::basic_string_hash(
+    constexpr basic_string_hash<Char>::basic_string_hash(
         basic_string_hash&& other) noexcept
-    {
-        assign(std::move(other));
+    : hash_(other.hash_) {
+        other.hash_ = empty_hash();
     }
 
     template < typename Char >
@@ -25,11 +95,9 @@ namespace e2d
     }
 
     template < typename Char >
-    basic_string_hash<Char>::basic_string_hash(
+    constexpr basic_string_hash<Char>::basic_string_hash(
         const basic_string_hash& other) noexcept
-    {
-        assign(other);
-    }
+    : hash_(other.hash_) {}
 
     template < typename Char >
     basic_string_hash<Char>& basic_string_hash<Char>::operator=(
@@ -106,14 +174,25 @@ namespace e2d
     }
 
     template < typename Char >
-    u32 basic_string_hash<Char>::hash() const noexcept {
+    constexpr u32 basic_string_hash<Char>::hash() const noexcept {
         return hash_;
     }
 
     template < typename Char >
-    u32 basic_string_hash<Char>::empty_hash() noexcept {
-        static u32 hash = calculate_hash(basic_string_view<Char>());
-        return hash;
+    constexpr basic_string_hash<Char> basic_string_hash<Char>::make_constexpr(
+        basic_string_view<Char> str) noexcept
+    {
+        return basic_string_hash(constexpr_tag(), utils::sdbm_hash(str));
+    }
+
+    template < typename Char >
+    constexpr basic_string_hash<Char>::basic_string_hash(
+        constexpr_tag, u32 hash) noexcept
+    : hash_(hash) {}
+
+    template < typename Char >
+    constexpr u32 basic_string_hash<Char>::empty_hash() noexcept {
+        return utils::sdbm_hash(basic_string_view<Char>());
     }
 
     template < typename Char >
@@ -127,17 +206,9 @@ namespace e2d
     void basic_string_hash<Char>::debug_check_collisions(u32 hash, basic_string_view<Char> str) noexcept {
     #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
         try {
-            static std::mutex mutex;
-            static hash_map<u32, basic_string<Char>> table;
-            std::lock_guard<std::mutex> guard(mutex);
-            const auto iter = table.find(hash);
-            if ( iter != table.end() ) {
-                E2D_ASSERT_MSG(
-                    iter->second == str,
-                    "basic_string_hash: hash collision detected");
-            } else {
-                table.insert(std::make_pair(hash, str));
-            }
+            E2D_ASSERT_MSG(
+                impl::string_hash_registry<Char>::instance().check(hash, str),
+                "basic_string_hash: hash collision detected");
         } catch (...) {
             E2D_ASSERT_MSG(false, "basic_string_hash: unexpected debug exception");
         }
@@ -155,21 +226,46 @@ namespace e2d
     }
 
     template < typename Char >
-    bool operator<(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept {
+    constexpr bool operator<(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept {
         return l.hash() < r.hash();
     }
 
     template < typename Char >
-    bool operator==(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept {
+    constexpr bool operator==(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept {
         return l.hash() == r.hash();
     }
 
     template < typename Char >
-    bool operator!=(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept {
+    constexpr bool operator!=(basic_string_hash<Char> l, basic_string_hash<Char> r) noexcept {
         return !(l == r);
     }
 }
 
+namespace e2d
+{
+    inline namespace literals
+    {
+        inline namespace string_hash_literals
+        {
+            constexpr str_hash operator""_hash(const char* str, std::size_t len) noexcept {
+                return str_hash::make_constexpr(str_view(str, len));
+            }
+
+            constexpr wstr_hash operator""_hash(const wchar_t* str, std::size_t len) noexcept {
+                return wstr_hash::make_constexpr(wstr_view(str, len));
+            }
+
+            constexpr str16_hash operator""_hash(const char16_t* str, std::size_t len) noexcept {
+                return str16_hash::make_constexpr(str16_view(str, len));
+            }
+
+            constexpr str32_hash operator""_hash(const char32_t* str, std::size_t len) noexcept {
+                return str32_hash::make_constexpr(str32_view(str, len));
+            }
+        }
+    }
+}
+
 namespace std
 {
     template < typename Char >
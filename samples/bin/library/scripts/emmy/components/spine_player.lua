@@ -1,7 +1,13 @@
 ---@class spine_player
 local spine_player = {
     ---@type spine_asset
-    spine = nil
+    spine = nil,
+
+    ---@type boolean
+    use_pose_cache = false,
+
+    ---@type number
+    pose_sample_rate = 30
 }
 
 ---@param self spine_player
@@ -13,7 +13,19 @@ local engine = {
     frame_count = 0,
 
     ---@type number
-    realtime_time = 0
+    realtime_time = 0,
+
+    ---@type boolean
+    fixed_update = false,
+
+    ---@type number
+    fixed_delta_time = 0,
+
+    ---@type integer
+    tick_count = 0,
+
+    ---@type number
+    tick_alpha = 1
 }
 
 ---@type engine
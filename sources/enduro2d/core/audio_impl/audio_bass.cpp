@@ -59,6 +59,12 @@ namespace e2d
         return *state_;
     }
 
+    f32 sound_stream::duration() const noexcept {
+        QWORD byte_len = BASS_ChannelGetLength(state().sound(), BASS_POS_BYTE);
+        return math::numeric_cast<f32>(
+            BASS_ChannelBytes2Seconds(state().sound(), byte_len));
+    }
+
     //
     // sound_source
     //
@@ -16,8 +16,15 @@ namespace e2d
 
     class sound_stream::internal_state final : private e2d::noncopyable {
     public:
-        internal_state() noexcept = default;
+        internal_state(f32 duration) noexcept
+        : duration_(duration) {}
         ~internal_state() noexcept = default;
+    public:
+        f32 duration() const noexcept {
+            return duration_;
+        }
+    private:
+        f32 duration_{0.f};
     };
 
     //
@@ -53,6 +60,10 @@ namespace e2d
         return *state_;
     }
 
+    f32 sound_stream::duration() const noexcept {
+        return state_->duration();
+    }
+
     //
     // sound_source
     //
@@ -122,15 +133,24 @@ namespace e2d
     sound_stream_ptr audio::create_stream(
         buffer_view sound_data)
     {
-        E2D_UNUSED(sound_data);
-        return nullptr;
+        return create_stream(make_memory_stream(
+            buffer(sound_data.data(), sound_data.size())));
     }
 
     sound_stream_ptr audio::create_stream(
         input_stream_uptr file_stream)
     {
-        E2D_UNUSED(file_stream);
-        return nullptr;
+        // nothing is played, the decoder only tells the duration of streams
+        sound_decoder_uptr decoder = make_sound_decoder(std::move(file_stream));
+        if ( !decoder ) {
+            return nullptr;
+        }
+
+        const f32 duration = static_cast<f32>(
+            static_cast<f64>(decoder->frame_count()) / decoder->sample_rate());
+
+        return std::make_shared<sound_stream>(
+            std::make_unique<sound_stream::internal_state>(duration));
     }
 
     sound_source_ptr audio::create_source(
@@ -0,0 +1,274 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "audio_soft_impl.hpp"
+
+#if defined(E2D_AUDIO_MODE) && E2D_AUDIO_MODE == E2D_AUDIO_MODE_SOFT
+
+namespace
+{
+    using namespace e2d;
+
+    // reads sound data shared by all sources of a memory stream
+    class shared_memory_stream final : public input_stream {
+    public:
+        shared_memory_stream(std::shared_ptr<buffer> data) noexcept
+        : data_(std::move(data)) {}
+
+        std::size_t read(void* dst, std::size_t size) final {
+            const std::size_t read_bytes = dst
+                ? math::min(size, data_->size() - pos_)
+                : 0;
+            if ( read_bytes > 0 ) {
+                std::memcpy(dst, data_->data() + pos_, read_bytes);
+                pos_ += read_bytes;
+            }
+            return read_bytes;
+        }
+
+        std::size_t seek(std::ptrdiff_t offset, bool relative) final {
+            const std::ptrdiff_t base = relative
+                ? math::numeric_cast<std::ptrdiff_t>(pos_)
+                : 0;
+            if ( offset < -base ) {
+                throw bad_stream_operation();
+            }
+            const std::size_t new_pos = math::numeric_cast<std::size_t>(base + offset);
+            if ( new_pos > data_->size() ) {
+                throw bad_stream_operation();
+            }
+            pos_ = new_pos;
+            return pos_;
+        }
+
+        std::size_t tell() const final {
+            return pos_;
+        }
+
+        std::size_t length() const noexcept final {
+            return data_->size();
+        }
+    private:
+        std::shared_ptr<buffer> data_;
+        std::size_t pos_{0u};
+    };
+}
+
+namespace e2d
+{
+    //
+    // sound_stream
+    //
+
+    sound_stream::sound_stream(internal_state_uptr state)
+    : state_(std::move(state)) {
+        E2D_ASSERT(state_);
+    }
+
+    const sound_stream::internal_state& sound_stream::state() const noexcept {
+        return *state_;
+    }
+
+    f32 sound_stream::duration() const noexcept {
+        return state().duration();
+    }
+
+    //
+    // sound_source
+    //
+
+    sound_source::sound_source(internal_state_uptr state)
+    : state_(std::move(state)) {
+        E2D_ASSERT(state_);
+    }
+
+    const sound_source::internal_state& sound_source::state() const noexcept {
+        return *state_;
+    }
+
+    void sound_source::play() noexcept {
+        state().mixer().play(state().voice());
+    }
+
+    void sound_source::stop() noexcept {
+        state().mixer().stop(state().voice());
+    }
+
+    void sound_source::pause() noexcept {
+        state().mixer().pause(state().voice());
+    }
+
+    void sound_source::resume() noexcept {
+        state().mixer().resume(state().voice());
+    }
+
+    bool sound_source::playing() const noexcept {
+        return state().mixer().playing(state().voice());
+    }
+
+    void sound_source::looping(bool value) noexcept {
+        state().mixer().looping(state().voice(), value);
+    }
+
+    bool sound_source::looping() noexcept {
+        return state().mixer().looping(state().voice());
+    }
+
+    void sound_source::volume(f32 value) noexcept {
+        state().mixer().volume(state().voice(), value);
+    }
+
+    f32 sound_source::volume() const noexcept {
+        return state().mixer().volume(state().voice());
+    }
+
+    void sound_source::position(f32 value) noexcept {
+        state().mixer().position(state().voice(), value);
+    }
+
+    f32 sound_source::position() const noexcept {
+        return state().mixer().position(state().voice());
+    }
+
+    f32 sound_source::duration() const noexcept {
+        return state().mixer().duration(state().voice());
+    }
+
+    //
+    // audio
+    //
+
+    audio::audio(debug& d)
+    : state_(std::make_unique<internal_state>(d)) {}
+
+    audio::~audio() noexcept {
+    }
+
+    sound_stream_ptr audio::create_stream(
+        buffer_view sound_data)
+    {
+        if ( !state_->initialized() ) {
+            state_->dbg().error("AUDIO: Not initialized");
+            return nullptr;
+        }
+
+        if ( sound_data.empty() ) {
+            state_->dbg().error("AUDIO: Sound data is empty");
+            return nullptr;
+        }
+
+        E2D_PROFILER_SCOPE("audio.create_stream");
+
+        auto data = std::make_shared<buffer>(sound_data.data(), sound_data.size());
+        sound_decoder_uptr decoder = make_sound_decoder(std::make_unique<shared_memory_stream>(data));
+        if ( !decoder ) {
+            state_->dbg().error("AUDIO: Failed to load sound sample, unsupported format");
+            return nullptr;
+        }
+
+        const f32 duration = static_cast<f32>(
+            static_cast<f64>(decoder->frame_count()) / decoder->sample_rate());
+
+        return std::make_shared<sound_stream>(
+            std::make_unique<sound_stream::internal_state>(
+                state_->dbg(), state_->mixer(), std::move(data), duration));
+    }
+
+    sound_stream_ptr audio::create_stream(
+        input_stream_uptr file_stream)
+    {
+        if ( !state_->initialized() ) {
+            state_->dbg().error("AUDIO: Not initialized");
+            return nullptr;
+        }
+
+        if ( !file_stream ) {
+            state_->dbg().error("AUDIO: file stream is null");
+            return nullptr;
+        }
+
+        E2D_PROFILER_SCOPE("audio.create_stream");
+
+        sound_decoder_uptr decoder = make_sound_decoder(std::move(file_stream));
+        if ( !decoder ) {
+            state_->dbg().error("AUDIO: Failed to create sound stream, unsupported format");
+            return nullptr;
+        }
+
+        const sound_mixer::voice_id voice = state_->mixer()->create_voice(std::move(decoder));
+        if ( voice == sound_mixer::invalid_voice ) {
+            state_->dbg().error("AUDIO: Failed to create sound stream, voice limit is reached");
+            return nullptr;
+        }
+
+        return std::make_shared<sound_stream>(
+            std::make_unique<sound_stream::internal_state>(
+                state_->dbg(), state_->mixer(), voice));
+    }
+
+    sound_source_ptr audio::create_source(
+        const sound_stream_ptr& stream)
+    {
+        if ( !state_->initialized() ) {
+            state_->dbg().error("AUDIO: Not initialized");
+            return nullptr;
+        }
+
+        if ( !stream ) {
+            state_->dbg().error("AUDIO: stream is null");
+            return nullptr;
+        }
+
+        E2D_PROFILER_SCOPE("audio.create_source");
+
+        // file streams own a single voice like a device stream,
+        // memory streams create a voice with its own decoder per source
+        const bool owns_voice = !!stream->state().sound_data();
+        const sound_mixer::voice_id voice = owns_voice
+            ? state_->mixer()->create_voice(make_sound_decoder(
+                std::make_unique<shared_memory_stream>(stream->state().sound_data())))
+            : stream->state().voice();
+
+        if ( voice == sound_mixer::invalid_voice ) {
+            state_->dbg().error("AUDIO: Failed to create sound source, voice limit is reached");
+            return nullptr;
+        }
+
+        return std::make_shared<sound_source>(
+            std::make_unique<sound_source::internal_state>(
+                state_->dbg(), stream, voice, owns_voice));
+    }
+
+    bool audio::initialized() const noexcept {
+        return state_->initialized();
+    }
+
+    void audio::volume(f32 value) noexcept {
+        state_->mixer()->master_volume(value);
+    }
+
+    f32 audio::volume() const noexcept {
+        return state_->mixer()->master_volume();
+    }
+
+    void audio::resume() noexcept {
+        if ( !state_->initialized() ) {
+            state_->dbg().error("AUDIO: Not initialized");
+            return;
+        }
+        state_->resume();
+    }
+
+    void audio::pause() noexcept {
+        if ( !state_->initialized() ) {
+            state_->dbg().error("AUDIO: Not initialized");
+            return;
+        }
+        state_->pause();
+    }
+}
+
+#endif
@@ -0,0 +1,203 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "audio_soft_impl.hpp"
+
+#if defined(E2D_AUDIO_MODE) && E2D_AUDIO_MODE == E2D_AUDIO_MODE_SOFT
+
+namespace
+{
+    using namespace e2d;
+
+    const sound_mixer::parameters mixer_parameters = sound_mixer::parameters()
+        .sample_rate(44100u)
+        .block_frames(512u)
+        .window_frames(2048u)
+        .max_voices(64u);
+}
+
+namespace e2d
+{
+    //
+    // sound_stream::internal_state
+    //
+
+    sound_stream::internal_state::internal_state(
+        debug& debug,
+        const sound_mixer_ptr& mixer,
+        std::shared_ptr<buffer> sound_data,
+        f32 duration)
+    : debug_(debug)
+    , mixer_(mixer)
+    , sound_data_(std::move(sound_data))
+    , duration_(duration) {
+        E2D_ASSERT(mixer_ && sound_data_);
+    }
+
+    sound_stream::internal_state::internal_state(
+        debug& debug,
+        const sound_mixer_ptr& mixer,
+        sound_mixer::voice_id voice)
+    : debug_(debug)
+    , mixer_(mixer)
+    , voice_(voice) {
+        E2D_ASSERT(mixer_ && voice_ != sound_mixer::invalid_voice);
+    }
+
+    sound_stream::internal_state::~internal_state() noexcept {
+        if ( voice_ != sound_mixer::invalid_voice ) {
+            mixer_->destroy_voice(voice_);
+        }
+    }
+
+    debug& sound_stream::internal_state::dbg() const noexcept {
+        return debug_;
+    }
+
+    const sound_mixer_ptr& sound_stream::internal_state::mixer() const noexcept {
+        return mixer_;
+    }
+
+    const std::shared_ptr<buffer>& sound_stream::internal_state::sound_data() const noexcept {
+        return sound_data_;
+    }
+
+    sound_mixer::voice_id sound_stream::internal_state::voice() const noexcept {
+        return voice_;
+    }
+
+    f32 sound_stream::internal_state::duration() const noexcept {
+        return sound_data_
+            ? duration_
+            : mixer_->duration(voice_);
+    }
+
+    //
+    // sound_source::internal_state
+    //
+
+    sound_source::internal_state::internal_state(
+        debug& debug,
+        const sound_stream_ptr& stream,
+        sound_mixer::voice_id voice,
+        bool owns_voice)
+    : debug_(debug)
+    , stream_(stream)
+    , voice_(voice)
+    , owns_voice_(owns_voice) {
+        E2D_ASSERT(stream_ && voice_ != sound_mixer::invalid_voice);
+    }
+
+    sound_source::internal_state::~internal_state() noexcept {
+        if ( owns_voice_ ) {
+            mixer().destroy_voice(voice_);
+        }
+    }
+
+    debug& sound_source::internal_state::dbg() const noexcept {
+        return debug_;
+    }
+
+    sound_mixer& sound_source::internal_state::mixer() const noexcept {
+        return *stream_->state().mixer();
+    }
+
+    sound_mixer::voice_id sound_source::internal_state::voice() const noexcept {
+        return voice_;
+    }
+
+    //
+    // audio::internal_state
+    //
+
+    audio::internal_state::internal_state(debug& debug)
+    : debug_(debug)
+    , mixer_(std::make_shared<sound_mixer>(mixer_parameters))
+    , sink_(make_null_sound_sink()) {
+        if ( !sink_ ) {
+            debug_.error("AUDIO: Failed to create sound sink");
+            return;
+        }
+        thread_ = std::thread([this](){
+            mixing_loop_();
+        });
+    }
+
+    audio::internal_state::~internal_state() noexcept {
+        if ( thread_.joinable() ) {
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                exit_ = true;
+            }
+            cond_var_.notify_all();
+            thread_.join();
+        }
+    }
+
+    debug& audio::internal_state::dbg() const noexcept {
+        return debug_;
+    }
+
+    bool audio::internal_state::initialized() const noexcept {
+        return thread_.joinable();
+    }
+
+    const sound_mixer_ptr& audio::internal_state::mixer() const noexcept {
+        return mixer_;
+    }
+
+    void audio::internal_state::resume() noexcept {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            paused_ = false;
+        }
+        cond_var_.notify_all();
+    }
+
+    void audio::internal_state::pause() noexcept {
+        std::lock_guard<std::mutex> guard(mutex_);
+        paused_ = true;
+    }
+
+    void audio::internal_state::mixing_loop_() noexcept {
+        using clock = std::chrono::steady_clock;
+
+        const auto block_duration = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<f64>(
+                static_cast<f64>(mixer_->params().block_frames()) /
+                static_cast<f64>(mixer_->params().sample_rate())));
+
+        auto deadline = clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while ( !exit_ ) {
+            if ( paused_ ) {
+                cond_var_.wait(lock, [this](){
+                    return exit_ || !paused_;
+                });
+                deadline = clock::now();
+                continue;
+            }
+
+            lock.unlock();
+            try {
+                E2D_PROFILER_SCOPE("audio.mix_block");
+                mixer_->render(*sink_, mixer_->params().block_frames());
+            } catch (...) {
+                debug_.error("AUDIO: Failed to render sound block");
+            }
+            lock.lock();
+
+            // the sink has no device clock, so the mixer is paced by the wall clock
+            deadline += block_duration;
+            cond_var_.wait_until(lock, deadline, [this](){
+                return exit_ || paused_;
+            });
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "audio.hpp"
+
+#if defined(E2D_AUDIO_MODE) && E2D_AUDIO_MODE == E2D_AUDIO_MODE_SOFT
+
+#include <condition_variable>
+
+namespace e2d
+{
+    using sound_mixer_ptr = std::shared_ptr<sound_mixer>;
+
+    //
+    // sound_stream::internal_state
+    //
+
+    class sound_stream::internal_state final : private e2d::noncopyable {
+    public:
+        internal_state(
+            debug& debug,
+            const sound_mixer_ptr& mixer,
+            std::shared_ptr<buffer> sound_data,
+            f32 duration);
+        internal_state(
+            debug& debug,
+            const sound_mixer_ptr& mixer,
+            sound_mixer::voice_id voice);
+        ~internal_state() noexcept;
+    public:
+        [[nodiscard]] debug& dbg() const noexcept;
+        [[nodiscard]] const sound_mixer_ptr& mixer() const noexcept;
+        [[nodiscard]] const std::shared_ptr<buffer>& sound_data() const noexcept;
+        [[nodiscard]] sound_mixer::voice_id voice() const noexcept;
+        [[nodiscard]] f32 duration() const noexcept;
+    private:
+        debug& debug_;
+        sound_mixer_ptr mixer_;
+        std::shared_ptr<buffer> sound_data_;
+        f32 duration_{0.f};
+        sound_mixer::voice_id voice_{sound_mixer::invalid_voice};
+    };
+
+    //
+    // sound_source::internal_state
+    //
+
+    class sound_source::internal_state final : private e2d::noncopyable {
+    public:
+        internal_state(
+            debug& debug,
+            const sound_stream_ptr& stream,
+            sound_mixer::voice_id voice,
+            bool owns_voice);
+        ~internal_state() noexcept;
+    public:
+        [[nodiscard]] debug& dbg() const noexcept;
+        [[nodiscard]] sound_mixer& mixer() const noexcept;
+        [[nodiscard]] sound_mixer::voice_id voice() const noexcept;
+    private:
+        debug& debug_;
+        sound_stream_ptr stream_;
+        sound_mixer::voice_id voice_;
+        bool owns_voice_;
+    };
+
+    //
+    // audio::internal_state
+    //
+
+    class audio::internal_state final : private e2d::noncopyable {
+    public:
+        internal_state(debug& debug);
+        ~internal_state() noexcept;
+    public:
+        [[nodiscard]] debug& dbg() const noexcept;
+        [[nodiscard]] bool initialized() const noexcept;
+        [[nodiscard]] const sound_mixer_ptr& mixer() const noexcept;
+
+        void resume() noexcept;
+        void pause() noexcept;
+    private:
+        void mixing_loop_() noexcept;
+    private:
+        debug& debug_;
+        sound_mixer_ptr mixer_;
+        sound_sink_uptr sink_;
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable cond_var_;
+        bool paused_{false};
+        bool exit_{false};
+    };
+}
+
+#endif
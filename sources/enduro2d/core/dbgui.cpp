@@ -6,6 +6,7 @@
 
 #include "dbgui_impl/dbgui.hpp"
 
+#include "dbgui_impl/widgets/audio_widget.hpp"
 #include "dbgui_impl/widgets/console_widget.hpp"
 #include "dbgui_impl/widgets/engine_widget.hpp"
 #include "dbgui_impl/widgets/input_widget.hpp"
@@ -173,8 +174,8 @@ namespace e2d
                             : texture_ptr();
 
                         mprops_
-                            .property("u_MVP", projection)
-                            .sampler("u_texture", render::sampler_state()
+                            .property("u_MVP"_hash, projection)
+                            .sampler("u_texture"_hash, render::sampler_state()
                                 .texture(texture)
                                 .min_filter(render::sampler_min_filter::linear)
                                 .mag_filter(render::sampler_mag_filter::linear));
@@ -463,6 +464,7 @@ namespace e2d
         register_menu_widget<dbgui_widgets::engine_widget>("Debug", ICON_FA_COGS " Engine");
         register_menu_widget<dbgui_widgets::input_widget>("Debug", ICON_FA_GAMEPAD " Input");
         register_menu_widget<dbgui_widgets::window_widget>("Debug", ICON_FA_DESKTOP " Window");
+        register_menu_widget<dbgui_widgets::audio_widget>("Debug", ICON_FA_VOLUME_UP " Audio");
     }
     dbgui::~dbgui() noexcept = default;
 
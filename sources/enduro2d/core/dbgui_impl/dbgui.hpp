@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <enduro2d/core/audio.hpp>
 #include <enduro2d/core/dbgui.hpp>
 
 #include <enduro2d/core/debug.hpp>
@@ -13,6 +14,7 @@
 #include <enduro2d/core/input.hpp>
 #include <enduro2d/core/profiler.hpp>
 #include <enduro2d/core/render.hpp>
+#include <enduro2d/core/voice_manager.hpp>
 #include <enduro2d/core/window.hpp>
 
 namespace e2d::imgui
@@ -0,0 +1,49 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "audio_widget.hpp"
+
+namespace e2d::dbgui_widgets
+{
+    bool audio_widget::show() {
+        if ( !modules::is_initialized<audio>() ) {
+            return false;
+        }
+
+        audio& a = the<audio>();
+
+        {
+            imgui_utils::with_disabled_flag([&a](){
+                bool initialized = a.initialized();
+                ImGui::Checkbox("initialized", &initialized);
+            });
+
+            if ( f32 volume = a.volume();
+                ImGui::SliderFloat("volume", &volume, 0.f, 1.f) )
+            {
+                a.volume(volume);
+            }
+        }
+
+        if ( modules::is_initialized<voice_manager>() ) {
+            ImGui::Separator();
+
+            const voice_manager::statistics& stats = the<voice_manager>().stats();
+            imgui_utils::show_formatted_text("voices: %0", stats.voices);
+            imgui_utils::show_formatted_text("audible voices: %0", stats.audible_voices);
+            imgui_utils::show_formatted_text("real voices: %0", stats.real_voices);
+            imgui_utils::show_formatted_text("virtual voices: %0", stats.virtual_voices);
+            imgui_utils::show_formatted_text("realized voices: %0", stats.realized_voices);
+            imgui_utils::show_formatted_text("virtualized voices: %0", stats.virtualized_voices);
+        }
+
+        return true;
+    }
+
+    const audio_widget::description& audio_widget::desc() const noexcept {
+        return desc_;
+    }
+}
@@ -8,10 +8,76 @@
 
 #include <enduro2d/core/profiler.hpp>
 
+namespace
+{
+    using namespace e2d;
+
+    thread_local deferrer::context_iptr thread_context;
+}
+
 namespace e2d
 {
+    //
+    // deferrer::context_scope
+    //
+
+    deferrer::context_scope::context_scope(context_iptr ctx) noexcept
+    : prev_ctx_(std::move(ctx)) {
+        thread_context.swap(prev_ctx_);
+    }
+
+    deferrer::context_scope::~context_scope() noexcept {
+        thread_context.swap(prev_ctx_);
+    }
+
+    //
+    // deferrer
+    //
+
     deferrer::deferrer()
-    : worker_(math::max(2u, std::thread::hardware_concurrency()) - 1u) {}
+    : worker_(math::max(2u, std::thread::hardware_concurrency()) - 1u) {
+        images::set_block_jobs_executor([this](
+            std::size_t count,
+            const std::function<void(std::size_t)>& job)
+        {
+            vector<stdex::promise<void>> jobs;
+            jobs.reserve(count - 1u);
+            for ( std::size_t i = 1; i < count; ++i ) {
+                jobs.push_back(do_in_worker_thread([&job, i](){
+                    job(i);
+                }));
+            }
+
+            std::exception_ptr error;
+
+            try {
+                job(0u);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            // the jobs reference the caller's job, so all of them
+            // have to finish before the first error is rethrown
+            for ( const stdex::promise<void>& p : jobs ) {
+                active_safe_wait_promise(p);
+                if ( !error ) {
+                    try {
+                        p.get();
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+
+            if ( error ) {
+                std::rethrow_exception(error);
+            }
+        });
+    }
+
+    deferrer::~deferrer() noexcept {
+        images::set_block_jobs_executor(nullptr);
+    }
 
     stdex::jobber& deferrer::worker() noexcept {
         return worker_;
@@ -33,4 +99,8 @@ namespace e2d
         E2D_PROFILER_SCOPE("deferrer.frame_tick");
         scheduler_.process_all_tasks();
     }
+
+    const deferrer::context_iptr& deferrer::current_context() noexcept {
+        return thread_context;
+    }
 }
@@ -16,6 +16,7 @@
 #include <enduro2d/core/profiler.hpp>
 #include <enduro2d/core/render.hpp>
 #include <enduro2d/core/vfs.hpp>
+#include <enduro2d/core/voice_manager.hpp>
 #include <enduro2d/core/window.hpp>
 
 namespace
@@ -109,6 +110,21 @@ namespace e2d
         return *this;
     }
 
+    engine::timer_parameters& engine::timer_parameters::deterministic(bool value) noexcept {
+        deterministic_ = value;
+        return *this;
+    }
+
+    engine::timer_parameters& engine::timer_parameters::fixed_update_rate(u32 value) noexcept {
+        fixed_update_rate_ = value;
+        return *this;
+    }
+
+    engine::timer_parameters& engine::timer_parameters::maximal_update_steps(u32 value) noexcept {
+        maximal_update_steps_ = value;
+        return *this;
+    }
+
     u32 engine::timer_parameters::minimal_framerate() const noexcept {
         return minimal_framerate_;
     }
@@ -117,6 +133,40 @@ namespace e2d
         return maximal_framerate_;
     }
 
+    bool engine::timer_parameters::deterministic() const noexcept {
+        return deterministic_;
+    }
+
+    u32 engine::timer_parameters::fixed_update_rate() const noexcept {
+        return fixed_update_rate_;
+    }
+
+    u32 engine::timer_parameters::maximal_update_steps() const noexcept {
+        return maximal_update_steps_;
+    }
+
+    //
+    // engine::render_parameters
+    //
+
+    engine::render_parameters& engine::render_parameters::render_thread(bool value) noexcept {
+        render_thread_ = value;
+        return *this;
+    }
+
+    engine::render_parameters& engine::render_parameters::max_queued_frames(u32 value) noexcept {
+        max_queued_frames_ = value;
+        return *this;
+    }
+
+    bool engine::render_parameters::render_thread() const noexcept {
+        return render_thread_;
+    }
+
+    u32 engine::render_parameters::max_queued_frames() const noexcept {
+        return max_queued_frames_;
+    }
+
     //
     // engine::window_parameters
     //
@@ -214,6 +264,11 @@ namespace e2d
         return *this;
     }
 
+    engine::parameters& engine::parameters::render_params(render_parameters value) noexcept {
+        render_params_ = std::move(value);
+        return *this;
+    }
+
     str& engine::parameters::game_name() noexcept {
         return game_name_;
     }
@@ -246,6 +301,10 @@ namespace e2d
         return timer_params_;
     }
 
+    engine::render_parameters& engine::parameters::render_params() noexcept {
+        return render_params_;
+    }
+
     const str& engine::parameters::game_name() const noexcept {
         return game_name_;
     }
@@ -278,6 +337,10 @@ namespace e2d
         return timer_params_;
     }
 
+    const engine::render_parameters& engine::parameters::render_params() const noexcept {
+        return render_params_;
+    }
+
     //
     // engine
     //
@@ -286,6 +349,7 @@ namespace e2d
     public:
         internal_state(const parameters& params)
         : timer_params_(params.timer_params())
+        , render_params_(params.render_params())
         {
             const auto first_frame_time = math::clamp(
                 math::max(timer_params_.minimal_framerate(), timer_params_.maximal_framerate()),
@@ -293,6 +357,13 @@ namespace e2d
                 1000u);
             delta_time_us_.store(
                 (time::second_us<u64>() / math::numeric_cast<u64>(first_frame_time)).value);
+
+            if ( timer_params_.fixed_update_rate() > 0u ) {
+                // the first frame simulates one tick to have a state to render
+                fixed_delta_time_us_ = time::second_us<u64>() / math::numeric_cast<u64>(
+                    math::min(timer_params_.fixed_update_rate(), 1000u));
+                frame_tick_count_.store(1u);
+            }
         }
         ~internal_state() noexcept = default;
     public:
@@ -314,10 +385,34 @@ namespace e2d
             return frame_count_.load();
         }
 
+        const render_parameters& render_params() const noexcept {
+            return render_params_;
+        }
+
         f32 realtime_time() const noexcept {
             const auto delta_us = time::now_us<u64>() - init_time_;
             return time::to_seconds(delta_us.cast_to<f32>()).value;
         }
+
+        bool fixed_update() const noexcept {
+            return fixed_delta_time_us_.value > 0u;
+        }
+
+        f32 fixed_delta_time() const noexcept {
+            return time::to_seconds(fixed_delta_time_us_.cast_to<f32>()).value;
+        }
+
+        u32 tick_count() const noexcept {
+            return tick_count_.load();
+        }
+
+        u32 frame_tick_count() const noexcept {
+            return frame_tick_count_.load();
+        }
+
+        f32 tick_alpha() const noexcept {
+            return tick_alpha_.load();
+        }
     public:
         void calculate_end_frame_timers() noexcept {
             E2D_PROFILER_SCOPE("engine.wait_for_target_fps");
@@ -333,6 +428,34 @@ namespace e2d
                     timer_params_.minimal_framerate(), 1u, 1000u));
 
             auto now_us = time::now_us<u64>();
+
+            if ( modules::is_initialized<input>() && the<input>().is_replaying() ) {
+                // replayed frames last exactly as long as the captured ones
+                // and are not throttled to run a capture as fast as possible
+                const auto delta_time_us = the<input>().frame_delta_time(
+                    minimal_delta_time_us);
+                delta_time_us_.store(delta_time_us.value);
+                time_us_.fetch_add(delta_time_us.value);
+                prev_frame_time_ = now_us;
+                update_fixed_ticks(delta_time_us);
+                update_frame_counters(now_us);
+                return;
+            }
+
+            if ( timer_params_.deterministic() ) {
+                // every frame lasts exactly 1/maximal_framerate of game time,
+                // wall clock time is used only for the frame rate counter
+                const auto delta_time_us = modules::is_initialized<input>()
+                    ? the<input>().frame_delta_time(minimal_delta_time_us)
+                    : minimal_delta_time_us;
+                delta_time_us_.store(delta_time_us.value);
+                time_us_.fetch_add(delta_time_us.value);
+                prev_frame_time_ = now_us;
+                update_fixed_ticks(delta_time_us);
+                update_frame_counters(now_us);
+                return;
+            }
+
             while ( now_us - prev_frame_time_ < minimal_delta_time_us ) {
                 const auto sleep_us = minimal_delta_time_us - (now_us - prev_frame_time_);
                 const auto microsecond = make_microseconds<u64>(1000u);
@@ -344,13 +467,54 @@ namespace e2d
                 now_us = time::now_us<u64>();
             }
 
-            delta_time_us_.store(math::minimized(
+            auto delta_time_us = math::minimized(
                 now_us - prev_frame_time_,
-                maximal_delta_time_us).value);
+                maximal_delta_time_us);
+
+            if ( modules::is_initialized<input>() ) {
+                delta_time_us = the<input>().frame_delta_time(delta_time_us);
+            }
+
+            delta_time_us_.store(delta_time_us.value);
 
             time_us_.store((now_us - init_time_).value);
             prev_frame_time_ = now_us;
 
+            update_fixed_ticks(delta_time_us);
+            update_frame_counters(now_us);
+        }
+    private:
+        void update_fixed_ticks(microseconds<u64> delta_time_us) noexcept {
+            if ( !fixed_update() ) {
+                return;
+            }
+
+            tick_count_.fetch_add(frame_tick_count_.load());
+            tick_accumulator_us_ += delta_time_us;
+
+            const u64 maximal_ticks = math::max(timer_params_.maximal_update_steps(), 1u);
+            u64 ticks = (tick_accumulator_us_ / fixed_delta_time_us_.value).value;
+
+            if ( ticks > maximal_ticks ) {
+                // the simulation can't keep up, the rest of the time is dropped
+                // to avoid the spiral of death with more and more ticks per frame
+                ticks = maximal_ticks;
+                tick_accumulator_us_ = make_microseconds(
+                    tick_accumulator_us_.value % fixed_delta_time_us_.value);
+            } else {
+                tick_accumulator_us_ -= fixed_delta_time_us_ * ticks;
+            }
+
+            frame_tick_count_.store(math::numeric_cast<u32>(ticks));
+            tick_alpha_.store(math::clamp(
+                tick_accumulator_us_.cast_to<f32>().value /
+                fixed_delta_time_us_.cast_to<f32>().value,
+                0.f, 1.f));
+        }
+
+        void update_frame_counters(microseconds<u64> now_us) noexcept {
+            const auto second_us = time::second_us<u64>();
+
             frame_count_.fetch_add(1);
             frame_rate_counter_.fetch_add(1);
             while ( now_us - prev_frame_rate_time_ >= second_us ) {
@@ -360,6 +524,7 @@ namespace e2d
         }
     private:
         timer_parameters timer_params_;
+        render_parameters render_params_;
         microseconds<u64> init_time_{time::now_us<u64>()};
         microseconds<u64> prev_frame_time_{time::now_us<u64>()};
         microseconds<u64> prev_frame_rate_time_{time::now_us<u64>()};
@@ -368,6 +533,12 @@ namespace e2d
         std::atomic<u32> frame_rate_{0};
         std::atomic<u32> frame_count_{0};
         std::atomic<u32> frame_rate_counter_{0};
+    private:
+        microseconds<u64> fixed_delta_time_us_{0};
+        microseconds<u64> tick_accumulator_us_{0};
+        std::atomic<u32> tick_count_{0};
+        std::atomic<u32> frame_tick_count_{0};
+        std::atomic<f32> tick_alpha_{1.f};
     };
 
     //
@@ -433,12 +604,26 @@ namespace e2d
         if ( !without_audio ) {
             safe_module_initialize<audio>(
                 the<debug>());
+
+            safe_module_initialize<voice_manager>(
+                the<debug>(),
+                the<audio>());
         }
 
         // setup network
 
         if ( !params.without_network() ) {
             safe_module_initialize<network>();
+
+            str http_cache;
+            if ( filesystem::extract_predef_path(http_cache, filesystem::predef_path::appdata) ) {
+                http_cache = path::combine(http_cache, params.company_name());
+                http_cache = path::combine(http_cache, params.game_name());
+                http_cache = path::combine(http_cache, "http_cache");
+            }
+
+            the<vfs>().register_scheme<http_file_source>("http", "http", http_cache);
+            the<vfs>().register_scheme<http_file_source>("https", "https", http_cache);
         }
 
         // setup graphics
@@ -482,6 +667,7 @@ namespace e2d
             render,
             window,
             network,
+            voice_manager,
             audio,
             input,
             vfs,
@@ -494,6 +680,18 @@ namespace e2d
     bool engine::start(application_uptr app) {
         E2D_ASSERT(is_in_main_thread());
 
+        // started before the application to release its resources on the render thread
+        if ( modules::is_initialized<render>() && state_->render_params().render_thread() ) {
+            the<render>().start_render_thread(
+                state_->render_params().max_queued_frames());
+        }
+
+        E2D_DEFER([](){
+            if ( modules::is_initialized<render>() ) {
+                the<render>().stop_render_thread();
+            }
+        });
+
         if ( !app || !app->initialize() ) {
             the<debug>().error("ENGINE: Failed to initialize application");
             return false;
@@ -503,18 +701,24 @@ namespace e2d
             try {
                 the<dbgui>().frame_tick();
                 the<deferrer>().frame_tick();
+                the<vfs>().frame_tick();
 
                 if ( !app->frame_tick() ) {
                     break;
                 }
 
+                if ( modules::is_initialized<voice_manager>() ) {
+                    the<voice_manager>().frame_tick(state_->delta_time());
+                }
+
                 if ( the<window>().enabled() ) {
                     app->frame_render();
                     the<dbgui>().frame_render();
-                    the<window>().swap_buffers();
+                    the<render>().submit_frame();
                 }
 
                 app->frame_finalize();
+                frame_arena::next_frame();
                 state_->calculate_end_frame_timers();
             } catch ( ... ) {
                 app->shutdown();
@@ -550,4 +754,24 @@ namespace e2d
     f32 engine::realtime_time() const noexcept {
         return state_->realtime_time();
     }
+
+    bool engine::fixed_update() const noexcept {
+        return state_->fixed_update();
+    }
+
+    f32 engine::fixed_delta_time() const noexcept {
+        return state_->fixed_delta_time();
+    }
+
+    u32 engine::tick_count() const noexcept {
+        return state_->tick_count();
+    }
+
+    u32 engine::frame_tick_count() const noexcept {
+        return state_->frame_tick_count();
+    }
+
+    f32 engine::tick_alpha() const noexcept {
+        return state_->tick_alpha();
+    }
 }
@@ -8,6 +8,200 @@
 
 #include <enduro2d/core/profiler.hpp>
 
+namespace
+{
+    using namespace e2d;
+
+    const u32 capture_file_version = 1u;
+    const str_view capture_file_signature = "e2d_input_capture";
+
+    bool is_same_events(const input_capture::event& l, const input_capture::event& r) noexcept {
+        if ( l.index() != r.index() ) {
+            return false;
+        }
+        return std::visit(utils::overloaded {
+            [&r](const input::input_char_event& e){
+                return e.uchar == std::get<input::input_char_event>(r).uchar;
+            },
+            [&r](const input::move_cursor_event& e){
+                return e.pos == std::get<input::move_cursor_event>(r).pos;
+            },
+            [&r](const input::mouse_scroll_event& e){
+                return e.delta == std::get<input::mouse_scroll_event>(r).delta;
+            },
+            [&r](const input::mouse_button_event& e){
+                const auto& o = std::get<input::mouse_button_event>(r);
+                return e.button == o.button && e.action == o.action;
+            },
+            [&r](const input::keyboard_key_event& e){
+                const auto& o = std::get<input::keyboard_key_event>(r);
+                return e.key == o.key && e.action == o.action;
+            }
+        }, l);
+    }
+
+    template < typename T >
+    void write_capture_pod(vector<u8>& dst, T v) {
+        static_assert(std::is_arithmetic_v<T>, "unsupported pod type");
+        const u8* v_data = reinterpret_cast<const u8*>(&v);
+        dst.insert(dst.end(), v_data, v_data + sizeof(v));
+    }
+
+    void write_capture_event(vector<u8>& dst, const input_capture::event& evt) {
+        write_capture_pod(dst, math::numeric_cast<u8>(evt.index()));
+        std::visit(utils::overloaded {
+            [&dst](const input::input_char_event& e){
+                write_capture_pod(dst, static_cast<u32>(e.uchar));
+            },
+            [&dst](const input::move_cursor_event& e){
+                write_capture_pod(dst, e.pos.x);
+                write_capture_pod(dst, e.pos.y);
+            },
+            [&dst](const input::mouse_scroll_event& e){
+                write_capture_pod(dst, e.delta.x);
+                write_capture_pod(dst, e.delta.y);
+            },
+            [&dst](const input::mouse_button_event& e){
+                write_capture_pod(dst, utils::enum_to_underlying(e.button));
+                write_capture_pod(dst, utils::enum_to_underlying(e.action));
+            },
+            [&dst](const input::keyboard_key_event& e){
+                write_capture_pod(dst, utils::enum_to_underlying(e.key));
+                write_capture_pod(dst, utils::enum_to_underlying(e.action));
+            }
+        }, evt);
+    }
+
+    bool read_capture_event(input_sequence& iseq, vector<input_capture::event>& dst) {
+        u8 type = 0;
+        if ( !iseq.read(type).success() ) {
+            return false;
+        }
+        switch ( type ) {
+            case 0: {
+                u32 uchar = 0;
+                iseq.read(uchar);
+                dst.emplace_back(input::input_char_event(static_cast<char32_t>(uchar)));
+                break;
+            }
+            case 1: {
+                v2f pos;
+                iseq.read(pos.x).read(pos.y);
+                dst.emplace_back(input::move_cursor_event(pos));
+                break;
+            }
+            case 2: {
+                v2f delta;
+                iseq.read(delta.x).read(delta.y);
+                dst.emplace_back(input::mouse_scroll_event(delta));
+                break;
+            }
+            case 3: {
+                std::underlying_type_t<mouse_button> button = 0;
+                std::underlying_type_t<mouse_button_action> action = 0;
+                iseq.read(button).read(action);
+                if ( button >= enum_hpp::size<mouse_button>()
+                    || action >= enum_hpp::size<mouse_button_action>() )
+                {
+                    return false;
+                }
+                dst.emplace_back(input::mouse_button_event(
+                    static_cast<mouse_button>(button),
+                    static_cast<mouse_button_action>(action)));
+                break;
+            }
+            case 4: {
+                std::underlying_type_t<keyboard_key> key = 0;
+                std::underlying_type_t<keyboard_key_action> action = 0;
+                iseq.read(key).read(action);
+                if ( key >= enum_hpp::size<keyboard_key>()
+                    || action >= enum_hpp::size<keyboard_key_action>() )
+                {
+                    return false;
+                }
+                dst.emplace_back(input::keyboard_key_event(
+                    static_cast<keyboard_key>(key),
+                    static_cast<keyboard_key_action>(action)));
+                break;
+            }
+            default:
+                return false;
+        }
+        return iseq.success();
+    }
+
+    bool check_signature(const input_stream_uptr& stream) {
+        input_sequence iseq{*stream};
+
+        u32 file_version = 0;
+        char* file_signature = static_cast<char*>(E2D_CLEAR_ALLOCA(
+            capture_file_signature.size() + 1));
+
+        iseq.read(file_signature, capture_file_signature.size())
+            .read(file_version);
+
+        return iseq.success()
+            && capture_file_signature == file_signature
+            && capture_file_version == file_version;
+    }
+
+    bool load_capture(input_capture& dst, const input_stream_uptr& stream) {
+        input_sequence iseq{*stream};
+
+        u32 frame_count = 0;
+        if ( !iseq.read(frame_count).success() ) {
+            return false;
+        }
+
+        input_capture capture;
+        for ( u32 i = 0; i < frame_count; ++i ) {
+            u64 delta_time_us = 0;
+            u32 event_count = 0;
+            if ( !iseq.read(delta_time_us).read(event_count).success() ) {
+                return false;
+            }
+
+            vector<input_capture::event> events;
+            events.reserve(math::min(event_count, 1024u));
+            for ( u32 j = 0; j < event_count; ++j ) {
+                if ( !read_capture_event(iseq, events) ) {
+                    return false;
+                }
+            }
+
+            capture.add_frame(make_microseconds(delta_time_us), std::move(events));
+        }
+
+        if ( stream->tell() != stream->length() ) {
+            return false;
+        }
+
+        dst = std::move(capture);
+        return true;
+    }
+
+    bool save_capture(const input_capture& src, buffer& dst) {
+        vector<u8> bytes;
+        bytes.insert(
+            bytes.end(),
+            capture_file_signature.begin(),
+            capture_file_signature.end());
+        write_capture_pod(bytes, capture_file_version);
+
+        write_capture_pod(bytes, math::numeric_cast<u32>(src.frame_count()));
+        for ( const input_capture::frame& f : src.frames() ) {
+            write_capture_pod(bytes, f.delta_time.value);
+            write_capture_pod(bytes, math::numeric_cast<u32>(f.events.size()));
+            for ( const input_capture::event& evt : f.events ) {
+                write_capture_event(bytes, evt);
+            }
+        }
+
+        dst.assign(bytes.data(), bytes.size());
+        return true;
+    }
+}
+
 namespace e2d
 {
     //
@@ -36,6 +230,15 @@ namespace e2d
             just_released.reset();
         }
 
+        void reset() noexcept {
+            std::lock_guard<std::mutex> guard(mutex);
+            cursor_pos = v2f::zero();
+            scroll_delta = v2f::zero();
+            pressed.reset();
+            just_pressed.reset();
+            just_released.reset();
+        }
+
         void post_event(input::move_cursor_event evt) noexcept {
             std::lock_guard<std::mutex> guard(mutex);
             cursor_pos = evt.pos;
@@ -96,6 +299,14 @@ namespace e2d
             just_released.reset();
         }
 
+        void reset() noexcept {
+            std::lock_guard<std::mutex> guard(mutex);
+            input_text.clear();
+            pressed.reset();
+            just_pressed.reset();
+            just_released.reset();
+        }
+
         void post_event(input::input_char_event evt) noexcept {
             std::lock_guard<std::mutex> guard(mutex);
             input_text += evt.uchar;
@@ -327,6 +538,158 @@ namespace e2d
     public:
         class mouse mouse;
         class keyboard keyboard;
+    public:
+        mutable std::mutex mutex;
+        bool recording{false};
+        bool recording_failed{false};
+        input_capture::frame recording_frame;
+        input_capture recorded;
+        bool replaying{false};
+        std::size_t replaying_frame{0u};
+        input_capture replayed;
+    public:
+        template < typename Event >
+        void post_event(Event evt) noexcept {
+            std::lock_guard<std::mutex> guard(mutex);
+            if ( replaying ) {
+                return;
+            }
+            if ( recording ) {
+                record_event_(evt);
+            }
+            dispatch_event_(evt);
+        }
+
+        void frame_tick() noexcept {
+            std::lock_guard<std::mutex> guard(mutex);
+
+            mouse.state_->frame_tick();
+            keyboard.state_->frame_tick();
+
+            if ( recording ) {
+                try {
+                    recorded.add_frame(std::move(recording_frame));
+                } catch (...) {
+                    recording_failed = true;
+                }
+                recording_frame = input_capture::frame();
+            }
+
+            if ( replaying ) {
+                ++replaying_frame;
+                dispatch_replaying_frame_();
+            }
+        }
+
+        void start_recording() {
+            std::lock_guard<std::mutex> guard(mutex);
+
+            recording = true;
+            recording_failed = false;
+            recording_frame = input_capture::frame();
+            recorded.clear();
+
+            record_event_(input::move_cursor_event(mouse.cursor_pos()));
+            for ( mouse_button btn : mouse.pressed_buttons() ) {
+                record_event_(input::mouse_button_event(btn, mouse_button_action::press));
+            }
+            for ( keyboard_key key : keyboard.pressed_keys() ) {
+                record_event_(input::keyboard_key_event(key, keyboard_key_action::press));
+            }
+        }
+
+        bool stop_recording(input_capture& dst) {
+            std::lock_guard<std::mutex> guard(mutex);
+
+            if ( !recording ) {
+                return false;
+            }
+
+            recording = false;
+            recording_frame = input_capture::frame();
+
+            if ( recording_failed ) {
+                recorded.clear();
+                return false;
+            }
+
+            dst = std::move(recorded);
+            recorded.clear();
+            return true;
+        }
+
+        void start_replaying(input_capture capture) {
+            std::lock_guard<std::mutex> guard(mutex);
+
+            replaying = true;
+            replaying_frame = 0u;
+            replayed = std::move(capture);
+
+            mouse.state_->reset();
+            keyboard.state_->reset();
+            dispatch_replaying_frame_();
+        }
+
+        void stop_replaying() noexcept {
+            std::lock_guard<std::mutex> guard(mutex);
+            replaying = false;
+            replaying_frame = 0u;
+            replayed.clear();
+        }
+
+        microseconds<u64> frame_delta_time(microseconds<u64> delta_time) noexcept {
+            std::lock_guard<std::mutex> guard(mutex);
+            if ( replaying ) {
+                return replayed.frame_at(replaying_frame).delta_time;
+            }
+            if ( recording ) {
+                recording_frame.delta_time = delta_time;
+            }
+            return delta_time;
+        }
+    private:
+        template < typename Event >
+        void record_event_(Event evt) noexcept {
+            try {
+                recording_frame.events.push_back(evt);
+            } catch (...) {
+                recording_failed = true;
+            }
+        }
+
+        void dispatch_event_(input::input_char_event evt) noexcept {
+            keyboard.state_->post_event(evt);
+        }
+
+        void dispatch_event_(input::move_cursor_event evt) noexcept {
+            mouse.state_->post_event(evt);
+        }
+
+        void dispatch_event_(input::mouse_scroll_event evt) noexcept {
+            mouse.state_->post_event(evt);
+        }
+
+        void dispatch_event_(input::mouse_button_event evt) noexcept {
+            mouse.state_->post_event(evt);
+        }
+
+        void dispatch_event_(input::keyboard_key_event evt) noexcept {
+            keyboard.state_->post_event(evt);
+        }
+
+        void dispatch_replaying_frame_() noexcept {
+            if ( replaying_frame >= replayed.frame_count() ) {
+                replaying = false;
+                replaying_frame = 0u;
+                replayed.clear();
+                return;
+            }
+            for ( const input_capture::event& evt : replayed.frame_at(replaying_frame).events ) {
+                std::visit([this](const auto& e){
+                    dispatch_event_(e);
+                }, evt);
+            }
+        }
     };
 
     //
@@ -346,28 +709,163 @@ namespace e2d
     }
 
     void input::post_event(input_char_event evt) noexcept {
-        state_->keyboard.state_->post_event(evt);
+        state_->post_event(evt);
     }
 
     void input::post_event(move_cursor_event evt) noexcept {
-        state_->mouse.state_->post_event(evt);
+        state_->post_event(evt);
     }
 
     void input::post_event(mouse_scroll_event evt) noexcept {
-        state_->mouse.state_->post_event(evt);
+        state_->post_event(evt);
     }
 
     void input::post_event(mouse_button_event evt) noexcept {
-        state_->mouse.state_->post_event(evt);
+        state_->post_event(evt);
     }
 
     void input::post_event(keyboard_key_event evt) noexcept {
-        state_->keyboard.state_->post_event(evt);
+        state_->post_event(evt);
     }
 
     void input::frame_tick() noexcept {
         E2D_PROFILER_SCOPE("input.frame_tick");
-        state_->mouse.state_->frame_tick();
-        state_->keyboard.state_->frame_tick();
+        state_->frame_tick();
+    }
+
+    void input::start_recording() {
+        state_->start_recording();
+    }
+
+    bool input::stop_recording(input_capture& dst) {
+        return state_->stop_recording(dst);
+    }
+
+    bool input::is_recording() const noexcept {
+        std::lock_guard<std::mutex> guard(state_->mutex);
+        return state_->recording;
+    }
+
+    void input::start_replaying(input_capture capture) {
+        state_->start_replaying(std::move(capture));
+    }
+
+    void input::stop_replaying() noexcept {
+        state_->stop_replaying();
+    }
+
+    bool input::is_replaying() const noexcept {
+        std::lock_guard<std::mutex> guard(state_->mutex);
+        return state_->replaying;
+    }
+
+    microseconds<u64> input::frame_delta_time(microseconds<u64> delta_time) noexcept {
+        return state_->frame_delta_time(delta_time);
+    }
+
+    //
+    // class input_capture
+    //
+
+    void input_capture::swap(input_capture& other) noexcept {
+        using std::swap;
+        swap(frames_, other.frames_);
+    }
+
+    void input_capture::clear() noexcept {
+        frames_.clear();
+    }
+
+    bool input_capture::empty() const noexcept {
+        return frames_.empty();
+    }
+
+    input_capture& input_capture::add_frame(frame f) {
+        frames_.push_back(std::move(f));
+        return *this;
+    }
+
+    input_capture& input_capture::add_frame(microseconds<u64> delta_time, vector<event> events) {
+        return add_frame(frame{delta_time, std::move(events)});
+    }
+
+    std::size_t input_capture::frame_count() const noexcept {
+        return frames_.size();
+    }
+
+    const input_capture::frame& input_capture::frame_at(std::size_t index) const noexcept {
+        E2D_ASSERT(index < frames_.size());
+        return frames_[index];
+    }
+
+    const vector<input_capture::frame>& input_capture::frames() const noexcept {
+        return frames_;
+    }
+
+    void swap(input_capture& l, input_capture& r) noexcept {
+        l.swap(r);
+    }
+
+    bool operator==(const input_capture& l, const input_capture& r) noexcept {
+        return std::equal(
+            l.frames().begin(), l.frames().end(),
+            r.frames().begin(), r.frames().end(),
+            [](const input_capture::frame& lf, const input_capture::frame& rf){
+                return lf.delta_time == rf.delta_time
+                    && std::equal(
+                        lf.events.begin(), lf.events.end(),
+                        rf.events.begin(), rf.events.end(),
+                        &is_same_events);
+            });
+    }
+
+    bool operator!=(const input_capture& l, const input_capture& r) noexcept {
+        return !(l == r);
+    }
+}
+
+namespace e2d::input_captures
+{
+    bool try_load_capture(
+        input_capture& dst,
+        buffer_view src) noexcept
+    {
+        try {
+            auto stream = make_memory_stream(buffer(src));
+            return stream
+                && check_signature(stream)
+                && load_capture(dst, stream);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    bool try_load_capture(
+        input_capture& dst,
+        const input_stream_uptr& src) noexcept
+    {
+        buffer file_data;
+        return streams::try_read_tail(file_data, src)
+            && try_load_capture(dst, file_data);
+    }
+
+    bool try_save_capture(
+        const input_capture& src,
+        buffer& dst) noexcept
+    {
+        try {
+            return save_capture(src, dst);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    bool try_save_capture(
+        const input_capture& src,
+        const output_stream_uptr& dst) noexcept
+    {
+        buffer file_data;
+        return try_save_capture(src, file_data)
+            && streams::try_write_tail(file_data, dst);
     }
 }
@@ -101,10 +101,10 @@ namespace
 
 namespace e2d
 {
-    profiler::auto_scope::auto_scope(profiler* profiler, str name)
-    : profiler_(profiler) {
-        if ( profiler_ ) {
-            profiler_->begin_scope(std::move(name));
+    profiler::auto_scope::auto_scope(profiler* profiler, str_view name) {
+        if ( profiler && profiler->has_sinks() ) {
+            profiler_ = profiler;
+            profiler_->begin_scope(str(name));
         }
     }
 
@@ -132,6 +132,7 @@ namespace e2d
         E2D_ASSERT(sink);
         std::lock_guard guard(rmutex_);
         sinks_.push_back(std::move(sink));
+        ++sink_count_;
         return *sinks_.back();
     }
 
@@ -140,12 +141,17 @@ namespace e2d
         for ( auto iter = sinks_.begin(); iter != sinks_.end(); ) {
             if ( iter->get() == &sink ) {
                 iter = sinks_.erase(iter);
+                --sink_count_;
             } else {
                 ++iter;
             }
         }
     }
 
+    bool profiler::has_sinks() const noexcept {
+        return sink_count_.load() > 0u;
+    }
+
     void profiler::begin_scope(str name) noexcept {
         return begin_scope(std::move(name), {});
     }
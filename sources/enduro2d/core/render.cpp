@@ -104,6 +104,10 @@ namespace
             render_.execute(command);
         }
 
+        void operator()(const render::draw_instanced_command& command) const {
+            render_.execute(command);
+        }
+
         void operator()(const render::clear_command& command) const {
             render_.execute(command);
         }
@@ -206,13 +210,15 @@ namespace e2d
         u8 nrows,
         u8 ncolumns,
         attribute_type ntype,
-        bool nnormalized) noexcept
+        bool nnormalized,
+        u32 ndivisor) noexcept
     : stride(nstride)
     , name(std::move(nname))
     , rows(nrows)
     , columns(ncolumns)
     , type(ntype)
-    , normalized(nnormalized) {}
+    , normalized(nnormalized)
+    , divisor(ndivisor) {}
 
     std::size_t vertex_declaration::attribute_info::row_size() const noexcept {
         return attribute_element_size(type) * columns;
@@ -228,6 +234,12 @@ namespace e2d
         return *this;
     }
 
+    vertex_declaration& vertex_declaration::per_instance(u32 divisor) noexcept {
+        E2D_ASSERT(attribute_count_ > 0 && divisor > 0);
+        attributes_[attribute_count_ - 1].divisor = divisor;
+        return *this;
+    }
+
     vertex_declaration& vertex_declaration::skip_bytes(std::size_t bytes) noexcept {
         bytes_per_vertex_ += bytes;
         return *this;
@@ -248,7 +260,8 @@ namespace e2d
             rows,
             columns,
             type,
-            normalized);
+            normalized,
+            0u);
         bytes_per_vertex_ += attribute_element_size(type) * rows * columns;
         ++attribute_count_;
         return *this;
@@ -267,6 +280,15 @@ namespace e2d
         return bytes_per_vertex_;
     }
 
+    bool vertex_declaration::has_per_instance_attributes() const noexcept {
+        for ( std::size_t i = 0; i < attribute_count_; ++i ) {
+            if ( attributes_[i].divisor > 0 ) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     bool operator==(const vertex_declaration& l, const vertex_declaration& r) noexcept {
         if ( l.bytes_per_vertex() != r.bytes_per_vertex() ) {
             return false;
@@ -295,7 +317,8 @@ namespace e2d
             && l.rows == r.rows
             && l.columns == r.columns
             && l.type == r.type
-            && l.normalized == r.normalized;
+            && l.normalized == r.normalized
+            && l.divisor == r.divisor;
     }
 
     bool operator!=(
@@ -998,6 +1021,104 @@ namespace e2d
         return properties_ ? *properties_ : empty_property_block;
     }
 
+    //
+    // draw_instanced_command
+    //
+
+    render::draw_instanced_command::draw_instanced_command(
+        const material& mat,
+        const geometry& geo,
+        const vertex_buffer_ptr& instances,
+        std::size_t instance_count) noexcept
+    : instance_count_(instance_count)
+    , material_(&mat)
+    , geometry_(&geo)
+    , instances_(instances) {}
+
+    render::draw_instanced_command::draw_instanced_command(
+        const material& mat,
+        const geometry& geo,
+        const property_block& props,
+        const vertex_buffer_ptr& instances,
+        std::size_t instance_count) noexcept
+    : instance_count_(instance_count)
+    , material_(&mat)
+    , geometry_(&geo)
+    , properties_(&props)
+    , instances_(instances) {}
+
+    render::draw_instanced_command& render::draw_instanced_command::index_range(std::size_t first, std::size_t count) noexcept {
+        first_index_ = first;
+        index_count_ = count;
+        return *this;
+    }
+
+    render::draw_instanced_command& render::draw_instanced_command::first_index(std::size_t value) noexcept {
+        first_index_ = value;
+        return *this;
+    }
+
+    render::draw_instanced_command& render::draw_instanced_command::index_count(std::size_t value) noexcept {
+        index_count_ = value;
+        return *this;
+    }
+
+    render::draw_instanced_command& render::draw_instanced_command::instance_count(std::size_t value) noexcept {
+        instance_count_ = value;
+        return *this;
+    }
+
+    render::draw_instanced_command& render::draw_instanced_command::material_ref(const material& value) noexcept {
+        material_ = &value;
+        return *this;
+    }
+
+    render::draw_instanced_command& render::draw_instanced_command::geometry_ref(const geometry& value) noexcept {
+        geometry_ = &value;
+        return *this;
+    }
+
+    render::draw_instanced_command& render::draw_instanced_command::properties_ref(const property_block& value) {
+        properties_ = &value;
+        return *this;
+    }
+
+    render::draw_instanced_command& render::draw_instanced_command::instances(const vertex_buffer_ptr& value) noexcept {
+        instances_ = value;
+        return *this;
+    }
+
+    std::size_t render::draw_instanced_command::first_index() const noexcept {
+        return first_index_;
+    }
+
+    std::size_t render::draw_instanced_command::index_count() const noexcept {
+        return index_count_;
+    }
+
+    std::size_t render::draw_instanced_command::instance_count() const noexcept {
+        return instance_count_;
+    }
+
+    const render::material& render::draw_instanced_command::material_ref() const noexcept {
+        E2D_ASSERT_MSG(material_, "draw instanced command with empty material");
+        return *material_;
+    }
+
+    const render::geometry& render::draw_instanced_command::geometry_ref() const noexcept {
+        E2D_ASSERT_MSG(geometry_, "draw instanced command with empty geometry");
+        return *geometry_;
+    }
+
+    const render::property_block& render::draw_instanced_command::properties_ref() const noexcept {
+        static property_block empty_property_block;
+        return properties_ ? *properties_ : empty_property_block;
+    }
+
+    const vertex_buffer_ptr& render::draw_instanced_command::instances() const noexcept {
+        return instances_;
+    }
+
     //
     // clear_command
     //
@@ -1134,6 +1255,35 @@ namespace e2d
         std::visit(command_value_visitor(*this), command);
         return *this;
     }
+
+    bool render::start_render_thread(std::size_t max_queued_frames) {
+        return pipeline_->start(*this, max_queued_frames);
+    }
+
+    void render::stop_render_thread() noexcept {
+        pipeline_->stop();
+    }
+
+    bool render::is_render_thread_active() const noexcept {
+        return pipeline_->active();
+    }
+
+    bool render::is_in_render_thread() const noexcept {
+        return pipeline_->active()
+            ? pipeline_->in_render_thread()
+            : is_in_main_thread();
+    }
+
+    render& render::submit_frame() {
+        E2D_ASSERT(is_in_main_thread());
+        pipeline_->submit_frame();
+        return *this;
+    }
+
+    render& render::wait_for_render_thread() noexcept {
+        pipeline_->wait();
+        return *this;
+    }
 }
 
 namespace e2d
@@ -10,3 +10,5 @@
 #include <enduro2d/core/profiler.hpp>
 #include <enduro2d/core/render.hpp>
 #include <enduro2d/core/window.hpp>
+
+#include "render_pipeline.hpp"
@@ -8,6 +8,108 @@
 
 #if defined(E2D_RENDER_MODE) && E2D_RENDER_MODE == E2D_RENDER_MODE_NONE
 
+namespace
+{
+    using namespace e2d;
+
+    pixel_declaration convert_image_data_format_to_pixel_declaration(image_data_format f) noexcept {
+        #define DEFINE_CASE(x) case image_data_format::x: return pixel_declaration::pixel_type::x
+        switch ( f ) {
+            DEFINE_CASE(a8);
+            DEFINE_CASE(l8);
+            DEFINE_CASE(la8);
+            DEFINE_CASE(rgb8);
+            DEFINE_CASE(rgba8);
+
+            DEFINE_CASE(rgba_dxt1);
+            DEFINE_CASE(rgba_dxt3);
+            DEFINE_CASE(rgba_dxt5);
+
+            DEFINE_CASE(rgb_etc1);
+            DEFINE_CASE(rgb_etc2);
+            DEFINE_CASE(rgba_etc2);
+            DEFINE_CASE(rgb_a1_etc2);
+
+            DEFINE_CASE(rgba_astc4x4);
+            DEFINE_CASE(rgba_astc5x5);
+            DEFINE_CASE(rgba_astc6x6);
+            DEFINE_CASE(rgba_astc8x8);
+            DEFINE_CASE(rgba_astc10x10);
+            DEFINE_CASE(rgba_astc12x12);
+
+            DEFINE_CASE(rgb_pvrtc2);
+            DEFINE_CASE(rgb_pvrtc4);
+            DEFINE_CASE(rgba_pvrtc2);
+            DEFINE_CASE(rgba_pvrtc4);
+
+            DEFINE_CASE(rgba_pvrtc2_v2);
+            DEFINE_CASE(rgba_pvrtc4_v2);
+            default:
+                E2D_ASSERT_MSG(false, "unexpected image data format");
+                return pixel_declaration::pixel_type::rgba8;
+        }
+        #undef DEFINE_CASE
+    }
+
+    // collects names of 'attribute' and 'in' declarations of a vertex source,
+    // so the null shaders answer has_attribute like the real ones
+    flat_set<str_hash> collect_vertex_attributes(str_view source) {
+        const auto is_space = [](char c) noexcept {
+            return std::isspace(static_cast<unsigned char>(c)) != 0;
+        };
+
+        flat_set<str_hash> attributes;
+        while ( !source.empty() ) {
+            const std::size_t end = std::min(source.find(';'), source.size());
+            const str_view decl = source.substr(0, end);
+            source.remove_prefix(std::min(end + 1, source.size()));
+
+            vector<str_view> words;
+            for ( std::size_t i = 0; i < decl.size(); ) {
+                while ( i < decl.size() && is_space(decl[i]) ) {
+                    ++i;
+                }
+                const std::size_t first = i;
+                while ( i < decl.size() && !is_space(decl[i]) ) {
+                    ++i;
+                }
+                if ( i > first ) {
+                    words.push_back(decl.substr(first, i - first));
+                }
+            }
+
+            if ( words.size() >= 3 && (words.front() == "attribute" || words.front() == "in") ) {
+                const str_view name = words.back().substr(0, words.back().find('['));
+                attributes.insert(make_hash(name));
+            }
+        }
+        return attributes;
+    }
+
+    render::device_caps make_null_device_caps() noexcept {
+        render::device_caps caps;
+        caps.max_texture_size = 8192u;
+        caps.max_renderbuffer_size = 8192u;
+        caps.max_cube_map_texture_size = 8192u;
+        caps.max_texture_image_units = 16u;
+        caps.max_combined_texture_image_units = 32u;
+        caps.max_vertex_attributes = 16u;
+        caps.max_vertex_texture_image_units = 16u;
+        caps.max_varying_vectors = 16u;
+        caps.max_vertex_uniform_vectors = 256u;
+        caps.max_fragment_uniform_vectors = 256u;
+        caps.npot_texture_supported = true;
+        caps.depth_texture_supported = true;
+        caps.render_target_supported = true;
+        caps.element_index_uint = true;
+        caps.instancing_supported = true;
+        caps.depth16_supported = true;
+        caps.depth24_supported = true;
+        caps.depth24_stencil8_supported = true;
+        return caps;
+    }
+}
+
 namespace e2d
 {
     //
@@ -16,7 +118,10 @@ namespace e2d
 
     class shader::internal_state final : private e2d::noncopyable {
     public:
-        internal_state() noexcept = default;
+        flat_set<str_hash> attributes;
+    public:
+        internal_state(flat_set<str_hash> attributes) noexcept
+        : attributes(std::move(attributes)) {}
         ~internal_state() noexcept = default;
     };
 
@@ -26,7 +131,12 @@ namespace e2d
 
     class texture::internal_state final : private e2d::noncopyable {
     public:
-        internal_state() noexcept = default;
+        v2u size;
+        pixel_declaration decl;
+    public:
+        internal_state(const v2u& size, const pixel_declaration& decl) noexcept
+        : size(size)
+        , decl(decl) {}
         ~internal_state() noexcept = default;
     };
 
@@ -36,7 +146,12 @@ namespace e2d
 
     class index_buffer::internal_state final : private e2d::noncopyable {
     public:
-        internal_state() noexcept = default;
+        std::size_t size;
+        index_declaration decl;
+    public:
+        internal_state(std::size_t size, const index_declaration& decl) noexcept
+        : size(size)
+        , decl(decl) {}
         ~internal_state() noexcept = default;
     };
 
@@ -46,7 +161,12 @@ namespace e2d
 
     class vertex_buffer::internal_state final : private e2d::noncopyable {
     public:
-        internal_state() noexcept = default;
+        std::size_t size;
+        vertex_declaration decl;
+    public:
+        internal_state(std::size_t size, const vertex_declaration& decl) noexcept
+        : size(size)
+        , decl(decl) {}
         ~internal_state() noexcept = default;
     };
 
@@ -56,7 +176,14 @@ namespace e2d
 
     class render_target::internal_state final : private e2d::noncopyable {
     public:
-        internal_state() noexcept = default;
+        v2u size;
+        texture_ptr color;
+        texture_ptr depth;
+    public:
+        internal_state(const v2u& size, texture_ptr color, texture_ptr depth) noexcept
+        : size(size)
+        , color(std::move(color))
+        , depth(std::move(depth)) {}
         ~internal_state() noexcept = default;
     };
 
@@ -68,10 +195,13 @@ namespace e2d
     public:
         debug& debug_;
         window& window_;
+        device_caps device_caps_;
+        statistics frame_statistics_;
     public:
         internal_state(debug& debug, window& window) noexcept
         : debug_(debug)
-        , window_(window) {}
+        , window_(window)
+        , device_caps_(make_null_device_caps()) {}
         ~internal_state() noexcept = default;
     };
 
@@ -87,6 +217,10 @@ namespace e2d
     : state_(std::move(state)) {}
     shader::~shader() noexcept = default;
 
+    bool shader::has_attribute(str_hash name) const noexcept {
+        return state_->attributes.count(name) > 0u;
+    }
+
     //
     // texture
     //
@@ -100,13 +234,11 @@ namespace e2d
     texture::~texture() noexcept = default;
 
     const v2u& texture::size() const noexcept {
-        static v2u size;
-        return size;
+        return state_->size;
     }
 
     const pixel_declaration& texture::decl() const noexcept {
-        static pixel_declaration decl;
-        return decl;
+        return state_->decl;
     }
 
     //
@@ -122,7 +254,16 @@ namespace e2d
     index_buffer::~index_buffer() noexcept = default;
 
     std::size_t index_buffer::buffer_size() const noexcept {
-        return 0u;
+        return state_->size;
+    }
+
+    std::size_t index_buffer::index_count() const noexcept {
+        E2D_ASSERT(state_->size % state_->decl.bytes_per_index() == 0);
+        return state_->size / state_->decl.bytes_per_index();
+    }
+
+    const index_declaration& index_buffer::decl() const noexcept {
+        return state_->decl;
     }
 
     //
@@ -138,30 +279,40 @@ namespace e2d
     vertex_buffer::~vertex_buffer() noexcept = default;
 
     std::size_t vertex_buffer::buffer_size() const noexcept {
-        return 0u;
+        return state_->size;
+    }
+
+    std::size_t vertex_buffer::vertex_count() const noexcept {
+        E2D_ASSERT(state_->size % state_->decl.bytes_per_vertex() == 0);
+        return state_->size / state_->decl.bytes_per_vertex();
+    }
+
+    const vertex_declaration& vertex_buffer::decl() const noexcept {
+        return state_->decl;
     }
 
     //
     // render_target
     //
 
+    const render_target::internal_state& render_target::state() const noexcept {
+        return *state_;
+    }
+
     render_target::render_target(internal_state_uptr state)
     : state_(std::move(state)) {}
     render_target::~render_target() noexcept = default;
 
     const v2u& render_target::size() const noexcept {
-        static v2u size;
-        return size;
+        return state_->size;
     }
 
     const texture_ptr& render_target::color() const noexcept {
-        static texture_ptr color;
-        return color;
+        return state_->color;
     }
 
     const texture_ptr& render_target::depth() const noexcept {
-        static texture_ptr depth;
-        return depth;
+        return state_->depth;
     }
 
     //
@@ -169,33 +320,69 @@ namespace e2d
     //
 
     render::render(debug& d, window& w)
-    : state_(new internal_state(d, w)) {}
+    : state_(new internal_state(d, w))
+    , pipeline_(new pipeline_state(d, w)) {}
     render::~render() noexcept = default;
 
     shader_ptr render::create_shader(
         str_view vertex_source,
         str_view fragment_source)
     {
-        E2D_UNUSED(vertex_source, fragment_source);
-        return nullptr;
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<shader>([&](){
+                return create_shader(vertex_source, fragment_source);
+            });
+        }
+
+        E2D_UNUSED(fragment_source);
+        return std::make_shared<shader>(
+            std::make_unique<shader::internal_state>(
+                collect_vertex_attributes(vertex_source)));
     }
 
     shader_ptr render::create_shader(
         buffer_view vertex_source,
         buffer_view fragment_source)
     {
-        E2D_UNUSED(vertex_source, fragment_source);
-        return nullptr;
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<shader>([&](){
+                return create_shader(vertex_source, fragment_source);
+            });
+        }
+
+        return create_shader(
+            str_view(reinterpret_cast<const char*>(vertex_source.data()), vertex_source.size()),
+            str_view(reinterpret_cast<const char*>(fragment_source.data()), fragment_source.size()));
     }
 
     texture_ptr render::create_texture(const image& image) {
-        E2D_UNUSED(image);
-        return nullptr;
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<texture>([&](){
+                return create_texture(image);
+            });
+        }
+
+        return create_texture(
+            image.size(),
+            convert_image_data_format_to_pixel_declaration(image.format()));
     }
 
     texture_ptr render::create_texture(const v2u& size, const pixel_declaration& decl) {
-        E2D_UNUSED(size, decl);
-        return nullptr;
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<texture>([&](){
+                return create_texture(size, decl);
+            });
+        }
+
+        if ( !is_pixel_supported(decl) ) {
+            state_->debug_.error("RENDER: Failed to create texture:\n"
+                "--> Info: unsupported pixel declaration\n"
+                "--> Pixel type: %0",
+                decl.type());
+            return nullptr;
+        }
+        return std::make_shared<texture>(
+            std::make_unique<texture::internal_state>(size, decl));
     }
 
     index_buffer_ptr render::create_index_buffer(
@@ -203,8 +390,16 @@ namespace e2d
         const index_declaration& decl,
         index_buffer::usage usage)
     {
-        E2D_UNUSED(indices, decl, usage);
-        return nullptr;
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<index_buffer>([&](){
+                return create_index_buffer(indices, decl, usage);
+            });
+        }
+
+        E2D_UNUSED(usage);
+        E2D_ASSERT(indices.size() % decl.bytes_per_index() == 0);
+        return std::make_shared<index_buffer>(
+            std::make_unique<index_buffer::internal_state>(indices.size(), decl));
     }
 
     vertex_buffer_ptr render::create_vertex_buffer(
@@ -212,8 +407,16 @@ namespace e2d
         const vertex_declaration& decl,
         vertex_buffer::usage usage)
     {
-        E2D_UNUSED(vertices, decl, usage);
-        return nullptr;
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<vertex_buffer>([&](){
+                return create_vertex_buffer(vertices, decl, usage);
+            });
+        }
+
+        E2D_UNUSED(usage);
+        E2D_ASSERT(vertices.size() % decl.bytes_per_vertex() == 0);
+        return std::make_shared<vertex_buffer>(
+            std::make_unique<vertex_buffer::internal_state>(vertices.size(), decl));
     }
 
     render_target_ptr render::create_render_target(
@@ -222,26 +425,106 @@ namespace e2d
         const pixel_declaration& depth_decl,
         render_target::external_texture external_texture)
     {
-        E2D_UNUSED(size, color_decl, depth_decl, external_texture);
-        return nullptr;
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<render_target>([&](){
+                return create_render_target(size, color_decl, depth_decl, external_texture);
+            });
+        }
+
+        const bool color_external =
+            !!(utils::enum_to_underlying(external_texture)
+            & utils::enum_to_underlying(render_target::external_texture::color));
+        const bool depth_external =
+            !!(utils::enum_to_underlying(external_texture)
+            & utils::enum_to_underlying(render_target::external_texture::depth));
+
+        texture_ptr color = color_external
+            ? create_texture(size, color_decl)
+            : nullptr;
+
+        texture_ptr depth = depth_external
+            ? create_texture(size, depth_decl)
+            : nullptr;
+
+        return std::make_shared<render_target>(
+            std::make_unique<render_target::internal_state>(
+                size, std::move(color), std::move(depth)));
     }
 
     render& render::execute(const draw_command& command) {
-        E2D_UNUSED(command);
+        if ( pipeline_->recording() ) {
+            pipeline_->record(command);
+            return *this;
+        }
+
+        const material& mat = command.material_ref();
+        const geometry& geo = command.geometry_ref();
+        for ( std::size_t i = 0, e = mat.pass_count(); i < e; ++i ) {
+            if ( !mat.pass(i).shader() || !geo.indices() ) {
+                continue;
+            }
+            statistics& stats = state_->frame_statistics_;
+            stats.draw_calls += 1u;
+            if ( command.first_index() < geo.indices()->index_count() ) {
+                stats.drawn_indices += math::min(
+                    command.index_count(),
+                    geo.indices()->index_count() - command.first_index());
+            }
+        }
+        return *this;
+    }
+
+    render& render::execute(const draw_instanced_command& command) {
+        if ( pipeline_->recording() ) {
+            pipeline_->record(command);
+            return *this;
+        }
+
+        const material& mat = command.material_ref();
+        const geometry& geo = command.geometry_ref();
+        for ( std::size_t i = 0, e = mat.pass_count(); i < e; ++i ) {
+            if ( !mat.pass(i).shader() || !geo.indices() || !command.instances() ) {
+                continue;
+            }
+            statistics& stats = state_->frame_statistics_;
+            stats.draw_calls += 1u;
+            stats.drawn_instances += command.instance_count();
+            if ( command.first_index() < geo.indices()->index_count() ) {
+                stats.drawn_indices += command.instance_count() * math::min(
+                    command.index_count(),
+                    geo.indices()->index_count() - command.first_index());
+            }
+        }
         return *this;
     }
 
     render& render::execute(const clear_command& command) {
+        if ( pipeline_->recording() ) {
+            pipeline_->record(command);
+            return *this;
+        }
+
         E2D_UNUSED(command);
+        state_->frame_statistics_.clear_calls += 1u;
         return *this;
     }
 
     render& render::execute(const target_command& command) {
+        if ( pipeline_->recording() ) {
+            pipeline_->record(command);
+            return *this;
+        }
+
         E2D_UNUSED(command);
         return *this;
     }
 
     render& render::execute(const viewport_command& command) {
+        if ( pipeline_->recording() ) {
+            pipeline_->record(command);
+            return *this;
+        }
+
         E2D_UNUSED(command);
         return *this;
     }
@@ -251,7 +534,15 @@ namespace e2d
         buffer_view indices,
         std::size_t offset)
     {
+        if ( pipeline_->recording() ) {
+            pipeline_->record(ibuffer, indices, offset);
+            return *this;
+        }
+
+        E2D_ASSERT(ibuffer);
+        E2D_ASSERT(indices.size() + offset * ibuffer->decl().bytes_per_index() <= ibuffer->buffer_size());
         E2D_UNUSED(ibuffer, indices, offset);
+        state_->frame_statistics_.buffer_updates += 1u;
         return *this;
     }
 
@@ -260,7 +551,15 @@ namespace e2d
         buffer_view vertices,
         std::size_t offset)
     {
+        if ( pipeline_->recording() ) {
+            pipeline_->record(vbuffer, vertices, offset);
+            return *this;
+        }
+
+        E2D_ASSERT(vbuffer);
+        E2D_ASSERT(vertices.size() + offset * vbuffer->decl().bytes_per_vertex() <= vbuffer->buffer_size());
         E2D_UNUSED(vbuffer, vertices, offset);
+        state_->frame_statistics_.buffer_updates += 1u;
         return *this;
     }
 
@@ -269,8 +568,12 @@ namespace e2d
         const image& img,
         v2u offset)
     {
-        E2D_UNUSED(tex, img, offset);
-        return *this;
+        if ( pipeline_->recording() ) {
+            pipeline_->record(tex, img, offset);
+            return *this;
+        }
+
+        return update_texture(tex, img.data(), b2u(offset, img.size()));
     }
 
     render& render::update_texture(
@@ -278,28 +581,59 @@ namespace e2d
         buffer_view pixels,
         const b2u& region)
     {
+        if ( pipeline_->recording() ) {
+            pipeline_->record(tex, pixels, region);
+            return *this;
+        }
+
+        E2D_ASSERT(tex);
+        E2D_ASSERT(region.position.x + region.size.x <= tex->size().x);
+        E2D_ASSERT(region.position.y + region.size.y <= tex->size().y);
         E2D_UNUSED(tex, pixels, region);
+        state_->frame_statistics_.texture_updates += 1u;
         return *this;
     }
 
     const render::device_caps& render::device_capabilities() const noexcept {
-        static device_caps caps;
-        return caps;
+        return state_->device_caps_;
     }
 
     bool render::is_pixel_supported(const pixel_declaration& decl) const noexcept {
-        E2D_UNUSED(decl);
-        return false;
+        // null device reports no support for compressed formats
+        return !decl.is_compressed();
+    }
+
+    bool render::is_image_format_supported(image_data_format format) const noexcept {
+        return is_pixel_supported(
+            convert_image_data_format_to_pixel_declaration(format));
     }
 
     bool render::is_index_supported(const index_declaration& decl) const noexcept {
         E2D_UNUSED(decl);
-        return false;
+        return true;
     }
 
     bool render::is_vertex_supported(const vertex_declaration& decl) const noexcept {
-        E2D_UNUSED(decl);
-        return false;
+        return decl.attribute_count() <= device_capabilities().max_vertex_attributes
+            && (!decl.has_per_instance_attributes() || device_capabilities().instancing_supported);
+    }
+
+    const render::statistics& render::frame_statistics() const noexcept {
+        if ( pipeline_->recording() ) {
+            return pipeline_->frame_statistics();
+        }
+
+        return state_->frame_statistics_;
+    }
+
+    render& render::reset_frame_statistics() noexcept {
+        if ( pipeline_->recording() ) {
+            pipeline_->reset_frame_statistics();
+            return *this;
+        }
+
+        state_->frame_statistics_ = statistics();
+        return *this;
     }
 }
 
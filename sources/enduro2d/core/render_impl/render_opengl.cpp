@@ -237,6 +237,21 @@ namespace
         });
     }
 
+    void set_vertex_attribute_divisor(
+        debug& debug,
+        GLuint index,
+        GLuint divisor) noexcept
+    {
+    #if E2D_RENDER_MODE == E2D_RENDER_MODE_OPENGL
+        GL_CHECK_CODE(debug, glVertexAttribDivisor(index, divisor));
+    #elif E2D_RENDER_MODE == E2D_RENDER_MODE_OPENGLES
+        E2D_UNUSED(debug, index, divisor);
+        E2D_ASSERT_MSG(false, "vertex attribute divisors are not supported");
+    #else
+    #   error unknown render mode
+    #endif
+    }
+
     void bind_vertex_declaration(
         debug& debug,
         const shader_ptr& ps,
@@ -259,6 +274,12 @@ namespace
                             vai.normalized ? GL_TRUE : GL_FALSE,
                             math::numeric_cast<GLsizei>(decl.bytes_per_vertex()),
                             reinterpret_cast<const GLvoid*>(vai.stride + row * vai.row_size())));
+                        if ( vai.divisor > 0 ) {
+                            set_vertex_attribute_divisor(
+                                debug,
+                                math::numeric_cast<GLuint>(ai.location) + row,
+                                math::numeric_cast<GLuint>(vai.divisor));
+                        }
                     }
                 });
             }
@@ -277,6 +298,12 @@ namespace
             ps->state().with_attribute_location(vai.name, [&debug, &vai](const attribute_info& ai) noexcept {
                 const GLuint rows = math::numeric_cast<GLuint>(vai.rows);
                 for ( GLuint row = 0; row < rows; ++row ) {
+                    if ( vai.divisor > 0 ) {
+                        set_vertex_attribute_divisor(
+                            debug,
+                            math::numeric_cast<GLuint>(ai.location) + row,
+                            0u);
+                    }
                     GL_CHECK_CODE(debug, glDisableVertexAttribArray(
                         math::numeric_cast<GLuint>(ai.location) + row));
                 }
@@ -304,6 +331,35 @@ namespace
         });
     }
 
+    void draw_indexed_primitive_instanced(
+        debug& debug,
+        render::topology tp,
+        const index_buffer_ptr& ib,
+        std::size_t first,
+        std::size_t count,
+        std::size_t instances) noexcept
+    {
+        E2D_ASSERT(ib);
+    #if E2D_RENDER_MODE == E2D_RENDER_MODE_OPENGL
+        with_gl_bind_buffer(debug, ib->state().id(), [&debug, &tp, &ib, &first, &count, &instances]() noexcept {
+            const index_declaration& decl = ib->decl();
+            if ( first < ib->index_count() && instances > 0 ) {
+                GL_CHECK_CODE(debug, glDrawElementsInstanced(
+                    convert_topology(tp),
+                    math::numeric_cast<GLsizei>(math::min(count, ib->index_count() - first)),
+                    convert_index_type(decl.type()),
+                    reinterpret_cast<const GLvoid*>(first * decl.bytes_per_index()),
+                    math::numeric_cast<GLsizei>(instances)));
+            }
+        });
+    #elif E2D_RENDER_MODE == E2D_RENDER_MODE_OPENGLES
+        E2D_UNUSED(debug, tp, ib, first, count, instances);
+        E2D_ASSERT_MSG(false, "instanced drawing is not supported");
+    #else
+    #   error unknown render mode
+    #endif
+    }
+
     template < typename F, typename... Args >
     void with_material_shader(
         debug& debug,
@@ -379,6 +435,15 @@ namespace e2d
     }
     shader::~shader() noexcept = default;
 
+    bool shader::has_attribute(str_hash name) const noexcept {
+        bool found = false;
+        state_->with_attribute_location(name, [&found](const opengl::attribute_info& ai) noexcept {
+            E2D_UNUSED(ai);
+            found = true;
+        });
+        return found;
+    }
+
     //
     // texture
     //
@@ -486,7 +551,8 @@ namespace e2d
     //
 
     render::render(debug& ndebug, window& nwindow)
-    : state_(new internal_state(ndebug, nwindow)) {
+    : state_(new internal_state(ndebug, nwindow))
+    , pipeline_(new pipeline_state(ndebug, nwindow)) {
         E2D_ASSERT(main_thread() == nwindow.main_thread());
     }
     render::~render() noexcept = default;
@@ -495,7 +561,13 @@ namespace e2d
         str_view vertex_source,
         str_view fragment_source)
     {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<shader>([&](){
+                return create_shader(vertex_source, fragment_source);
+            });
+        }
+
+        E2D_ASSERT(is_in_render_thread());
 
         gl_shader_id vs(state_->dbg());
 
@@ -553,7 +625,13 @@ namespace e2d
         buffer_view vertex_source,
         buffer_view fragment_source)
     {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<shader>([&](){
+                return create_shader(vertex_source, fragment_source);
+            });
+        }
+
+        E2D_ASSERT(is_in_render_thread());
 
         return create_shader(
             str_view(reinterpret_cast<const char*>(vertex_source.data()), vertex_source.size()),
@@ -563,7 +641,13 @@ namespace e2d
     texture_ptr render::create_texture(
         const image& image)
     {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<texture>([&](){
+                return create_texture(image);
+            });
+        }
+
+        E2D_ASSERT(is_in_render_thread());
 
         const pixel_declaration decl =
             convert_image_data_format_to_pixel_declaration(image.format());
@@ -647,7 +731,13 @@ namespace e2d
         const v2u& size,
         const pixel_declaration& decl)
     {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<texture>([&](){
+                return create_texture(size, decl);
+            });
+        }
+
+        E2D_ASSERT(is_in_render_thread());
 
         if ( !is_pixel_supported(decl) ) {
             state_->dbg().error("RENDER: Failed to create texture:\n"
@@ -740,7 +830,13 @@ namespace e2d
         const index_declaration& decl,
         index_buffer::usage usage)
     {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<index_buffer>([&](){
+                return create_index_buffer(indices, decl, usage);
+            });
+        }
+
+        E2D_ASSERT(is_in_render_thread());
         E2D_ASSERT(indices.size() % decl.bytes_per_index() == 0);
 
         if ( !is_index_supported(decl) ) {
@@ -778,7 +874,13 @@ namespace e2d
         const vertex_declaration& decl,
         vertex_buffer::usage usage)
     {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<vertex_buffer>([&](){
+                return create_vertex_buffer(vertices, decl, usage);
+            });
+        }
+
+        E2D_ASSERT(is_in_render_thread());
         E2D_ASSERT(vertices.size() % decl.bytes_per_vertex() == 0);
 
         if ( !is_vertex_supported(decl) ) {
@@ -815,7 +917,13 @@ namespace e2d
         const pixel_declaration& depth_decl,
         render_target::external_texture external_texture)
     {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            return pipeline_->create<render_target>([&](){
+                return create_render_target(size, color_decl, depth_decl, external_texture);
+            });
+        }
+
+        E2D_ASSERT(is_in_render_thread());
 
         E2D_ASSERT(
             depth_decl.is_depth() &&
@@ -937,7 +1045,12 @@ namespace e2d
     }
 
     render& render::execute(const draw_command& command) {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            pipeline_->record(command);
+            return *this;
+        }
+
+        E2D_ASSERT(is_in_render_thread());
 
         const material& mat = command.material_ref();
         const geometry& geo = command.geometry_ref();
@@ -965,6 +1078,74 @@ namespace e2d
                             command.index_count());
                     });
                 });
+                statistics& stats = state_->frame_statistics();
+                stats.draw_calls += 1u;
+                if ( command.first_index() < geo.indices()->index_count() ) {
+                    stats.drawn_indices += math::min(
+                        command.index_count(),
+                        geo.indices()->index_count() - command.first_index());
+                }
+            } catch (...) {
+                main_property_cache().clear();
+                throw;
+            }
+            main_property_cache().clear();
+        }
+        return *this;
+    }
+
+    render& render::execute(const draw_instanced_command& command) {
+        if ( pipeline_->recording() ) {
+            pipeline_->record(command);
+            return *this;
+        }
+
+        E2D_ASSERT(is_in_render_thread());
+
+        if ( !device_capabilities().instancing_supported ) {
+            state_->dbg().error("RENDER: Failed to execute draw instanced command:\n"
+                "--> Info: instancing is not supported");
+            return *this;
+        }
+
+        const material& mat = command.material_ref();
+        const geometry& geo = command.geometry_ref();
+        const property_block& props = command.properties_ref();
+        const vertex_buffer_ptr& instances = command.instances();
+
+        for ( std::size_t i = 0, e = mat.pass_count(); i < e; ++i ) {
+            const pass_state& pass = mat.pass(i);
+            if ( !pass.shader() || !geo.indices() || !instances ) {
+                continue;
+            }
+            try {
+                const property_block& main_props = main_property_cache()
+                    .merge(mat.properties())
+                    .merge(pass.properties())
+                    .merge(props);
+                state_->set_states(pass.states());
+                state_->set_shader_program(pass.shader());
+                with_material_shader(state_->dbg(), pass.shader(), main_props, [this, &command, &pass, &geo, &instances]() noexcept {
+                    with_geometry_vertices(state_->dbg(), pass.shader(), geo, [this, &command, &pass, &geo, &instances]() noexcept {
+                        bind_vertex_declaration(state_->dbg(), pass.shader(), instances);
+                        draw_indexed_primitive_instanced(
+                            state_->dbg(),
+                            geo.topo(),
+                            geo.indices(),
+                            command.first_index(),
+                            command.index_count(),
+                            command.instance_count());
+                        unbind_vertex_declaration(state_->dbg(), pass.shader(), instances);
+                    });
+                });
+                statistics& stats = state_->frame_statistics();
+                stats.draw_calls += 1u;
+                stats.drawn_instances += command.instance_count();
+                if ( command.first_index() < geo.indices()->index_count() ) {
+                    stats.drawn_indices += command.instance_count() * math::min(
+                        command.index_count(),
+                        geo.indices()->index_count() - command.first_index());
+                }
             } catch (...) {
                 main_property_cache().clear();
                 throw;
@@ -975,7 +1156,12 @@ namespace e2d
     }
 
     render& render::execute(const clear_command& command) {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            pipeline_->record(command);
+            return *this;
+        }
+
+        E2D_ASSERT(is_in_render_thread());
 
         bool clear_color =
             !!(utils::enum_to_underlying(command.clear_buffer())
@@ -1020,17 +1206,28 @@ namespace e2d
             }
         }
         GL_CHECK_CODE(state_->dbg(), glClear(clear_mask));
+        state_->frame_statistics().clear_calls += 1u;
         return *this;
     }
 
     render& render::execute(const target_command& command) {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            pipeline_->record(command);
+            return *this;
+        }
+
+        E2D_ASSERT(is_in_render_thread());
         state_->set_render_target(command.target());
         return *this;
     }
 
     render& render::execute(const viewport_command& command) {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            pipeline_->record(command);
+            return *this;
+        }
+
+        E2D_ASSERT(is_in_render_thread());
 
         const b2i viewport = math::make_minmax_rect(command.viewport_rect());
         GL_CHECK_CODE(state_->dbg(), glViewport(
@@ -1059,7 +1256,12 @@ namespace e2d
         buffer_view indices,
         std::size_t offset)
     {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            pipeline_->record(ibuffer, indices, offset);
+            return *this;
+        }
+
+        E2D_ASSERT(is_in_render_thread());
         E2D_ASSERT(ibuffer);
         const std::size_t buffer_offset = offset * ibuffer->state().decl().bytes_per_index();
         E2D_ASSERT(indices.size() + buffer_offset <= ibuffer->state().size());
@@ -1072,6 +1274,7 @@ namespace e2d
                     math::numeric_cast<GLsizeiptr>(indices.size()),
                     indices.data()));
             });
+        state_->frame_statistics().buffer_updates += 1u;
         return *this;
     }
 
@@ -1080,7 +1283,12 @@ namespace e2d
         buffer_view vertices,
         std::size_t offset)
     {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            pipeline_->record(vbuffer, vertices, offset);
+            return *this;
+        }
+
+        E2D_ASSERT(is_in_render_thread());
         E2D_ASSERT(vbuffer);
         const std::size_t buffer_offset = offset * vbuffer->state().decl().bytes_per_vertex();
         E2D_ASSERT(vertices.size() + buffer_offset <= vbuffer->state().size());
@@ -1093,6 +1301,7 @@ namespace e2d
                     math::numeric_cast<GLsizeiptr>(vertices.size()),
                     vertices.data()));
             });
+        state_->frame_statistics().buffer_updates += 1u;
         return *this;
     }
 
@@ -1101,7 +1310,12 @@ namespace e2d
         const image& img,
         v2u offset)
     {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            pipeline_->record(tex, img, offset);
+            return *this;
+        }
+
+        E2D_ASSERT(is_in_render_thread());
         E2D_ASSERT(tex);
 
         const pixel_declaration decl =
@@ -1124,7 +1338,12 @@ namespace e2d
         buffer_view pixels,
         const b2u& region)
     {
-        E2D_ASSERT(is_in_main_thread());
+        if ( pipeline_->recording() ) {
+            pipeline_->record(tex, pixels, region);
+            return *this;
+        }
+
+        E2D_ASSERT(is_in_render_thread());
         E2D_ASSERT(tex);
         E2D_ASSERT(region.position.x < tex->size().x && region.position.y < tex->size().y);
         E2D_ASSERT(region.position.x + region.size.x <= tex->size().x);
@@ -1165,16 +1384,17 @@ namespace e2d
                 });
         }
 
+        state_->frame_statistics().texture_updates += 1u;
         return *this;
     }
 
     const render::device_caps& render::device_capabilities() const noexcept {
-        E2D_ASSERT(is_in_main_thread());
+        E2D_ASSERT(is_in_main_thread() || is_in_render_thread());
         return state_->device_capabilities();
     }
 
     bool render::is_pixel_supported(const pixel_declaration& decl) const noexcept {
-        E2D_ASSERT(is_in_main_thread());
+        E2D_ASSERT(is_in_main_thread() || is_in_render_thread());
         const device_caps& caps = device_capabilities();
         switch ( decl.type() ) {
             case pixel_declaration::pixel_type::depth16:
@@ -1233,8 +1453,13 @@ namespace e2d
         }
     }
 
+    bool render::is_image_format_supported(image_data_format format) const noexcept {
+        return is_pixel_supported(
+            convert_image_data_format_to_pixel_declaration(format));
+    }
+
     bool render::is_index_supported(const index_declaration& decl) const noexcept {
-        E2D_ASSERT(is_in_main_thread());
+        E2D_ASSERT(is_in_main_thread() || is_in_render_thread());
         const device_caps& caps = device_capabilities();
         switch ( decl.type() ) {
             case index_declaration::index_type::unsigned_short:
@@ -1248,8 +1473,29 @@ namespace e2d
     }
 
     bool render::is_vertex_supported(const vertex_declaration& decl) const noexcept {
-        E2D_ASSERT(is_in_main_thread());
-        return decl.attribute_count() <= device_capabilities().max_vertex_attributes;
+        E2D_ASSERT(is_in_main_thread() || is_in_render_thread());
+        return decl.attribute_count() <= device_capabilities().max_vertex_attributes
+            && (!decl.has_per_instance_attributes() || device_capabilities().instancing_supported);
+    }
+
+    const render::statistics& render::frame_statistics() const noexcept {
+        if ( pipeline_->recording() ) {
+            return pipeline_->frame_statistics();
+        }
+
+        E2D_ASSERT(is_in_render_thread());
+        return state_->frame_statistics();
+    }
+
+    render& render::reset_frame_statistics() noexcept {
+        if ( pipeline_->recording() ) {
+            pipeline_->reset_frame_statistics();
+            return *this;
+        }
+
+        E2D_ASSERT(is_in_render_thread());
+        state_->frame_statistics() = statistics();
+        return *this;
     }
 }
 
@@ -1388,6 +1388,16 @@ namespace e2d::opengl
             gl_has_any_extension(debug,
                 "GL_OES_element_index_uint");
 
+    #if E2D_RENDER_MODE == E2D_RENDER_MODE_OPENGL
+        caps.instancing_supported =
+            version >= gl_version::gl_3_3;
+    #elif E2D_RENDER_MODE == E2D_RENDER_MODE_OPENGLES
+        // the es backend is built against the gles 2.0 headers
+        caps.instancing_supported = false;
+    #else
+    #   error unknown render mode
+    #endif
+
         caps.depth16_supported =
             version >= gl_version::gl_1_4 ||
             version >= gl_version::gles_3_0 ||
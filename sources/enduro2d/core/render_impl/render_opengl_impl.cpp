@@ -321,6 +321,10 @@ namespace e2d
         return render_target_;
     }
 
+    render::statistics& render::internal_state::frame_statistics() noexcept {
+        return frame_statistics_;
+    }
+
     render::internal_state& render::internal_state::reset_states() noexcept {
         set_depth_state_(state_block_.depth());
         set_stencil_state_(state_block_.stencil());
@@ -175,6 +175,7 @@ namespace e2d
         window& wnd() const noexcept;
         const device_caps& device_capabilities() const noexcept;
         const render_target_ptr& render_target() const noexcept;
+        statistics& frame_statistics() noexcept;
     public:
         internal_state& reset_states() noexcept;
         internal_state& set_states(const state_block& sb) noexcept;
@@ -194,6 +195,7 @@ namespace e2d
         debug& debug_;
         window& window_;
         device_caps device_caps_;
+        statistics frame_statistics_;
         state_block state_block_;
         shader_ptr shader_program_;
         render_target_ptr render_target_;
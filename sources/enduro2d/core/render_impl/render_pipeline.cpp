@@ -0,0 +1,323 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "render_pipeline.hpp"
+
+namespace e2d
+{
+    render::pipeline_state::pipeline_state(debug& d, window& w)
+    : debug_(d)
+    , window_(w)
+    , releases_(std::make_shared<release_queue>()) {}
+
+    render::pipeline_state::~pipeline_state() noexcept {
+        stop();
+    }
+
+    bool render::pipeline_state::start(render& r, std::size_t max_queued_frames) {
+        E2D_ASSERT(r.is_in_main_thread());
+
+        if ( active_ ) {
+            debug_.error("RENDER: Render thread is already started");
+            return false;
+        }
+
+        max_queued_frames_ = math::max(max_queued_frames, std::size_t(1u));
+        exit_ = false;
+
+        window_.unbind_context();
+        try {
+            thread_ = std::thread([this, &r](){
+                process_(r);
+            });
+        } catch (...) {
+            window_.bind_context();
+            debug_.error("RENDER: Failed to start render thread");
+            return false;
+        }
+
+        thread_id_ = thread_.get_id();
+        main_thread_id_ = std::this_thread::get_id();
+        releases_->activate(thread_.get_id());
+        active_ = true;
+        return true;
+    }
+
+    void render::pipeline_state::stop() noexcept {
+        if ( !active_ ) {
+            return;
+        }
+
+        wait();
+
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            exit_ = true;
+        }
+        cond_var_.notify_all();
+
+        thread_.join();
+        thread_id_ = std::thread::id();
+        active_ = false;
+
+        window_.bind_context();
+        recording_.clear();
+    }
+
+    bool render::pipeline_state::active() const noexcept {
+        return active_;
+    }
+
+    bool render::pipeline_state::recording() const noexcept {
+        return active_ && std::this_thread::get_id() != thread_id_.load();
+    }
+
+    bool render::pipeline_state::in_render_thread() const noexcept {
+        return active_ && std::this_thread::get_id() == thread_id_.load();
+    }
+
+    void render::pipeline_state::record(const draw_command& command) {
+        recording_frame_().push_back(draw_operation{
+            command.material_ref(),
+            command.geometry_ref(),
+            command.properties_ref(),
+            command.first_index(),
+            command.index_count()});
+    }
+
+    void render::pipeline_state::record(const draw_instanced_command& command) {
+        recording_frame_().push_back(draw_instanced_operation{
+            command.material_ref(),
+            command.geometry_ref(),
+            command.properties_ref(),
+            command.instances(),
+            command.first_index(),
+            command.index_count(),
+            command.instance_count()});
+    }
+
+    void render::pipeline_state::record(const clear_command& command) {
+        recording_frame_().push_back(command);
+    }
+
+    void render::pipeline_state::record(const target_command& command) {
+        recording_frame_().push_back(command);
+    }
+
+    void render::pipeline_state::record(const viewport_command& command) {
+        recording_frame_().push_back(command);
+    }
+
+    void render::pipeline_state::record(
+        const index_buffer_ptr& ibuffer,
+        buffer_view indices,
+        std::size_t offset)
+    {
+        recording_frame_().push_back(index_update_operation{
+            ibuffer,
+            buffer(indices.data(), indices.size()),
+            offset});
+    }
+
+    void render::pipeline_state::record(
+        const vertex_buffer_ptr& vbuffer,
+        buffer_view vertices,
+        std::size_t offset)
+    {
+        recording_frame_().push_back(vertex_update_operation{
+            vbuffer,
+            buffer(vertices.data(), vertices.size()),
+            offset});
+    }
+
+    void render::pipeline_state::record(
+        const texture_ptr& tex,
+        const image& img,
+        v2u offset)
+    {
+        recording_frame_().push_back(image_update_operation{
+            tex,
+            img,
+            offset});
+    }
+
+    void render::pipeline_state::record(
+        const texture_ptr& tex,
+        buffer_view pixels,
+        const b2u& region)
+    {
+        recording_frame_().push_back(pixels_update_operation{
+            tex,
+            buffer(pixels.data(), pixels.size()),
+            region});
+    }
+
+    void render::pipeline_state::submit_frame() {
+        if ( !active_ ) {
+            window_.swap_buffers();
+            return;
+        }
+
+        E2D_PROFILER_SCOPE("render.submit_frame");
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_var_.wait(lock, [this](){
+            const std::size_t queued_frames = frames_.size() + (executing_ ? 1u : 0u);
+            return queued_frames < max_queued_frames_;
+        });
+
+        frames_.push_back(std::move(recording_));
+        frame_statistics_ = completed_statistics_;
+
+        if ( free_frames_.empty() ) {
+            recording_ = frame();
+        } else {
+            recording_ = std::move(free_frames_.back());
+            free_frames_.pop_back();
+        }
+
+        lock.unlock();
+        cond_var_.notify_all();
+    }
+
+    void render::pipeline_state::wait() noexcept {
+        if ( !active_ ) {
+            return;
+        }
+        E2D_PROFILER_SCOPE("render.wait_for_render_thread");
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_var_.wait(lock, [this](){
+            return frames_.empty() && !executing_ && tasks_.empty();
+        });
+    }
+
+    const render::statistics& render::pipeline_state::frame_statistics() const noexcept {
+        return frame_statistics_;
+    }
+
+    void render::pipeline_state::reset_frame_statistics() noexcept {
+        frame_statistics_ = statistics();
+    }
+
+    render::pipeline_state::frame& render::pipeline_state::recording_frame_() noexcept {
+        // frames are submitted by the main thread, so only it may record them
+        E2D_ASSERT(std::this_thread::get_id() == main_thread_id_);
+        return recording_;
+    }
+
+    void render::pipeline_state::run_task_(const std::function<void()>& task) {
+        E2D_PROFILER_SCOPE("render.wait_for_render_thread");
+        std::unique_lock<std::mutex> lock(mutex_);
+        const u64 task_id = ++pushed_tasks_;
+        tasks_.push_back(&task);
+        cond_var_.notify_all();
+        cond_var_.wait(lock, [this, task_id](){
+            return completed_tasks_ >= task_id;
+        });
+    }
+
+    void render::pipeline_state::process_(render& r) noexcept {
+        window_.bind_context();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        while ( true ) {
+            cond_var_.wait(lock, [this](){
+                return exit_ || !tasks_.empty() || !frames_.empty();
+            });
+
+            if ( !tasks_.empty() ) {
+                const std::function<void()>* task = tasks_.front();
+                tasks_.pop_front();
+                lock.unlock();
+                (*task)();
+                lock.lock();
+                ++completed_tasks_;
+                cond_var_.notify_all();
+                continue;
+            }
+
+            if ( !frames_.empty() ) {
+                frame f = std::move(frames_.front());
+                frames_.pop_front();
+                executing_ = true;
+                lock.unlock();
+
+                execute_(r, f);
+                f.clear();
+                releases_->release(false);
+
+                lock.lock();
+                executing_ = false;
+                completed_statistics_ = r.frame_statistics();
+                r.reset_frame_statistics();
+                free_frames_.push_back(std::move(f));
+                cond_var_.notify_all();
+                continue;
+            }
+
+            if ( exit_ ) {
+                break;
+            }
+        }
+        lock.unlock();
+
+        releases_->release(true);
+        window_.unbind_context();
+    }
+
+    void render::pipeline_state::execute_(render& r, const frame& f) noexcept {
+        E2D_PROFILER_SCOPE_EX("render.execute_frame", {
+            {"operations", std::to_string(f.size())}
+        });
+
+        const auto visitor = utils::overloaded {
+            [&r](const draw_operation& op){
+                r.execute(draw_command(op.mat, op.geo, op.props)
+                    .index_range(op.first_index, op.index_count));
+            },
+            [&r](const draw_instanced_operation& op){
+                r.execute(draw_instanced_command(
+                    op.mat, op.geo, op.props, op.instances, op.instance_count)
+                    .index_range(op.first_index, op.index_count));
+            },
+            [&r](const clear_command& command){
+                r.execute(command);
+            },
+            [&r](const target_command& command){
+                r.execute(command);
+            },
+            [&r](const viewport_command& command){
+                r.execute(command);
+            },
+            [&r](const index_update_operation& op){
+                r.update_buffer(op.ibuffer, op.indices, op.offset);
+            },
+            [&r](const vertex_update_operation& op){
+                r.update_buffer(op.vbuffer, op.vertices, op.offset);
+            },
+            [&r](const image_update_operation& op){
+                r.update_texture(op.tex, op.img, op.offset);
+            },
+            [&r](const pixels_update_operation& op){
+                r.update_texture(op.tex, op.pixels, op.region);
+            }
+        };
+
+        for ( const operation& op : f ) {
+            try {
+                std::visit(visitor, op);
+            } catch ( std::exception& e ) {
+                debug_.error("RENDER: Failed to execute recorded operation:\n"
+                    "--> Exception: %0",
+                    e.what());
+            } catch (...) {
+                debug_.error("RENDER: Failed to execute recorded operation");
+            }
+        }
+
+        window_.swap_buffers();
+    }
+}
@@ -0,0 +1,219 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include <enduro2d/core/debug.hpp>
+#include <enduro2d/core/profiler.hpp>
+#include <enduro2d/core/render.hpp>
+#include <enduro2d/core/window.hpp>
+
+#include <deque>
+#include <condition_variable>
+
+namespace e2d
+{
+    //
+    // render::pipeline_state
+    //
+
+    class render::pipeline_state final : private e2d::noncopyable {
+    public:
+        struct draw_operation {
+            material mat;
+            geometry geo;
+            property_block props;
+            std::size_t first_index{0u};
+            std::size_t index_count{0u};
+        };
+
+        struct draw_instanced_operation {
+            material mat;
+            geometry geo;
+            property_block props;
+            vertex_buffer_ptr instances;
+            std::size_t first_index{0u};
+            std::size_t index_count{0u};
+            std::size_t instance_count{0u};
+        };
+
+        struct index_update_operation {
+            index_buffer_ptr ibuffer;
+            buffer indices;
+            std::size_t offset{0u};
+        };
+
+        struct vertex_update_operation {
+            vertex_buffer_ptr vbuffer;
+            buffer vertices;
+            std::size_t offset{0u};
+        };
+
+        struct image_update_operation {
+            texture_ptr tex;
+            image img;
+            v2u offset;
+        };
+
+        struct pixels_update_operation {
+            texture_ptr tex;
+            buffer pixels;
+            b2u region;
+        };
+
+        using operation = std::variant<
+            draw_operation,
+            draw_instanced_operation,
+            clear_command,
+            target_command,
+            viewport_command,
+            index_update_operation,
+            vertex_update_operation,
+            image_update_operation,
+            pixels_update_operation>;
+    public:
+        pipeline_state(debug& d, window& w);
+        ~pipeline_state() noexcept;
+
+        bool start(render& r, std::size_t max_queued_frames);
+        void stop() noexcept;
+
+        bool active() const noexcept;
+        bool recording() const noexcept;
+        bool in_render_thread() const noexcept;
+
+        void record(const draw_command& command);
+        void record(const draw_instanced_command& command);
+        void record(const clear_command& command);
+        void record(const target_command& command);
+        void record(const viewport_command& command);
+
+        void record(const index_buffer_ptr& ibuffer, buffer_view indices, std::size_t offset);
+        void record(const vertex_buffer_ptr& vbuffer, buffer_view vertices, std::size_t offset);
+        void record(const texture_ptr& tex, const image& img, v2u offset);
+        void record(const texture_ptr& tex, buffer_view pixels, const b2u& region);
+
+        void submit_frame();
+        void wait() noexcept;
+
+        template < typename T, typename F >
+        std::shared_ptr<T> create(F&& f);
+
+        const statistics& frame_statistics() const noexcept;
+        void reset_frame_statistics() noexcept;
+    private:
+        class release_queue;
+        using frame = vector<operation>;
+
+        frame& recording_frame_() noexcept;
+        void run_task_(const std::function<void()>& task);
+        void process_(render& r) noexcept;
+        void execute_(render& r, const frame& f) noexcept;
+
+        template < typename T >
+        std::shared_ptr<T> wrap_release_(std::shared_ptr<T> resource);
+    private:
+        debug& debug_;
+        window& window_;
+        std::thread thread_;
+        std::atomic<std::thread::id> thread_id_;
+        std::thread::id main_thread_id_;
+        std::atomic<bool> active_{false};
+        std::size_t max_queued_frames_{1u};
+        std::shared_ptr<release_queue> releases_;
+    private:
+        mutable std::mutex mutex_;
+        std::condition_variable cond_var_;
+        std::deque<frame> frames_;
+        vector<frame> free_frames_;
+        std::deque<const std::function<void()>*> tasks_;
+        u64 pushed_tasks_{0u};
+        u64 completed_tasks_{0u};
+        bool executing_{false};
+        bool exit_{false};
+        statistics completed_statistics_;
+    private:
+        frame recording_;
+        statistics frame_statistics_;
+    };
+
+    //
+    // render::pipeline_state::release_queue
+    //
+    // Resources created in the pipelined mode are released on the render
+    // thread, the last reference dropped by any other thread queues them.
+    //
+
+    class render::pipeline_state::release_queue final : private e2d::noncopyable {
+    public:
+        void push(std::shared_ptr<void> resource) noexcept {
+            std::unique_lock<std::mutex> guard(mutex_);
+            if ( active_ && std::this_thread::get_id() != thread_id_ ) {
+                try {
+                    resources_.push_back(std::move(resource));
+                } catch (...) {
+                    // nothing, released in place
+                }
+            }
+            guard.unlock();
+            resource.reset();
+        }
+
+        void activate(std::thread::id thread_id) noexcept {
+            std::lock_guard<std::mutex> guard(mutex_);
+            active_ = true;
+            thread_id_ = thread_id;
+        }
+
+        void release(bool deactivate) noexcept {
+            vector<std::shared_ptr<void>> resources;
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                resources.swap(resources_);
+                active_ = active_ && !deactivate;
+            }
+            resources.clear();
+        }
+    private:
+        std::mutex mutex_;
+        vector<std::shared_ptr<void>> resources_;
+        std::thread::id thread_id_;
+        bool active_{false};
+    };
+}
+
+namespace e2d
+{
+    template < typename T, typename F >
+    std::shared_ptr<T> render::pipeline_state::create(F&& f) {
+        std::shared_ptr<T> resource;
+        std::exception_ptr exception;
+        run_task_([&f, &resource, &exception](){
+            try {
+                resource = f();
+            } catch (...) {
+                exception = std::current_exception();
+            }
+        });
+        if ( exception ) {
+            std::rethrow_exception(exception);
+        }
+        return wrap_release_(std::move(resource));
+    }
+
+    template < typename T >
+    std::shared_ptr<T> render::pipeline_state::wrap_release_(std::shared_ptr<T> resource) {
+        if ( !resource ) {
+            return resource;
+        }
+        T* resource_ptr = resource.get();
+        return std::shared_ptr<T>(
+            resource_ptr,
+            [releases = releases_, resource = std::move(resource)](T*) mutable {
+                releases->push(std::move(resource));
+            });
+    }
+}
@@ -10,6 +10,11 @@
 
 #include <3rdparty/miniz/miniz.h>
 
+#if defined(E2D_PLATFORM) && E2D_PLATFORM == E2D_PLATFORM_LINUX
+#  include <unistd.h>
+#  include <sys/inotify.h>
+#endif
+
 namespace
 {
     using namespace e2d;
@@ -74,6 +79,23 @@ namespace
 
 namespace e2d
 {
+    //
+    // vfs::file_source
+    //
+
+    bool vfs::file_source::watch(str_view path) const {
+        E2D_UNUSED(path);
+        return false;
+    }
+
+    void vfs::file_source::poll_changes(vector<str>& changed_paths) const {
+        E2D_UNUSED(changed_paths);
+    }
+
+    bool vfs::file_source::prefetch(str_view path) const {
+        return exists(path);
+    }
+
     //
     // vfs
     //
@@ -83,7 +105,8 @@ namespace e2d
         std::mutex mutex;
         stdex::jobber worker{1};
         flat_map<str, url> aliases;
-        flat_map<str, file_source_uptr> schemes;
+        flat_map<str, std::shared_ptr<file_source>> schemes;
+        vector<change_listener_uptr> listeners;
     public:
         url resolve_url(const url& url, u8 level = 0) const {
             if ( level > 32 ) {
@@ -96,14 +119,24 @@ namespace e2d
         }
 
         template < typename F, typename R >
-        R with_file_source(const url& url, F&& f, R&& fallback_result) const {
-            const auto resolved_url = resolve_url(url);
-            const auto scheme_iter = schemes.find(resolved_url.scheme());
-            return (scheme_iter != schemes.cend() && scheme_iter->second)
+        R with_file_source(const url& url, F&& f, R&& fallback_result) {
+            std::shared_ptr<file_source> source;
+            str source_path;
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                const auto resolved_url = resolve_url(url);
+                const auto scheme_iter = schemes.find(resolved_url.scheme());
+                if ( scheme_iter != schemes.cend() && scheme_iter->second ) {
+                    source = scheme_iter->second;
+                    source_path = resolved_url.path();
+                }
+            }
+            // sources are used without the lock, remote ones can block for a while
+            return source
                 ? std::invoke(
                     std::forward<F>(f),
-                    scheme_iter->second,
-                    resolved_url.path())
+                    *source,
+                    source_path)
                 : std::forward<R>(fallback_result);
         }
     };
@@ -151,26 +184,23 @@ namespace e2d
     }
 
     bool vfs::exists(const url& url) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->with_file_source(url,
-            [](const file_source_uptr& source, const str& path) {
-                return source->exists(path);
+            [](const file_source& source, const str& path) {
+                return source.exists(path);
             }, false);
     }
 
     input_stream_uptr vfs::read(const url& url) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->with_file_source(url,
-            [](const file_source_uptr& source, const str& path) {
-                return source->read(path);
+            [](const file_source& source, const str& path) {
+                return source.read(path);
             }, input_stream_uptr());
     }
 
     output_stream_uptr vfs::write(const url& url, bool append) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->with_file_source(url,
-            [&append](const file_source_uptr& source, const str& path) {
-                return source->write(path, append);
+            [&append](const file_source& source, const str& path) {
+                return source.write(path, append);
             }, output_stream_uptr());
     }
 
@@ -221,10 +251,9 @@ namespace e2d
     }
 
     bool vfs::trace(const url& url, filesystem::trace_func func) const {
-        std::lock_guard<std::mutex> guard(state_->mutex);
         return state_->with_file_source(url,
-            [&func](const file_source_uptr& source, const str& path) {
-                return source->trace(path, func);
+            [&func](const file_source& source, const str& path) {
+                return source.trace(path, func);
             }, false);
     }
 
@@ -233,6 +262,122 @@ namespace e2d
         return state_->resolve_url(url);
     }
 
+    bool vfs::watch(const url& url) const {
+        return state_->with_file_source(url,
+            [](const file_source& source, const str& path) {
+                return source.watch(path);
+            }, false);
+    }
+
+    bool vfs::prefetch(const url& url) const {
+        E2D_PROFILER_SCOPE_EX("vfs.prefetch", {
+            {"url", url.schemepath()}
+        });
+        return state_->with_file_source(url,
+            [](const file_source& source, const str& path) {
+                return source.prefetch(path);
+            }, false);
+    }
+
+    stdex::promise<void> vfs::prefetch_async(const url& manifest_url) const {
+        return state_->worker.async([this, manifest_url](){
+            E2D_PROFILER_SCOPE_EX("vfs.prefetch_async", {
+                {"url", manifest_url.schemepath()}
+            });
+
+            str manifest;
+            const input_stream_uptr stream = read(manifest_url);
+            if ( !stream || !streams::try_read_tail(manifest, stream) ) {
+                throw vfs_load_async_exception();
+            }
+
+            const url manifest_dir(
+                manifest_url.scheme(),
+                path::parent_path(manifest_url.path()));
+
+            for ( std::size_t first = 0; first < manifest.size(); ) {
+                std::size_t last = manifest.find('\n', first);
+                if ( last == str::npos ) {
+                    last = manifest.size();
+                }
+
+                str_view entry = str_view(manifest).substr(first, last - first);
+                first = last + 1;
+
+                while ( !entry.empty() && std::isspace(static_cast<unsigned char>(entry.back())) ) {
+                    entry.remove_suffix(1);
+                }
+
+                while ( !entry.empty() && std::isspace(static_cast<unsigned char>(entry.front())) ) {
+                    entry.remove_prefix(1);
+                }
+
+                if ( entry.empty() || entry.front() == '#' ) {
+                    continue;
+                }
+
+                if ( !prefetch(manifest_dir / entry) ) {
+                    throw vfs_load_async_exception();
+                }
+            }
+        });
+    }
+
+    vfs::change_listener& vfs::register_change_listener(change_listener_uptr listener) {
+        E2D_ASSERT(listener);
+        std::lock_guard<std::mutex> guard(state_->mutex);
+        state_->listeners.push_back(std::move(listener));
+        return *state_->listeners.back();
+    }
+
+    void vfs::unregister_change_listener(const change_listener& listener) noexcept {
+        std::lock_guard<std::mutex> guard(state_->mutex);
+        for ( auto iter = state_->listeners.begin(); iter != state_->listeners.end(); ) {
+            if ( iter->get() == &listener ) {
+                iter = state_->listeners.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+
+    void vfs::frame_tick() noexcept {
+        E2D_PROFILER_SCOPE("vfs.frame_tick");
+
+        vector<url> changed_urls;
+        vector<change_listener*> listeners;
+
+        try {
+            std::lock_guard<std::mutex> guard(state_->mutex);
+            vector<str> changed_paths;
+            for ( const auto& [scheme, source] : state_->schemes ) {
+                if ( source ) {
+                    source->poll_changes(changed_paths);
+                }
+                for ( str& path : changed_paths ) {
+                    changed_urls.emplace_back(scheme, std::move(path));
+                }
+                changed_paths.clear();
+            }
+            listeners.reserve(state_->listeners.size());
+            for ( const change_listener_uptr& listener : state_->listeners ) {
+                listeners.push_back(listener.get());
+            }
+        } catch (...) {
+            return;
+        }
+
+        // listeners are notified without the lock, they are free to use the vfs
+        for ( const url& url : changed_urls ) {
+            E2D_PROFILER_GLOBAL_EVENT_EX("vfs.file_changed", {
+                {"url", url.schemepath()}
+            });
+            for ( change_listener* listener : listeners ) {
+                listener->on_change(url);
+            }
+        }
+    }
+
     //
     // archive_file_source
     //
@@ -241,6 +386,7 @@ namespace e2d
     public:
         using archive_ptr = std::shared_ptr<mz_zip_archive>;
         using stream_ptr = std::shared_ptr<input_stream>;
+        std::mutex mutex;
         archive_ptr archive;
         stream_ptr stream;
     public:
@@ -290,6 +436,7 @@ namespace e2d
     }
 
     bool archive_file_source::exists(str_view path) const {
+        std::lock_guard<std::mutex> guard(state_->mutex);
         return -1 != mz_zip_reader_locate_file(
             state_->archive.get(),
             make_utf8(path).c_str(),
@@ -299,6 +446,7 @@ namespace e2d
 
     input_stream_uptr archive_file_source::read(str_view path) const {
         try {
+            std::lock_guard<std::mutex> guard(state_->mutex);
             struct owned_state_t {
                 state::archive_ptr archive;
                 state::stream_ptr stream;
@@ -318,6 +466,7 @@ namespace e2d
     }
 
     bool archive_file_source::trace(str_view path, filesystem::trace_func func) const {
+        std::lock_guard<std::mutex> guard(state_->mutex);
         str parent = make_utf8(path);
         if ( !parent.empty() ) {
             if ( parent.back() != '/' ) {
@@ -361,7 +510,96 @@ namespace e2d
     // filesystem_file_source
     //
 
-    filesystem_file_source::filesystem_file_source() = default;
+#if defined(E2D_PLATFORM) && E2D_PLATFORM == E2D_PLATFORM_LINUX
+    class filesystem_file_source::state final : private e2d::noncopyable {
+    public:
+        state() noexcept
+        : fd_(::inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {}
+
+        ~state() noexcept {
+            if ( fd_ != -1 ) {
+                ::close(fd_);
+            }
+        }
+
+        bool watch(str_view path) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if ( fd_ == -1 ) {
+                return false;
+            }
+
+            // directories are watched instead of files
+            // to survive replacing a file by an editor
+            const str directory = path::parent_path(path);
+            const int wd = ::inotify_add_watch(
+                fd_,
+                directory.empty() ? "." : directory.c_str(),
+                IN_CLOSE_WRITE | IN_MOVED_TO);
+            if ( wd == -1 ) {
+                return false;
+            }
+
+            watches_[wd][path::filename(path)] = path;
+            return true;
+        }
+
+        void poll_changes(vector<str>& changed_paths) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if ( fd_ == -1 || watches_.empty() ) {
+                return;
+            }
+
+            alignas(inotify_event) char events[4096];
+            const std::size_t first_changed = changed_paths.size();
+
+            while ( true ) {
+                const ssize_t len = ::read(fd_, events, sizeof(events));
+                if ( len <= 0 ) {
+                    break;
+                }
+                for ( ssize_t offset = 0; offset < len; ) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(events + offset);
+                    offset += math::numeric_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                    if ( !event->len ) {
+                        continue;
+                    }
+                    const auto watch_iter = watches_.find(event->wd);
+                    if ( watch_iter == watches_.end() ) {
+                        continue;
+                    }
+                    const auto file_iter = watch_iter->second.find(str(event->name));
+                    if ( file_iter == watch_iter->second.end() ) {
+                        continue;
+                    }
+                    // an editor can write a file several times per save
+                    const auto first = changed_paths.begin() + first_changed;
+                    if ( std::find(first, changed_paths.end(), file_iter->second) == changed_paths.end() ) {
+                        changed_paths.push_back(file_iter->second);
+                    }
+                }
+            }
+        }
+    private:
+        std::mutex mutex_;
+        int fd_{-1};
+        flat_map<int, flat_map<str, str>> watches_;
+    };
+#else
+    class filesystem_file_source::state final : private e2d::noncopyable {
+    public:
+        bool watch(str_view path) {
+            E2D_UNUSED(path);
+            return false;
+        }
+
+        void poll_changes(vector<str>& changed_paths) {
+            E2D_UNUSED(changed_paths);
+        }
+    };
+#endif
+
+    filesystem_file_source::filesystem_file_source()
+    : state_(new state()) {}
     filesystem_file_source::~filesystem_file_source() noexcept = default;
 
     bool filesystem_file_source::valid() const noexcept {
@@ -386,4 +624,12 @@ namespace e2d
     bool filesystem_file_source::trace(str_view path, filesystem::trace_func func) const {
         return filesystem::trace_directory_recursive(path, func);
     }
+
+    bool filesystem_file_source::watch(str_view path) const {
+        return state_->watch(path);
+    }
+
+    void filesystem_file_source::poll_changes(vector<str>& changed_paths) const {
+        state_->poll_changes(changed_paths);
+    }
 }
@@ -0,0 +1,544 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/core/vfs.hpp>
+
+#include <enduro2d/core/network.hpp>
+#include <enduro2d/core/profiler.hpp>
+
+#include <future>
+
+namespace
+{
+    using namespace e2d;
+
+    const std::size_t http_block_size = 256u * 1024u;
+    const str_view http_cache_signature = "e2d_http_cache_1";
+
+    // file names of different urls must not collide, unlike std::hash values
+    str cache_file_name(str_view url) {
+        const sha256_digest digest = digests::sha256(url);
+        str name;
+        name.reserve(digest.size() * 2u);
+        for ( u8 b : digest ) {
+            name.push_back("0123456789abcdef"[b >> 4u]);
+            name.push_back("0123456789abcdef"[b & 0x0Fu]);
+        }
+        return name;
+    }
+
+    str find_header(const net::response& response, str_view name) {
+        const auto same_char = [](char l, char r) noexcept {
+            return std::tolower(static_cast<unsigned char>(l))
+                == std::tolower(static_cast<unsigned char>(r));
+        };
+        for ( const auto& [key, value] : response.headers ) {
+            if ( std::equal(key.begin(), key.end(), name.begin(), name.end(), same_char) ) {
+                return value;
+            }
+        }
+        return str();
+    }
+
+    buffer response_content(const net::response& response) {
+        return buffer(
+            response.content.data().data(),
+            response.content.size());
+    }
+}
+
+namespace e2d
+{
+    //
+    // http_file_source::state
+    //
+
+    class http_file_source::state final
+        : public std::enable_shared_from_this<state>
+        , private e2d::noncopyable
+    {
+    public:
+        struct entry {
+            str url;
+            str etag;
+            std::size_t size{0u};
+            bool cached{false};
+        };
+
+        class range_stream;
+        using response_ptr = std::shared_ptr<const net::response>;
+    public:
+        state(str scheme, str cache_directory)
+        : scheme_(std::move(scheme))
+        , cache_directory_(std::move(cache_directory)) {}
+
+        std::optional<entry> validate(str_view path) {
+            entry remote;
+            remote.url = scheme_ + "://" + str(path);
+
+            entry cached;
+            const bool has_cached = load_cached_entry_(remote.url, cached);
+
+            net::request_builder rb;
+            rb.method(net::http_method::HEAD).url(remote.url);
+            if ( has_cached && !cached.etag.empty() ) {
+                rb.header("If-None-Match", cached.etag);
+            }
+
+            const response_ptr response = perform_(
+                strings::rformat("HEAD %0 %1", remote.url, cached.etag),
+                std::move(rb));
+
+            if ( !response ) {
+                // the cached version is better than nothing while offline
+                return has_cached
+                    ? std::make_optional(std::move(cached))
+                    : std::nullopt;
+            }
+
+            if ( response->http_code() == 304u && has_cached ) {
+                return cached;
+            }
+
+            if ( response->http_code() != 200u ) {
+                return std::nullopt;
+            }
+
+            if ( !strings::try_parse(find_header(*response, "Content-Length"), remote.size) ) {
+                return std::nullopt;
+            }
+
+            remote.etag = find_header(*response, "ETag");
+            if ( has_cached
+                && !remote.etag.empty()
+                && remote.etag == cached.etag
+                && remote.size == cached.size )
+            {
+                return cached;
+            }
+
+            return remote;
+        }
+
+        input_stream_uptr open(str_view path);
+
+        bool prefetch(str_view path) {
+            if ( cache_directory_.empty() ) {
+                return false;
+            }
+
+            const std::optional<entry> e = validate(path);
+            if ( !e ) {
+                return false;
+            }
+
+            if ( e->cached ) {
+                return true;
+            }
+
+            net::request_builder rb;
+            rb.method(net::http_method::GET).url(e->url);
+
+            const response_ptr response = perform_(
+                strings::rformat("GET %0", e->url),
+                std::move(rb));
+
+            if ( !response
+                || response->http_code() != 200u
+                || response->content.size() != e->size )
+            {
+                return false;
+            }
+
+            output_stream_uptr cache_stream = begin_caching(*e);
+            if ( !cache_stream ) {
+                // being cached by a reader right now
+                return true;
+            }
+
+            const bool success = output_sequence(*cache_stream)
+                .write_all(response_content(*response))
+                .flush()
+                .success();
+
+            cache_stream.reset();
+            return end_caching(*e, success);
+        }
+
+        // returns the data of a block starting at the block_first offset,
+        // servers without range support return the whole file
+        buffer fetch_range(
+            const entry& e,
+            std::size_t first,
+            std::size_t last,
+            std::size_t& block_first)
+        {
+            net::request_builder rb;
+            rb.method(net::http_method::GET)
+                .url(e.url)
+                .header("Range", strings::rformat("bytes=%0-%1", first, last));
+            if ( !e.etag.empty() ) {
+                rb.header("If-Range", e.etag);
+            }
+
+            const response_ptr response = perform_(
+                strings::rformat("GET %0 %1-%2", e.url, first, last),
+                std::move(rb));
+
+            if ( !response ) {
+                throw bad_vfs_operation();
+            }
+
+            if ( response->http_code() == 206u ) {
+                if ( response->content.size() != last - first + 1u ) {
+                    throw bad_vfs_operation();
+                }
+                block_first = first;
+                return response_content(*response);
+            }
+
+            if ( response->http_code() == 200u ) {
+                // If-Range responds with the whole file when it has been changed
+                if ( response->content.size() != e.size
+                    || (!e.etag.empty() && find_header(*response, "ETag") != e.etag) )
+                {
+                    throw bad_vfs_operation();
+                }
+                block_first = 0u;
+                return response_content(*response);
+            }
+
+            throw bad_vfs_operation();
+        }
+
+        output_stream_uptr begin_caching(const entry& e) {
+            if ( cache_directory_.empty() ) {
+                return nullptr;
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                if ( !caching_.insert(e.url).second ) {
+                    return nullptr;
+                }
+            }
+
+            // the data is written aside, readers of the old one keep streaming it
+            output_stream_uptr stream;
+            if ( filesystem::create_directory_recursive(cache_directory_) ) {
+                stream = make_write_file(cache_temp_path_(e.url), false);
+            }
+
+            if ( !stream ) {
+                std::lock_guard<std::mutex> guard(mutex_);
+                caching_.erase(e.url);
+            }
+
+            return stream;
+        }
+
+        bool end_caching(const entry& e, bool success) noexcept {
+            try {
+                // the meta file is written last and marks the data as complete
+                if ( success ) {
+                    success = filesystem::remove_file(cache_meta_path_(e.url))
+                        && filesystem::rename_file(cache_temp_path_(e.url), cache_data_path_(e.url));
+                }
+                if ( success ) {
+                    const str meta = strings::rformat(
+                        "%0\n%1\n%2\n%3\n",
+                        http_cache_signature, e.url, e.etag, e.size);
+                    success = filesystem::try_write_all(meta, cache_meta_path_(e.url), false);
+                }
+                if ( !success ) {
+                    filesystem::remove_file(cache_temp_path_(e.url));
+                }
+            } catch (...) {
+                success = false;
+            }
+
+            std::lock_guard<std::mutex> guard(mutex_);
+            caching_.erase(e.url);
+            return success;
+        }
+    private:
+        response_ptr perform_(const str& key, net::request_builder rb) {
+            std::shared_future<response_ptr> future;
+            std::promise<response_ptr> promise;
+            bool performer = false;
+
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                const auto iter = requests_.find(key);
+                if ( iter != requests_.end() ) {
+                    future = iter->second;
+                } else {
+                    future = promise.get_future().share();
+                    requests_.emplace(key, future);
+                    performer = true;
+                }
+            }
+
+            // concurrent requests of the same data wait for the first one
+            if ( performer ) {
+                E2D_PROFILER_SCOPE_EX("vfs.http_request", {
+                    {"request", key}
+                });
+
+                response_ptr response;
+                try {
+                    net::request request = rb.send();
+                    if ( request.wait() == net::req_status::done ) {
+                        response = std::make_shared<net::response>(request.take());
+                    }
+                } catch (...) {
+                    // nothing, failed requests are reported by an empty response
+                }
+
+                promise.set_value(response);
+
+                std::lock_guard<std::mutex> guard(mutex_);
+                requests_.erase(key);
+            }
+
+            return future.get();
+        }
+
+        bool load_cached_entry_(const str& url, entry& dst) const {
+            if ( cache_directory_.empty() ) {
+                return false;
+            }
+
+            str meta;
+            if ( !filesystem::try_read_all(meta, cache_meta_path_(url)) ) {
+                return false;
+            }
+
+            vector<str> lines;
+            for ( std::size_t first = 0; first < meta.size(); ) {
+                const std::size_t last = math::min(meta.find('\n', first), meta.size());
+                lines.emplace_back(meta, first, last - first);
+                first = last + 1;
+            }
+
+            entry e;
+            if ( lines.size() != 4u
+                || lines[0] != http_cache_signature
+                || lines[1] != url
+                || !strings::try_parse(lines[3], e.size) )
+            {
+                return false;
+            }
+
+            read_file_uptr data = make_read_file(cache_data_path_(url));
+            if ( !data || data->length() != e.size ) {
+                return false;
+            }
+
+            e.url = url;
+            e.etag = std::move(lines[2]);
+            e.cached = true;
+            dst = std::move(e);
+            return true;
+        }
+
+        str cache_data_path_(const str& url) const {
+            return path::combine(cache_directory_, cache_file_name(url) + ".data");
+        }
+
+        str cache_meta_path_(const str& url) const {
+            return path::combine(cache_directory_, cache_file_name(url) + ".meta");
+        }
+
+        str cache_temp_path_(const str& url) const {
+            return path::combine(cache_directory_, cache_file_name(url) + ".temp");
+        }
+    private:
+        str scheme_;
+        str cache_directory_;
+        std::mutex mutex_;
+        flat_set<str> caching_;
+        flat_map<str, std::shared_future<response_ptr>> requests_;
+    };
+
+    //
+    // http_file_source::state::range_stream
+    //
+
+    class http_file_source::state::range_stream final : public input_stream {
+    public:
+        range_stream(std::shared_ptr<state> owner, entry e)
+        : owner_(std::move(owner))
+        , entry_(std::move(e))
+        , cache_stream_(owner_->begin_caching(entry_)) {}
+
+        ~range_stream() noexcept final {
+            if ( cache_stream_ ) {
+                cache_stream_.reset();
+                owner_->end_caching(entry_, false);
+            }
+        }
+
+        std::size_t read(void* dst, std::size_t size) final {
+            std::size_t read_bytes = 0;
+            while ( read_bytes < size && pos_ < entry_.size ) {
+                if ( pos_ < block_first_ || pos_ >= block_first_ + block_.size() ) {
+                    load_block_(pos_);
+                }
+                const std::size_t block_offset = pos_ - block_first_;
+                const std::size_t block_bytes = math::min(
+                    size - read_bytes,
+                    block_.size() - block_offset);
+                std::memcpy(
+                    static_cast<u8*>(dst) + read_bytes,
+                    block_.data() + block_offset,
+                    block_bytes);
+                read_bytes += block_bytes;
+                pos_ += block_bytes;
+            }
+            return read_bytes;
+        }
+
+        std::size_t seek(std::ptrdiff_t offset, bool relative) final {
+            if ( offset < 0 ) {
+                const std::size_t uoffset = math::abs_to_unsigned(offset);
+                if ( !relative || uoffset > pos_ ) {
+                    throw bad_stream_operation();
+                }
+                pos_ -= uoffset;
+                return pos_;
+            } else {
+                const std::size_t uoffset = math::abs_to_unsigned(offset);
+                const std::size_t available_bytes = relative
+                    ? entry_.size - pos_
+                    : entry_.size;
+                if ( uoffset > available_bytes ) {
+                    throw bad_stream_operation();
+                }
+                pos_ = uoffset + (entry_.size - available_bytes);
+                return pos_;
+            }
+        }
+
+        std::size_t tell() const final {
+            return pos_;
+        }
+
+        std::size_t length() const noexcept final {
+            return entry_.size;
+        }
+    private:
+        void load_block_(std::size_t pos) {
+            const std::size_t first = pos - pos % http_block_size;
+            const std::size_t last = math::min(first + http_block_size, entry_.size) - 1u;
+            block_ = owner_->fetch_range(entry_, first, last, block_first_);
+            cache_block_();
+        }
+
+        void cache_block_() noexcept {
+            if ( !cache_stream_ || block_first_ > cached_bytes_ ) {
+                // only sequentially read files are cached
+                drop_caching_();
+                return;
+            }
+
+            if ( block_first_ + block_.size() <= cached_bytes_ ) {
+                return;
+            }
+
+            const std::size_t skip_bytes = cached_bytes_ - block_first_;
+            const bool success = output_sequence(*cache_stream_)
+                .write(block_.data() + skip_bytes, block_.size() - skip_bytes)
+                .success();
+
+            if ( !success ) {
+                drop_caching_();
+                return;
+            }
+
+            cached_bytes_ = block_first_ + block_.size();
+            if ( cached_bytes_ == entry_.size ) {
+                const bool flushed = output_sequence(*cache_stream_)
+                    .flush()
+                    .success();
+                cache_stream_.reset();
+                owner_->end_caching(entry_, flushed);
+            }
+        }
+
+        void drop_caching_() noexcept {
+            if ( cache_stream_ ) {
+                cache_stream_.reset();
+                owner_->end_caching(entry_, false);
+            }
+        }
+    private:
+        std::shared_ptr<state> owner_;
+        entry entry_;
+        std::size_t pos_{0u};
+        buffer block_;
+        std::size_t block_first_{0u};
+        output_stream_uptr cache_stream_;
+        std::size_t cached_bytes_{0u};
+    };
+
+    input_stream_uptr http_file_source::state::open(str_view path) {
+        std::optional<entry> e = validate(path);
+        if ( !e ) {
+            return nullptr;
+        }
+
+        if ( e->cached ) {
+            if ( read_file_uptr file = make_read_file(cache_data_path_(e->url)) ) {
+                return file;
+            }
+        }
+
+        return std::make_unique<range_stream>(shared_from_this(), std::move(*e));
+    }
+
+    //
+    // http_file_source
+    //
+
+    http_file_source::http_file_source(str scheme, str cache_directory)
+    : state_(std::make_shared<state>(std::move(scheme), std::move(cache_directory))) {}
+    http_file_source::~http_file_source() noexcept = default;
+
+    bool http_file_source::valid() const noexcept {
+        return modules::is_initialized<network>();
+    }
+
+    bool http_file_source::exists(str_view path) const {
+        return !!state_->validate(path);
+    }
+
+    input_stream_uptr http_file_source::read(str_view path) const {
+        try {
+            return state_->open(path);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    output_stream_uptr http_file_source::write(str_view path, bool append) const {
+        E2D_UNUSED(path, append);
+        return nullptr;
+    }
+
+    bool http_file_source::trace(str_view path, filesystem::trace_func func) const {
+        E2D_UNUSED(path, func);
+        return false;
+    }
+
+    bool http_file_source::prefetch(str_view path) const {
+        try {
+            return state_->prefetch(path);
+        } catch (...) {
+            return false;
+        }
+    }
+}
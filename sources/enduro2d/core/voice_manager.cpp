@@ -0,0 +1,445 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/core/voice_manager.hpp>
+
+#include <enduro2d/core/debug.hpp>
+#include <enduro2d/core/profiler.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    // source volumes are not updated for smaller gain changes
+    const f32 source_gain_epsilon = 0.001f;
+
+    f32 category_attenuation(const voice_manager::category& c, f32 distance) noexcept {
+        return c.max_distance() > 0.f
+            ? math::clamp(1.f - distance / c.max_distance(), 0.f, 1.f)
+            : 1.f;
+    }
+}
+
+namespace e2d
+{
+    //
+    // sound_voice
+    //
+
+    sound_voice::sound_voice(
+        const sound_stream_ptr& stream,
+        str_hash category,
+        i32 priority)
+    : stream_(stream)
+    , category_(category)
+    , priority_(priority)
+    , duration_(stream ? stream->duration() : 0.f) {}
+
+    sound_voice::~sound_voice() noexcept {
+        release_source_();
+    }
+
+    const sound_stream_ptr& sound_voice::stream() const noexcept {
+        return stream_;
+    }
+
+    str_hash sound_voice::category() const noexcept {
+        return category_;
+    }
+
+    i32 sound_voice::priority() const noexcept {
+        return priority_;
+    }
+
+    void sound_voice::play() noexcept {
+        state_ = states::playing;
+        position_ = 0.f;
+        if ( source_ ) {
+            source_->play();
+        }
+    }
+
+    void sound_voice::stop() noexcept {
+        state_ = states::stopped;
+        position_ = 0.f;
+        release_source_();
+    }
+
+    void sound_voice::pause() noexcept {
+        if ( state_ != states::playing ) {
+            return;
+        }
+        state_ = states::paused;
+        if ( source_ ) {
+            position_ = source_->position();
+            release_source_();
+        }
+    }
+
+    void sound_voice::resume() noexcept {
+        if ( state_ == states::paused ) {
+            state_ = states::playing;
+        }
+    }
+
+    sound_voice::states sound_voice::state() const noexcept {
+        return state_;
+    }
+
+    bool sound_voice::playing() const noexcept {
+        return state_ == states::playing;
+    }
+
+    void sound_voice::looping(bool value) noexcept {
+        looping_ = value;
+        if ( source_ ) {
+            source_->looping(value);
+        }
+    }
+
+    bool sound_voice::looping() const noexcept {
+        return looping_;
+    }
+
+    void sound_voice::volume(f32 value) noexcept {
+        volume_ = math::max(value, 0.f);
+    }
+
+    f32 sound_voice::volume() const noexcept {
+        return volume_;
+    }
+
+    void sound_voice::distance(f32 value) noexcept {
+        distance_ = math::max(value, 0.f);
+    }
+
+    f32 sound_voice::distance() const noexcept {
+        return distance_;
+    }
+
+    void sound_voice::position(f32 value) noexcept {
+        position_ = math::clamp(value, 0.f, duration_);
+        if ( source_ ) {
+            source_->position(position_);
+        }
+    }
+
+    f32 sound_voice::position() const noexcept {
+        return source_
+            ? source_->position()
+            : position_;
+    }
+
+    f32 sound_voice::duration() const noexcept {
+        return duration_;
+    }
+
+    bool sound_voice::is_virtual() const noexcept {
+        return state_ == states::playing && !source_;
+    }
+
+    f32 sound_voice::audibility() const noexcept {
+        return audibility_;
+    }
+
+    bool sound_voice::audible() const noexcept {
+        return audible_;
+    }
+
+    void sound_voice::release_source_() noexcept {
+        if ( source_ ) {
+            source_->stop();
+            source_.reset();
+            source_gain_ = -1.f;
+        }
+    }
+
+    //
+    // voice_manager::category
+    //
+
+    voice_manager::category& voice_manager::category::max_voices(u32 value) noexcept {
+        max_voices_ = value;
+        return *this;
+    }
+
+    voice_manager::category& voice_manager::category::volume(f32 value) noexcept {
+        volume_ = value;
+        return *this;
+    }
+
+    voice_manager::category& voice_manager::category::max_distance(f32 value) noexcept {
+        max_distance_ = value;
+        return *this;
+    }
+
+    u32 voice_manager::category::max_voices() const noexcept {
+        return max_voices_;
+    }
+
+    f32 voice_manager::category::volume() const noexcept {
+        return volume_;
+    }
+
+    f32 voice_manager::category::max_distance() const noexcept {
+        return max_distance_;
+    }
+
+    //
+    // voice_manager::internal_state
+    //
+
+    class voice_manager::internal_state final : private e2d::noncopyable {
+    public:
+        internal_state(debug& d, audio& a)
+        : debug_(d)
+        , audio_(a) {}
+        ~internal_state() noexcept = default;
+    public:
+        debug& dbg() const noexcept {
+            return debug_;
+        }
+
+        sound_voice_ptr create_voice(
+            const sound_stream_ptr& stream,
+            str_hash category,
+            i32 priority)
+        {
+            if ( !stream ) {
+                debug_.error("VOICE_MANAGER: stream is null");
+                return nullptr;
+            }
+            auto voice = std::make_shared<sound_voice>(stream, category, priority);
+            voices_.push_back(voice);
+            return voice;
+        }
+
+        void register_category(str_hash name, const category& params) {
+            categories_[name] = params;
+        }
+
+        const category& find_category(str_hash name) const noexcept {
+            const auto iter = categories_.find(name);
+            return iter != categories_.end()
+                ? iter->second
+                : default_category_;
+        }
+
+        void max_real_voices(u32 value) noexcept {
+            max_real_voices_ = value;
+        }
+
+        u32 max_real_voices() const noexcept {
+            return max_real_voices_;
+        }
+
+        void audibility_threshold(f32 value) noexcept {
+            audibility_threshold_ = value;
+        }
+
+        f32 audibility_threshold() const noexcept {
+            return audibility_threshold_;
+        }
+
+        const statistics& stats() const noexcept {
+            return stats_;
+        }
+
+        void frame_tick(f32 dt) {
+            E2D_PROFILER_SCOPE("voice_manager.frame_tick");
+
+            // stopped voices without external owners are not needed anymore,
+            // looping ones would never stop, so nobody could stop them later
+            voices_.erase(
+                std::remove_if(voices_.begin(), voices_.end(), [](const sound_voice_ptr& v){
+                    return v.use_count() == 1 && (!v->playing() || v->looping_);
+                }),
+                voices_.end());
+
+            candidates_.clear();
+            for ( const sound_voice_ptr& v : voices_ ) {
+                const category& c = find_category(v->category_);
+                if ( v->playing() ) {
+                    advance_voice_(*v, dt);
+                }
+                v->audibility_ = v->playing()
+                    ? v->volume_ * c.volume() * category_attenuation(c, v->distance_)
+                    : 0.f;
+                v->audible_ = false;
+                if ( v->playing() ) {
+                    candidates_.push_back(v.get());
+                }
+            }
+
+            std::stable_sort(candidates_.begin(), candidates_.end(), [](
+                const sound_voice* l,
+                const sound_voice* r) noexcept
+            {
+                return l->priority_ != r->priority_
+                    ? l->priority_ > r->priority_
+                    : l->audibility_ > r->audibility_;
+            });
+
+            statistics stats;
+            stats.voices = voices_.size();
+            category_voices_.clear();
+
+            for ( sound_voice* v : candidates_ ) {
+                const category& c = find_category(v->category_);
+                u32& category_voices = category_voices_[v->category_];
+
+                v->audible_ =
+                    v->audibility_ >= audibility_threshold_ &&
+                    stats.audible_voices < max_real_voices_ &&
+                    category_voices < c.max_voices();
+
+                // a backend without free sources does not pass
+                // the slot of an audible voice to a lower ranked one
+                if ( v->audible_ ) {
+                    ++stats.audible_voices;
+                    ++category_voices;
+                }
+
+                if ( v->audible_ && (v->source_ || realize_voice_(*v, stats)) ) {
+                    if ( math::abs(v->source_gain_ - v->audibility_) > source_gain_epsilon ) {
+                        v->source_->volume(v->audibility_);
+                        v->source_gain_ = v->audibility_;
+                    }
+                    ++stats.real_voices;
+                } else {
+                    if ( v->source_ ) {
+                        v->position_ = v->source_->position();
+                        v->release_source_();
+                        ++stats.virtualized_voices;
+                    }
+                    ++stats.virtual_voices;
+                }
+            }
+
+            if ( stats.real_voices != stats_.real_voices
+                || stats.virtual_voices != stats_.virtual_voices )
+            {
+                E2D_PROFILER_GLOBAL_EVENT_EX("voice_manager.voices", {
+                    {"real", std::to_string(stats.real_voices)},
+                    {"virtual", std::to_string(stats.virtual_voices)}});
+            }
+
+            stats_ = stats;
+        }
+    private:
+        void advance_voice_(sound_voice& v, f32 dt) noexcept {
+            if ( v.source_ ) {
+                if ( v.source_->playing() ) {
+                    v.position_ = v.source_->position();
+                } else {
+                    v.stop();
+                }
+                return;
+            }
+
+            // virtual voices only track the time they would have played
+            v.position_ += dt;
+            if ( v.position_ >= v.duration_ ) {
+                if ( v.looping_ && v.duration_ > 0.f ) {
+                    v.position_ = std::fmod(v.position_, v.duration_);
+                } else {
+                    v.stop();
+                }
+            }
+        }
+
+        bool realize_voice_(sound_voice& v, statistics& stats) {
+            if ( !audio_.initialized() ) {
+                return false;
+            }
+
+            sound_source_ptr source = audio_.create_source(v.stream_);
+            if ( !source ) {
+                return false;
+            }
+
+            source->looping(v.looping_);
+            source->volume(v.audibility_);
+            source->play();
+            if ( v.position_ > 0.f ) {
+                source->position(v.position_);
+            }
+
+            v.source_ = std::move(source);
+            v.source_gain_ = v.audibility_;
+            ++stats.realized_voices;
+            return true;
+        }
+    private:
+        debug& debug_;
+        audio& audio_;
+        vector<sound_voice_ptr> voices_;
+        vector<sound_voice*> candidates_;
+        flat_map<str_hash, category> categories_;
+        flat_map<str_hash, u32> category_voices_;
+        category default_category_;
+        u32 max_real_voices_{32u};
+        f32 audibility_threshold_{0.001f};
+        statistics stats_;
+    };
+
+    //
+    // voice_manager
+    //
+
+    voice_manager::voice_manager(debug& d, audio& a)
+    : state_(new internal_state(d, a)) {}
+    voice_manager::~voice_manager() noexcept = default;
+
+    sound_voice_ptr voice_manager::create_voice(
+        const sound_stream_ptr& stream,
+        str_hash category,
+        i32 priority)
+    {
+        return state_->create_voice(stream, category, priority);
+    }
+
+    voice_manager& voice_manager::register_category(str_hash name, const category& params) {
+        state_->register_category(name, params);
+        return *this;
+    }
+
+    const voice_manager::category& voice_manager::find_category(str_hash name) const noexcept {
+        return state_->find_category(name);
+    }
+
+    voice_manager& voice_manager::max_real_voices(u32 value) noexcept {
+        state_->max_real_voices(value);
+        return *this;
+    }
+
+    u32 voice_manager::max_real_voices() const noexcept {
+        return state_->max_real_voices();
+    }
+
+    voice_manager& voice_manager::audibility_threshold(f32 value) noexcept {
+        state_->audibility_threshold(value);
+        return *this;
+    }
+
+    f32 voice_manager::audibility_threshold() const noexcept {
+        return state_->audibility_threshold();
+    }
+
+    const voice_manager::statistics& voice_manager::stats() const noexcept {
+        return state_->stats();
+    }
+
+    void voice_manager::frame_tick(f32 dt) noexcept {
+        try {
+            state_->frame_tick(dt);
+        } catch ( const std::exception& e ) {
+            state_->dbg().error("VOICE_MANAGER: Failed to update voices:\n"
+                "--> Exception: %0",
+                e.what());
+        }
+    }
+}
@@ -718,6 +718,11 @@ namespace e2d
         glfwMakeContextCurrent(state_->window.get());
     }
 
+    void window::unbind_context() noexcept {
+        std::lock_guard<std::recursive_mutex> guard(state_->rmutex);
+        glfwMakeContextCurrent(nullptr);
+    }
+
     void window::swap_buffers() noexcept {
         E2D_PROFILER_SCOPE("window.swap_buffers");
         std::lock_guard<std::recursive_mutex> guard(state_->rmutex);
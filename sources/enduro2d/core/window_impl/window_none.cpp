@@ -186,6 +186,9 @@ namespace e2d
     void window::bind_context() noexcept {
     }
 
+    void window::unbind_context() noexcept {
+    }
+
     void window::swap_buffers() noexcept {
     }
 
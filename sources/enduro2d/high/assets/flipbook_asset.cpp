@@ -70,20 +70,15 @@ namespace
     })json";
 
     const rapidjson::SchemaDocument& flipbook_asset_schema() {
-        static std::mutex mutex;
-        static std::unique_ptr<rapidjson::SchemaDocument> schema;
-
-        std::lock_guard<std::mutex> guard(mutex);
-        if ( !schema ) {
+        static const std::unique_ptr<rapidjson::SchemaDocument> schema = [](){
             rapidjson::Document doc;
             if ( doc.Parse(flipbook_asset_schema_source).HasParseError() ) {
                 the<debug>().error("ASSETS: Failed to parse flipbook asset schema");
                 throw flipbook_asset_loading_exception();
             }
             json_utils::add_common_schema_definitions(doc);
-            schema = std::make_unique<rapidjson::SchemaDocument>(doc);
-        }
-
+            return std::make_unique<rapidjson::SchemaDocument>(doc);
+        }();
         return *schema;
     }
 
@@ -215,27 +210,9 @@ namespace e2d
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& flipbook_data){
             return the<deferrer>().do_in_worker_thread([address, flipbook_data](){
-                const rapidjson::Document& doc = *flipbook_data->content();
-                rapidjson::SchemaValidator validator(flipbook_asset_schema());
-
-                if ( doc.Accept(validator) ) {
-                    return;
+                if ( !flipbook_data->validate(flipbook_asset_schema(), address) ) {
+                    throw flipbook_asset_loading_exception();
                 }
-
-                rapidjson::StringBuffer sb;
-                if ( validator.GetInvalidDocumentPointer().StringifyUriFragment(sb) ) {
-                    the<debug>().error("ASSET: Failed to validate asset json:\n"
-                        "--> Address: %0\n"
-                        "--> Invalid schema keyword: %1\n"
-                        "--> Invalid document pointer: %2",
-                        address,
-                        validator.GetInvalidSchemaKeyword(),
-                        sb.GetString());
-                } else {
-                    the<debug>().error("ASSET: Failed to validate asset json");
-                }
-
-                throw flipbook_asset_loading_exception();
             })
             .then([&library, parent_address, flipbook_data](){
                 return parse_flipbook(
@@ -16,6 +16,30 @@ namespace
             return "image asset loading exception";
         }
     };
+    void post_process_image(
+        image& content,
+        const image_conversion_options& conversion,
+        bool expand_rgb)
+    {
+        const image_data_format format = expand_rgb && content.format() == image_data_format::rgb8
+            ? image_data_format::rgba8
+            : content.format();
+
+        if ( conversion.empty() && format == content.format() ) {
+            return;
+        }
+
+        // compressed images are uploaded as is
+        if ( !images::check_convert_image_support(content, format) ) {
+            return;
+        }
+
+        image converted;
+        if ( !images::try_convert_image(converted, content, format, conversion) ) {
+            throw image_asset_loading_exception();
+        }
+        content = std::move(converted);
+    }
 }
 
 namespace e2d
@@ -25,11 +49,15 @@ namespace e2d
     {
         return library.load_asset_async<binary_asset>(address)
         .then([
-            address = str(address)
+            address = str(address),
+            conversion = library.image_conversion(),
+            expand_rgb = library.expand_rgb_images()
         ](const binary_asset::load_result& image_data){
             return the<deferrer>().do_in_worker_thread([
                 image_data,
-                address = std::move(address)
+                address = std::move(address),
+                conversion = std::move(conversion),
+                expand_rgb
             ](){
                 E2D_PROFILER_SCOPE_EX("image_asset.load_async", {
                     {"address", address}
@@ -38,6 +66,7 @@ namespace e2d
                 if ( !images::try_load_image(content, image_data->content()) ) {
                     throw image_asset_loading_exception();
                 }
+                post_process_image(content, conversion, expand_rgb);
                 return image_asset::create(std::move(content));
             });
         });
@@ -5,7 +5,6 @@
  ******************************************************************************/
 
 #include <enduro2d/high/assets/json_asset.hpp>
-#include <enduro2d/high/assets/text_asset.hpp>
 
 namespace
 {
@@ -16,6 +15,33 @@ namespace
             return "json asset loading exception";
         }
     };
+
+    //
+    // validation_cache
+    //
+
+    class validation_cache final : private noncopyable {
+    public:
+        using key_type = std::pair<const rapidjson::SchemaDocument*, sha256_digest>;
+    public:
+        bool contains(const key_type& key) const {
+            std::lock_guard<std::mutex> guard(mutex_);
+            return validated_.count(key) > 0u;
+        }
+
+        void store(const key_type& key) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            validated_.insert(key);
+        }
+    private:
+        mutable std::mutex mutex_;
+        flat_set<key_type> validated_;
+    };
+
+    validation_cache& json_validation_cache() {
+        static validation_cache cache;
+        return cache;
+    }
 }
 
 namespace e2d
@@ -23,23 +49,76 @@ namespace e2d
     json_asset::load_async_result json_asset::load_async(
         const library& library, str_view address)
     {
-        return library.load_asset_async<text_asset>(address)
+        const auto asset_url = library.root() / address;
+        return the<vfs>().load_as_string_async(asset_url)
         .then([
             address = str(address)
-        ](const text_asset::load_result& json_data){
+        ](auto&& content){
             return the<deferrer>().do_in_worker_thread([
-                json_data,
+                content = std::forward<decltype(content)>(content),
                 address = std::move(address)
-            ](){
+            ]() mutable {
                 E2D_PROFILER_SCOPE_EX("json_asset.parsing", {
                     {"address", address}
                 });
-                auto json = std::make_shared<rapidjson::Document>();
-                if ( json->Parse(json_data->content().c_str()).HasParseError() ) {
+                const sha256_digest digest = digests::sha256(str_view(content));
+                json_uptr json = json_utils::parse_insitu(std::move(content));
+                if ( !json ) {
                     throw json_asset_loading_exception();
                 }
-                return json_asset::create(std::move(json));
+                return json_asset::create(std::move(json), digest);
             });
         });
     }
+
+    json_asset::load_result json_asset::create(json_uptr content, const sha256_digest& content_digest) {
+        auto result = create(std::move(content));
+        result->content_digest_ = content_digest;
+        return result;
+    }
+
+    const std::optional<sha256_digest>& json_asset::content_digest() const noexcept {
+        return content_digest_;
+    }
+
+    bool json_asset::validate(const rapidjson::SchemaDocument& schema, str_view address) const {
+        E2D_PROFILER_SCOPE_EX("json_asset.validation", {
+            {"address", str(address)}
+        });
+
+        const std::optional<validation_cache::key_type> cache_key = content_digest_
+            ? std::make_optional(std::make_pair(&schema, *content_digest_))
+            : std::nullopt;
+
+        if ( cache_key && json_validation_cache().contains(*cache_key) ) {
+            return true;
+        }
+
+        if ( !content() ) {
+            return false;
+        }
+
+        rapidjson::SchemaValidator validator(schema);
+        if ( content()->Accept(validator) ) {
+            if ( cache_key ) {
+                json_validation_cache().store(*cache_key);
+            }
+            return true;
+        }
+
+        rapidjson::StringBuffer sb;
+        if ( validator.GetInvalidDocumentPointer().StringifyUriFragment(sb) ) {
+            the<debug>().error("ASSET: Failed to validate asset json:\n"
+                "--> Address: %0\n"
+                "--> Invalid schema keyword: %1\n"
+                "--> Invalid document pointer: %2",
+                address,
+                validator.GetInvalidSchemaKeyword(),
+                sb.GetString());
+        } else {
+            the<debug>().error("ASSET: Failed to validate asset json");
+        }
+
+        return false;
+    }
 }
@@ -339,20 +339,15 @@ namespace
         })json";
 
     const rapidjson::SchemaDocument& material_asset_schema() {
-        static std::mutex mutex;
-        static std::unique_ptr<rapidjson::SchemaDocument> schema;
-
-        std::lock_guard<std::mutex> guard(mutex);
-        if ( !schema ) {
+        static const std::unique_ptr<rapidjson::SchemaDocument> schema = [](){
             rapidjson::Document doc;
             if ( doc.Parse(material_asset_schema_source).HasParseError() ) {
                 the<debug>().error("ASSETS: Failed to parse material asset schema");
                 throw material_asset_loading_exception();
             }
             json_utils::add_common_schema_definitions(doc);
-            schema = std::make_unique<rapidjson::SchemaDocument>(doc);
-        }
-
+            return std::make_unique<rapidjson::SchemaDocument>(doc);
+        }();
         return *schema;
     }
 
@@ -1050,27 +1045,9 @@ namespace e2d
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& material_data){
             return the<deferrer>().do_in_worker_thread([address, material_data](){
-                const rapidjson::Document& doc = *material_data->content();
-                rapidjson::SchemaValidator validator(material_asset_schema());
-
-                if ( doc.Accept(validator) ) {
-                    return;
+                if ( !material_data->validate(material_asset_schema(), address) ) {
+                    throw material_asset_loading_exception();
                 }
-
-                rapidjson::StringBuffer sb;
-                if ( validator.GetInvalidDocumentPointer().StringifyUriFragment(sb) ) {
-                    the<debug>().error("ASSET: Failed to validate asset json:\n"
-                        "--> Address: %0\n"
-                        "--> Invalid schema keyword: %1\n"
-                        "--> Invalid document pointer: %2",
-                        address,
-                        validator.GetInvalidSchemaKeyword(),
-                        sb.GetString());
-                } else {
-                    the<debug>().error("ASSET: Failed to validate asset json");
-                }
-
-                throw material_asset_loading_exception();
             })
             .then([&library, parent_address, material_data](){
                 return parse_material(
@@ -65,21 +65,121 @@ namespace
         }
     })json";
 
-    const rapidjson::SchemaDocument& prefab_asset_schema() {
-        static std::mutex mutex;
-        static std::unique_ptr<rapidjson::SchemaDocument> schema;
+    // children with fewer nodes than this are grouped into one job,
+    // a smaller job costs more to schedule than to parse
+    const std::size_t min_prefab_job_nodes = 256u;
+
+    // counts nodes of the subtree, but stops at 'limit', so grouping
+    // children into jobs doesn't walk whole subtrees at every depth
+    std::size_t count_prefab_nodes(
+        const rapidjson::Value& root,
+        std::size_t limit) noexcept
+    {
+        std::size_t result = 1u;
+
+        const auto count_children = [&result, limit](const rapidjson::Value& children_root){
+            for ( rapidjson::SizeType i = 0; i < children_root.Size() && result < limit; ++i ) {
+                result += count_prefab_nodes(children_root[i], limit - result);
+            }
+        };
+
+        if ( result < limit && root.HasMember("children") ) {
+            count_children(root["children"]);
+        }
+
+        if ( result < limit && root.HasMember("mod_children") ) {
+            count_children(root["mod_children"]);
+        }
+
+        return result;
+    }
+
+    // F: void(rapidjson::SizeType index)
+    // splits children into consecutive ranges of at least 'min_prefab_job_nodes'
+    // nodes and processes them by worker jobs, the current thread takes the first
+    // range and helps the workers while waiting, so nested calls don't starve
+    template < typename F >
+    void for_each_prefab_child(const rapidjson::Value& children_root, F&& f) {
+        vector<std::pair<rapidjson::SizeType, rapidjson::SizeType>> ranges;
+        {
+            std::size_t range_nodes = 0u;
+            rapidjson::SizeType range_first = 0u;
+            for ( rapidjson::SizeType i = 0; i < children_root.Size(); ++i ) {
+                range_nodes += count_prefab_nodes(
+                    children_root[i],
+                    min_prefab_job_nodes - range_nodes);
+                if ( range_nodes >= min_prefab_job_nodes ) {
+                    ranges.emplace_back(range_first, i + 1u);
+                    range_first = i + 1u;
+                    range_nodes = 0u;
+                }
+            }
+            if ( range_first < children_root.Size() ) {
+                ranges.emplace_back(range_first, children_root.Size());
+            }
+        }
+
+        const auto process_range = [&f](
+            const std::pair<rapidjson::SizeType, rapidjson::SizeType>& range)
+        {
+            for ( rapidjson::SizeType i = range.first; i < range.second; ++i ) {
+                f(i);
+            }
+        };
+
+        if ( ranges.size() < 2u ) {
+            for ( const auto& range : ranges ) {
+                process_range(range);
+            }
+            return;
+        }
+
+        deferrer& d = the<deferrer>();
+
+        vector<stdex::promise<void>> jobs;
+        jobs.reserve(ranges.size() - 1u);
+        for ( std::size_t i = 1; i < ranges.size(); ++i ) {
+            jobs.push_back(d.do_in_worker_thread([&process_range, range = ranges[i]](){
+                process_range(range);
+            }));
+        }
 
-        std::lock_guard<std::mutex> guard(mutex);
-        if ( !schema ) {
+        // the jobs refer to the locals, so all of them have to be finished
+        // before leaving, the first error in children order is rethrown
+        std::exception_ptr error;
+
+        try {
+            process_range(ranges.front());
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        for ( const stdex::promise<void>& job : jobs ) {
+            d.active_safe_wait_promise(job);
+            if ( !error ) {
+                try {
+                    job.get();
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+        }
+
+        if ( error ) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    const rapidjson::SchemaDocument& prefab_asset_schema() {
+        static const std::unique_ptr<rapidjson::SchemaDocument> schema = [](){
             rapidjson::Document doc;
             if ( doc.Parse(prefab_asset_schema_source).HasParseError() ) {
                 the<debug>().error("ASSETS: Failed to parse prefab asset schema");
                 throw prefab_asset_loading_exception();
             }
             json_utils::add_common_schema_definitions(doc);
-            schema = std::make_unique<rapidjson::SchemaDocument>(doc);
-        }
-
+            return std::make_unique<rapidjson::SchemaDocument>(doc);
+        }();
         return *schema;
     }
 
@@ -95,8 +195,18 @@ namespace
 
         if ( root.HasMember("children") ) {
             const rapidjson::Value& children_root = root["children"];
-            for ( rapidjson::SizeType i = 0; i < children_root.Size(); ++i ) {
-                collect_dependencies(parent_address, children_root[i], dependencies);
+
+            vector<asset_dependencies> children_dependencies(children_root.Size());
+            for_each_prefab_child(children_root, [
+                parent_address,
+                &children_root,
+                &children_dependencies
+            ](rapidjson::SizeType i){
+                collect_dependencies(parent_address, children_root[i], children_dependencies[i]);
+            });
+
+            for ( asset_dependencies& child_dependencies : children_dependencies ) {
+                dependencies.merge(std::move(child_dependencies));
             }
         }
 
@@ -195,16 +305,22 @@ namespace
         if ( root.HasMember("children") ) {
             const rapidjson::Value& children_root = root["children"];
 
-            for ( rapidjson::SizeType i = 0; i < children_root.Size(); ++i ) {
-                const rapidjson::Value& child_root = children_root[i];
-
-                prefab child;
+            vector<prefab> children(children_root.Size());
+            for_each_prefab_child(children_root, [
+                parent_address,
+                &children_root,
+                &children,
+                &dependencies
+            ](rapidjson::SizeType i){
                 parse_prefab_inplace(
-                    child,
+                    children[i],
                     parent_address,
-                    child_root,
+                    children_root[i],
                     dependencies);
+            });
 
+            content.children().reserve(content.children().size() + children.size());
+            for ( prefab& child : children ) {
                 content.children().push_back(std::move(child));
             }
         }
@@ -287,35 +403,19 @@ namespace e2d
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& prefab_data){
             return the<deferrer>().do_in_worker_thread([address, prefab_data](){
-                const rapidjson::Document& doc = *prefab_data->content();
-                rapidjson::SchemaValidator validator(prefab_asset_schema());
-
-                if ( doc.Accept(validator) ) {
-                    return;
-                }
-
-                rapidjson::StringBuffer sb;
-                if ( validator.GetInvalidDocumentPointer().StringifyUriFragment(sb) ) {
-                    the<debug>().error("ASSET: Failed to validate asset json:\n"
-                        "--> Address: %0\n"
-                        "--> Invalid schema keyword: %1\n"
-                        "--> Invalid document pointer: %2",
-                        address,
-                        validator.GetInvalidSchemaKeyword(),
-                        sb.GetString());
-                } else {
-                    the<debug>().error("ASSET: Failed to validate asset json");
+                if ( !prefab_data->validate(prefab_asset_schema(), address) ) {
+                    throw prefab_asset_loading_exception();
                 }
-
-                throw prefab_asset_loading_exception();
             })
             .then([&library, parent_address, prefab_data](){
                 return collect_dependencies(
                     library, parent_address, *prefab_data->content());
             })
             .then([parent_address, prefab_data](const asset_group& dependencies){
-                return prefab_asset::create(parse_prefab(
-                    parent_address, *prefab_data->content(), dependencies));
+                return the<deferrer>().do_in_worker_thread([parent_address, prefab_data, dependencies](){
+                    return prefab_asset::create(parse_prefab(
+                        parent_address, *prefab_data->content(), dependencies));
+                });
             });
         });
     }
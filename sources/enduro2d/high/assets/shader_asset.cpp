@@ -31,20 +31,15 @@ namespace
         })json";
 
     const rapidjson::SchemaDocument& shader_asset_schema() {
-        static std::mutex mutex;
-        static std::unique_ptr<rapidjson::SchemaDocument> schema;
-
-        std::lock_guard<std::mutex> guard(mutex);
-        if ( !schema ) {
+        static const std::unique_ptr<rapidjson::SchemaDocument> schema = [](){
             rapidjson::Document doc;
             if ( doc.Parse(shader_asset_schema_source).HasParseError() ) {
                 the<debug>().error("ASSETS: Failed to parse shader asset schema");
                 throw shader_asset_loading_exception();
             }
             json_utils::add_common_schema_definitions(doc);
-            schema = std::make_unique<rapidjson::SchemaDocument>(doc);
-        }
-
+            return std::make_unique<rapidjson::SchemaDocument>(doc);
+        }();
         return *schema;
     }
 
@@ -104,27 +99,9 @@ namespace e2d
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& shader_data){
             return the<deferrer>().do_in_worker_thread([address, shader_data](){
-                const rapidjson::Document& doc = *shader_data->content();
-                rapidjson::SchemaValidator validator(shader_asset_schema());
-
-                if ( doc.Accept(validator) ) {
-                    return;
-                }
-
-                rapidjson::StringBuffer sb;
-                if ( validator.GetInvalidDocumentPointer().StringifyUriFragment(sb) ) {
-                    the<debug>().error("ASSET: Failed to validate asset json:\n"
-                        "--> Address: %0\n"
-                        "--> Invalid schema keyword: %1\n"
-                        "--> Invalid document pointer: %2",
-                        address,
-                        validator.GetInvalidSchemaKeyword(),
-                        sb.GetString());
-                } else {
-                    the<debug>().error("ASSET: Failed to validate asset json");
+                if ( !shader_data->validate(shader_asset_schema(), address) ) {
+                    throw shader_asset_loading_exception();
                 }
-
-                throw shader_asset_loading_exception();
             })
             .then([&library, parent_address, shader_data](){
                 return parse_shader(
@@ -30,20 +30,15 @@ namespace
     })json";
 
     const rapidjson::SchemaDocument& sound_asset_schema() {
-        static std::mutex mutex;
-        static std::unique_ptr<rapidjson::SchemaDocument> schema;
-
-        std::lock_guard<std::mutex> guard(mutex);
-        if ( !schema ) {
+        static const std::unique_ptr<rapidjson::SchemaDocument> schema = [](){
             rapidjson::Document doc;
             if ( doc.Parse(sound_asset_schema_source).HasParseError() ) {
                 the<debug>().error("ASSETS: Failed to parse sound asset schema");
                 throw sound_asset_loading_exception();
             }
             json_utils::add_common_schema_definitions(doc);
-            schema = std::make_unique<rapidjson::SchemaDocument>(doc);
-        }
-
+            return std::make_unique<rapidjson::SchemaDocument>(doc);
+        }();
         return *schema;
     }
 
@@ -101,27 +96,9 @@ namespace e2d
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& sound_data){
             return the<deferrer>().do_in_worker_thread([address, sound_data](){
-                const rapidjson::Document& doc = *sound_data->content();
-                rapidjson::SchemaValidator validator(sound_asset_schema());
-
-                if ( doc.Accept(validator) ) {
-                    return;
-                }
-
-                rapidjson::StringBuffer sb;
-                if ( validator.GetInvalidDocumentPointer().StringifyUriFragment(sb) ) {
-                    the<debug>().error("ASSET: Failed to validate asset json:\n"
-                        "--> Address: %0\n"
-                        "--> Invalid schema keyword: %1\n"
-                        "--> Invalid document pointer: %2",
-                        address,
-                        validator.GetInvalidSchemaKeyword(),
-                        sb.GetString());
-                } else {
-                    the<debug>().error("ASSET: Failed to validate asset json");
+                if ( !sound_data->validate(sound_asset_schema(), address) ) {
+                    throw sound_asset_loading_exception();
                 }
-
-                throw sound_asset_loading_exception();
             })
             .then([&library, parent_address, sound_data](){
                 return parse_sound(
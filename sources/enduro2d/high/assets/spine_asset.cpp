@@ -53,20 +53,15 @@ namespace
     })json";
 
     const rapidjson::SchemaDocument& spine_asset_schema() {
-        static std::mutex mutex;
-        static std::unique_ptr<rapidjson::SchemaDocument> schema;
-
-        std::lock_guard<std::mutex> guard(mutex);
-        if ( !schema ) {
+        static const std::unique_ptr<rapidjson::SchemaDocument> schema = [](){
             rapidjson::Document doc;
             if ( doc.Parse(spine_asset_schema_source).HasParseError() ) {
                 the<debug>().error("ASSETS: Failed to parse spine asset schema");
                 throw spine_asset_loading_exception();
             }
             json_utils::add_common_schema_definitions(doc);
-            schema = std::make_unique<rapidjson::SchemaDocument>(doc);
-        }
-
+            return std::make_unique<rapidjson::SchemaDocument>(doc);
+        }();
         return *schema;
     }
 
@@ -362,27 +357,9 @@ namespace e2d
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& spine_data){
             return the<deferrer>().do_in_worker_thread([address, spine_data](){
-                const rapidjson::Document& doc = *spine_data->content();
-                rapidjson::SchemaValidator validator(spine_asset_schema());
-
-                if ( doc.Accept(validator) ) {
-                    return;
-                }
-
-                rapidjson::StringBuffer sb;
-                if ( validator.GetInvalidDocumentPointer().StringifyUriFragment(sb) ) {
-                    the<debug>().error("ASSET: Failed to validate asset json:\n"
-                        "--> Address: %0\n"
-                        "--> Invalid schema keyword: %1\n"
-                        "--> Invalid document pointer: %2",
-                        address,
-                        validator.GetInvalidSchemaKeyword(),
-                        sb.GetString());
-                } else {
-                    the<debug>().error("ASSET: Failed to validate asset json");
+                if ( !spine_data->validate(spine_asset_schema(), address) ) {
+                    throw spine_asset_loading_exception();
                 }
-
-                throw spine_asset_loading_exception();
             })
             .then([&library, parent_address, spine_data](){
                 return parse_spine(
@@ -8,8 +8,11 @@
 
 #include <enduro2d/high/assets/json_asset.hpp>
 #include <enduro2d/high/assets/atlas_asset.hpp>
+#include <enduro2d/high/assets/image_asset.hpp>
 #include <enduro2d/high/assets/texture_asset.hpp>
 
+#include <enduro2d/high/dynamic_atlas.hpp>
+
 namespace
 {
     using namespace e2d;
@@ -27,7 +30,8 @@ namespace
             "additionalProperties" : false,
             "properties" : {
                 "texture" : { "$ref": "#/common_definitions/address" },
-                "texrect" : { "$ref": "#/common_definitions/b2" }
+                "texrect" : { "$ref": "#/common_definitions/b2" },
+                "dynamic_atlas" : { "type" : "boolean" }
             }
         },{
             "type" : "object",
@@ -36,37 +40,51 @@ namespace
             "properties" : {
                 "texture" : { "$ref": "#/common_definitions/address" },
                 "inner_texrect" : { "$ref": "#/common_definitions/b2" },
-                "outer_texrect" : { "$ref": "#/common_definitions/b2" }
+                "outer_texrect" : { "$ref": "#/common_definitions/b2" },
+                "dynamic_atlas" : { "type" : "boolean" }
             }
         }]
     })json";
 
     const rapidjson::SchemaDocument& sprite_asset_schema() {
-        static std::mutex mutex;
-        static std::unique_ptr<rapidjson::SchemaDocument> schema;
-
-        std::lock_guard<std::mutex> guard(mutex);
-        if ( !schema ) {
+        static const std::unique_ptr<rapidjson::SchemaDocument> schema = [](){
             rapidjson::Document doc;
             if ( doc.Parse(sprite_asset_schema_source).HasParseError() ) {
                 the<debug>().error("ASSETS: Failed to parse sprite asset schema");
                 throw sprite_asset_loading_exception();
             }
             json_utils::add_common_schema_definitions(doc);
-            schema = std::make_unique<rapidjson::SchemaDocument>(doc);
-        }
-
+            return std::make_unique<rapidjson::SchemaDocument>(doc);
+        }();
         return *schema;
     }
 
+    stdex::promise<sprite> load_sprite_texture(
+        const library& library,
+        str_view texture_address,
+        const b2f& inner_texrect,
+        const b2f& outer_texrect)
+    {
+        return library.load_asset_async<texture_asset>(texture_address)
+        .then([
+            inner_texrect,
+            outer_texrect
+        ](const texture_asset::load_result& texture){
+            sprite content;
+            content.set_inner_texrect(inner_texrect);
+            content.set_outer_texrect(outer_texrect);
+            content.set_texture(texture);
+            return content;
+        });
+    }
+
     stdex::promise<sprite> parse_sprite(
         const library& library,
         str_view parent_address,
         const rapidjson::Value& root)
     {
         E2D_ASSERT(root.HasMember("texture") && root["texture"].IsString());
-        auto texture_p = library.load_asset_async<texture_asset>(
-            path::combine(parent_address, root["texture"].GetString()));
+        const str texture_address = path::combine(parent_address, root["texture"].GetString());
 
         b2f inner_texrect;
         b2f outer_texrect;
@@ -95,15 +113,43 @@ namespace
             }
         }
 
-        return texture_p.then([
+        bool use_dynamic_atlas = false;
+        if ( root.HasMember("dynamic_atlas") ) {
+            E2D_ASSERT(root["dynamic_atlas"].IsBool());
+            use_dynamic_atlas = root["dynamic_atlas"].GetBool();
+        }
+
+        if ( !use_dynamic_atlas || !modules::is_initialized<dynamic_atlas>() ) {
+            return load_sprite_texture(library, texture_address, inner_texrect, outer_texrect);
+        }
+
+        return library.load_asset_async<image_asset>(texture_address)
+        .then([texture_address, inner_texrect, outer_texrect](const image_asset::load_result& image){
+            return the<deferrer>().do_in_main_thread([
+                image,
+                texture_address,
+                inner_texrect,
+                outer_texrect
+            ](){
+                std::pair<bool, sprite> result;
+                result.first = the<dynamic_atlas>().try_insert(
+                    make_hash(texture_address),
+                    image->content(),
+                    inner_texrect,
+                    outer_texrect,
+                    result.second);
+                return result;
+            });
+        })
+        .then([
+            &library,
+            texture_address,
             inner_texrect,
             outer_texrect
-        ](const texture_asset::load_result& texture){
-            sprite content;
-            content.set_inner_texrect(inner_texrect);
-            content.set_outer_texrect(outer_texrect);
-            content.set_texture(texture);
-            return content;
+        ](const std::pair<bool, sprite>& result){
+            return result.first
+                ? stdex::make_resolved_promise(result.second)
+                : load_sprite_texture(library, texture_address, inner_texrect, outer_texrect);
         });
     }
 }
@@ -120,27 +166,9 @@ namespace e2d
             parent_address = path::parent_path(address)
         ](const json_asset::load_result& sprite_data){
             return the<deferrer>().do_in_worker_thread([address, sprite_data](){
-                const rapidjson::Document& doc = *sprite_data->content();
-                rapidjson::SchemaValidator validator(sprite_asset_schema());
-
-                if ( doc.Accept(validator) ) {
-                    return;
+                if ( !sprite_data->validate(sprite_asset_schema(), address) ) {
+                    throw sprite_asset_loading_exception();
                 }
-
-                rapidjson::StringBuffer sb;
-                if ( validator.GetInvalidDocumentPointer().StringifyUriFragment(sb) ) {
-                    the<debug>().error("ASSET: Failed to validate asset json:\n"
-                        "--> Address: %0\n"
-                        "--> Invalid schema keyword: %1\n"
-                        "--> Invalid document pointer: %2",
-                        address,
-                        validator.GetInvalidSchemaKeyword(),
-                        sb.GetString());
-                } else {
-                    the<debug>().error("ASSET: Failed to validate asset json");
-                }
-
-                throw sprite_asset_loading_exception();
             })
             .then([&library, parent_address, sprite_data](){
                 return parse_sprite(
@@ -16,6 +16,51 @@ namespace
             return "texture asset loading exception";
         }
     };
+
+    vector<image_data_format> get_transcoding_targets(image_data_format format) {
+        switch ( format ) {
+            case image_data_format::rgba_dxt1:
+            case image_data_format::rgba_dxt3:
+            case image_data_format::rgba_dxt5:
+                return {
+                    image_data_format::rgba_etc2,
+                    image_data_format::rgba8};
+            case image_data_format::rgb_etc1:
+                return {
+                    image_data_format::rgb_etc2,
+                    image_data_format::rgba_dxt1,
+                    image_data_format::rgb8};
+            case image_data_format::rgb_etc2:
+                return {
+                    image_data_format::rgba_dxt1,
+                    image_data_format::rgb_etc1,
+                    image_data_format::rgb8};
+            case image_data_format::rgba_etc2:
+                return {
+                    image_data_format::rgba_dxt5,
+                    image_data_format::rgba8};
+            case image_data_format::rgb_a1_etc2:
+                return {
+                    image_data_format::rgba_dxt1,
+                    image_data_format::rgba_etc2,
+                    image_data_format::rgba8};
+            default:
+                return {};
+        }
+    }
+
+    image_data_format select_texture_format(image_data_format format) {
+        const render& r = the<render>();
+        if ( r.is_image_format_supported(format) ) {
+            return format;
+        }
+        for ( image_data_format target : get_transcoding_targets(format) ) {
+            if ( r.is_image_format_supported(target) ) {
+                return target;
+            }
+        }
+        return format;
+    }
 }
 
 namespace e2d
@@ -26,20 +71,54 @@ namespace e2d
         return library.load_asset_async<image_asset>(address)
         .then([
             address = str(address)
-        ](const image_asset::load_result& texture_data){
-            return the<deferrer>().do_in_main_thread([
-                texture_data,
-                address = std::move(address)
-            ](){
-                E2D_PROFILER_SCOPE_EX("texture_asset.create_texture", {
-                    {"address", address}
-                });
-                const texture_ptr content = the<render>().create_texture(
-                    texture_data->content());
-                if ( !content ) {
-                    throw texture_asset_loading_exception();
+        ](const image_asset::load_result& image_data){
+            return the<deferrer>().do_in_main_thread([image_data](){
+                return select_texture_format(image_data->content().format());
+            })
+            .then([
+                image_data,
+                address
+            ](image_data_format format) -> stdex::promise<image_asset::load_result> {
+                if ( format == image_data->content().format() ) {
+                    return stdex::make_resolved_promise(image_data);
                 }
-                return texture_asset::create(content);
+                return the<deferrer>().do_in_worker_thread([
+                    image_data,
+                    address,
+                    format
+                ](){
+                    E2D_PROFILER_SCOPE_EX("texture_asset.transcode_image", {
+                        {"address", address}
+                    });
+                    image content;
+                    if ( !images::try_transcode_image(content, image_data->content(), format) ) {
+                        the<debug>().error("TEXTURE: Failed to transcode texture image:\n"
+                            "--> Address: %0\n"
+                            "--> Source format: %1\n"
+                            "--> Target format: %2",
+                            address,
+                            enum_hpp::to_string_or_throw(image_data->content().format()),
+                            enum_hpp::to_string_or_throw(format));
+                        throw texture_asset_loading_exception();
+                    }
+                    return image_asset::create(std::move(content));
+                });
+            })
+            .then([address](const image_asset::load_result& texture_data){
+                return the<deferrer>().do_in_main_thread([
+                    texture_data,
+                    address
+                ](){
+                    E2D_PROFILER_SCOPE_EX("texture_asset.create_texture", {
+                        {"address", address}
+                    });
+                    const texture_ptr content = the<render>().create_texture(
+                        texture_data->content());
+                    if ( !content ) {
+                        throw texture_asset_loading_exception();
+                    }
+                    return texture_asset::create(content);
+                });
             });
         });
     }
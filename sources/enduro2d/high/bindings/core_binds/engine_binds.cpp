@@ -30,6 +30,22 @@ namespace e2d::bindings::core
 
             "realtime_time", sol::property([](const engine& e) -> f32 {
                 return e.realtime_time();
+            }),
+
+            "fixed_update", sol::property([](const engine& e) -> bool {
+                return e.fixed_update();
+            }),
+
+            "fixed_delta_time", sol::property([](const engine& e) -> f32 {
+                return e.fixed_delta_time();
+            }),
+
+            "tick_count", sol::property([](const engine& e) -> u32 {
+                return e.tick_count();
+            }),
+
+            "tick_alpha", sol::property([](const engine& e) -> f32 {
+                return e.tick_alpha();
             })
         );
     }
@@ -24,6 +24,22 @@ namespace e2d::bindings::high
                     c->spine(v);
                 }),
 
+            "use_pose_cache", sol::property(
+                [](const gcomponent<spine_player>& c) -> bool {
+                    return c->use_pose_cache();
+                },
+                [](gcomponent<spine_player>& c, bool v){
+                    c->use_pose_cache(v);
+                }),
+
+            "pose_sample_rate", sol::property(
+                [](const gcomponent<spine_player>& c) -> f32 {
+                    return c->pose_sample_rate();
+                },
+                [](gcomponent<spine_player>& c, f32 v){
+                    c->pose_sample_rate(v);
+                }),
+
             "skin", [](gcomponent<spine_player>& c, str_view name) -> bool {
                 return c->skin(name);
             },
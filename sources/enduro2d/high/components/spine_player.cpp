@@ -106,13 +106,13 @@ namespace
         E2D_ASSERT(root.HasMember("desc") && root["desc"].IsObject());
         const auto& event_desc = root["desc"];
 
-        if ( command_type == make_hash("custom_evt") ) {
+        if ( command_type == "custom_evt"_hash ) {
             auto evt = parse_custom_evt(event_desc);
             return evt ? evt : std::nullopt;
-        } else if ( command_type == make_hash("end_evt") ) {
+        } else if ( command_type == "end_evt"_hash ) {
             auto evt = parse_end_evt(event_desc);
             return evt ? evt : std::nullopt;
-        } else if ( command_type == make_hash("complete_evt") ) {
+        } else if ( command_type == "complete_evt"_hash ) {
             auto evt = parse_complete_evt(event_desc);
             return evt ? evt : std::nullopt;
         } else {
@@ -368,19 +368,19 @@ namespace
         E2D_ASSERT(root.HasMember("desc") && root["desc"].IsObject());
         const auto& command_desc = root["desc"];
 
-        if ( command_type == make_hash("clear_track_cmd") ) {
+        if ( command_type == "clear_track_cmd"_hash ) {
             auto cmd = parse_clear_track_cmd(command_desc);
             return cmd ? cmd : std::nullopt;
-        } else if ( command_type == make_hash("set_anim_cmd") ) {
+        } else if ( command_type == "set_anim_cmd"_hash ) {
             auto cmd = parse_set_anim_cmd(command_desc);
             return cmd ? cmd : std::nullopt;
-        } else if ( command_type == make_hash("add_anim_cmd") ) {
+        } else if ( command_type == "add_anim_cmd"_hash ) {
             auto cmd = parse_add_anim_cmd(command_desc);
             return cmd ? cmd : std::nullopt;
-        } else if ( command_type == make_hash("set_empty_anim_cmd") ) {
+        } else if ( command_type == "set_empty_anim_cmd"_hash ) {
             auto cmd = parse_set_empty_anim_cmd(command_desc);
             return cmd ? cmd : std::nullopt;
-        } else if ( command_type == make_hash("add_empty_anim_cmd") ) {
+        } else if ( command_type == "add_empty_anim_cmd"_hash ) {
             auto cmd = parse_add_empty_anim_cmd(command_desc);
             return cmd ? cmd : std::nullopt;
         } else {
@@ -445,6 +445,9 @@ namespace e2d
         clipping_ = std::move(new_clipping);
         skeleton_ = std::move(new_skeleton);
         animation_ = std::move(new_animation);
+        custom_attachments_ = false;
+        baked_animation_.reset();
+        baked_pose_ = nullptr;
         return *this;
     }
 
@@ -471,8 +474,13 @@ namespace e2d
         static thread_local str attachment_name;
         attachment_name = name;
 
-        return !!spSkeleton_setAttachment(
-            skeleton_.get(), slot_name.c_str(), attachment_name.c_str());
+        if ( !spSkeleton_setAttachment(skeleton_.get(), slot_name.c_str(), attachment_name.c_str()) ) {
+            return false;
+        }
+
+        // baked poses know nothing about attachment overrides
+        custom_attachments_ = true;
+        return true;
     }
 
     bool spine_player::has_skin(str_view name) const noexcept {
@@ -534,6 +542,41 @@ namespace e2d
             ? iter->second
             : nullptr;
     }
+
+    spine_player& spine_player::use_pose_cache(bool value) noexcept {
+        use_pose_cache_ = value;
+        return *this;
+    }
+
+    spine_player& spine_player::pose_sample_rate(f32 value) noexcept {
+        pose_sample_rate_ = value;
+        return *this;
+    }
+
+    bool spine_player::use_pose_cache() const noexcept {
+        return use_pose_cache_;
+    }
+
+    f32 spine_player::pose_sample_rate() const noexcept {
+        return pose_sample_rate_;
+    }
+
+    bool spine_player::has_custom_attachments() const noexcept {
+        return custom_attachments_;
+    }
+
+    spine_player& spine_player::baked_pose(
+        spine_pose_cache::baked_animation_ptr animation,
+        const spine_pose_cache::pose* pose) noexcept
+    {
+        baked_animation_ = std::move(animation);
+        baked_pose_ = baked_animation_ ? pose : nullptr;
+        return *this;
+    }
+
+    const spine_pose_cache::pose* spine_player::baked_pose() const noexcept {
+        return baked_pose_;
+    }
 }
 
 namespace e2d
@@ -546,7 +589,9 @@ namespace e2d
             "spine" : { "$ref": "#/common_definitions/address" },
             "materials" : { "$ref": "#/definitions/materials" },
             "skin" : { "$ref": "#/common_definitions/name" },
-            "attachments" : { "$ref": "#/definitions/attachments" }
+            "attachments" : { "$ref": "#/definitions/attachments" },
+            "use_pose_cache" : { "type" : "boolean" },
+            "pose_sample_rate" : { "type" : "number", "exclusiveMinimum" : 0 }
         },
         "definitions" : {
             "materials" : {
@@ -664,6 +709,24 @@ namespace e2d
             }
         }
 
+        if ( ctx.root.HasMember("use_pose_cache") ) {
+            bool use_pose_cache = component.use_pose_cache();
+            if ( !json_utils::try_parse_value(ctx.root["use_pose_cache"], use_pose_cache) ) {
+                the<debug>().error("SPINE_PLAYER: Incorrect formatting of 'use_pose_cache' property");
+                return false;
+            }
+            component.use_pose_cache(use_pose_cache);
+        }
+
+        if ( ctx.root.HasMember("pose_sample_rate") ) {
+            f32 pose_sample_rate = component.pose_sample_rate();
+            if ( !json_utils::try_parse_value(ctx.root["pose_sample_rate"], pose_sample_rate) ) {
+                the<debug>().error("SPINE_PLAYER: Incorrect formatting of 'pose_sample_rate' property");
+                return false;
+            }
+            component.pose_sample_rate(pose_sample_rate);
+        }
+
         return true;
     }
 
@@ -915,7 +978,34 @@ namespace e2d
     const char* component_inspector<spine_player>::title = ICON_FA_PARAGRAPH " spine_player";
 
     void component_inspector<spine_player>::operator()(gcomponent<spine_player>& c) const {
-        E2D_UNUSED(c);
+        if ( bool use_pose_cache = c->use_pose_cache();
+            ImGui::Checkbox("use_pose_cache", &use_pose_cache) )
+        {
+            c->use_pose_cache(use_pose_cache);
+        }
+
+        if ( f32 pose_sample_rate = c->pose_sample_rate();
+            ImGui::DragFloat("pose_sample_rate", &pose_sample_rate, 1.f, 1.f, 240.f) )
+        {
+            c->pose_sample_rate(pose_sample_rate);
+        }
+
+        if ( c->spine() && c->spine()->content().pose_cache() ) {
+            const spine_pose_cache::statistics stats =
+                c->spine()->content().pose_cache()->stats();
+            imgui_utils::show_formatted_text(
+                "baked: %0 animations, %1 poses, %2 KiB, %3 us, %4 pending",
+                stats.baked_animations,
+                stats.baked_poses,
+                stats.memory_usage / 1024u,
+                stats.baking_time_us,
+                stats.pending_animations);
+            imgui_utils::show_formatted_text(
+                "updates: %0 cached, %1 evaluated",
+                stats.cached_updates,
+                stats.evaluated_updates);
+        }
+
         ///TODO(BlackMat): add 'spine' inspector
         ///TODO(BlackMat): add 'materials' inspector
     }
@@ -0,0 +1,381 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/high/dynamic_atlas.hpp>
+
+#include <enduro2d/high/assets/texture_asset.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    bool is_convertible_to_rgba8(image_data_format format) noexcept {
+        switch ( format ) {
+            case image_data_format::a8:
+            case image_data_format::l8:
+            case image_data_format::la8:
+            case image_data_format::rgb8:
+            case image_data_format::rgba8:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    buffer convert_to_rgba8(const image& img) {
+        buffer result(std::size_t(img.size().x) * img.size().y * 4u);
+        u8* dst = result.data();
+        for ( u32 v = 0; v < img.size().y; ++v ) {
+            for ( u32 u = 0; u < img.size().x; ++u, dst += 4 ) {
+                const color32 c = img.pixel32(u, v);
+                dst[0] = c.r;
+                dst[1] = c.g;
+                dst[2] = c.b;
+                dst[3] = c.a;
+            }
+        }
+        return result;
+    }
+
+    // repeats the edge texels of the image into the padding around it,
+    // so the filtering at the sprite borders doesn't fetch the neighbours
+    buffer extrude_rgba8(buffer_view src, const v2u& size, u32 padding) {
+        const std::size_t src_pitch = std::size_t(size.x) * 4u;
+        const std::size_t dst_pitch = (std::size_t(size.x) + padding * 2u) * 4u;
+        const std::size_t dst_height = std::size_t(size.y) + padding * 2u;
+
+        buffer result(dst_pitch * dst_height);
+        for ( std::size_t y = 0; y < dst_height; ++y ) {
+            const std::size_t src_y = math::clamp(
+                y, std::size_t(padding), std::size_t(size.y) + padding - 1u) - padding;
+            const u8* src_row = static_cast<const u8*>(src.data()) + src_y * src_pitch;
+            u8* dst_row = result.data() + y * dst_pitch;
+
+            for ( u32 x = 0; x < padding; ++x ) {
+                std::memcpy(dst_row + x * 4u, src_row, 4u);
+                std::memcpy(dst_row + dst_pitch - (x + 1u) * 4u, src_row + src_pitch - 4u, 4u);
+            }
+            std::memcpy(dst_row + padding * 4u, src_row, src_pitch);
+        }
+        return result;
+    }
+}
+
+namespace e2d
+{
+    //
+    // dynamic_atlas::parameters
+    //
+
+    dynamic_atlas::parameters& dynamic_atlas::parameters::page_size(const v2u& value) noexcept {
+        page_size_ = value;
+        return *this;
+    }
+
+    dynamic_atlas::parameters& dynamic_atlas::parameters::max_pages(std::size_t value) noexcept {
+        max_pages_ = value;
+        return *this;
+    }
+
+    dynamic_atlas::parameters& dynamic_atlas::parameters::max_image_size(const v2u& value) noexcept {
+        max_image_size_ = value;
+        return *this;
+    }
+
+    dynamic_atlas::parameters& dynamic_atlas::parameters::padding(u32 value) noexcept {
+        padding_ = value;
+        return *this;
+    }
+
+    const v2u& dynamic_atlas::parameters::page_size() const noexcept {
+        return page_size_;
+    }
+
+    std::size_t dynamic_atlas::parameters::max_pages() const noexcept {
+        return max_pages_;
+    }
+
+    const v2u& dynamic_atlas::parameters::max_image_size() const noexcept {
+        return max_image_size_;
+    }
+
+    u32 dynamic_atlas::parameters::padding() const noexcept {
+        return padding_;
+    }
+
+    //
+    // dynamic_atlas::internal_state
+    //
+
+    class dynamic_atlas::internal_state final : private e2d::noncopyable {
+    public:
+        struct page {
+            texture_asset::ptr texture;
+            rect_packer packer;
+            vector<str_hash> keys;
+        };
+
+        struct entry {
+            std::size_t page{0u};
+            b2u texrect;
+        };
+    public:
+        internal_state(const parameters& params)
+        : params_(params) {}
+
+        bool is_suitable(const image& img) const noexcept {
+            const u32 extrusion = params_.padding() * 2u;
+            return !img.empty()
+                && is_convertible_to_rgba8(img.format())
+                && img.size().x <= params_.max_image_size().x
+                && img.size().y <= params_.max_image_size().y
+                && img.size().x + extrusion <= params_.page_size().x
+                && img.size().y + extrusion <= params_.page_size().y;
+        }
+
+        bool find(str_hash key, sprite& dst) const {
+            std::lock_guard<std::mutex> guard(mutex_);
+            const auto iter = entries_.find(key);
+            if ( iter == entries_.end() ) {
+                return false;
+            }
+            const b2f texrect(iter->second.texrect.size.cast_to<f32>());
+            make_sprite_(iter->second, texrect, texrect, dst);
+            return true;
+        }
+
+        bool insert(
+            str_hash key,
+            const image& img,
+            const b2f& inner_texrect,
+            const b2f& outer_texrect,
+            sprite& dst)
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+
+            if ( const auto iter = entries_.find(key); iter != entries_.end() ) {
+                make_sprite_(iter->second, inner_texrect, outer_texrect, dst);
+                return true;
+            }
+
+            if ( !is_suitable(img) ) {
+                ++rejections_;
+                return false;
+            }
+
+            const u32 padding = params_.padding();
+
+            entry new_entry;
+            if ( !allocate_(img.size() + v2u(padding * 2u), new_entry) ) {
+                ++rejections_;
+                return false;
+            }
+
+            page& p = pages_[new_entry.page];
+            if ( padding > 0u ) {
+                the<render>().update_texture(
+                    p.texture->content(),
+                    img.format() == image_data_format::rgba8
+                        ? extrude_rgba8(img.data(), img.size(), padding)
+                        : extrude_rgba8(convert_to_rgba8(img), img.size(), padding),
+                    new_entry.texrect);
+            } else if ( img.format() == image_data_format::rgba8 ) {
+                the<render>().update_texture(
+                    p.texture->content(),
+                    img.data(),
+                    new_entry.texrect);
+            } else {
+                the<render>().update_texture(
+                    p.texture->content(),
+                    convert_to_rgba8(img),
+                    new_entry.texrect);
+            }
+
+            new_entry.texrect = b2u(
+                new_entry.texrect.position + v2u(padding),
+                img.size());
+
+            p.keys.push_back(key);
+            entries_.insert_or_assign(key, new_entry);
+
+            make_sprite_(new_entry, inner_texrect, outer_texrect, dst);
+            return true;
+        }
+
+        std::size_t evict_unused_pages() {
+            std::lock_guard<std::mutex> guard(mutex_);
+            std::size_t result = 0u;
+            for ( std::size_t i = 0; i < pages_.size(); ++i ) {
+                if ( !pages_[i].keys.empty() && is_unused_page_(pages_[i]) ) {
+                    evict_page_(i);
+                    ++result;
+                }
+            }
+            return result;
+        }
+
+        statistics stats() const {
+            std::lock_guard<std::mutex> guard(mutex_);
+            statistics result;
+            result.pages = pages_.size();
+            result.images = entries_.size();
+            result.evictions = evictions_;
+            result.rejections = rejections_;
+
+            u64 used_area = 0u;
+            u64 total_area = 0u;
+            for ( const page& p : pages_ ) {
+                used_area += p.packer.used_area();
+                total_area += u64(p.packer.size().x) * p.packer.size().y;
+            }
+            result.occupancy = total_area > 0u
+                ? static_cast<f32>(static_cast<f64>(used_area) / static_cast<f64>(total_area))
+                : 0.f;
+
+            return result;
+        }
+    private:
+        bool allocate_(const v2u& size, entry& result) {
+            for ( std::size_t i = 0; i < pages_.size(); ++i ) {
+                if ( pages_[i].packer.insert(size, result.texrect) ) {
+                    result.page = i;
+                    return true;
+                }
+            }
+
+            if ( pages_.size() < params_.max_pages() ) {
+                if ( !create_page_() ) {
+                    return false;
+                }
+                result.page = pages_.size() - 1u;
+                return pages_.back().packer.insert(size, result.texrect);
+            }
+
+            for ( std::size_t i = 0; i < pages_.size(); ++i ) {
+                if ( is_unused_page_(pages_[i]) ) {
+                    evict_page_(i);
+                    if ( pages_[i].packer.insert(size, result.texrect) ) {
+                        result.page = i;
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        bool create_page_() {
+            const v2u& size = params_.page_size();
+            const texture_ptr texture = the<render>().create_texture(image(
+                size,
+                image_data_format::rgba8,
+                buffer(std::size_t(size.x) * size.y * 4u)));
+
+            if ( !texture ) {
+                the<debug>().error("DYNAMIC_ATLAS: Failed to create atlas page:\n"
+                    "--> Size: %0",
+                    size);
+                return false;
+            }
+
+            // images are allocated with their extruded borders,
+            // so the packer itself doesn't need to keep any gaps
+            page p;
+            p.texture = texture_asset::create(texture);
+            p.packer.reset(size);
+            pages_.push_back(std::move(p));
+            return true;
+        }
+
+        // a page is unused when only the atlas itself refers to its texture
+        bool is_unused_page_(const page& p) const noexcept {
+            return p.texture && p.texture->use_count() == 1u;
+        }
+
+        void evict_page_(std::size_t index) {
+            page& p = pages_[index];
+            for ( str_hash key : p.keys ) {
+                entries_.erase(key);
+            }
+
+            the<debug>().trace("DYNAMIC_ATLAS: Atlas page is evicted:\n"
+                "--> Page: %0\n"
+                "--> Images: %1",
+                index,
+                p.keys.size());
+
+            p.keys.clear();
+            p.packer.clear();
+            ++evictions_;
+        }
+
+        void make_sprite_(
+            const entry& e,
+            const b2f& inner_texrect,
+            const b2f& outer_texrect,
+            sprite& dst) const
+        {
+            const v2f offset = e.texrect.position.cast_to<f32>();
+            dst.set_texture(pages_[e.page].texture);
+            dst.set_inner_texrect(b2f(inner_texrect.position + offset, inner_texrect.size));
+            dst.set_outer_texrect(b2f(outer_texrect.position + offset, outer_texrect.size));
+        }
+    private:
+        parameters params_;
+        mutable std::mutex mutex_;
+        vector<page> pages_;
+        hash_map<str_hash, entry> entries_;
+        std::size_t evictions_{0u};
+        std::size_t rejections_{0u};
+    };
+
+    //
+    // dynamic_atlas
+    //
+
+    dynamic_atlas::dynamic_atlas()
+    : dynamic_atlas(parameters()) {}
+
+    dynamic_atlas::dynamic_atlas(const parameters& params)
+    : state_(std::make_unique<internal_state>(params)) {}
+
+    dynamic_atlas::~dynamic_atlas() noexcept = default;
+
+    bool dynamic_atlas::is_suitable(const image& img) const noexcept {
+        return state_->is_suitable(img);
+    }
+
+    bool dynamic_atlas::find(str_hash key, sprite& dst) const {
+        return state_->find(key, dst);
+    }
+
+    bool dynamic_atlas::try_insert(
+        str_hash key,
+        const image& img,
+        sprite& dst)
+    {
+        const b2f texrect(img.size().cast_to<f32>());
+        return state_->insert(key, img, texrect, texrect, dst);
+    }
+
+    bool dynamic_atlas::try_insert(
+        str_hash key,
+        const image& img,
+        const b2f& inner_texrect,
+        const b2f& outer_texrect,
+        sprite& dst)
+    {
+        return state_->insert(key, img, inner_texrect, outer_texrect, dst);
+    }
+
+    std::size_t dynamic_atlas::evict_unused_pages() {
+        return state_->evict_unused_pages();
+    }
+
+    dynamic_atlas::statistics dynamic_atlas::stats() const {
+        return state_->stats();
+    }
+}
@@ -43,6 +43,15 @@ namespace e2d
         return state_->raw_entity();
     }
 
+    void gobject::mark_structure_changed() noexcept {
+        structure_counter_().fetch_add(1u, std::memory_order_acq_rel);
+    }
+
+    std::atomic<u32>& gobject::structure_counter_() noexcept {
+        static std::atomic<u32> counter{0u};
+        return counter;
+    }
+
     bool operator<(const gobject& l, const gobject& r) noexcept {
         return (!l && r)
             || (l && r && l.raw_entity() < r.raw_entity());
@@ -50,4 +50,11 @@ namespace e2d
             (*p.second.drawer)(go, ctx);
         }
     }
+
+    bool inspector::has_component(gobject go, str_view type) const {
+        std::lock_guard<std::mutex> guard(mutex_);
+        const auto iter = inspector_impls_.find(str(type));
+        return iter != inspector_impls_.end()
+            && iter->second.creator->exists(go);
+    }
 }
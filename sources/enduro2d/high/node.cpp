@@ -6,6 +6,13 @@
 
 #include <enduro2d/high/node.hpp>
 
+namespace
+{
+    using namespace e2d;
+
+    std::atomic<u32> hierarchy_version_counter{0u};
+}
+
 namespace e2d
 {
     node::node(gobject owner)
@@ -66,6 +73,7 @@ namespace e2d
 
     void node::owner(gobject owner) noexcept {
         owner_ = std::move(owner);
+        mark_hierarchy_changed_();
     }
 
     gobject node::owner() const noexcept {
@@ -238,6 +246,7 @@ namespace e2d
         children_.push_front(*child);
         child->parent_ = this;
         child->mark_dirty_world_matrix_();
+        mark_hierarchy_changed_();
         return true;
     }
 
@@ -257,6 +266,7 @@ namespace e2d
         children_.push_back(*child);
         child->parent_ = this;
         child->mark_dirty_world_matrix_();
+        mark_hierarchy_changed_();
         return true;
     }
 
@@ -279,6 +289,7 @@ namespace e2d
             *child);
         child->parent_ = this;
         child->mark_dirty_world_matrix_();
+        mark_hierarchy_changed_();
         return true;
     }
 
@@ -301,6 +312,7 @@ namespace e2d
             *child);
         child->parent_ = this;
         child->mark_dirty_world_matrix_();
+        mark_hierarchy_changed_();
         return true;
     }
 
@@ -327,6 +339,7 @@ namespace e2d
                 n->mark_dirty_world_matrix_();
                 intrusive_ptr_release(n);
             });
+        mark_hierarchy_changed_();
         return true;
     }
 
@@ -353,6 +366,7 @@ namespace e2d
             node_children::iterator_to(*child_l),
             node_children::iterator_to(*child_r));
 
+        mark_hierarchy_changed_();
         return true;
     }
 
@@ -490,6 +504,10 @@ namespace e2d
 
         return {math::numeric_cast<std::size_t>(distance), true};
     }
+
+    u32 node::hierarchy_version() noexcept {
+        return hierarchy_version_counter.load(std::memory_order_acquire);
+    }
 }
 
 namespace e2d
@@ -517,6 +535,10 @@ namespace e2d
             ? local_matrix() * parent_->world_matrix()
             : local_matrix();
     }
+
+    void node::mark_hierarchy_changed_() noexcept {
+        hierarchy_version_counter.fetch_add(1u, std::memory_order_acq_rel);
+    }
 }
 
 namespace e2d::nodes
@@ -8,6 +8,213 @@
 
 #include <spine/spine.h>
 
+namespace
+{
+    using namespace e2d;
+
+    using skeleton_uptr = std::unique_ptr<spSkeleton, decltype(&spSkeleton_dispose)>;
+    using clipping_uptr = std::unique_ptr<spSkeletonClipping, decltype(&spSkeletonClipping_dispose)>;
+
+    void append_pose_mesh(
+        spine_pose_cache::pose& pose,
+        spine_pose_cache::mesh mesh,
+        const float* vertices,
+        const float* uvs,
+        std::size_t vertex_count,
+        const unsigned short* indices,
+        std::size_t index_count)
+    {
+        mesh.first_vertex = math::numeric_cast<u32>(pose.vertices.size());
+        mesh.vertex_count = math::numeric_cast<u32>(vertex_count);
+        mesh.first_index = math::numeric_cast<u32>(pose.indices.size());
+        mesh.index_count = math::numeric_cast<u32>(index_count);
+
+        for ( std::size_t i = 0; i < vertex_count; ++i ) {
+            pose.vertices.emplace_back(vertices[i * 2], vertices[i * 2 + 1]);
+            pose.uvs.emplace_back(uvs[i * 2], uvs[i * 2 + 1]);
+        }
+
+        pose.indices.insert(pose.indices.end(), indices, indices + index_count);
+        pose.meshes.push_back(mesh);
+    }
+
+    void bake_pose(
+        spSkeleton& skeleton,
+        spSkeletonClipping& clipper,
+        vector<float>& world_vertices,
+        spine_pose_cache::pose& pose)
+    {
+        unsigned short quad_indices[6] = { 0, 1, 2, 2, 3, 0 };
+
+        for ( int i = 0; i < skeleton.slotsCount; ++i ) {
+            spSlot* slot = skeleton.drawOrder[i];
+
+            auto slot_clipping_defer = make_defer([&clipper, slot](){
+                spSkeletonClipping_clipEnd(&clipper, slot);
+            });
+
+            spAttachment* attachment = slot->attachment;
+            if ( !attachment || math::is_near_zero(slot->color.a) ) {
+                continue;
+            }
+
+            float* uvs = nullptr;
+            unsigned short* indices = nullptr;
+            int index_count = 0;
+            int vertex_count = 0;
+            const spAtlasPage* atlas_page = nullptr;
+            const spColor* attachment_color = nullptr;
+
+            if ( attachment->type == SP_ATTACHMENT_REGION ) {
+                spRegionAttachment* region = reinterpret_cast<spRegionAttachment*>(attachment);
+                attachment_color = &region->color;
+                if ( math::is_near_zero(attachment_color->a) ) {
+                    continue;
+                }
+                vertex_count = 8;
+                world_vertices.resize(math::max(
+                    world_vertices.size(),
+                    math::numeric_cast<std::size_t>(vertex_count)));
+                spRegionAttachment_computeWorldVertices(
+                    region,
+                    slot->bone,
+                    world_vertices.data(),
+                    0, 2);
+                uvs = region->uvs;
+                indices = quad_indices;
+                index_count = 6;
+                atlas_page = static_cast<spAtlasRegion*>(region->rendererObject)->page;
+            } else if ( attachment->type == SP_ATTACHMENT_MESH ) {
+                spMeshAttachment* mesh = reinterpret_cast<spMeshAttachment*>(attachment);
+                attachment_color = &mesh->color;
+                if ( math::is_near_zero(attachment_color->a) ) {
+                    continue;
+                }
+                vertex_count = mesh->super.worldVerticesLength;
+                world_vertices.resize(math::max(
+                    world_vertices.size(),
+                    math::numeric_cast<std::size_t>(vertex_count)));
+                spVertexAttachment_computeWorldVertices(
+                    &mesh->super,
+                    slot,
+                    0,
+                    mesh->super.worldVerticesLength,
+                    world_vertices.data(),
+                    0, 2);
+                uvs = mesh->uvs;
+                indices = mesh->triangles;
+                index_count = mesh->trianglesCount;
+                atlas_page = static_cast<spAtlasRegion*>(mesh->rendererObject)->page;
+            } else if ( attachment->type == SP_ATTACHMENT_CLIPPING ) {
+                spClippingAttachment* clip = reinterpret_cast<spClippingAttachment*>(attachment);
+                spSkeletonClipping_clipStart(&clipper, slot, clip);
+                slot_clipping_defer.dismiss();
+                continue;
+            } else {
+                slot_clipping_defer.dismiss();
+                continue;
+            }
+
+            const float* vertices = world_vertices.data();
+            if ( spSkeletonClipping_isClipping(&clipper) ) {
+                spSkeletonClipping_clipTriangles(
+                    &clipper,
+                    world_vertices.data(), vertex_count,
+                    indices, index_count,
+                    uvs,
+                    2);
+                vertices = clipper.clippedVertices->items;
+                vertex_count = clipper.clippedVertices->size;
+                uvs = clipper.clippedUVs->items;
+                indices = clipper.clippedTriangles->items;
+                index_count = clipper.clippedTriangles->size;
+            }
+
+            spine_pose_cache::mesh mesh;
+            mesh.page = atlas_page;
+            mesh.blend_mode = slot->data->blendMode;
+            mesh.tint =
+                color(slot->color.r, slot->color.g, slot->color.b, slot->color.a) *
+                color(attachment_color->r, attachment_color->g, attachment_color->b, attachment_color->a);
+
+            append_pose_mesh(
+                pose,
+                mesh,
+                vertices,
+                uvs,
+                math::numeric_cast<std::size_t>(vertex_count >> 1),
+                indices,
+                math::numeric_cast<std::size_t>(index_count));
+        }
+
+        spSkeletonClipping_clipEnd2(&clipper);
+    }
+
+    vector<const spEvent*> bake_events(const spAnimation& animation) {
+        vector<const spEvent*> events;
+        for ( int i = 0; i < animation.timelinesCount; ++i ) {
+            const spTimeline* timeline = animation.timelines[i];
+            if ( !timeline || timeline->type != SP_TIMELINE_EVENT ) {
+                continue;
+            }
+            const spEventTimeline* event_timeline =
+                reinterpret_cast<const spEventTimeline*>(timeline);
+            for ( int j = 0; j < event_timeline->framesCount; ++j ) {
+                events.push_back(event_timeline->events[j]);
+            }
+        }
+        std::stable_sort(events.begin(), events.end(), [](const spEvent* l, const spEvent* r){
+            return l->time < r->time;
+        });
+        return events;
+    }
+
+    spine_pose_cache::baked_animation_ptr bake_animation(
+        spSkeletonData* skeleton_data,
+        const spAnimation* animation,
+        const spSkin* skin,
+        f32 sample_rate)
+    {
+        E2D_ASSERT(skeleton_data && animation && sample_rate > 0.f);
+
+        skeleton_uptr skeleton(spSkeleton_create(skeleton_data), spSkeleton_dispose);
+        clipping_uptr clipper(spSkeletonClipping_create(), spSkeletonClipping_dispose);
+        if ( !skeleton || !clipper ) {
+            throw std::bad_alloc();
+        }
+
+        if ( skin ) {
+            spSkeleton_setSkin(skeleton.get(), const_cast<spSkin*>(skin));
+        }
+
+        const f32 duration = math::max(0.f, animation->duration);
+        const std::size_t pose_count = 1u + math::numeric_cast<std::size_t>(
+            std::ceil(duration * sample_rate));
+
+        vector<float> world_vertices(1000u, 0.f);
+        vector<spine_pose_cache::pose> poses(pose_count);
+
+        for ( std::size_t i = 0; i < pose_count; ++i ) {
+            const f32 time = math::min(duration, static_cast<f32>(i) / sample_rate);
+            spSkeleton_setToSetupPose(skeleton.get());
+            spAnimation_apply(
+                animation,
+                skeleton.get(),
+                time, time,
+                0,
+                nullptr, nullptr,
+                1.f,
+                SP_MIX_BLEND_SETUP,
+                SP_MIX_DIRECTION_IN);
+            spSkeleton_updateWorldTransform(skeleton.get());
+            bake_pose(*skeleton, *clipper, world_vertices, poses[i]);
+        }
+
+        return std::make_shared<spine_pose_cache::baked_animation>(
+            duration, sample_rate, std::move(poses), bake_events(*animation));
+    }
+}
+
 namespace e2d
 {
     spine::spine(spine&& other) noexcept {
@@ -30,6 +237,7 @@ namespace e2d
         atlas_.reset();
         skeleton_.reset();
         animation_.reset();
+        pose_cache_.reset();
     }
 
     void spine::swap(spine& other) noexcept {
@@ -37,6 +245,7 @@ namespace e2d
         swap(atlas_, other.atlas_);
         swap(skeleton_, other.skeleton_);
         swap(animation_, other.animation_);
+        swap(pose_cache_, other.pose_cache_);
     }
 
     spine& spine::assign(spine&& other) noexcept {
@@ -53,6 +262,7 @@ namespace e2d
             m.atlas_ = other.atlas_;
             m.skeleton_ = other.skeleton_;
             m.animation_ = other.animation_;
+            m.pose_cache_ = other.pose_cache_;
             swap(m);
         }
         return *this;
@@ -65,6 +275,7 @@ namespace e2d
 
     spine& spine::set_skeleton(skeleton_data_ptr skeleton) {
         animation_data_ptr animation;
+        pose_cache_ptr pose_cache;
         if ( skeleton ) {
             animation.reset(
                 spAnimationStateData_create(skeleton.get()),
@@ -72,9 +283,11 @@ namespace e2d
             if ( !animation ) {
                 throw std::bad_alloc();
             }
+            pose_cache = std::make_shared<spine_pose_cache>(skeleton);
         }
         skeleton_ = std::move(skeleton);
         animation_ = std::move(animation);
+        pose_cache_ = std::move(pose_cache);
         return *this;
     }
 
@@ -118,6 +331,10 @@ namespace e2d
     const spine::animation_data_ptr& spine::animation() const noexcept {
         return animation_;
     }
+
+    const spine::pose_cache_ptr& spine::pose_cache() const noexcept {
+        return pose_cache_;
+    }
 }
 
 namespace e2d
@@ -136,3 +353,272 @@ namespace e2d
         return !(l == r);
     }
 }
+
+namespace e2d
+{
+    //
+    // spine_pose_cache::baked_animation
+    //
+
+    spine_pose_cache::baked_animation::baked_animation(
+        f32 duration,
+        f32 sample_rate,
+        vector<pose> poses,
+        vector<const spEvent*> events)
+    : duration_(duration)
+    , sample_rate_(sample_rate)
+    , poses_(std::move(poses))
+    , events_(std::move(events))
+    {
+        E2D_ASSERT(!poses_.empty());
+        memory_usage_ = sizeof(*this)
+            + poses_.capacity() * sizeof(pose)
+            + events_.capacity() * sizeof(const spEvent*);
+        for ( const pose& p : poses_ ) {
+            memory_usage_ +=
+                p.meshes.capacity() * sizeof(mesh) +
+                p.vertices.capacity() * sizeof(v2f) +
+                p.uvs.capacity() * sizeof(v2f) +
+                p.indices.capacity() * sizeof(u16);
+        }
+    }
+
+    f32 spine_pose_cache::baked_animation::duration() const noexcept {
+        return duration_;
+    }
+
+    f32 spine_pose_cache::baked_animation::sample_rate() const noexcept {
+        return sample_rate_;
+    }
+
+    std::size_t spine_pose_cache::baked_animation::pose_count() const noexcept {
+        return poses_.size();
+    }
+
+    std::size_t spine_pose_cache::baked_animation::memory_usage() const noexcept {
+        return memory_usage_;
+    }
+
+    const spine_pose_cache::pose& spine_pose_cache::baked_animation::pose_at(f32 time) const noexcept {
+        const f32 index = math::clamp(time, 0.f, duration_) * sample_rate_ + 0.5f;
+        return poses_[math::min(
+            poses_.size() - 1u,
+            static_cast<std::size_t>(index))];
+    }
+
+    const vector<const spEvent*>& spine_pose_cache::baked_animation::events() const noexcept {
+        return events_;
+    }
+
+    //
+    // spine_pose_cache::internal_state
+    //
+
+    class spine_pose_cache::internal_state final
+        : public std::enable_shared_from_this<internal_state>
+        , private noncopyable {
+    public:
+        using bake_key = std::tuple<const spAnimation*, const spSkin*, f32>;
+    public:
+        internal_state(spine::skeleton_data_ptr skeleton)
+        : skeleton_(std::move(skeleton)) {}
+
+        baked_animation_ptr find_or_bake(
+            const spAnimation* animation,
+            const spSkin* skin,
+            f32 sample_rate)
+        {
+            if ( !skeleton_ || !animation || !(sample_rate > 0.f) ) {
+                return nullptr;
+            }
+
+            const bake_key key{animation, skin, sample_rate};
+
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                if ( auto iter = animations_.find(key); iter != animations_.end() ) {
+                    return iter->second;
+                }
+            }
+
+            return bake_and_store_(key);
+        }
+
+        baked_animation_ptr find_or_bake_async(
+            const spAnimation* animation,
+            const spSkin* skin,
+            f32 sample_rate)
+        {
+            if ( !skeleton_ || !animation || !(sample_rate > 0.f) ) {
+                return nullptr;
+            }
+
+            if ( !modules::is_initialized<deferrer>() ) {
+                return find_or_bake(animation, skin, sample_rate);
+            }
+
+            const bake_key key{animation, skin, sample_rate};
+
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                if ( auto iter = animations_.find(key); iter != animations_.end() ) {
+                    return iter->second;
+                }
+                if ( failed_.count(key) || !pending_.insert(key).second ) {
+                    return nullptr;
+                }
+            }
+
+            E2D_ERROR_DEFER([this, &key](){
+                std::lock_guard<std::mutex> guard(mutex_);
+                pending_.erase(key);
+            });
+
+            the<deferrer>().do_in_worker_thread([self = shared_from_this(), key](){
+                self->bake_and_store_(key);
+            }).except([self = shared_from_this(), key](std::exception_ptr e){
+                E2D_UNUSED(e);
+                self->mark_failed_(key);
+            });
+
+            return nullptr;
+        }
+
+        const spine::skeleton_data_ptr& skeleton() const noexcept {
+            return skeleton_;
+        }
+
+        void register_update(bool cached) noexcept {
+            (cached ? cached_updates_ : evaluated_updates_)
+                .fetch_add(1u, std::memory_order_relaxed);
+        }
+
+        statistics stats() const {
+            std::lock_guard<std::mutex> guard(mutex_);
+            statistics result = stats_;
+            result.pending_animations = pending_.size();
+            result.cached_updates = cached_updates_.load(std::memory_order_relaxed);
+            result.evaluated_updates = evaluated_updates_.load(std::memory_order_relaxed);
+            return result;
+        }
+    private:
+        baked_animation_ptr bake_and_store_(const bake_key& key) {
+            const spAnimation* animation = std::get<0>(key);
+
+            const auto begin_us = time::now_us<u64>();
+            baked_animation_ptr baked = bake_animation(
+                skeleton_.get(), animation, std::get<1>(key), std::get<2>(key));
+            const auto baking_time_us = (time::now_us<u64>() - begin_us).value;
+
+            std::lock_guard<std::mutex> guard(mutex_);
+            pending_.erase(key);
+
+            const auto [iter, inserted] = animations_.emplace(key, baked);
+            if ( !inserted ) {
+                return iter->second;
+            }
+
+            stats_.baked_animations += 1u;
+            stats_.baked_poses += baked->pose_count();
+            stats_.memory_usage += baked->memory_usage();
+            stats_.baking_time_us += baking_time_us;
+
+            if ( modules::is_initialized<debug>() ) {
+                the<debug>().trace("SPINE_POSE_CACHE: Animation is baked:\n"
+                    "--> Animation: %0\n"
+                    "--> Poses: %1\n"
+                    "--> Memory: %2 bytes\n"
+                    "--> Time: %3 us",
+                    animation->name ? animation->name : "",
+                    baked->pose_count(),
+                    baked->memory_usage(),
+                    baking_time_us);
+            }
+
+            return baked;
+        }
+
+        void mark_failed_(const bake_key& key) {
+            const spAnimation* animation = std::get<0>(key);
+
+            std::lock_guard<std::mutex> guard(mutex_);
+            pending_.erase(key);
+            failed_.insert(key);
+
+            if ( modules::is_initialized<debug>() ) {
+                the<debug>().error("SPINE_POSE_CACHE: Failed to bake animation:\n"
+                    "--> Animation: %0",
+                    animation->name ? animation->name : "");
+            }
+        }
+    private:
+        spine::skeleton_data_ptr skeleton_;
+        mutable std::mutex mutex_;
+        flat_map<bake_key, baked_animation_ptr> animations_;
+        flat_set<bake_key> pending_;
+        flat_set<bake_key> failed_;
+        statistics stats_;
+        std::atomic<u64> cached_updates_{0u};
+        std::atomic<u64> evaluated_updates_{0u};
+    };
+
+    //
+    // spine_pose_cache
+    //
+
+    spine_pose_cache::spine_pose_cache(spine::skeleton_data_ptr skeleton)
+    : state_(std::make_shared<internal_state>(std::move(skeleton))) {}
+
+    spine_pose_cache::~spine_pose_cache() noexcept = default;
+
+    spine_pose_cache::baked_animation_ptr spine_pose_cache::find_or_bake(
+        const spAnimation* animation,
+        const spSkin* skin,
+        f32 sample_rate)
+    {
+        return state_->find_or_bake(animation, skin, sample_rate);
+    }
+
+    spine_pose_cache::baked_animation_ptr spine_pose_cache::find_or_bake_async(
+        const spAnimation* animation,
+        const spSkin* skin,
+        f32 sample_rate)
+    {
+        return state_->find_or_bake_async(animation, skin, sample_rate);
+    }
+
+    spine_pose_cache::baked_animation_ptr spine_pose_cache::find_or_bake(
+        str_view animation,
+        str_view skin,
+        f32 sample_rate)
+    {
+        spSkeletonData* skeleton_data = state_->skeleton().get();
+        if ( !skeleton_data ) {
+            return nullptr;
+        }
+
+        const spAnimation* anim = spSkeletonData_findAnimation(
+            skeleton_data, str(animation).c_str());
+        if ( !anim ) {
+            return nullptr;
+        }
+
+        const spSkin* sk = nullptr;
+        if ( !skin.empty() ) {
+            sk = spSkeletonData_findSkin(skeleton_data, str(skin).c_str());
+            if ( !sk ) {
+                return nullptr;
+            }
+        }
+
+        return state_->find_or_bake(anim, sk, sample_rate);
+    }
+
+    void spine_pose_cache::register_update(bool cached) noexcept {
+        state_->register_update(cached);
+    }
+
+    spine_pose_cache::statistics spine_pose_cache::stats() const {
+        return state_->stats();
+    }
+}
@@ -5,12 +5,14 @@
  ******************************************************************************/
 
 #include <enduro2d/high/starter.hpp>
+#include <enduro2d/high/dynamic_atlas.hpp>
 
 #include <enduro2d/high/editor.hpp>
 #include <enduro2d/high/factory.hpp>
 #include <enduro2d/high/inspector.hpp>
 #include <enduro2d/high/library.hpp>
 #include <enduro2d/high/luasol.hpp>
+#include <enduro2d/high/streamer.hpp>
 #include <enduro2d/high/world.hpp>
 
 #include <enduro2d/high/components/actor.hpp>
@@ -41,6 +43,7 @@
 #include <enduro2d/high/systems/render_system.hpp>
 #include <enduro2d/high/systems/script_system.hpp>
 #include <enduro2d/high/systems/spine_system.hpp>
+#include <enduro2d/high/systems/streaming_system.hpp>
 #include <enduro2d/high/systems/touch_system.hpp>
 #include <enduro2d/high/systems/widget_system.hpp>
 #include <enduro2d/high/systems/world_system.hpp>
@@ -81,6 +84,8 @@ namespace
                     .add_system<script_system>())
                 .feature<struct spine_feature>(ecs::feature()
                     .add_system<spine_system>())
+                .feature<struct streaming_feature>(ecs::feature()
+                    .add_system<streaming_system>())
                 .feature<struct touch_feature>(ecs::feature()
                     .add_system<touch_system>())
                 .feature<struct widget_feature>(ecs::feature()
@@ -98,6 +103,7 @@ namespace
 
         bool frame_tick() final {
             E2D_PROFILER_SCOPE("application.frame_tick");
+            the<library>().frame_tick();
             the<world>().registry().process_event(systems::frame_update_event{});
             return !the<window>().should_close()
                 || (application_ && !application_->on_should_close());
@@ -143,10 +149,37 @@ namespace e2d
         return *this;
     }
 
+    starter::library_parameters& starter::library_parameters::image_conversion(image_conversion_options value) noexcept {
+        image_conversion_ = std::move(value);
+        return *this;
+    }
+
+    starter::library_parameters& starter::library_parameters::expand_rgb_images(bool value) noexcept {
+        expand_rgb_images_ = value;
+        return *this;
+    }
+
+    starter::library_parameters& starter::library_parameters::hot_reload(bool value) noexcept {
+        hot_reload_ = value;
+        return *this;
+    }
+
     const url& starter::library_parameters::root() const noexcept {
         return root_;
     }
 
+    const image_conversion_options& starter::library_parameters::image_conversion() const noexcept {
+        return image_conversion_;
+    }
+
+    bool starter::library_parameters::expand_rgb_images() const noexcept {
+        return expand_rgb_images_;
+    }
+
+    bool starter::library_parameters::hot_reload() const noexcept {
+        return hot_reload_;
+    }
+
     //
     // starter::parameters
     //
@@ -247,9 +280,17 @@ namespace e2d
 
         safe_module_initialize<luasol>();
 
+        if ( modules::is_initialized<render>() ) {
+            safe_module_initialize<dynamic_atlas>();
+        }
+
         safe_module_initialize<library>(
             params.library_params());
 
+        safe_module_initialize<streamer>(
+            the<debug>(),
+            the<library>());
+
         safe_module_initialize<world>();
         safe_module_initialize<editor>();
     }
@@ -260,7 +301,9 @@ namespace e2d
         modules::shutdown<
             editor,
             world,
+            streamer,
             library,
+            dynamic_atlas,
             luasol,
             inspector,
             factory,
@@ -0,0 +1,494 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/high/streamer.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    f32 focus_distance(const vector<v2f>& points, const v2f& center) noexcept {
+        f32 result = std::numeric_limits<f32>::max();
+        for ( const v2f& p : points ) {
+            result = math::min(result, math::distance(p, center));
+        }
+        return result;
+    }
+}
+
+namespace e2d
+{
+    //
+    // streamer::group
+    //
+
+    streamer::group& streamer::group::assets(asset_dependencies value) noexcept {
+        assets_ = std::move(value);
+        return *this;
+    }
+
+    streamer::group& streamer::group::region(const v2f& center, f32 radius) noexcept {
+        center_ = center;
+        radius_ = math::max(radius, 0.f);
+        return *this;
+    }
+
+    streamer::group& streamer::group::release_radius(f32 value) noexcept {
+        release_radius_ = math::max(value, 0.f);
+        return *this;
+    }
+
+    streamer::group& streamer::group::scene(str_view value) {
+        scene_ = value;
+        return *this;
+    }
+
+    streamer::group& streamer::group::priority(i32 value) noexcept {
+        priority_ = value;
+        return *this;
+    }
+
+    streamer::group& streamer::group::memory_size(std::size_t value) noexcept {
+        memory_size_ = value;
+        return *this;
+    }
+
+    const asset_dependencies& streamer::group::assets() const noexcept {
+        return assets_;
+    }
+
+    const v2f& streamer::group::center() const noexcept {
+        return center_;
+    }
+
+    f32 streamer::group::radius() const noexcept {
+        return radius_;
+    }
+
+    f32 streamer::group::release_radius() const noexcept {
+        return math::max(radius_, release_radius_);
+    }
+
+    const str& streamer::group::scene() const noexcept {
+        return scene_;
+    }
+
+    i32 streamer::group::priority() const noexcept {
+        return priority_;
+    }
+
+    std::size_t streamer::group::memory_size() const noexcept {
+        return memory_size_;
+    }
+
+    //
+    // streamer::internal_state
+    //
+
+    class streamer::internal_state final : private e2d::noncopyable {
+    public:
+        internal_state(debug& d, library& l)
+        : debug_(d)
+        , library_(l) {}
+
+        ~internal_state() noexcept {
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+            lifetime_->alive = false;
+            for ( auto& [key, record] : groups_ ) {
+                E2D_UNUSED(key);
+                if ( record.token ) {
+                    record.token->cancel();
+                }
+            }
+        }
+    public:
+        void add_group(str_view name, const group& params) {
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+            group_record& record = groups_[make_hash(name)];
+            release_group_(record);
+            record.name = name;
+            record.params = params;
+            record.state = group_states::unloaded;
+        }
+
+        bool remove_group(str_view name) {
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+            const auto iter = groups_.find(make_hash(name));
+            if ( iter == groups_.end() ) {
+                return false;
+            }
+            release_group_(iter->second);
+            groups_.erase(iter);
+            return true;
+        }
+
+        bool has_group(str_view name) const noexcept {
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+            return groups_.count(make_hash(name)) > 0u;
+        }
+
+        group_states group_state(str_view name) const noexcept {
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+            const auto iter = groups_.find(make_hash(name));
+            return iter != groups_.end()
+                ? iter->second.state
+                : group_states::unloaded;
+        }
+
+        asset_group group_assets(str_view name) const {
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+            const auto iter = groups_.find(make_hash(name));
+            return iter != groups_.end()
+                ? iter->second.assets
+                : asset_group();
+        }
+
+        void memory_budget(std::size_t value) noexcept {
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+            memory_budget_ = value;
+        }
+
+        std::size_t memory_budget() const noexcept {
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+            return memory_budget_;
+        }
+
+        void focus(vector<v2f> points) {
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+            focus_ = std::move(points);
+        }
+
+        const vector<v2f>& focus() const noexcept {
+            return focus_;
+        }
+
+        void activate_scene(str_view name) {
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+            scenes_.insert(make_hash(name));
+        }
+
+        void deactivate_scene(str_view name) {
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+            scenes_.erase(make_hash(name));
+        }
+
+        bool is_scene_active(str_view name) const noexcept {
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+            return scenes_.count(make_hash(name)) > 0u;
+        }
+
+        const statistics& stats() const noexcept {
+            return stats_;
+        }
+
+        void frame_tick() {
+            E2D_PROFILER_SCOPE("streamer.frame_tick");
+            std::lock_guard<std::recursive_mutex> guard(lifetime_->mutex);
+
+            bool released = false;
+            candidates_.clear();
+
+            for ( auto& [key, record] : groups_ ) {
+                E2D_UNUSED(key);
+                update_distance_(record);
+
+                if ( !record.keep ) {
+                    if ( record.state == group_states::loading
+                        || record.state == group_states::loaded )
+                    {
+                        released = true;
+                        release_group_(record);
+                    }
+                    // failed groups are retried only after they were left
+                    record.state = group_states::unloaded;
+                }
+
+                if ( record.wanted && record.state == group_states::unloaded ) {
+                    candidates_.push_back(&record);
+                }
+            }
+
+            std::sort(candidates_.begin(), candidates_.end(), [](
+                const group_record* l,
+                const group_record* r) noexcept
+            {
+                return l->params.priority() != r->params.priority()
+                    ? l->params.priority() > r->params.priority()
+                    : l->distance < r->distance;
+            });
+
+            for ( group_record* record : candidates_ ) {
+                if ( memory_budget_ > 0u ) {
+                    while ( resident_memory_() + record->params.memory_size() > memory_budget_ ) {
+                        if ( !evict_group_() ) {
+                            break;
+                        }
+                        released = true;
+                    }
+                    if ( resident_memory_() + record->params.memory_size() > memory_budget_ ) {
+                        continue;
+                    }
+                }
+                start_loading_(*record);
+            }
+
+            if ( released ) {
+                library_.unload_unused_assets();
+            }
+
+            update_stats_();
+        }
+    private:
+        struct group_record {
+            str name;
+            group params;
+            group_states state{group_states::unloaded};
+            asset_group assets;
+            loading_token_iptr token;
+            std::size_t generation{0u};
+            unit<i64, microseconds_tag> load_start;
+            f32 distance{0.f};
+            bool wanted{false};
+            bool keep{false};
+        };
+
+        // load callbacks can outlive the streamer, so they share its mutex
+        struct lifetime {
+            std::recursive_mutex mutex;
+            bool alive{true};
+        };
+    private:
+        void update_distance_(group_record& record) const noexcept {
+            if ( !record.params.scene().empty() ) {
+                const bool active = scenes_.count(make_hash(record.params.scene())) > 0u;
+                record.distance = active ? 0.f : std::numeric_limits<f32>::max();
+                record.wanted = active;
+                record.keep = active;
+            } else {
+                record.distance = focus_distance(focus_, record.params.center());
+                record.wanted = record.distance <= record.params.radius();
+                record.keep = record.distance <= record.params.release_radius();
+            }
+        }
+
+        std::size_t resident_memory_() const noexcept {
+            std::size_t result{0u};
+            for ( const auto& [key, record] : groups_ ) {
+                E2D_UNUSED(key);
+                if ( record.state == group_states::loading
+                    || record.state == group_states::loaded )
+                {
+                    result += record.params.memory_size();
+                }
+            }
+            return result;
+        }
+
+        // releases the farthest group that is kept by the hysteresis only
+        bool evict_group_() noexcept {
+            group_record* victim = nullptr;
+            for ( auto& [key, record] : groups_ ) {
+                E2D_UNUSED(key);
+                const bool resident =
+                    record.state == group_states::loading ||
+                    record.state == group_states::loaded;
+                if ( resident && !record.wanted
+                    && (!victim || victim->distance < record.distance) )
+                {
+                    victim = &record;
+                }
+            }
+            if ( !victim ) {
+                return false;
+            }
+            release_group_(*victim);
+            return true;
+        }
+
+        void start_loading_(group_record& record) {
+            record.state = group_states::loading;
+            record.token = make_intrusive<loading_token>(record.params.priority());
+            record.load_start = time::now_us();
+
+            const str_hash key = make_hash(record.name);
+            const std::size_t generation = ++record.generation;
+
+            record.params.assets().load_async(library_, record.token)
+            .then([this, lifetime = lifetime_, key, generation](const asset_group& assets){
+                std::lock_guard<std::recursive_mutex> guard(lifetime->mutex);
+                if ( lifetime->alive ) {
+                    on_group_loaded_(key, generation, &assets);
+                }
+            }).except([this, lifetime = lifetime_, key, generation](std::exception_ptr e){
+                E2D_UNUSED(e);
+                std::lock_guard<std::recursive_mutex> guard(lifetime->mutex);
+                if ( lifetime->alive ) {
+                    on_group_loaded_(key, generation, nullptr);
+                }
+            });
+        }
+
+        void on_group_loaded_(str_hash key, std::size_t generation, const asset_group* assets) {
+            const auto iter = groups_.find(key);
+            if ( iter == groups_.end()
+                || iter->second.generation != generation
+                || iter->second.state != group_states::loading )
+            {
+                return;
+            }
+
+            group_record& record = iter->second;
+            record.token.reset();
+
+            if ( !assets ) {
+                record.state = group_states::failed;
+                debug_.error("STREAMER: Failed to load asset group:\n"
+                    "--> Group: %0",
+                    record.name);
+                return;
+            }
+
+            record.state = group_states::loaded;
+            record.assets = *assets;
+
+            const f32 latency = static_cast<f32>(
+                (time::now_us() - record.load_start).value) * 0.000001f;
+            stats_.last_load_latency = latency;
+            stats_.max_load_latency = math::max(stats_.max_load_latency, latency);
+            ++stats_.loaded_groups;
+
+            E2D_PROFILER_GLOBAL_EVENT_EX("streamer.group_loaded", {
+                {"group", record.name},
+                {"latency", std::to_string(latency)}});
+        }
+
+        void release_group_(group_record& record) noexcept {
+            if ( record.token ) {
+                record.token->cancel();
+                record.token.reset();
+            }
+            if ( record.state == group_states::loaded ) {
+                ++stats_.released_groups;
+            }
+            record.state = group_states::unloaded;
+            record.assets = asset_group();
+            ++record.generation;
+        }
+
+        void update_stats_() {
+            statistics stats = stats_;
+            stats.groups = groups_.size();
+            stats.resident_groups = 0u;
+            stats.loading_groups = 0u;
+            stats.resident_memory = resident_memory_();
+            for ( const auto& [key, record] : groups_ ) {
+                E2D_UNUSED(key);
+                if ( record.state == group_states::loaded ) {
+                    ++stats.resident_groups;
+                } else if ( record.state == group_states::loading ) {
+                    ++stats.loading_groups;
+                }
+            }
+
+            if ( stats.resident_groups != stats_.resident_groups
+                || stats.loading_groups != stats_.loading_groups
+                || stats.resident_memory != stats_.resident_memory )
+            {
+                E2D_PROFILER_GLOBAL_EVENT_EX("streamer.residency", {
+                    {"resident", std::to_string(stats.resident_groups)},
+                    {"loading", std::to_string(stats.loading_groups)},
+                    {"memory", std::to_string(stats.resident_memory)}});
+            }
+
+            stats_ = stats;
+        }
+    private:
+        debug& debug_;
+        library& library_;
+        std::shared_ptr<lifetime> lifetime_{std::make_shared<lifetime>()};
+        hash_map<str_hash, group_record> groups_;
+        vector<group_record*> candidates_;
+        flat_set<str_hash> scenes_;
+        vector<v2f> focus_;
+        std::size_t memory_budget_{0u};
+        statistics stats_;
+    };
+
+    //
+    // streamer
+    //
+
+    streamer::streamer(debug& d, library& l)
+    : state_(new internal_state(d, l)) {}
+    streamer::~streamer() noexcept = default;
+
+    streamer& streamer::add_group(str_view name, const group& params) {
+        state_->add_group(name, params);
+        return *this;
+    }
+
+    bool streamer::remove_group(str_view name) {
+        return state_->remove_group(name);
+    }
+
+    bool streamer::has_group(str_view name) const noexcept {
+        return state_->has_group(name);
+    }
+
+    streamer::group_states streamer::group_state(str_view name) const noexcept {
+        return state_->group_state(name);
+    }
+
+    asset_group streamer::group_assets(str_view name) const {
+        return state_->group_assets(name);
+    }
+
+    streamer& streamer::memory_budget(std::size_t value) noexcept {
+        state_->memory_budget(value);
+        return *this;
+    }
+
+    std::size_t streamer::memory_budget() const noexcept {
+        return state_->memory_budget();
+    }
+
+    streamer& streamer::focus(vector<v2f> points) {
+        state_->focus(std::move(points));
+        return *this;
+    }
+
+    const vector<v2f>& streamer::focus() const noexcept {
+        return state_->focus();
+    }
+
+    streamer& streamer::activate_scene(str_view name) {
+        state_->activate_scene(name);
+        return *this;
+    }
+
+    streamer& streamer::deactivate_scene(str_view name) {
+        state_->deactivate_scene(name);
+        return *this;
+    }
+
+    bool streamer::is_scene_active(str_view name) const noexcept {
+        return state_->is_scene_active(name);
+    }
+
+    const streamer::statistics& streamer::stats() const noexcept {
+        return state_->stats();
+    }
+
+    void streamer::frame_tick() noexcept {
+        try {
+            state_->frame_tick();
+        } catch ( const std::exception& e ) {
+            the<debug>().error("STREAMER: Failed to update asset groups:\n"
+                "--> Exception: %0",
+                e.what());
+        }
+    }
+}
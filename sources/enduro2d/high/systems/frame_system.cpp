@@ -6,6 +6,7 @@
 
 #include <enduro2d/high/systems/frame_system.hpp>
 
+#include <enduro2d/high/components/actor.hpp>
 #include <enduro2d/high/components/camera.hpp>
 #include <enduro2d/high/components/disabled.hpp>
 
@@ -58,26 +59,41 @@ namespace e2d
         ~internal_state() noexcept = default;
 
         void process_frame_update(ecs::registry& owner) {
-            const f32 dt = engine_.delta_time();
-            const f32 time = engine_.time();
-
-            {
-                E2D_PROFILER_SCOPE("ecs.pre_update");
-                owner.process_event(systems::pre_update_event{dt,time});
+            if ( !engine_.fixed_update() ) {
+                prev_transforms_.clear();
+                process_tick(
+                    owner,
+                    engine_.delta_time(),
+                    engine_.time(),
+                    engine_.frame_count(),
+                    1.f);
+                return;
             }
 
-            {
-                E2D_PROFILER_SCOPE("ecs.update");
-                owner.process_event(systems::update_event{dt,time});
-            }
-
-            {
-                E2D_PROFILER_SCOPE("ecs.post_update");
-                owner.process_event(systems::post_update_event{dt,time});
+            const f32 dt = engine_.fixed_delta_time();
+            const u32 first_tick = engine_.tick_count();
+            const u32 tick_count = engine_.frame_tick_count();
+            const f32 alpha = engine_.tick_alpha();
+
+            for ( u32 i = 0; i < tick_count; ++i ) {
+                const u32 tick = first_tick + i;
+                if ( i + 1 == tick_count ) {
+                    // only the state before the last tick is interpolated from
+                    capture_transforms(owner);
+                }
+                process_tick(owner, dt, dt * math::numeric_cast<f32>(tick + 1u), tick, alpha);
             }
         }
 
         void process_frame_render(ecs::registry& owner) {
+            E2D_DEFER([this](){
+                restore_transforms();
+            });
+
+            if ( engine_.fixed_update() ) {
+                interpolate_transforms(owner, engine_.tick_alpha());
+            }
+
             clear_framebuffer(render_, window_);
 
             {
@@ -95,10 +111,82 @@ namespace e2d
                 for_all_cameras<systems::post_render_event>(owner);
             }
         }
+    private:
+        struct node_transform {
+            node_iptr node;
+            t2f transform;
+        };
+
+        void process_tick(ecs::registry& owner, f32 dt, f32 time, u32 tick, f32 alpha) {
+            {
+                E2D_PROFILER_SCOPE("ecs.pre_update");
+                owner.process_event(systems::pre_update_event{dt,time,tick,alpha});
+            }
+
+            {
+                E2D_PROFILER_SCOPE("ecs.update");
+                owner.process_event(systems::update_event{dt,time,tick,alpha});
+            }
+
+            {
+                E2D_PROFILER_SCOPE("ecs.post_update");
+                owner.process_event(systems::post_update_event{dt,time,tick,alpha});
+            }
+        }
+
+        void capture_transforms(ecs::registry& owner) {
+            E2D_PROFILER_SCOPE("frame_system.capture_transforms");
+
+            prev_transforms_.clear();
+            owner.for_each_component<actor>([this](
+                const ecs::const_entity&,
+                actor& a)
+            {
+                if ( a.node() ) {
+                    prev_transforms_.push_back({a.node(), a.node()->transform()});
+                }
+            });
+        }
+
+        void interpolate_transforms(ecs::registry& owner, f32 alpha) {
+            E2D_PROFILER_SCOPE("frame_system.interpolate_transforms");
+
+            for ( const node_transform& prev : prev_transforms_ ) {
+                const t2f curr = prev.node->transform();
+                if ( curr != prev.transform ) {
+                    curr_transforms_.push_back({prev.node, curr});
+                    prev.node->transform(math::lerp(prev.transform, curr, alpha));
+                }
+            }
+
+            if ( curr_transforms_.empty() ) {
+                return;
+            }
+
+            // camera views are taken from the node matrices on update
+            owner.for_joined_components<camera, actor>([](
+                const ecs::const_entity&,
+                camera& c,
+                const actor& a)
+            {
+                if ( a.node() ) {
+                    c.view(math::inversed(a.node()->world_matrix()).first);
+                }
+            });
+        }
+
+        void restore_transforms() noexcept {
+            for ( const node_transform& curr : curr_transforms_ ) {
+                curr.node->transform(curr.transform);
+            }
+            curr_transforms_.clear();
+        }
     private:
         engine& engine_;
         render& render_;
         window& window_;
+        vector<node_transform> prev_transforms_;
+        vector<node_transform> curr_transforms_;
     };
 
     //
@@ -180,13 +180,13 @@ namespace
         const v4f outline_color = make_vec4(color(l.outline_color()));
 
         r.properties(render::property_block()
-            .sampler("u_texture", render::sampler_state()
+            .sampler("u_texture"_hash, render::sampler_state()
                 .texture(texture)
                 .min_filter(render::sampler_min_filter::linear)
                 .mag_filter(render::sampler_mag_filter::linear))
-            .property("u_glyph_dilate", glyph_dilate)
-            .property("u_outline_width", outline_width)
-            .property("u_outline_color", outline_color));
+            .property("u_glyph_dilate"_hash, glyph_dilate)
+            .property("u_outline_width"_hash, outline_width)
+            .property("u_outline_color"_hash, outline_color));
     }
 
     void update_label_geometry(const label& l, model_renderer& mr, geometry_builder& gb) {
@@ -207,13 +207,8 @@ namespace
             f32 kerning{0.f};
         };
 
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local vector<glyph_desc> glyphs;
-        glyphs.clear();
-
-        if ( glyphs.capacity() < text.size() ) {
-            glyphs.reserve(math::max(glyphs.capacity() * 2u, text.size()));
-        }
+        frame_vector<glyph_desc> glyphs;
+        glyphs.reserve(text.size());
 
         for ( std::size_t i = 0, e = text.size(); i < e; ++i ) {
             glyph_desc desc;
@@ -248,14 +243,8 @@ namespace
             : start(start) {}
         };
 
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local vector<string_desc> strings;
-        strings.clear();
-
-        const std::size_t string_count = calculate_string_count(text);
-        if ( strings.capacity() < string_count ) {
-            strings.reserve(math::max(strings.capacity() * 2u, string_count));
-        }
+        frame_vector<string_desc> strings;
+        strings.reserve(calculate_string_count(text));
 
         f32 last_space_width = 0.f;
         std::size_t last_space_index = std::size_t(-1);
@@ -363,7 +352,7 @@ namespace
             update_label_geometry(l, mr, gb);
             gb.clear();
         });
-        owner.remove_all_components<label::dirty>();
+        ecsex::remove_all_components<label::dirty>(owner);
     }
 }
 
@@ -153,12 +153,12 @@ namespace
                 disabled<actor>,
                 disabled<widget>>());
 
-        owner.for_joined_components<widget, actor>([](
+        owner.for_joined_components<widget, actor>([
             ecs::entity e,
             const widget&,
             const actor& a)
         {
-            e.ensure_component<yogo_node>();
+            ecsex::ensure_component<yogo_node>(e);
             if ( a.node() && a.node()->owner() ) {
                 gcomponent<layout> l{a.node()->owner()};
                 gcomponent<widget> w{a.node()->owner()};
@@ -171,41 +171,136 @@ namespace
             disabled<widget>>());
     }
 
-    void update_dirty_layouts(ecs::registry& owner) {
-        owner.for_joined_components<layout::dirty, yogo_node, layout, widget, actor>([](
+    YGNodeRef find_parent_yogo_root(const actor& a) noexcept {
+        const const_node_iptr parent = a.node()
+            ? a.node()->parent()
+            : nullptr;
+        if ( !parent || !parent->owner() ) {
+            return nullptr;
+        }
+        const_gcomponent<layout> parent_l{parent->owner()};
+        const_gcomponent<yogo_node> parent_yn{parent->owner()};
+        return parent_l && parent_yn
+            ? parent_yn->as_root.get()
+            : nullptr;
+    }
+
+    void update_yogo_owners(ecs::registry& owner) {
+        owner.for_joined_components<yogo_node, widget, actor>([](
             const ecs::const_entity&,
-            const layout::dirty&,
+            const yogo_node& yn,
+            const widget&,
+            const actor& a)
+        {
+            const YGNodeRef item = yn.as_item.get();
+            const YGNodeRef item_owner = YGNodeGetOwner(item);
+            const YGNodeRef parent_root = find_parent_yogo_root(a);
+            if ( item_owner == parent_root ) {
+                return;
+            }
+
+            // detaching marks the previous root as dirty for yoga,
+            // so it will be picked up by update_dirty_layouts
+            if ( item_owner ) {
+                YGNodeRemoveChild(item_owner, item);
+            }
+
+            if ( parent_root && a.node() && a.node()->owner() ) {
+                gcomponent<widget> w{a.node()->owner()};
+                layouts::mark_dirty(widgets::find_parent_layout(w));
+            }
+        }, !ecs::exists_any<
+            disabled<actor>,
+            disabled<widget>>());
+    }
+
+    void update_yogo_children(const yogo_node& root_yn, const frame_vector<gcomponent<widget>>& item_ws) {
+        const YGNodeRef root = root_yn.as_root.get();
+
+        u32 index = 0;
+        for ( const auto& item_w : item_ws ) {
+            const_gcomponent<actor> item_a{item_w.owner()};
+            const_gcomponent<yogo_node> item_yn{item_w.owner()};
+            if ( !item_a || !item_yn ) {
+                continue;
+            }
+
+            update_yogo_widget(*item_yn, *item_w, *item_a);
+
+            const YGNodeRef item = item_yn->as_item.get();
+            if ( index >= YGNodeGetChildCount(root) || YGNodeGetChild(root, index) != item ) {
+                if ( const YGNodeRef item_owner = YGNodeGetOwner(item) ) {
+                    YGNodeRemoveChild(item_owner, item);
+                }
+                YGNodeInsertChild(root, item, index);
+            }
+            ++index;
+        }
+
+        while ( YGNodeGetChildCount(root) > index ) {
+            YGNodeRemoveChild(root, YGNodeGetChild(root, YGNodeGetChildCount(root) - 1));
+        }
+    }
+
+    std::size_t get_node_depth(const const_node_iptr& n) noexcept {
+        std::size_t depth = 0u;
+        for ( const_node_iptr p = n ? n->parent() : nullptr; p; p = p->parent() ) {
+            ++depth;
+        }
+        return depth;
+    }
+
+    void update_dirty_layouts(ecs::registry& owner) {
+        struct dirty_root {
+            std::size_t depth;
+            bool marked;
+            ecs::entity entity;
+        };
+
+        frame_vector<dirty_root> dirty_roots;
+
+        owner.for_joined_components<yogo_node, layout, widget, actor>([&dirty_roots](
+            const ecs::entity& e,
             const yogo_node& root_yn,
-            const layout& root_l,
-            const widget& root_w,
+            const layout&,
+            const widget&,
             const actor& root_a)
         {
-            static thread_local vector<gcomponent<widget>> item_ws;
-            E2D_DEFER([](){ item_ws.clear(); });
+            const bool marked = e.exists_component<layout::dirty>();
+            if ( marked || YGNodeIsDirty(root_yn.as_root.get()) ) {
+                dirty_roots.push_back({get_node_depth(root_a.node()), marked, e});
+            }
+        }, !ecs::exists_any<
+            disabled<actor>,
+            disabled<widget>>());
+
+        // outer layouts first, so every root is calculated once per frame
+        std::stable_sort(dirty_roots.begin(), dirty_roots.end(), [](
+            const dirty_root& l,
+            const dirty_root& r) noexcept
+        {
+            return l.depth < r.depth;
+        });
+
+        frame_vector<gcomponent<widget>> item_ws;
+        for ( const dirty_root& dr : dirty_roots ) {
+            const yogo_node& root_yn = dr.entity.get_component<yogo_node>();
+            const layout& root_l = dr.entity.get_component<layout>();
+            const widget& root_w = dr.entity.get_component<widget>();
+            const actor& root_a = dr.entity.get_component<actor>();
 
+            item_ws.clear();
             nodes::extract_components_from_children<widget>(
                 root_a.node(),
                 std::back_inserter(item_ws));
 
-            E2D_DEFER([&root_yn](){
-                YGNodeRemoveAllChildren(root_yn.as_root.get());
-            });
-
             update_yogo_layout(root_yn, root_l, root_w);
+            update_yogo_children(root_yn, item_ws);
 
-            for ( const auto& item_w : item_ws ) {
-                const_gcomponent<actor> item_a{item_w.owner()};
-                const_gcomponent<yogo_node> item_yn{item_w.owner()};
-                if ( item_a && item_yn ) {
-                    update_yogo_widget(
-                        *item_yn,
-                        *item_w,
-                        *item_a);
-                    YGNodeInsertChild(
-                        root_yn.as_root.get(),
-                        item_yn->as_item.get(),
-                        YGNodeGetChildCount(root_yn.as_root.get()));
-                }
+            // nothing to recalculate for yoga, but explicitly marked roots
+            // still have to place their children again
+            if ( !dr.marked && !YGNodeIsDirty(root_yn.as_root.get()) ) {
+                continue;
             }
 
             YGNodeCalculateLayout(
@@ -218,14 +313,17 @@ namespace
                 gcomponent<actor> item_a{item_w.owner()};
                 const_gcomponent<yogo_node> item_yn{item_w.owner()};
                 if ( item_a && item_a->node() && item_yn && item_yn->as_item ) {
-                    item_a->node()->translation(v2f(
+                    const v2f translation(
                         YGNodeLayoutGetLeft(item_yn->as_item.get()),
-                        YGNodeLayoutGetTop(item_yn->as_item.get())));
+                        YGNodeLayoutGetTop(item_yn->as_item.get()));
+                    if ( item_a->node()->translation() != translation ) {
+                        item_a->node()->translation(translation);
+                    }
                 }
             }
-        });
+        }
 
-        owner.remove_all_components<layout::dirty>();
+        ecsex::remove_all_components<layout::dirty>(owner);
     }
 }
 
@@ -242,6 +340,7 @@ namespace e2d
 
         void process_update(ecs::registry& owner) {
             update_yogo_nodes(owner);
+            update_yogo_owners(owner);
             update_dirty_layouts(owner);
         }
     };
@@ -6,52 +6,17 @@
 
 #include <enduro2d/high/systems/render_system.hpp>
 
-#include <enduro2d/high/components/actor.hpp>
 #include <enduro2d/high/components/camera.hpp>
-#include <enduro2d/high/components/disabled.hpp>
-#include <enduro2d/high/components/scene.hpp>
 
 #include "render_system_impl/render_system_base.hpp"
 #include "render_system_impl/render_system_batcher.hpp"
 #include "render_system_impl/render_system_drawer.hpp"
+#include "render_system_impl/render_system_queue.hpp"
 
 namespace
 {
     using namespace e2d;
     using namespace e2d::render_system_impl;
-
-    void for_all_children(
-        const const_node_iptr& root,
-        drawer::context& ctx)
-    {
-        ctx.draw(root);
-
-        nodes::for_each_child(root, [&ctx](const const_node_iptr& child){
-            for_all_children(child, ctx);
-        });
-    }
-
-    void for_all_scenes(drawer::context& ctx, const ecs::registry& owner) {
-        const auto comp = [](const auto& l, const auto& r) noexcept {
-            return std::get<scene>(l).depth() < std::get<scene>(r).depth();
-        };
-
-        const auto func = [&ctx](
-            const ecs::const_entity&,
-            const scene&,
-            const actor& scene_a)
-        {
-            for_all_children(scene_a.node(), ctx);
-        };
-
-        ecsex::for_extracted_sorted_components<scene, actor>(
-            owner,
-            comp,
-            func,
-            !ecs::exists_any<
-                disabled<actor>,
-                disabled<scene>>());
-    }
 }
 
 namespace e2d
@@ -70,14 +35,18 @@ namespace e2d
             if ( !cam_e.valid() || !cam_e.exists_component<camera>() ) {
                 return;
             }
+            queue_.update(owner);
             drawer_.with(
                 cam_e.get_component<camera>(),
-                [&owner](drawer::context& ctx){
-                    for_all_scenes(ctx, owner);
+                [this](drawer::context& ctx){
+                    for ( const render_queue::item& item : queue_.items() ) {
+                        ctx.draw(item);
+                    }
                 });
         }
     private:
         drawer drawer_;
+        render_queue queue_;
     };
 
     //
@@ -46,19 +46,18 @@ namespace e2d::render_system_impl
             std::size_t count{0u};
             material_asset::ptr material;
             render::property_block properties;
-
-            batch_type(
-                std::size_t nstart,
-                const material_asset::ptr& nmaterial,
-                const render::property_block& nproperties)
-            : start(nstart)
-            , material(nmaterial)
-            , properties(nproperties) {}
         };
+        batch_type& push_batch_(
+            std::size_t start,
+            const material_asset::ptr& material,
+            const render::property_block& properties);
     private:
         debug& debug_;
         render& render_;
+        // batch slots are reused between flushes to keep the capacity
+        // of their property blocks, only first batch_count_ are alive
         vector<batch_type> batches_;
+        std::size_t batch_count_{0u};
         vector<index_type> indices_;
         vector<vertex_type> vertices_;
         index_declaration index_decl_;
@@ -111,15 +110,16 @@ namespace e2d::render_system_impl
         });
 
         const bool batching_available =
-            !batches_.empty() &&
-            (batches_.back().material == material || batches_.back().material->content() == material->content()) &&
-            batches_.back().properties == properties;
+            batch_count_ > 0u &&
+            (batches_[batch_count_ - 1u].material == material ||
+                batches_[batch_count_ - 1u].material->content() == material->content()) &&
+            batches_[batch_count_ - 1u].properties == properties;
 
         if ( !batching_available ) {
-            const std::size_t start = batches_.empty()
-                ? 0u
-                : batches_.back().start + batches_.back().count;
-            batches_.emplace_back(start, material, properties);
+            const std::size_t start = batch_count_ > 0u
+                ? batches_[batch_count_ - 1u].start + batches_[batch_count_ - 1u].count
+                : 0u;
+            push_batch_(start, material, properties);
         }
 
         if ( indices && index_count ) {
@@ -131,7 +131,7 @@ namespace e2d::render_system_impl
                 [add = vertices_.size()](index_type v) noexcept {
                     return static_cast<index_type>(v + add);
                 });
-            batches_.back().count += index_count;
+            batches_[batch_count_ - 1u].count += index_count;
         }
 
         if ( vertices && vertex_count ) {
@@ -155,7 +155,11 @@ namespace e2d::render_system_impl
 
     template < typename Index, typename Vertex >
     void batcher<Index, Vertex>::clear(bool clear_internal_props) noexcept {
-        batches_.clear();
+        for ( std::size_t i = 0; i < batch_count_; ++i ) {
+            batches_[i].material.reset();
+            batches_[i].properties.clear();
+        }
+        batch_count_ = 0u;
         indices_.clear();
         vertices_.clear();
         if ( clear_internal_props ) {
@@ -163,6 +167,24 @@ namespace e2d::render_system_impl
         }
     }
 
+    template < typename Index, typename Vertex >
+    typename batcher<Index, Vertex>::batch_type& batcher<Index, Vertex>::push_batch_(
+        std::size_t start,
+        const material_asset::ptr& material,
+        const render::property_block& properties)
+    {
+        if ( batch_count_ == batches_.size() ) {
+            batches_.emplace_back();
+        }
+        batch_type& batch = batches_[batch_count_];
+        batch.start = start;
+        batch.count = 0u;
+        batch.material = material;
+        batch.properties = properties;
+        ++batch_count_;
+        return batch;
+    }
+
     template < typename Index, typename Vertex >
     void batcher<Index, Vertex>::update_buffers_() {
         update_index_buffer_();
@@ -183,7 +205,8 @@ namespace e2d::render_system_impl
             property_cache_.clear();
         });
 
-        for ( const batch_type& batch : batches_ ) {
+        for ( std::size_t i = 0; i < batch_count_; ++i ) {
+            const batch_type& batch = batches_[i];
             const render::material& mat = batch.material->content();
             render_.execute(render::draw_command(
                 mat,
@@ -206,11 +229,11 @@ namespace e2d::render_system_impl
                 index_buffer_ ? index_buffer_->buffer_size() : 0u,
                 min_ib_size);
 
-            buffer new_ib_data(new_ib_size);
+            frame_vector<u8> new_ib_data(new_ib_size);
             std::memcpy(new_ib_data.data(), indices_.data(), min_ib_size);
 
             index_buffer_ = render_.create_index_buffer(
-                new_ib_data,
+                buffer_view(new_ib_data.data(), new_ib_data.size()),
                 index_decl_,
                 index_buffer::usage::dynamic_draw);
 
@@ -233,11 +256,11 @@ namespace e2d::render_system_impl
                 vertex_buffer_ ? vertex_buffer_->buffer_size() : 0u,
                 min_vb_size);
 
-            buffer new_vb_data(new_vb_size);
+            frame_vector<u8> new_vb_data(new_vb_size);
             std::memcpy(new_vb_data.data(), vertices_.data(), min_vb_size);
 
             vertex_buffer_ = render_.create_vertex_buffer(
-                new_vb_data,
+                buffer_view(new_vb_data.data(), new_vb_data.size()),
                 vertex_decl_,
                 vertex_buffer::usage::dynamic_draw);
 
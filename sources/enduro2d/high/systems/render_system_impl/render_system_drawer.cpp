@@ -18,20 +18,139 @@ namespace
 {
     using namespace e2d;
 
-    const str_hash screen_s_property_hash = "u_screen_s";
+    constexpr str_hash screen_s_property_hash = "u_screen_s"_hash;
+
+    constexpr str_hash matrix_m_property_hash = "u_matrix_m"_hash;
+    constexpr str_hash matrix_v_property_hash = "u_matrix_v"_hash;
+    constexpr str_hash matrix_p_property_hash = "u_matrix_p"_hash;
+    constexpr str_hash matrix_vp_property_hash = "u_matrix_vp"_hash;
+
+    constexpr str_hash time_property_hash = "u_time"_hash;
+    constexpr str_hash texture_sampler_hash = "u_texture"_hash;
+
+    constexpr str_hash normal_material_hash = "normal"_hash;
+    constexpr str_hash additive_material_hash = "additive"_hash;
+    constexpr str_hash multiply_material_hash = "multiply"_hash;
+    constexpr str_hash screen_material_hash = "screen"_hash;
+
+    texture_ptr find_spine_texture(const spAtlasPage* atlas_page) noexcept {
+        const texture_asset* texture_asset_ptr = atlas_page
+            ? static_cast<const texture_asset*>(atlas_page->rendererObject)
+            : nullptr;
+        return texture_asset_ptr
+            ? texture_asset_ptr->content()
+            : nullptr;
+    }
 
-    const str_hash matrix_m_property_hash = "u_matrix_m";
-    const str_hash matrix_v_property_hash = "u_matrix_v";
-    const str_hash matrix_p_property_hash = "u_matrix_p";
-    const str_hash matrix_vp_property_hash = "u_matrix_vp";
+    render::sampler_state make_spine_sampler(
+        const texture_ptr& tex_p,
+        const spAtlasPage* atlas_page)
+    {
+        render::sampler_min_filter tex_min_f = render::sampler_min_filter::linear;
+        if ( atlas_page ) {
+            switch ( atlas_page->minFilter ) {
+            case SP_ATLAS_NEAREST:
+            case SP_ATLAS_MIPMAP_NEAREST_LINEAR:
+            case SP_ATLAS_MIPMAP_NEAREST_NEAREST:
+                tex_min_f = render::sampler_min_filter::nearest;
+                break;
+            default:
+                tex_min_f = render::sampler_min_filter::linear;
+                break;
+            }
+        }
 
-    const str_hash time_property_hash = "u_time";
-    const str_hash texture_sampler_hash = "u_texture";
+        render::sampler_mag_filter tex_mag_f = render::sampler_mag_filter::linear;
+        if ( atlas_page ) {
+            switch ( atlas_page->magFilter ) {
+            case SP_ATLAS_NEAREST:
+            case SP_ATLAS_MIPMAP_NEAREST_LINEAR:
+            case SP_ATLAS_MIPMAP_NEAREST_NEAREST:
+                tex_mag_f = render::sampler_mag_filter::nearest;
+                break;
+            default:
+                tex_mag_f = render::sampler_mag_filter::linear;
+                break;
+            }
+        }
 
-    const str_hash normal_material_hash = "normal";
-    const str_hash additive_material_hash = "additive";
-    const str_hash multiply_material_hash = "multiply";
-    const str_hash screen_material_hash = "screen";
+        render::sampler_wrap tex_wrap_s = render::sampler_wrap::repeat;
+        if ( atlas_page ) {
+            switch ( atlas_page->uWrap ) {
+            case SP_ATLAS_MIRROREDREPEAT:
+                tex_wrap_s = render::sampler_wrap::mirror;
+                break;
+            case SP_ATLAS_CLAMPTOEDGE:
+                tex_wrap_s = render::sampler_wrap::clamp;
+                break;
+            case SP_ATLAS_REPEAT:
+                tex_wrap_s = render::sampler_wrap::repeat;
+                break;
+            default:
+                E2D_ASSERT_MSG(false, "unexpected wrap mode for slot");
+                break;
+            }
+        }
+
+        render::sampler_wrap tex_wrap_t = render::sampler_wrap::repeat;
+        if ( atlas_page ) {
+            switch ( atlas_page->vWrap ) {
+            case SP_ATLAS_MIRROREDREPEAT:
+                tex_wrap_t = render::sampler_wrap::mirror;
+                break;
+            case SP_ATLAS_CLAMPTOEDGE:
+                tex_wrap_t = render::sampler_wrap::clamp;
+                break;
+            case SP_ATLAS_REPEAT:
+                tex_wrap_t = render::sampler_wrap::repeat;
+                break;
+            default:
+                E2D_ASSERT_MSG(false, "unexpected wrap mode for slot");
+                break;
+            }
+        }
+
+        return render::sampler_state()
+            .texture(tex_p)
+            .filter(tex_min_f, tex_mag_f)
+            .wrap(tex_wrap_s, tex_wrap_t);
+    }
+
+    class spine_material_cache final {
+    public:
+        spine_material_cache(const spine_player& spine_r) noexcept
+        : spine_r_(spine_r) {}
+
+        const material_asset::ptr& find(int blend_mode) {
+            switch ( blend_mode ) {
+                case SP_BLEND_MODE_NORMAL:
+                    return find_(normal_mat_a_, normal_material_hash);
+                case SP_BLEND_MODE_ADDITIVE:
+                    return find_(additive_mat_a_, additive_material_hash);
+                case SP_BLEND_MODE_MULTIPLY:
+                    return find_(multiply_mat_a_, multiply_material_hash);
+                case SP_BLEND_MODE_SCREEN:
+                    return find_(screen_mat_a_, screen_material_hash);
+                default:
+                    E2D_ASSERT_MSG(false, "unexpected blend mode for slot");
+                    return empty_mat_a_;
+            }
+        }
+    private:
+        const material_asset::ptr& find_(material_asset::ptr& mat_a, str_hash name) {
+            if ( !mat_a ) {
+                mat_a = spine_r_.find_material(name);
+            }
+            return mat_a;
+        }
+    private:
+        const spine_player& spine_r_;
+        material_asset::ptr normal_mat_a_;
+        material_asset::ptr additive_mat_a_;
+        material_asset::ptr multiply_mat_a_;
+        material_asset::ptr screen_mat_a_;
+        material_asset::ptr empty_mat_a_;
+    };
 }
 
 namespace e2d::render_system_impl
@@ -45,9 +164,11 @@ namespace e2d::render_system_impl
         engine& engine,
         render& render,
         window& window,
-        batcher_type& batcher)
+        batcher_type& batcher,
+        instancer& instancer)
     : render_(render)
     , batcher_(batcher)
+    , instancer_(instancer)
     {
         const m4f& m_v = cam.view();
         const m4f& m_p = cam.projection();
@@ -80,6 +201,7 @@ namespace e2d::render_system_impl
     }
 
     drawer::context::~context() noexcept {
+        instancer_.clear();
         batcher_.clear(true);
     }
 
@@ -89,33 +211,83 @@ namespace e2d::render_system_impl
         }
 
         const gobject& owner = node->owner();
-        gcomponent<renderer> node_r{owner};
+        const_gcomponent<renderer> node_r{owner};
 
         if ( !node_r || owner.component<disabled<renderer>>() ) {
             return;
         }
 
+        render_queue::item item;
+        item.owner_n = node.get();
+        item.node_r = node_r.find();
+        item.mdl_r = owner.component<model_renderer>().find();
+        item.spine_r = owner.component<spine_player>().find();
+        item.spr_r = owner.component<sprite_renderer>().find();
+        draw(item);
+    }
+
+    void drawer::context::draw(const render_queue::item& item) {
+        E2D_ASSERT(item.owner_n && item.node_r);
+
         const m4f& model_m =
-            math::make_trs_matrix4(node_r->transform()) *
-            node->world_matrix();
+            math::make_trs_matrix4(item.node_r->transform()) *
+            item.owner_n->world_matrix();
+
+        // the model of an item is drawn before its spine and sprite, so only
+        // items with a model alone can be deferred to an instanced draw
+        if ( item.mdl_r && !item.spine_r && !item.spr_r ) {
+            if ( draw_instanced(model_m, *item.node_r, *item.mdl_r) ) {
+                return;
+            }
+        }
+
+        flush_instances();
 
-        if ( auto mdl_r = gcomponent<model_renderer>{owner} ) {
-            draw(model_m, *node_r, *mdl_r);
+        if ( item.mdl_r ) {
+            draw(model_m, *item.node_r, *item.mdl_r);
         }
 
-        if ( auto spn_p = gcomponent<spine_player>{owner} ) {
-            draw(model_m, *node_r, *spn_p);
+        if ( item.spine_r ) {
+            draw(model_m, *item.node_r, *item.spine_r);
         }
 
-        if ( auto spr_r = gcomponent<sprite_renderer>{owner} ) {
-            draw(model_m, *node_r, *spr_r);
+        if ( item.spr_r ) {
+            draw(model_m, *item.node_r, *item.spr_r);
         }
     }
 
     void drawer::context::flush() {
+        flush_instances();
         batcher_.flush();
     }
 
+    bool drawer::context::draw_instanced(
+        const m4f& model_m,
+        const renderer& node_r,
+        const model_renderer& mdl_r)
+    {
+        if ( !instancer_.is_instanceable(node_r, mdl_r) ) {
+            return false;
+        }
+
+        if ( !instancer_.is_compatible(node_r, mdl_r) ) {
+            flush_instances();
+        }
+
+        if ( instancer_.empty() ) {
+            batcher_.flush();
+        }
+
+        instancer_.batch(model_m, node_r, mdl_r);
+        return true;
+    }
+
+    void drawer::context::flush_instances() {
+        if ( !instancer_.empty() ) {
+            instancer_.flush(batcher_.flush());
+        }
+    }
+
     void drawer::context::draw(
         const m4f& model_m,
         const renderer& node_r,
@@ -160,10 +332,6 @@ namespace e2d::render_system_impl
         const renderer& node_r,
         const spine_player& spine_r)
     {
-        //TODO(BlackMat): replace it to frame allocator
-        static thread_local std::vector<float> temp_vertices(1000u, 0.f);
-        static thread_local std::vector<batcher_type::vertex_type> batch_vertices(1000u);
-
         spSkeleton* skeleton = spine_r.skeleton().get();
         spSkeletonClipping* clipper = spine_r.clipper().get();
 
@@ -175,15 +343,56 @@ namespace e2d::render_system_impl
             return;
         }
 
-        material_asset::ptr normal_mat_a;
-        material_asset::ptr additive_mat_a;
-        material_asset::ptr multiply_mat_a;
-        material_asset::ptr screen_mat_a;
+        const color skeleton_color = color(
+            skeleton->color.r, skeleton->color.g, skeleton->color.b, skeleton->color.a);
 
-        unsigned short quad_indices[6] = { 0, 1, 2, 2, 3, 0 };
+        spine_material_cache materials(spine_r);
 
-        E2D_DEFER([this, clipper](){
+        E2D_DEFER([this](){
             property_cache_.clear();
+        });
+
+        if ( const spine_pose_cache::pose* pose = spine_r.baked_pose() ) {
+            frame_vector<batcher_type::vertex_type> batch_vertices;
+
+            for ( const spine_pose_cache::mesh& mesh : pose->meshes ) {
+                const color32 vert_color = color32(skeleton_color * mesh.tint);
+                const texture_ptr tex_p = find_spine_texture(mesh.page);
+                const material_asset::ptr& mat_a = materials.find(mesh.blend_mode);
+
+                if ( math::is_near_zero(vert_color.a) || !tex_p || !mat_a ) {
+                    continue;
+                }
+
+                batch_vertices.resize(mesh.vertex_count);
+                for ( std::size_t j = 0; j < mesh.vertex_count; ++j ) {
+                    const v2f& v = pose->vertices[mesh.first_vertex + j];
+                    batcher_type::vertex_type& vert = batch_vertices[j];
+                    vert.v = v3f(v4f(v.x, v.y, 0.f, 1.f) * model_m);
+                    vert.t = pose->uvs[mesh.first_vertex + j];
+                    vert.c = vert_color;
+                }
+
+                property_cache_
+                    .sampler(texture_sampler_hash, make_spine_sampler(tex_p, mesh.page))
+                    .merge(node_r.properties());
+
+                batcher_.batch(
+                    mat_a,
+                    property_cache_,
+                    pose->indices.data() + mesh.first_index, mesh.index_count,
+                    batch_vertices.data(), batch_vertices.size());
+            }
+
+            return;
+        }
+
+        frame_vector<float> temp_vertices(1000u, 0.f);
+        frame_vector<batcher_type::vertex_type> batch_vertices(1000u);
+
+        unsigned short quad_indices[6] = { 0, 1, 2, 2, 3, 0 };
+
+        E2D_DEFER([clipper](){
             spSkeletonClipping_clipEnd2(clipper);
         });
 
@@ -272,109 +481,13 @@ namespace e2d::render_system_impl
                 continue;
             }
 
-            color32 vert_color = color32(
-                color(skeleton->color.r, skeleton->color.g, skeleton->color.b, skeleton->color.a) *
+            const color32 vert_color = color32(
+                skeleton_color *
                 color(slot->color.r, slot->color.g, slot->color.b, slot->color.a) *
                 color(attachment_color->r, attachment_color->g, attachment_color->b, attachment_color->a));
 
-            texture_ptr tex_p;
-            const texture_asset* texture_asset_ptr = atlas_page
-                ? static_cast<const texture_asset*>(atlas_page->rendererObject)
-                : nullptr;
-            if ( texture_asset_ptr ) {
-                tex_p = texture_asset_ptr->content();
-            }
-
-            render::sampler_min_filter tex_min_f = render::sampler_min_filter::linear;
-            if ( atlas_page ) {
-                switch ( atlas_page->minFilter ) {
-                case SP_ATLAS_NEAREST:
-                case SP_ATLAS_MIPMAP_NEAREST_LINEAR:
-                case SP_ATLAS_MIPMAP_NEAREST_NEAREST:
-                    tex_min_f = render::sampler_min_filter::nearest;
-                    break;
-                default:
-                    tex_min_f = render::sampler_min_filter::linear;
-                    break;
-                }
-            }
-
-            render::sampler_mag_filter tex_mag_f = render::sampler_mag_filter::linear;
-            if ( atlas_page ) {
-                switch ( atlas_page->magFilter ) {
-                case SP_ATLAS_NEAREST:
-                case SP_ATLAS_MIPMAP_NEAREST_LINEAR:
-                case SP_ATLAS_MIPMAP_NEAREST_NEAREST:
-                    tex_mag_f = render::sampler_mag_filter::nearest;
-                    break;
-                default:
-                    tex_mag_f = render::sampler_mag_filter::linear;
-                    break;
-                }
-            }
-
-            render::sampler_wrap tex_wrap_s = render::sampler_wrap::repeat;
-            if ( atlas_page ) {
-                switch ( atlas_page->uWrap ) {
-                case SP_ATLAS_MIRROREDREPEAT:
-                    tex_wrap_s = render::sampler_wrap::mirror;
-                    break;
-                case SP_ATLAS_CLAMPTOEDGE:
-                    tex_wrap_s = render::sampler_wrap::clamp;
-                    break;
-                case SP_ATLAS_REPEAT:
-                    tex_wrap_s = render::sampler_wrap::repeat;
-                    break;
-                default:
-                    E2D_ASSERT_MSG(false, "unexpected wrap mode for slot");
-                    break;
-                }
-            }
-
-            render::sampler_wrap tex_wrap_t = render::sampler_wrap::repeat;
-            if ( atlas_page ) {
-                switch ( atlas_page->vWrap ) {
-                case SP_ATLAS_MIRROREDREPEAT:
-                    tex_wrap_t = render::sampler_wrap::mirror;
-                    break;
-                case SP_ATLAS_CLAMPTOEDGE:
-                    tex_wrap_t = render::sampler_wrap::clamp;
-                    break;
-                case SP_ATLAS_REPEAT:
-                    tex_wrap_t = render::sampler_wrap::repeat;
-                    break;
-                default:
-                    E2D_ASSERT_MSG(false, "unexpected wrap mode for slot");
-                    break;
-                }
-            }
-
-            material_asset::ptr mat_a;
-            switch ( slot->data->blendMode ) {
-                case SP_BLEND_MODE_NORMAL:
-                    mat_a = normal_mat_a
-                        ? normal_mat_a
-                        : (normal_mat_a = spine_r.find_material(normal_material_hash));
-                    break;
-                case SP_BLEND_MODE_ADDITIVE:
-                    mat_a = additive_mat_a
-                        ? additive_mat_a
-                        : (additive_mat_a = spine_r.find_material(additive_material_hash));
-                    break;
-                case SP_BLEND_MODE_MULTIPLY:
-                    mat_a = multiply_mat_a
-                        ? multiply_mat_a
-                        : (multiply_mat_a = spine_r.find_material(multiply_material_hash));
-                    break;
-                case SP_BLEND_MODE_SCREEN:
-                    mat_a = screen_mat_a
-                        ? screen_mat_a
-                        : (screen_mat_a = spine_r.find_material(screen_material_hash));
-                    break;
-                default:
-                    E2D_ASSERT_MSG(false, "unexpected blend mode for slot");
-                    break;
-            }
+            const texture_ptr tex_p = find_spine_texture(atlas_page);
+            const material_asset::ptr& mat_a = materials.find(slot->data->blendMode);
 
             if ( math::is_near_zero(vert_color.a) || !tex_p || !mat_a ) {
                 continue;
@@ -410,10 +523,7 @@ namespace e2d::render_system_impl
                 }
 
                 property_cache_
-                    .sampler(texture_sampler_hash, render::sampler_state()
-                        .texture(tex_p)
-                        .filter(tex_min_f, tex_mag_f)
-                        .wrap(tex_wrap_s, tex_wrap_t))
+                    .sampler(texture_sampler_hash, make_spine_sampler(tex_p, atlas_page))
                     .merge(node_r.properties());
 
                 batcher_.batch(
@@ -643,5 +753,6 @@ namespace e2d::render_system_impl
     : engine_(e)
     , render_(r)
     , window_(w)
-    , batcher_(d, r) {}
+    , batcher_(d, r)
+    , instancer_(d, r) {}
 }
@@ -13,6 +13,8 @@
 
 #include "render_system_base.hpp"
 #include "render_system_batcher.hpp"
+#include "render_system_instancer.hpp"
+#include "render_system_queue.hpp"
 
 namespace e2d::render_system_impl
 {
@@ -36,12 +38,21 @@ namespace e2d::render_system_impl
                 engine& engine,
                 render& render,
                 window& window,
-                batcher_type& batcher);
+                batcher_type& batcher,
+                instancer& instancer);
             ~context() noexcept;
 
             void draw(const const_node_iptr& node);
+            void draw(const render_queue::item& item);
             void flush();
         private:
+            bool draw_instanced(
+                const m4f& model_m,
+                const renderer& node_r,
+                const model_renderer& mdl_r);
+
+            void flush_instances();
+
             void draw(
                 const m4f& model_m,
                 const renderer& node_r,
@@ -59,6 +70,7 @@ namespace e2d::render_system_impl
         private:
             render& render_;
             batcher_type& batcher_;
+            instancer& instancer_;
             render::property_block property_cache_;
         };
     public:
@@ -71,6 +83,7 @@ namespace e2d::render_system_impl
         render& render_;
         window& window_;
         batcher_type batcher_;
+        instancer instancer_;
     };
 }
 
@@ -78,7 +91,7 @@ namespace e2d::render_system_impl
 {
     template < typename F >
     void drawer::with(const camera& cam, F&& f) {
-        context ctx{cam, engine_, render_, window_, batcher_};
+        context ctx{cam, engine_, render_, window_, batcher_, instancer_};
         std::forward<F>(f)(ctx);
         ctx.flush();
     }
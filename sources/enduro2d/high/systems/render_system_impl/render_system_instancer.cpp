@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "render_system_instancer.hpp"
+
+namespace
+{
+    using namespace e2d;
+
+    constexpr str_hash matrix_m_attribute_hash = "a_matrix_m"_hash;
+}
+
+namespace e2d::render_system_impl
+{
+    instancer::instancer(debug& debug, render& render)
+    : debug_(debug)
+    , render_(render)
+    , instance_decl_(vertex_declaration()
+        .add_attribute<m4f>(matrix_m_attribute_hash)
+        .per_instance()) {}
+
+    bool instancer::is_instanceable(
+        const renderer& node_r,
+        const model_renderer& mdl_r) const noexcept
+    {
+        if ( !render_.device_capabilities().instancing_supported ) {
+            return false;
+        }
+
+        if ( !mdl_r.model() || !mdl_r.model()->content().mesh() ) {
+            return false;
+        }
+
+        const std::size_t submesh_count = math::min(
+            mdl_r.model()->content().mesh()->content().indices_submesh_count(),
+            node_r.materials().size());
+
+        bool has_passes = false;
+        for ( std::size_t i = 0; i < submesh_count; ++i ) {
+            const material_asset::ptr& mat = node_r.materials()[i];
+            if ( !mat ) {
+                continue;
+            }
+            const render::material& mat_c = mat->content();
+            for ( std::size_t j = 0, je = mat_c.pass_count(); j < je; ++j ) {
+                const shader_ptr& ps = mat_c.pass(j).shader();
+                if ( !ps ) {
+                    continue;
+                }
+                if ( !ps->has_attribute(matrix_m_attribute_hash) ) {
+                    return false;
+                }
+                has_passes = true;
+            }
+        }
+
+        return has_passes;
+    }
+
+    bool instancer::is_compatible(
+        const renderer& node_r,
+        const model_renderer& mdl_r) const noexcept
+    {
+        if ( empty() ) {
+            return true;
+        }
+
+        return mdl_r_->model() == mdl_r.model()
+            && node_r_->materials() == node_r.materials()
+            && node_r_->properties().equals(node_r.properties());
+    }
+
+    void instancer::batch(
+        const m4f& model_m,
+        const renderer& node_r,
+        const model_renderer& mdl_r)
+    {
+        E2D_ASSERT(is_compatible(node_r, mdl_r));
+        if ( empty() ) {
+            node_r_ = &node_r;
+            mdl_r_ = &mdl_r;
+        }
+        matrices_.push_back(model_m);
+    }
+
+    void instancer::flush(const render::property_block& internal_props) {
+        if ( empty() ) {
+            return;
+        }
+
+        E2D_DEFER([this](){
+            clear();
+        });
+
+        update_instance_buffer_();
+        if ( !instance_buffer_ ) {
+            return;
+        }
+
+        const model& mdl = mdl_r_->model()->content();
+        const mesh& msh = mdl.mesh()->content();
+
+        E2D_DEFER([this](){
+            property_cache_.clear();
+        });
+
+        property_cache_
+            .merge(internal_props)
+            .merge(node_r_->properties());
+
+        const std::size_t submesh_count = math::min(
+            msh.indices_submesh_count(),
+            node_r_->materials().size());
+
+        for ( std::size_t i = 0, first_index = 0; i < submesh_count; ++i ) {
+            const std::size_t index_count = msh.indices(i).size();
+            const material_asset::ptr& mat = node_r_->materials()[i];
+            if ( mat ) {
+                render_.execute(render::draw_instanced_command(
+                    mat->content(),
+                    mdl.geometry(),
+                    property_cache_,
+                    instance_buffer_,
+                    matrices_.size()
+                ).index_range(first_index, index_count));
+            }
+            first_index += index_count;
+        }
+    }
+
+    void instancer::clear() noexcept {
+        node_r_ = nullptr;
+        mdl_r_ = nullptr;
+        matrices_.clear();
+    }
+
+    bool instancer::empty() const noexcept {
+        return matrices_.empty();
+    }
+
+    void instancer::update_instance_buffer_() {
+        const std::size_t min_vb_size = matrices_.size() * sizeof(matrices_[0]);
+        if ( instance_buffer_ && instance_buffer_->buffer_size() >= min_vb_size ) {
+            render_.update_buffer(
+                instance_buffer_,
+                buffer_view(matrices_.data(), min_vb_size),
+                0u);
+        } else {
+            const std::size_t new_vb_size = math::max(
+                instance_buffer_ ? instance_buffer_->buffer_size() * 2u : 0u,
+                min_vb_size);
+
+            frame_vector<u8> new_vb_data(new_vb_size);
+            std::memcpy(new_vb_data.data(), matrices_.data(), min_vb_size);
+
+            instance_buffer_ = render_.create_vertex_buffer(
+                buffer_view(new_vb_data.data(), new_vb_data.size()),
+                instance_decl_,
+                vertex_buffer::usage::dynamic_draw);
+
+            if ( !instance_buffer_ ) {
+                debug_.error("INSTANCER: Failed to create instance buffer:\n"
+                    "--> Size: %0",
+                    new_vb_size);
+            }
+        }
+    }
+}
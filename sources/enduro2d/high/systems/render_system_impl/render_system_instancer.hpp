@@ -0,0 +1,58 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include <enduro2d/high/_high.hpp>
+
+#include <enduro2d/high/components/model_renderer.hpp>
+#include <enduro2d/high/components/renderer.hpp>
+
+namespace e2d::render_system_impl
+{
+    //
+    // instancer
+    //
+    // Collects consecutive model renderers with the same model, materials
+    // and properties and draws them with one instanced draw per submesh.
+    // Only materials whose shaders read the model matrix from the per-instance
+    // 'a_matrix_m' attribute are drawn this way.
+    //
+
+    class instancer final : private noncopyable {
+    public:
+        instancer(debug& debug, render& render);
+
+        bool is_instanceable(
+            const renderer& node_r,
+            const model_renderer& mdl_r) const noexcept;
+
+        bool is_compatible(
+            const renderer& node_r,
+            const model_renderer& mdl_r) const noexcept;
+
+        void batch(
+            const m4f& model_m,
+            const renderer& node_r,
+            const model_renderer& mdl_r);
+
+        void flush(const render::property_block& internal_props);
+        void clear() noexcept;
+
+        bool empty() const noexcept;
+    private:
+        void update_instance_buffer_();
+    private:
+        debug& debug_;
+        render& render_;
+        const renderer* node_r_{nullptr};
+        const model_renderer* mdl_r_{nullptr};
+        vector<m4f> matrices_;
+        vertex_declaration instance_decl_;
+        vertex_buffer_ptr instance_buffer_;
+        render::property_block property_cache_;
+    };
+}
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "render_system_queue.hpp"
+
+#include <enduro2d/high/components/actor.hpp>
+#include <enduro2d/high/components/disabled.hpp>
+#include <enduro2d/high/components/model_renderer.hpp>
+#include <enduro2d/high/components/renderer.hpp>
+#include <enduro2d/high/components/scene.hpp>
+#include <enduro2d/high/components/spine_player.hpp>
+#include <enduro2d/high/components/sprite_renderer.hpp>
+
+namespace e2d::render_system_impl
+{
+    bool render_queue::update(const ecs::registry& owner) {
+        E2D_PROFILER_SCOPE("render_system.update_queue");
+
+        collect_roots_(owner);
+
+        const versions new_versions = current_versions_();
+        if ( !dirty_ && new_versions == versions_ && new_roots_ == roots_ ) {
+            return false;
+        }
+
+        versions_ = new_versions;
+        roots_.swap(new_roots_);
+        rebuild_();
+
+        dirty_ = false;
+        return true;
+    }
+
+    void render_queue::invalidate() noexcept {
+        dirty_ = true;
+    }
+
+    const vector<render_queue::item>& render_queue::items() const noexcept {
+        return items_;
+    }
+
+    render_queue::versions render_queue::current_versions_() noexcept {
+        return {
+            node::hierarchy_version(),
+            gobject::structure_version<actor>(),
+            gobject::structure_version<disabled<actor>>(),
+            gobject::structure_version<scene>(),
+            gobject::structure_version<disabled<scene>>(),
+            gobject::structure_version<renderer>(),
+            gobject::structure_version<disabled<renderer>>(),
+            gobject::structure_version<model_renderer>(),
+            gobject::structure_version<spine_player>(),
+            gobject::structure_version<sprite_renderer>()};
+    }
+
+    void render_queue::collect_roots_(const ecs::registry& owner) {
+        const auto comp = [](const auto& l, const auto& r) noexcept {
+            return std::get<scene>(l).depth() < std::get<scene>(r).depth();
+        };
+
+        const auto func = [this](
+            const ecs::const_entity&,
+            const scene&,
+            const actor& scene_a)
+        {
+            if ( scene_a.node() ) {
+                new_roots_.push_back(scene_a.node());
+            }
+        };
+
+        new_roots_.clear();
+        ecsex::for_extracted_sorted_components<scene, actor>(
+            owner,
+            comp,
+            func,
+            !ecs::exists_any<
+                disabled<actor>,
+                disabled<scene>>());
+    }
+
+    void render_queue::rebuild_() {
+        E2D_PROFILER_SCOPE("render_system.rebuild_queue");
+
+        items_.clear();
+        for ( const const_node_iptr& root : roots_ ) {
+            add_node_recursive_(root);
+        }
+    }
+
+    void render_queue::add_node_recursive_(const const_node_iptr& n) {
+        if ( const gobject& owner = n->owner() ) {
+            const_gcomponent<renderer> node_r{owner};
+            if ( node_r && !owner.component<disabled<renderer>>() ) {
+                item i;
+                i.owner_n = n.get();
+                i.node_r = node_r.find();
+                i.mdl_r = owner.component<model_renderer>().find();
+                i.spine_r = owner.component<spine_player>().find();
+                i.spr_r = owner.component<sprite_renderer>().find();
+                items_.push_back(i);
+            }
+        }
+
+        nodes::for_each_child(n, [this](const const_node_iptr& child){
+            add_node_recursive_(child);
+        });
+    }
+}
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include <enduro2d/high/_high.hpp>
+
+#include <enduro2d/high/node.hpp>
+
+namespace e2d::render_system_impl
+{
+    //
+    // render_queue
+    //
+    // Renderable nodes of all enabled scenes in draw order with their
+    // component pointers. The pointers refer to the ECS component storages,
+    // so the queue is rebuilt after any hierarchy change and after any
+    // addition or removal of the components it depends on.
+    //
+
+    class render_queue final : private noncopyable {
+    public:
+        struct item {
+            const node* owner_n{nullptr};
+            const renderer* node_r{nullptr};
+            const model_renderer* mdl_r{nullptr};
+            const spine_player* spine_r{nullptr};
+            const sprite_renderer* spr_r{nullptr};
+        };
+    public:
+        render_queue() = default;
+        ~render_queue() noexcept = default;
+
+        // returns true when the queue was rebuilt
+        bool update(const ecs::registry& owner);
+        void invalidate() noexcept;
+
+        [[nodiscard]] const vector<item>& items() const noexcept;
+    private:
+        using versions = std::array<u32, 10>;
+        static versions current_versions_() noexcept;
+
+        void collect_roots_(const ecs::registry& owner);
+        void rebuild_();
+        void add_node_recursive_(const const_node_iptr& n);
+    private:
+        vector<item> items_;
+        vector<const_node_iptr> roots_;
+        vector<const_node_iptr> new_roots_;
+        versions versions_{};
+        bool dirty_{true};
+    };
+}
@@ -48,59 +48,65 @@ namespace
         };
     }
 
-    void process_spine_player_events(ecs::registry& owner) {
-        ecsex::for_extracted_components<events<spine_player_events::event>, behaviour, actor>(owner,
-        [](ecs::entity e, const events<spine_player_events::event>& es, behaviour& b, actor& a){
+    void process_spine_player_events(world& w) {
+        w.stream<spine_player_events::event>().for_each([](
+            const ecs::entity& target,
+            const spine_player_events::event& evt)
+        {
+            ecs::entity e = target;
+            behaviour b = e.get_component<behaviour>();
+            actor a = e.get_component<actor>();
             if ( !a.node() || !a.node()->owner() ) {
                 return;
             }
-            for ( const spine_player_events::event& evt : es.get() ) {
-                behaviours::call_result r = behaviours::call_result::success;
-                std::visit(utils::overloaded {
-                    [&b,&a,&r](const spine_player_events::custom_evt& e){
-                        r = behaviours::call_meta_method(
-                            b, "on_event", a.node()->owner(), "spine_player.custom_evt", e);
-                    },
-                    [&b,&a,&r](const spine_player_events::end_evt& e){
-                        r = behaviours::call_meta_method(
-                            b, "on_event", a.node()->owner(), "spine_player.end_evt", e);
-                    },
-                    [&b,&a,&r](const spine_player_events::complete_evt& e){
-                        r = behaviours::call_meta_method(
-                            b, "on_event", a.node()->owner(), "spine_player.complete_evt", e);
-                    }
-                }, evt);
-                if ( r == behaviours::call_result::failed ) {
-                    e.assign_component<disabled<behaviour>>();
+            behaviours::call_result r = behaviours::call_result::success;
+            std::visit(utils::overloaded {
+                [&b,&a,&r](const spine_player_events::custom_evt& e){
+                    r = behaviours::call_meta_method(
+                        b, "on_event", a.node()->owner(), "spine_player.custom_evt", e);
+                },
+                [&b,&a,&r](const spine_player_events::end_evt& e){
+                    r = behaviours::call_meta_method(
+                        b, "on_event", a.node()->owner(), "spine_player.end_evt", e);
+                },
+                [&b,&a,&r](const spine_player_events::complete_evt& e){
+                    r = behaviours::call_meta_method(
+                        b, "on_event", a.node()->owner(), "spine_player.complete_evt", e);
                 }
+            }, evt);
+            if ( r == behaviours::call_result::failed ) {
+                ecsex::assign_component<disabled<behaviour>>(e);
             }
-        }, !ecs::exists<disabled<behaviour>>());
+        }, ecs::exists_all<behaviour, actor>(), !ecs::exists<disabled<behaviour>>());
     }
 
-    void process_touchable_events(ecs::registry& owner) {
-        ecsex::for_extracted_components<events<touchable_events::event>, behaviour, actor>(owner,
-        [](ecs::entity e, const events<touchable_events::event>& es, behaviour& b, actor& a){
+    void process_touchable_events(world& w) {
+        w.stream<touchable_events::event>().for_each([](
+            const ecs::entity& target,
+            const touchable_events::event& evt)
+        {
+            ecs::entity e = target;
+            behaviour b = e.get_component<behaviour>();
+            actor a = e.get_component<actor>();
             if ( !a.node() || !a.node()->owner() ) {
                 return;
             }
-            for ( const touchable_events::event& evt : es.get() ) {
-                behaviours::call_result r = behaviours::call_result::success;
-                std::visit(utils::overloaded {
-                    [](std::monostate){},
-                    [&b,&a,&r](const touchable_events::mouse_evt& e){
-                        r = behaviours::call_meta_method(
-                            b, "on_event", a.node()->owner(), "touchable.mouse_evt", e);
-                    },
-                    [&b,&a,&r](const touchable_events::touch_evt& e){
-                        r = behaviours::call_meta_method(
-                            b, "on_event", a.node()->owner(), "touchable.touch_evt", e);
-                    }
-                }, evt);
-                if ( r == behaviours::call_result::failed ) {
-                    e.assign_component<disabled<behaviour>>();
+            behaviours::call_result r = behaviours::call_result::success;
+            std::visit(utils::overloaded {
+                [](std::monostate){},
+                [&b,&a,&r](const touchable_events::mouse_evt& e){
+                    r = behaviours::call_meta_method(
+                        b, "on_event", a.node()->owner(), "touchable.mouse_evt", e);
+                },
+                [&b,&a,&r](const touchable_events::touch_evt& e){
+                    r = behaviours::call_meta_method(
+                        b, "on_event", a.node()->owner(), "touchable.touch_evt", e);
                 }
+            }, evt);
+            if ( r == behaviours::call_result::failed ) {
+                ecsex::assign_component<disabled<behaviour>>(e);
             }
-        }, !ecs::exists<disabled<behaviour>>());
+        }, ecs::exists_all<behaviour, actor>(), !ecs::exists<disabled<behaviour>>());
     }
 }
 
@@ -129,14 +135,14 @@ namespace e2d
                 }
                 const auto result = behaviours::call_meta_method(b, "on_update", a.node()->owner());
                 if ( result == behaviours::call_result::failed ) {
-                    e.assign_component<disabled<behaviour>>();
+                    ecsex::assign_component<disabled<behaviour>>(e);
                 }
             }, !ecs::exists<disabled<behaviour>>());
         }
 
-        void process_events(ecs::registry& owner) {
-            process_spine_player_events(owner);
-            process_touchable_events(owner);
+        void process_events() {
+            process_spine_player_events(the<world>());
+            process_touchable_events(the<world>());
         }
     };
 
@@ -161,8 +167,8 @@ namespace e2d
         ecs::registry& owner,
         const ecs::before<systems::update_event>& trigger)
     {
-        E2D_UNUSED(trigger);
+        E2D_UNUSED(owner, trigger);
         E2D_PROFILER_SCOPE("script_system.process_events");
-        state_->process_events(owner);
+        state_->process_events();
     }
 }
@@ -6,6 +6,8 @@
 
 #include <enduro2d/high/systems/spine_system.hpp>
 
+#include <enduro2d/high/world.hpp>
+
 #include <enduro2d/high/components/events.hpp>
 #include <enduro2d/high/components/commands.hpp>
 #include <enduro2d/high/components/spine_player.hpp>
@@ -50,26 +52,24 @@ namespace
             if ( !event || !event->data ) {
                 return;
             }
-            entry_state.target
-            .ensure_component<events<spine_player_events::event>>()
-            .add(spine_player_events::custom_evt(event->data->name ? event->data->name : "")
-                .int_value(event->intValue)
-                .float_value(event->floatValue)
-                .string_value(event->stringValue ? event->stringValue : ""));
+            the<world>().stream<spine_player_events::event>()
+            .add(entry_state.target,
+                spine_player_events::custom_evt(event->data->name ? event->data->name : "")
+                    .int_value(event->intValue)
+                    .float_value(event->floatValue)
+                    .string_value(event->stringValue ? event->stringValue : ""));
         } else if ( type == SP_ANIMATION_END ) {
             if ( entry_state.end_message.empty() ) {
                 return;
             }
-            entry_state.target
-            .ensure_component<events<spine_player_events::event>>()
-            .add(spine_player_events::end_evt(entry_state.end_message));
+            the<world>().stream<spine_player_events::event>()
+            .add(entry_state.target, spine_player_events::end_evt(entry_state.end_message));
         } else if ( type == SP_ANIMATION_COMPLETE ) {
             if ( entry_state.complete_message.empty() ) {
                 return;
             }
-            entry_state.target
-            .ensure_component<events<spine_player_events::event>>()
-            .add(spine_player_events::complete_evt(entry_state.complete_message));
+            the<world>().stream<spine_player_events::event>()
+            .add(entry_state.target, spine_player_events::complete_evt(entry_state.complete_message));
         }
     }
 
@@ -170,11 +170,149 @@ namespace
         spAnimationState& animation_state_;
     };
 
-    void clear_events(ecs::registry& owner) {
-        owner.for_each_component<events<spine_player_events::event>>([
-        ](const ecs::const_entity&, events<spine_player_events::event>& es) {
-            es.clear();
-        });
+    void clear_events() noexcept {
+        the<world>().stream<spine_player_events::event>().clear();
+    }
+
+    spTrackEntry* find_single_unmixed_entry(const spAnimationState& anim_state) noexcept {
+        spTrackEntry* result = nullptr;
+        for ( int i = 0; i < anim_state.tracksCount; ++i ) {
+            spTrackEntry* entry = anim_state.tracks[i];
+            if ( !entry ) {
+                continue;
+            }
+            if ( result || i != 0 ) {
+                return nullptr;
+            }
+            result = entry;
+        }
+        const bool unmixed = result
+            && result->animation
+            && !result->mixingFrom
+            && math::approximately(result->alpha, 1.f)
+            && result->delay <= 0.f;
+        return unmixed ? result : nullptr;
+    }
+
+    f32 animation_time(const spTrackEntry& entry) noexcept {
+        const f32 duration = entry.animationEnd - entry.animationStart;
+        if ( entry.loop && duration > 0.f ) {
+            return entry.animationStart + std::fmod(entry.trackTime, duration);
+        }
+        return math::min(entry.trackTime + entry.animationStart, entry.animationEnd);
+    }
+
+    void fire_entry_event(
+        spAnimationState& anim_state,
+        spEventType type,
+        spTrackEntry& entry,
+        const spEvent* event)
+    {
+        spEvent* mutable_event = const_cast<spEvent*>(event);
+        if ( entry.listener ) {
+            entry.listener(&anim_state, type, &entry, mutable_event);
+        }
+        if ( anim_state.listener ) {
+            anim_state.listener(&anim_state, type, &entry, mutable_event);
+        }
+    }
+
+    // mirrors the event gathering of spAnimationState_apply for an entry
+    // whose timelines are not applied, events come from the baked list
+    void fire_baked_events(
+        spAnimationState& anim_state,
+        spTrackEntry& entry,
+        const spine_pose_cache::baked_animation& baked)
+    {
+        const f32 last = entry.animationLast;
+        const f32 time = animation_time(entry);
+
+        const f32 animation_start = entry.animationStart;
+        const f32 animation_end = entry.animationEnd;
+        const f32 duration = animation_end - animation_start;
+        const f32 track_last_wrapped = duration > 0.f
+            ? std::fmod(entry.trackLast, duration)
+            : 0.f;
+
+        const bool complete = entry.loop
+            ? (duration <= 0.f || track_last_wrapped > std::fmod(entry.trackTime, duration))
+            : (time >= animation_end && last < animation_end);
+
+        // events before the complete are the ones of the last iteration
+        bool completed = false;
+        const auto fire_event = [&](const spEvent* event){
+            if ( !completed && event->time < track_last_wrapped ) {
+                completed = true;
+                if ( complete ) {
+                    fire_entry_event(anim_state, SP_ANIMATION_COMPLETE, entry, nullptr);
+                }
+            }
+            const bool outside = completed
+                ? event->time < animation_start
+                : event->time > animation_end;
+            if ( !outside ) {
+                fire_entry_event(anim_state, SP_ANIMATION_EVENT, entry, event);
+            }
+        };
+
+        const vector<const spEvent*>& events = baked.events();
+        if ( entry.loop && last > time ) {
+            for ( const spEvent* event : events ) {
+                if ( event->time > last ) {
+                    fire_event(event);
+                }
+            }
+            for ( const spEvent* event : events ) {
+                if ( event->time <= time ) {
+                    fire_event(event);
+                }
+            }
+        } else {
+            for ( const spEvent* event : events ) {
+                if ( event->time > last && event->time <= time ) {
+                    fire_event(event);
+                }
+            }
+        }
+
+        if ( !completed && complete ) {
+            fire_entry_event(anim_state, SP_ANIMATION_COMPLETE, entry, nullptr);
+        }
+
+        entry.nextAnimationLast = time;
+        entry.nextTrackLast = entry.trackTime;
+    }
+
+    bool try_apply_baked_pose(spine_player& p, const spSkeleton& skeleton, spAnimationState& anim_state) {
+        if ( !p.use_pose_cache() || p.has_custom_attachments() || !p.spine() ) {
+            return false;
+        }
+
+        const spine::pose_cache_ptr& cache = p.spine()->content().pose_cache();
+        if ( !cache ) {
+            return false;
+        }
+
+        spTrackEntry* entry = find_single_unmixed_entry(anim_state);
+        if ( !entry ) {
+            cache->register_update(false);
+            return false;
+        }
+
+        spine_pose_cache::baked_animation_ptr baked = cache->find_or_bake_async(
+            entry->animation,
+            skeleton.skin,
+            p.pose_sample_rate());
+        if ( !baked ) {
+            cache->register_update(false);
+            return false;
+        }
+
+        const spine_pose_cache::pose* pose = &baked->pose_at(animation_time(*entry));
+        fire_baked_events(anim_state, *entry, *baked);
+        p.baked_pose(std::move(baked), pose);
+        cache->register_update(true);
+        return true;
     }
 
     void update_animations(f32 dt, ecs::registry& owner) {
@@ -191,6 +329,14 @@ namespace
 
             spSkeleton_update(skeleton, dt);
             spAnimationState_update(anim_state, dt);
+
+            // baked players don't apply timelines, the skeleton keeps its
+            // last applied pose and vertices come from the baked one
+            if ( try_apply_baked_pose(p, *skeleton, *anim_state) ) {
+                return;
+            }
+
+            p.baked_pose(nullptr, nullptr);
             spAnimationState_apply(anim_state, skeleton);
             spSkeleton_updateWorldTransform(skeleton);
         });
@@ -238,7 +384,7 @@ namespace e2d
         void process_update(f32 dt, ecs::registry& owner) {
             process_commands(owner);
             clear_commands(owner);
-            clear_events(owner);
+            clear_events();
             update_animations(dt, owner);
         }
     };
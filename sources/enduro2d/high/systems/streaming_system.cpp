@@ -0,0 +1,64 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/high/systems/streaming_system.hpp>
+
+#include <enduro2d/high/components/actor.hpp>
+#include <enduro2d/high/components/camera.hpp>
+#include <enduro2d/high/components/disabled.hpp>
+
+#include <enduro2d/high/streamer.hpp>
+
+namespace e2d
+{
+    //
+    // streaming_system::internal_state
+    //
+
+    class streaming_system::internal_state final : private noncopyable {
+    public:
+        internal_state(streamer& s)
+        : streamer_(s) {}
+        ~internal_state() noexcept = default;
+
+        void process_update(ecs::registry& owner) {
+            // enabled cameras are the focus points of the streaming
+            vector<v2f> focus;
+            owner.for_joined_components<camera, actor>([&focus](
+                const ecs::const_entity&,
+                const camera&,
+                const actor& a)
+            {
+                if ( a.node() ) {
+                    const v4f p = a.node()->local_to_world(v4f(0.f, 0.f, 0.f, 1.f));
+                    focus.emplace_back(p.x, p.y);
+                }
+            }, !ecs::exists<disabled<camera>>());
+
+            streamer_.focus(std::move(focus));
+            streamer_.frame_tick();
+        }
+    private:
+        streamer& streamer_;
+    };
+
+    //
+    // streaming_system
+    //
+
+    streaming_system::streaming_system()
+    : state_(new internal_state(the<streamer>())) {}
+    streaming_system::~streaming_system() noexcept = default;
+
+    void streaming_system::process(
+        ecs::registry& owner,
+        const ecs::after<systems::post_update_event>& trigger)
+    {
+        E2D_UNUSED(trigger);
+        E2D_PROFILER_SCOPE("streaming_system.process_update");
+        state_->process_update(owner);
+    }
+}
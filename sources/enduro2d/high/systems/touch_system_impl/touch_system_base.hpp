@@ -7,6 +7,7 @@
 #pragma once
 
 #include <enduro2d/high/_high.hpp>
+#include <enduro2d/high/world.hpp>
 
 #include <enduro2d/high/components/actor.hpp>
 #include <enduro2d/high/components/camera.hpp>
@@ -125,12 +125,8 @@ namespace e2d::touch_system_impl::impl
         const m4f& camera_vp,
         const b2f& camera_viewport)
     {
-        static thread_local std::vector<v2f> points;
-        E2D_DEFER([](){ points.clear(); });
-
-        if ( points.capacity() < c.points.size() ) {
-            points.reserve(math::max(points.capacity() * 2u, c.points.size()));
-        }
+        frame_vector<v2f> points;
+        points.reserve(c.points.size());
 
         std::transform(c.points.begin(), c.points.end(), std::back_inserter(points), [
             &camera_vp,
@@ -155,7 +151,7 @@ namespace e2d::touch_system_impl
     }
 
     void update_world_space_colliders_under_mouse(input& input, window& window, ecs::registry& owner) {
-        owner.remove_all_components<touchable_under_mouse>();
+        ecsex::remove_all_components<touchable_under_mouse>(owner);
         owner.for_joined_components<camera::input, camera>([&input, &window, &owner](
             const ecs::const_entity&,
             const camera::input&,
@@ -50,7 +50,7 @@ namespace e2d::touch_system_impl
                 const actor& a)
             {
                 update_world_space_collider(
-                    e.ensure_component<world_space_collider_t>(),
+                    ecsex::ensure_component<world_space_collider_t>(e),
                     src,
                     a.node() ? a.node()->world_matrix() : m4f::identity());
             }, !ecs::exists_any<
@@ -97,7 +97,7 @@ namespace e2d::touch_system_impl
                 &camera_viewport
             ](ecs::entity e, const touchable&, const world_space_collider_t& c){
                 if ( is_world_space_collider_under_mouse(c, mouse_p, camera_vp, camera_viewport) ) {
-                    e.ensure_component<touchable_under_mouse>();
+                    ecsex::ensure_component<touchable_under_mouse>(e);
                 }
             }, !ecs::exists_any<
                 disabled<touchable>,
@@ -12,12 +12,11 @@ namespace
     using namespace e2d::touch_system_impl;
 
     gobject find_event_target(const ecs::registry& owner) {
-        static thread_local vector<std::tuple<
+        frame_vector<std::tuple<
             ecs::const_entity,
             scene,
             actor>> scenes;
 
-        E2D_DEFER([](){ scenes.clear(); });
         ecsex::extract_components<scene, actor>(
             owner,
             std::back_inserter(scenes),
@@ -61,8 +60,7 @@ namespace
         // parents
         //
 
-        static thread_local std::vector<gcomponent<touchable>> parents;
-        E2D_DEFER([](){ parents.clear(); });
+        frame_vector<gcomponent<touchable>> parents;
 
         nodes::extract_components_from_parents<touchable>(
             target_actor->node(),
@@ -89,7 +87,10 @@ namespace
         // targeting
         //
 
-        target.component<events<touchable_events::event>>().ensure().add(event);
+        event_stream<touchable_events::event>& stream =
+            the<world>().stream<touchable_events::event>();
+
+        stream.add(target.raw_entity(), event);
 
         //
         // bubbling
@@ -102,7 +103,7 @@ namespace
                     disabled<touchable>
                 >()(iter->owner().raw_entity());
                 if ( !parent_disabled ) {
-                    iter->component<events<touchable_events::event>>().ensure().add(event);
+                    stream.add(iter->owner().raw_entity(), event);
                     if ( !(*iter)->bubbling() ) {
                         return;
                     }
@@ -117,10 +118,7 @@ namespace e2d::touch_system_impl
     void dispatcher::dispatch_all_events(ecs::registry& owner) {
         E2D_DEFER([this](){ events_.clear(); });
 
-        owner.for_each_component<events<touchable_events::event>>([
-        ](const ecs::const_entity&, events<touchable_events::event>& es) {
-            es.clear();
-        });
+        the<world>().stream<touchable_events::event>().clear();
 
         if ( events_.empty() ) {
             return;
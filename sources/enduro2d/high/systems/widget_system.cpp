@@ -32,7 +32,7 @@ namespace
             disabled<actor>,
             disabled<widget>>());
 
-        owner.remove_all_components<widget::dirty>();
+        ecsex::remove_all_components<widget::dirty>(owner);
     }
 }
 
@@ -8,6 +8,7 @@
 
 #include <enduro2d/high/editor.hpp>
 #include <enduro2d/high/gobject.hpp>
+#include <enduro2d/high/inspector.hpp>
 #include <enduro2d/high/node.hpp>
 #include <enduro2d/high/world.hpp>
 
@@ -19,51 +20,66 @@ namespace
 {
     using namespace e2d;
 
-    void show_tree_for_node(editor& e, input& i, world& w, const node_iptr& root) {
-        const gobject owner = root ? root->owner() : gobject();
-        if ( !owner ) {
-            return;
-        }
+    const std::size_t index_nodes_per_frame = 4096u;
+    const std::size_t search_nodes_per_frame = 4096u;
+
+    str make_lowercase(str_view src) {
+        str dst(src);
+        std::transform(dst.begin(), dst.end(), dst.begin(), [](char c){
+            return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        });
+        return dst;
+    }
 
-        const str icon_name = owner.component<scene>().exists()
+    str make_node_label(const gobject& owner) {
+        const char* icon_name = owner.component<scene>().exists()
             ? ICON_FA_CUBES
             : ICON_FA_CUBE;
 
-        const str component_name = owner.component<named>()
-            ? owner.component<named>()->name()
-            : str();
-
-        const str tree_node_name = component_name.empty()
-            ? icon_name
-            : strings::rformat("%0 %1", icon_name, component_name);
-
-        ImGui::PushID(root.get());
-        E2D_DEFER([](){ ImGui::PopID(); });
-
-        ImGuiTreeNodeFlags tree_node_flags =
-            ImGuiTreeNodeFlags_OpenOnArrow |
-            ImGuiTreeNodeFlags_SpanFullWidth |
-            ImGuiTreeNodeFlags_OpenOnDoubleClick;
+        const_gcomponent<named> owner_named{owner};
+        return owner_named && !owner_named->name().empty()
+            ? strings::rformat("%0 %1", icon_name, owner_named->name())
+            : str(icon_name);
+    }
 
-        if ( !root->has_children() ) {
-            tree_node_flags |= ImGuiTreeNodeFlags_Leaf;
+    void show_node_context_menu(world& w, const node_iptr& n, const gobject& owner) {
+        if ( !ImGui::BeginPopupContextItem() ) {
+            return;
         }
 
-        if ( e.selection() && e.selection() == owner ) {
-            tree_node_flags |= ImGuiTreeNodeFlags_Selected;
+        E2D_DEFER([](){ ImGui::EndPopup(); });
+
+        if ( ImGui::MenuItem("Add child") ) {
+            gobject inst = w.instantiate();
+            if ( !n->add_child(inst.component<actor>()->node()) ) {
+                inst.destroy();
+            }
         }
 
-        const bool tree_node_opened = ImGui::TreeNodeEx(
-            root.get(),
-            tree_node_flags,
-            "%s", tree_node_name.c_str());
+        imgui_utils::with_disabled_flag_ex(!n->has_parent(), [&w, &n](){
+            if ( ImGui::MenuItem("Add sibling after") ) {
+                gobject inst = w.instantiate();
+                if ( !n->add_sibling_after(inst.component<actor>()->node()) ) {
+                    inst.destroy();
+                }
+            }
 
-        E2D_DEFER([tree_node_opened](){
-            if ( tree_node_opened ) {
-                ImGui::TreePop();
+            if ( ImGui::MenuItem("Add sibling before") ) {
+                gobject inst = w.instantiate();
+                if ( !n->add_sibling_before(inst.component<actor>()->node()) ) {
+                    inst.destroy();
+                }
             }
         });
 
+        ImGui::Separator();
+
+        if ( ImGui::MenuItem("Destroy") ) {
+            w.destroy_instance(owner);
+        }
+    }
+
+    void process_item_selection(editor& e, const gobject& owner) {
         if ( ImGui::IsItemClicked() ) {
             if ( ImGui::IsItemToggledOpen() || e.selection() != owner ) {
                 e.select(owner);
@@ -71,95 +87,373 @@ namespace
                 e.clear_selection();
             }
         }
+    }
 
-        if ( ImGui::BeginPopupContextItem() ) {
-            E2D_DEFER([](){ ImGui::EndPopup(); });
+    void process_tree_selection(editor& e, input& i) {
+        if ( !e.selection() || !ImGui::IsWindowFocused(ImGuiFocusedFlags_ChildWindows) ) {
+            return;
+        }
 
-            if ( ImGui::MenuItem("Add child") ) {
-                gobject inst = w.instantiate();
-                if ( !root->add_child(inst.component<actor>()->node()) ) {
-                    inst.destroy();
-                }
+        const keyboard& k = i.keyboard();
+        if ( k.is_key_just_pressed(keyboard_key::del)
+            || k.is_key_just_pressed(keyboard_key::backspace) )
+        {
+            e.selection().destroy();
+        }
+    }
+}
+
+namespace e2d::dbgui_widgets
+{
+    //
+    // hierarchy_widget::internal_state
+    //
+    // The tree is flattened to rows of the expanded nodes only and is rebuilt
+    // after hierarchy changes, so a frame submits just the rows in the view.
+    // The search index covers all nodes and is filled over several frames.
+    //
+
+    class hierarchy_widget::internal_state final : private e2d::noncopyable {
+    public:
+        internal_state() = default;
+        ~internal_state() noexcept = default;
+
+        void show(editor& e, world& w) {
+            if ( ImGui::InputTextWithHint("##search", ICON_FA_SEARCH " name #component", &query_) ) {
+                parse_query_();
+            }
+
+            ImGui::BeginChild("e2d_hierarchy_rows", ImVec2(0.f, -ImGui::GetFrameHeightWithSpacing()));
+            E2D_DEFER([](){ ImGui::EndChild(); });
+
+            if ( name_terms_.empty() && type_terms_.empty() ) {
+                update_rows_(w);
+                show_rows_(e, w);
+            } else {
+                update_index_(w);
+                update_results_();
+                show_results_(e, w);
             }
+        }
+    private:
+        struct row {
+            node_iptr node;
+            u32 depth{0u};
+            bool opened{false};
+        };
+
+        struct index_entry {
+            node_iptr node;
+            str name;
+        };
+
+        struct versions {
+            u32 hierarchy{0u};
+            u32 actors{0u};
+            u32 names{0u};
+
+            bool operator==(const versions& other) const noexcept {
+                return hierarchy == other.hierarchy
+                    && actors == other.actors
+                    && names == other.names;
+            }
+        };
 
-            imgui_utils::with_disabled_flag_ex(!root->has_parent(), [&w, &root](){
-                if ( ImGui::MenuItem("Add sibling after") ) {
-                    gobject inst = w.instantiate();
-                    if ( !root->add_sibling_after(inst.component<actor>()->node()) ) {
-                        inst.destroy();
+        static versions current_versions_() noexcept {
+            return {
+                node::hierarchy_version(),
+                gobject::structure_version<actor>(),
+                gobject::structure_version<named>()};
+        }
+
+        static vector<node_iptr> collect_roots_(world& w) {
+            vector<node_iptr> roots;
+            ecsex::for_extracted_components<actor>(w.registry(), [&roots](
+                const ecs::const_entity&,
+                actor& a)
+            {
+                if ( a.node() && !a.node()->has_parent() ) {
+                    roots.push_back(a.node());
+                }
+            });
+            return roots;
+        }
+    private:
+        void parse_query_() {
+            name_terms_.clear();
+            type_terms_.clear();
+
+            const str query = make_lowercase(query_);
+            for ( std::size_t first = 0; first < query.size(); ) {
+                const std::size_t last = std::min(query.find(' ', first), query.size());
+                if ( last > first ) {
+                    if ( query[first] == '#' ) {
+                        if ( last > first + 1 ) {
+                            type_terms_.push_back(query.substr(first + 1, last - first - 1));
+                        }
+                    } else {
+                        name_terms_.push_back(query.substr(first, last - first));
                     }
                 }
+                first = last + 1;
+            }
+
+            results_.clear();
+            results_cursor_ = 0u;
+        }
+
+        void update_rows_(world& w) {
+            const versions new_versions = current_versions_();
+            if ( !rows_dirty_ && rows_versions_ == new_versions ) {
+                return;
+            }
+
+            E2D_PROFILER_SCOPE("hierarchy_widget.update_rows");
+
+            rows_.clear();
+            for ( const node_iptr& root : collect_roots_(w) ) {
+                add_rows_recursive_(root, 0u);
+            }
 
-                if ( ImGui::MenuItem("Add sibling before") ) {
-                    gobject inst = w.instantiate();
-                    if ( !root->add_sibling_before(inst.component<actor>()->node()) ) {
-                        inst.destroy();
+            rows_versions_ = new_versions;
+            rows_dirty_ = false;
+        }
+
+        void add_rows_recursive_(const node_iptr& n, u32 depth) {
+            const bool opened = n->has_children() && ImGui::TreeNodeBehaviorIsOpen(
+                ImGui::GetID(n.get()),
+                ImGuiTreeNodeFlags_None);
+
+            rows_.push_back({n, depth, opened});
+
+            if ( opened ) {
+                nodes::for_each_child(n, [this, depth](const node_iptr& child){
+                    add_rows_recursive_(child, depth + 1u);
+                });
+            }
+        }
+
+        void show_rows_(editor& e, world& w) {
+            ImGuiListClipper clipper(math::numeric_cast<int>(rows_.size()));
+            while ( clipper.Step() ) {
+                for ( int index = clipper.DisplayStart; index < clipper.DisplayEnd; ++index ) {
+                    const row& r = rows_[math::numeric_cast<std::size_t>(index)];
+                    if ( show_row_(e, w, r) != r.opened ) {
+                        rows_dirty_ = true;
                     }
                 }
+            }
+        }
+
+        bool show_row_(editor& e, world& w, const row& r) {
+            const gobject owner = r.node->owner();
+            if ( !owner ) {
+                ImGui::TextUnformatted("");
+                return r.opened;
+            }
+
+            const f32 indent = math::numeric_cast<f32>(r.depth) * ImGui::GetStyle().IndentSpacing;
+            if ( r.depth > 0u ) {
+                ImGui::Indent(indent);
+            }
+
+            E2D_DEFER([&r, indent](){
+                if ( r.depth > 0u ) {
+                    ImGui::Unindent(indent);
+                }
             });
 
-            ImGui::Separator();
+            ImGuiTreeNodeFlags tree_node_flags =
+                ImGuiTreeNodeFlags_OpenOnArrow |
+                ImGuiTreeNodeFlags_SpanFullWidth |
+                ImGuiTreeNodeFlags_OpenOnDoubleClick |
+                ImGuiTreeNodeFlags_NoTreePushOnOpen;
+
+            if ( !r.node->has_children() ) {
+                tree_node_flags |= ImGuiTreeNodeFlags_Leaf;
+            }
+
+            if ( e.selection() && e.selection() == owner ) {
+                tree_node_flags |= ImGuiTreeNodeFlags_Selected;
+            }
+
+            const bool tree_node_opened = ImGui::TreeNodeEx(
+                r.node.get(),
+                tree_node_flags,
+                "%s", make_node_label(owner).c_str());
+
+            process_item_selection(e, owner);
+            show_node_context_menu(w, r.node, owner);
 
-            if ( ImGui::MenuItem("Destroy") ) {
-                w.destroy_instance(owner);
+            return tree_node_opened && r.node->has_children();
+        }
+    private:
+        void update_index_(world& w) {
+            const versions new_versions = current_versions_();
+            if ( index_dirty_ || !(index_versions_ == new_versions) ) {
+                index_.clear();
+                index_pending_ = collect_roots_(w);
+                std::reverse(index_pending_.begin(), index_pending_.end());
+                index_versions_ = new_versions;
+                index_dirty_ = false;
+                results_.clear();
+                results_cursor_ = 0u;
+            }
+
+            if ( index_pending_.empty() ) {
                 return;
             }
+
+            E2D_PROFILER_SCOPE("hierarchy_widget.update_index");
+
+            for ( std::size_t i = 0; i < index_nodes_per_frame && !index_pending_.empty(); ++i ) {
+                node_iptr n = std::move(index_pending_.back());
+                index_pending_.pop_back();
+
+                nodes::for_each_child(n, [this](const node_iptr& child){
+                    index_pending_.push_back(child);
+                }, nodes::options().reversed(true));
+
+                const gobject owner = n->owner();
+                const_gcomponent<named> owner_named{owner};
+                index_.push_back({
+                    std::move(n),
+                    owner_named ? make_lowercase(owner_named->name()) : str()});
+            }
         }
 
-        if ( tree_node_opened ) {
-            nodes::for_each_child(root, [&e, &i, &w](const node_iptr& child){
-                show_tree_for_node(e, i, w, child);
-            });
+        void update_results_() {
+            if ( results_cursor_ >= index_.size() ) {
+                return;
+            }
+
+            E2D_PROFILER_SCOPE("hierarchy_widget.update_results");
+
+            inspector* insp = modules::is_initialized<inspector>()
+                ? &the<inspector>()
+                : nullptr;
+
+            const std::size_t last = std::min(
+                index_.size(),
+                results_cursor_ + search_nodes_per_frame);
+
+            for ( ; results_cursor_ < last; ++results_cursor_ ) {
+                if ( is_matched_(insp, index_[results_cursor_]) ) {
+                    results_.push_back(results_cursor_);
+                }
+            }
         }
-    }
 
-    void show_tree_for_all_free_nodes(editor& e, input& i, world& w) {
-        ecsex::for_extracted_components<actor>(w.registry(), [&e, &i, &w](
-            const ecs::const_entity&,
-            actor& a)
-        {
-            if ( a.node() && !a.node()->has_parent() ) {
-                show_tree_for_node(e, i, w, a.node());
+        bool is_matched_(inspector* insp, const index_entry& entry) const {
+            for ( const str& term : name_terms_ ) {
+                if ( entry.name.find(term) == str::npos ) {
+                    return false;
+                }
             }
-        });
 
-        ImGui::Separator();
+            if ( !type_terms_.empty() ) {
+                const gobject owner = entry.node->owner();
+                if ( !insp || !owner ) {
+                    return false;
+                }
+                for ( const str& term : type_terms_ ) {
+                    if ( !insp->has_component(owner, term) ) {
+                        return false;
+                    }
+                }
+            }
 
-        if ( ImGui::Button("+ Add Node") ) {
-            w.instantiate();
+            return true;
         }
-    }
 
-    void process_tree_selection(editor& e, input& i) {
-        if ( !e.selection() || !ImGui::IsWindowFocused() ) {
-            return;
+        void show_results_(editor& e, world& w) {
+            if ( !index_pending_.empty() || results_cursor_ < index_.size() ) {
+                imgui_utils::show_formatted_text(
+                    "searching... %0 found, %1 nodes indexed",
+                    results_.size(),
+                    index_.size());
+            } else {
+                imgui_utils::show_formatted_text(
+                    "%0 found",
+                    results_.size());
+            }
+
+            ImGui::Separator();
+
+            ImGuiListClipper clipper(math::numeric_cast<int>(results_.size()));
+            while ( clipper.Step() ) {
+                for ( int index = clipper.DisplayStart; index < clipper.DisplayEnd; ++index ) {
+                    const index_entry& entry = index_[results_[math::numeric_cast<std::size_t>(index)]];
+                    show_result_(e, w, entry.node);
+                }
+            }
         }
 
-        const keyboard& k = i.keyboard();
-        if ( k.is_key_just_pressed(keyboard_key::del)
-            || k.is_key_just_pressed(keyboard_key::backspace) )
-        {
-            e.selection().destroy();
+        void show_result_(editor& e, world& w, const node_iptr& n) {
+            const gobject owner = n->owner();
+            if ( !owner ) {
+                ImGui::TextUnformatted("");
+                return;
+            }
+
+            ImGuiTreeNodeFlags tree_node_flags =
+                ImGuiTreeNodeFlags_Leaf |
+                ImGuiTreeNodeFlags_SpanFullWidth |
+                ImGuiTreeNodeFlags_NoTreePushOnOpen;
+
+            if ( e.selection() && e.selection() == owner ) {
+                tree_node_flags |= ImGuiTreeNodeFlags_Selected;
+            }
+
+            ImGui::TreeNodeEx(
+                n.get(),
+                tree_node_flags,
+                "%s", make_node_label(owner).c_str());
+
+            process_item_selection(e, owner);
+            show_node_context_menu(w, n, owner);
         }
-    }
+    private:
+        vector<row> rows_;
+        versions rows_versions_;
+        bool rows_dirty_{true};
+    private:
+        str query_;
+        vector<str> name_terms_;
+        vector<str> type_terms_;
+        vector<index_entry> index_;
+        vector<node_iptr> index_pending_;
+        versions index_versions_;
+        bool index_dirty_{true};
+        vector<std::size_t> results_;
+        std::size_t results_cursor_{0u};
+    };
 }
 
 namespace e2d::dbgui_widgets
 {
-    hierarchy_widget::hierarchy_widget() {
+    hierarchy_widget::hierarchy_widget()
+    : state_(std::make_unique<internal_state>()) {
         desc_.first_size = v2f(300.f, 400.f);
     }
 
+    hierarchy_widget::~hierarchy_widget() noexcept = default;
+
     bool hierarchy_widget::show() {
         if ( !modules::is_initialized<editor, input, world>() ) {
             return false;
         }
 
-        show_tree_for_all_free_nodes(
+        state_->show(
             the<editor>(),
-            the<input>(),
             the<world>());
 
+        ImGui::Separator();
+
+        if ( ImGui::Button("+ Add Node") ) {
+            the<world>().instantiate();
+        }
+
         process_tree_selection(
             the<editor>(),
             the<input>());
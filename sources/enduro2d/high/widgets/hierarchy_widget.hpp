@@ -13,11 +13,13 @@ namespace e2d::dbgui_widgets
     class hierarchy_widget final : public dbgui::widget {
     public:
         hierarchy_widget();
-        ~hierarchy_widget() noexcept = default;
+        ~hierarchy_widget() noexcept;
 
         bool show() override;
         const description& desc() const noexcept override;
     private:
+        class internal_state;
+        std::unique_ptr<internal_state> state_;
         description desc_;
     };
 }
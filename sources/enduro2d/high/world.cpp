@@ -15,50 +15,20 @@ namespace
     using namespace e2d;
 
     class gobject_state final : public gobject::state {
-    private:
-        enum flag_masks : u32 {
-            fm_destroyed = 1u << 0,
-            fm_invalided = 1u << 1,
-        };
     public:
         gobject_state(world& w, ecs::entity e)
-        : world_(w)
-        , entity_(std::move(e)) {}
-
-        void mark_destroyed() noexcept {
-            math::set_flags_inplace(flags_, fm_destroyed);
-        }
+        : gobject::state(std::move(e))
+        , world_(w) {}
 
-        void mark_invalided() noexcept {
-            math::set_flags_inplace(flags_, fm_invalided);
-        }
+        using gobject::state::mark_destroyed;
+        using gobject::state::mark_invalided;
     public:
         void destroy() noexcept final {
             gobject go{this};
             world_.destroy_instance(go);
         }
-
-        bool destroyed() const noexcept final {
-            return math::check_any_flags(flags_, fm_destroyed);
-        }
-
-        bool invalided() const noexcept final {
-            return math::check_any_flags(flags_, fm_invalided);
-        }
-
-        ecs::entity raw_entity() noexcept final {
-            E2D_ASSERT(!invalided());
-            return entity_;
-        }
-
-        ecs::const_entity raw_entity() const noexcept final {
-            E2D_ASSERT(!invalided());
-            return entity_;
-        }
     private:
         world& world_;
-        ecs::entity entity_;
-        u32 flags_{0u};
     };
 }
 
@@ -79,14 +49,14 @@ namespace
 
         if ( inst ) {
             auto inst_g = dynamic_pointer_cast<gobject_state>(inst.internal_state());
-            inst_g->raw_entity().destroy();
+            ecsex::destroy_entity(inst_g->raw_entity());
             inst_g->mark_destroyed();
             inst_g->mark_invalided();
         }
     }
 
     gobject new_instance(world& world, const prefab& root_prefab) {
-        ecs::entity ent = world.registry().create_entity(root_prefab.prototype());
+        ecs::entity ent = ecsex::create_entity(world.registry(), root_prefab.prototype());
         auto ent_defer = make_error_defer([&ent](){
             ent.destroy();
         });
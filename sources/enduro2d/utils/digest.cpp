@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/digest.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    const u32 sha256_round_constants[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    u32 rotr(u32 v, u32 n) noexcept {
+        return (v >> n) | (v << (32u - n));
+    }
+
+    void sha256_process_block(u32 (&state)[8], const u8* block) noexcept {
+        u32 w[64];
+        for ( std::size_t i = 0; i < 16; ++i ) {
+            w[i] =
+                (static_cast<u32>(block[i * 4 + 0]) << 24) |
+                (static_cast<u32>(block[i * 4 + 1]) << 16) |
+                (static_cast<u32>(block[i * 4 + 2]) <<  8) |
+                (static_cast<u32>(block[i * 4 + 3]) <<  0);
+        }
+        for ( std::size_t i = 16; i < 64; ++i ) {
+            const u32 s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const u32 s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        u32 a = state[0], b = state[1], c = state[2], d = state[3];
+        u32 e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for ( std::size_t i = 0; i < 64; ++i ) {
+            const u32 s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            const u32 ch = (e & f) ^ (~e & g);
+            const u32 t1 = h + s1 + ch + sha256_round_constants[i] + w[i];
+            const u32 s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            const u32 maj = (a & b) ^ (a & c) ^ (b & c);
+            const u32 t2 = s0 + maj;
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+namespace e2d::digests
+{
+    sha256_digest sha256(buffer_view src) noexcept {
+        u32 state[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+        const u8* data = static_cast<const u8*>(src.data());
+        const std::size_t size = src.size();
+
+        std::size_t offset = 0;
+        for ( ; offset + 64 <= size; offset += 64 ) {
+            sha256_process_block(state, data + offset);
+        }
+
+        // the tail, the 0x80 terminator and the big-endian bit length
+        // take one or two more blocks
+        u8 tail[128] = {0};
+        const std::size_t tail_size = size - offset;
+        if ( tail_size ) {
+            std::memcpy(tail, data + offset, tail_size);
+        }
+        tail[tail_size] = 0x80;
+
+        const std::size_t tail_blocks = tail_size + 9 > 64 ? 2 : 1;
+        const u64 bit_size = static_cast<u64>(size) * 8u;
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            tail[tail_blocks * 64 - 1 - i] = static_cast<u8>(bit_size >> (i * 8));
+        }
+
+        for ( std::size_t i = 0; i < tail_blocks; ++i ) {
+            sha256_process_block(state, tail + i * 64);
+        }
+
+        sha256_digest result;
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            result[i * 4 + 0] = static_cast<u8>(state[i] >> 24);
+            result[i * 4 + 1] = static_cast<u8>(state[i] >> 16);
+            result[i * 4 + 2] = static_cast<u8>(state[i] >>  8);
+            result[i * 4 + 3] = static_cast<u8>(state[i] >>  0);
+        }
+        return result;
+    }
+
+    sha256_digest sha256(str_view src) noexcept {
+        return sha256(buffer_view(src.data(), src.size()));
+    }
+}
@@ -45,6 +45,10 @@ namespace e2d::filesystem
             && impl::remove_directory(path);
     }
 
+    bool rename_file(str_view from, str_view to) {
+        return impl::rename_file(from, to);
+    }
+
     bool file_exists(str_view path) {
         return impl::file_exists(path);
     }
@@ -14,6 +14,7 @@ namespace e2d::filesystem::impl
 {
     bool remove_file(str_view path);
     bool remove_directory(str_view path);
+    bool rename_file(str_view from, str_view to);
 
     bool file_exists(str_view path);
     bool directory_exists(str_view path);
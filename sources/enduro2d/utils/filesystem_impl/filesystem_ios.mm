@@ -8,6 +8,7 @@
 
 #if defined(E2D_PLATFORM) && E2D_PLATFORM == E2D_PLATFORM_IOS
 
+#include <cstdio>
 #include <unistd.h>
 #include <dirent.h>
 #include <sys/stat.h>
@@ -100,6 +101,10 @@ namespace e2d::filesystem::impl
             || errno == ENOENT;
     }
 
+    bool rename_file(str_view from, str_view to) {
+        return 0 == ::rename(make_utf8(from).c_str(), make_utf8(to).c_str());
+    }
+
     bool file_exists(str_view path) {
         struct stat st{};
         return 0 == ::stat(make_utf8(path).c_str(), &st)
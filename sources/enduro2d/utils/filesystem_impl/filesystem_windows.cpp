@@ -108,6 +108,15 @@ namespace e2d::filesystem::impl
             || ::GetLastError() == ERROR_PATH_NOT_FOUND;
     }
 
+    bool rename_file(str_view from, str_view to) {
+        const wstr wide_from = make_wide(from);
+        const wstr wide_to = make_wide(to);
+        return FALSE != ::MoveFileExW(
+            wide_from.c_str(),
+            wide_to.c_str(),
+            MOVEFILE_REPLACE_EXISTING);
+    }
+
     bool file_exists(str_view path) {
         const wstr wide_path = make_wide(path);
         DWORD attributes = ::GetFileAttributesW(wide_path.c_str());
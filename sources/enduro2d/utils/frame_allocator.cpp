@@ -0,0 +1,174 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/frame_allocator.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    std::atomic<u64> current_frame_number{0u};
+
+    std::size_t align_offset(const u8* ptr, std::size_t alignment) noexcept {
+        const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(ptr);
+        return (alignment - addr % alignment) % alignment;
+    }
+}
+
+namespace e2d
+{
+    frame_arena::frame_arena(std::size_t block_size)
+    : block_size_(math::max(block_size, std::size_t(1u))) {}
+
+    void* frame_arena::allocate(std::size_t size, std::size_t alignment) {
+        E2D_ASSERT(alignment > 0u && math::is_power_of_2(alignment));
+
+        void* result = nullptr;
+        if ( size == 0u ) {
+            size = 1u;
+        }
+
+        for ( ; block_index_ < blocks_.size(); ++block_index_, block_offset_ = 0u ) {
+            if ( try_allocate_from_(blocks_[block_index_], size, alignment, result) ) {
+                return result;
+            }
+        }
+
+        if ( size > std::numeric_limits<std::size_t>::max() - alignment ) {
+            throw bad_frame_allocation();
+        }
+
+        const std::size_t new_block_size = math::max(
+            size + alignment,
+            blocks_.empty() ? block_size_ : blocks_.back().size * 2u);
+
+        block new_block;
+        new_block.data = std::make_unique<u8[]>(new_block_size);
+        new_block.size = new_block_size;
+        blocks_.push_back(std::move(new_block));
+
+        block_index_ = blocks_.size() - 1u;
+        block_offset_ = 0u;
+
+        stats_.capacity_bytes += new_block_size;
+        stats_.block_allocations += 1u;
+
+        if ( !try_allocate_from_(blocks_.back(), size, alignment, result) ) {
+            E2D_ASSERT_MSG(false, "unexpected frame arena state");
+            throw bad_frame_allocation();
+        }
+
+        return result;
+    }
+
+    void frame_arena::deallocate(void* ptr, std::size_t size) noexcept {
+        if ( !ptr ) {
+            return;
+        }
+
+        if ( !stats_.live_allocations ) {
+            // the allocation has outlived a reset and is already counted
+            return;
+        }
+        stats_.live_allocations -= 1u;
+
+        if ( block_index_ >= blocks_.size() ) {
+            return;
+        }
+
+        if ( size == 0u ) {
+            size = 1u;
+        }
+
+        const u8* data = blocks_[block_index_].data.get();
+        const u8* p = static_cast<const u8*>(ptr);
+
+        if ( p >= data && p + size == data + block_offset_ ) {
+            const std::size_t rewind = block_offset_ - static_cast<std::size_t>(p - data);
+            block_offset_ -= rewind;
+            stats_.used_bytes -= math::min(rewind, stats_.used_bytes);
+        }
+    }
+
+    void frame_arena::reset() {
+        E2D_ASSERT_MSG(
+            stats_.live_allocations == 0u,
+            "frame arena reset with outstanding allocations");
+
+        // blocks are not coalesced under alive allocations, their memory
+        // is overwritten by the next frame, but never freed
+        const bool outlived = stats_.live_allocations > 0u;
+        stats_.outlived_allocations += stats_.live_allocations;
+        stats_.live_allocations = 0u;
+
+        if ( !outlived && blocks_.size() > 1u ) {
+            std::size_t total_size = 0u;
+            for ( const block& b : blocks_ ) {
+                total_size += b.size;
+            }
+
+            blocks_.clear();
+
+            block new_block;
+            new_block.data = std::make_unique<u8[]>(total_size);
+            new_block.size = total_size;
+            blocks_.push_back(std::move(new_block));
+
+            stats_.capacity_bytes = total_size;
+            stats_.block_allocations += 1u;
+        }
+
+        block_index_ = 0u;
+        block_offset_ = 0u;
+
+        stats_.used_bytes = 0u;
+        stats_.frame_peak_bytes = 0u;
+    }
+
+    const frame_arena::statistics& frame_arena::stats() const noexcept {
+        return stats_;
+    }
+
+    frame_arena& frame_arena::thread_local_arena() {
+        static thread_local frame_arena arena;
+        const u64 frame_number = current_frame_number.load(std::memory_order_acquire);
+        if ( arena.frame_number_ != frame_number ) {
+            arena.frame_number_ = frame_number;
+            arena.reset();
+        }
+        return arena;
+    }
+
+    void frame_arena::next_frame() noexcept {
+        current_frame_number.fetch_add(1u, std::memory_order_acq_rel);
+    }
+
+    u64 frame_arena::frame_number() noexcept {
+        return current_frame_number.load(std::memory_order_acquire);
+    }
+
+    bool frame_arena::try_allocate_from_(
+        block& b,
+        std::size_t size,
+        std::size_t alignment,
+        void*& result) noexcept
+    {
+        const std::size_t padding = align_offset(b.data.get() + block_offset_, alignment);
+        if ( block_offset_ + padding > b.size || b.size - block_offset_ - padding < size ) {
+            return false;
+        }
+
+        result = b.data.get() + block_offset_ + padding;
+        block_offset_ += padding + size;
+
+        stats_.used_bytes += padding + size;
+        stats_.live_allocations += 1u;
+        stats_.frame_peak_bytes = math::max(stats_.frame_peak_bytes, stats_.used_bytes);
+        stats_.peak_bytes = math::max(stats_.peak_bytes, stats_.used_bytes);
+
+        return true;
+    }
+}
@@ -55,6 +55,9 @@ namespace
         E2D_ASSERT(fdesc.format == format);
         return fdesc;
     }
+
+    std::mutex block_jobs_executor_mutex;
+    images::block_jobs_executor block_jobs_executor_instance;
 }
 
 namespace e2d
@@ -202,6 +205,62 @@ namespace e2d
     }
 }
 
+namespace e2d
+{
+    image_conversion_options& image_conversion_options::premultiply_alpha(bool value) noexcept {
+        premultiply_alpha_ = value;
+        return *this;
+    }
+
+    image_conversion_options& image_conversion_options::unpremultiply_alpha(bool value) noexcept {
+        unpremultiply_alpha_ = value;
+        return *this;
+    }
+
+    image_conversion_options& image_conversion_options::srgb_to_linear(bool value) noexcept {
+        srgb_to_linear_ = value;
+        return *this;
+    }
+
+    image_conversion_options& image_conversion_options::linear_to_srgb(bool value) noexcept {
+        linear_to_srgb_ = value;
+        return *this;
+    }
+
+    image_conversion_options& image_conversion_options::swap_red_blue(bool value) noexcept {
+        swap_red_blue_ = value;
+        return *this;
+    }
+
+    bool image_conversion_options::premultiply_alpha() const noexcept {
+        return premultiply_alpha_;
+    }
+
+    bool image_conversion_options::unpremultiply_alpha() const noexcept {
+        return unpremultiply_alpha_;
+    }
+
+    bool image_conversion_options::srgb_to_linear() const noexcept {
+        return srgb_to_linear_;
+    }
+
+    bool image_conversion_options::linear_to_srgb() const noexcept {
+        return linear_to_srgb_;
+    }
+
+    bool image_conversion_options::swap_red_blue() const noexcept {
+        return swap_red_blue_;
+    }
+
+    bool image_conversion_options::empty() const noexcept {
+        return !premultiply_alpha_
+            && !unpremultiply_alpha_
+            && !srgb_to_linear_
+            && !linear_to_srgb_
+            && !swap_red_blue_;
+    }
+}
+
 namespace e2d::images
 {
     bool try_load_image(
@@ -282,4 +341,101 @@ namespace e2d::images
                 return false;
         }
     }
+
+    void set_block_jobs_executor(block_jobs_executor executor) {
+        std::lock_guard<std::mutex> guard(block_jobs_executor_mutex);
+        block_jobs_executor_instance = std::move(executor);
+    }
+
+    bool try_compress_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        image_compression_quality quality) noexcept
+    {
+        try {
+            return impl::compress_image(dst, src, format, quality);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    bool check_compress_image_support(
+        const image& src,
+        image_data_format format) noexcept
+    {
+        return impl::check_compress_image(src, format);
+    }
+
+    bool try_decompress_image(
+        image& dst,
+        const image& src) noexcept
+    {
+        try {
+            return impl::decompress_image(dst, src);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    bool check_decompress_image_support(
+        const image& src) noexcept
+    {
+        return impl::check_decompress_image(src);
+    }
+
+    bool try_transcode_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        image_compression_quality quality) noexcept
+    {
+        try {
+            return impl::transcode_image(dst, src, format, quality);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    bool try_convert_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        const image_conversion_options& options) noexcept
+    {
+        try {
+            return impl::convert_image(dst, src, format, options);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    bool check_convert_image_support(
+        const image& src,
+        image_data_format format) noexcept
+    {
+        return impl::check_convert_image(src, format);
+    }
+}
+
+namespace e2d::images::impl
+{
+    void run_block_jobs(
+        std::size_t count,
+        const std::function<void(std::size_t)>& job)
+    {
+        block_jobs_executor executor;
+        if ( count > 1u ) {
+            std::lock_guard<std::mutex> guard(block_jobs_executor_mutex);
+            executor = block_jobs_executor_instance;
+        }
+
+        if ( executor ) {
+            executor(count, job);
+        } else {
+            for ( std::size_t i = 0; i < count; ++i ) {
+                job(i);
+            }
+        }
+    }
 }
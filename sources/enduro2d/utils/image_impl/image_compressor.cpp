@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "image_impl_compress.hpp"
+
+namespace
+{
+    using namespace e2d;
+    using namespace e2d::images::impl::compress;
+
+    std::size_t get_bytes_per_pixel(image_data_format format) noexcept {
+        switch ( format ) {
+            case image_data_format::a8:
+            case image_data_format::l8:
+                return 1u;
+            case image_data_format::la8:
+                return 2u;
+            case image_data_format::rgb8:
+                return 3u;
+            case image_data_format::rgba8:
+                return 4u;
+            default:
+                return 0u;
+        }
+    }
+
+    void fetch_block(const image& src, u32 bx, u32 by, block_pixels& dst) {
+        const v2u& size = src.size();
+        const u8* data = src.data().data();
+        for ( u32 y = 0; y < 4u; ++y ) {
+            const u32 sy = math::min(by * 4u + y, size.y - 1u);
+            for ( u32 x = 0; x < 4u; ++x ) {
+                const u32 sx = math::min(bx * 4u + x, size.x - 1u);
+                color32& c = dst[y * 4u + x];
+                switch ( src.format() ) {
+                    case image_data_format::rgba8: {
+                        const u8* p = data + (std::size_t(sy) * size.x + sx) * 4u;
+                        c = color32(p[0], p[1], p[2], p[3]);
+                        break;
+                    }
+                    case image_data_format::rgb8: {
+                        const u8* p = data + (std::size_t(sy) * size.x + sx) * 3u;
+                        c = color32(p[0], p[1], p[2], 255u);
+                        break;
+                    }
+                    default:
+                        c = src.pixel32(sx, sy);
+                        break;
+                }
+            }
+        }
+    }
+
+    void encode_block(
+        const block_pixels& src,
+        image_data_format format,
+        image_compression_quality quality,
+        u8* dst) noexcept
+    {
+        switch ( format ) {
+            case image_data_format::rgba_dxt1:
+                encode_bc1_block(src, true, quality, dst);
+                break;
+            case image_data_format::rgba_dxt3:
+                encode_bc2_alpha_block(src, dst);
+                encode_bc1_block(src, false, quality, dst + 8u);
+                break;
+            case image_data_format::rgba_dxt5:
+                encode_bc3_alpha_block(src, quality, dst);
+                encode_bc1_block(src, false, quality, dst + 8u);
+                break;
+            case image_data_format::rgb_etc1:
+            case image_data_format::rgb_etc2:
+                encode_etc1_block(src, quality, dst);
+                break;
+            case image_data_format::rgba_etc2:
+                encode_eac_alpha_block(src, quality, dst);
+                encode_etc1_block(src, quality, dst + 8u);
+                break;
+            default:
+                E2D_ASSERT_MSG(false, "unexpected compressed image format");
+                break;
+        }
+    }
+}
+
+namespace e2d::images::impl
+{
+    bool check_compress_image(
+        const image& src,
+        image_data_format format) noexcept
+    {
+        const std::size_t bytes_per_pixel = get_bytes_per_pixel(src.format());
+        return !src.empty()
+            && src.size().x > 0u
+            && src.size().y > 0u
+            && bytes_per_pixel > 0u
+            && src.data().size() >= std::size_t(src.size().x) * src.size().y * bytes_per_pixel
+            && get_block_size(format) > 0u
+            && format != image_data_format::rgb_a1_etc2;
+    }
+
+    bool compress_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        image_compression_quality quality)
+    {
+        if ( !check_compress_image(src, format) ) {
+            return false;
+        }
+
+        const std::size_t block_size = get_block_size(format);
+        const u32 blocks_x = (src.size().x + 3u) / 4u;
+        const u32 blocks_y = (src.size().y + 3u) / 4u;
+
+        buffer data(std::size_t(blocks_x) * blocks_y * block_size);
+        u8* const data_ptr = data.data();
+
+        for_each_block_row(blocks_y, [&src, format, quality, block_size, blocks_x, data_ptr](u32 by){
+            block_pixels pixels;
+            u8* row = data_ptr + std::size_t(by) * blocks_x * block_size;
+            for ( u32 bx = 0; bx < blocks_x; ++bx ) {
+                fetch_block(src, bx, by, pixels);
+                encode_block(pixels, format, quality, row + bx * block_size);
+            }
+        });
+
+        dst.assign(src.size(), format, std::move(data));
+        return true;
+    }
+}
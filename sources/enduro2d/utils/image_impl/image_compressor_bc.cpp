@@ -0,0 +1,429 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "image_impl_compress.hpp"
+
+namespace
+{
+    using namespace e2d;
+    using namespace e2d::images::impl::compress;
+
+    const u8 bc1_alpha_threshold = 128u;
+
+    struct rgb_f {
+        f32 r{0.f};
+        f32 g{0.f};
+        f32 b{0.f};
+    };
+
+    rgb_f operator+(const rgb_f& l, const rgb_f& r) noexcept {
+        return {l.r + r.r, l.g + r.g, l.b + r.b};
+    }
+
+    rgb_f operator-(const rgb_f& l, const rgb_f& r) noexcept {
+        return {l.r - r.r, l.g - r.g, l.b - r.b};
+    }
+
+    rgb_f operator*(const rgb_f& l, f32 r) noexcept {
+        return {l.r * r, l.g * r, l.b * r};
+    }
+
+    f32 dot(const rgb_f& l, const rgb_f& r) noexcept {
+        return l.r * r.r + l.g * r.g + l.b * r.b;
+    }
+
+    rgb_f to_rgb_f(const color32& c) noexcept {
+        return {f32(c.r), f32(c.g), f32(c.b)};
+    }
+
+    u16 pack_565(const rgb_f& c) noexcept {
+        const u32 r = static_cast<u32>(math::clamp(c.r * 31.f / 255.f + 0.5f, 0.f, 31.f));
+        const u32 g = static_cast<u32>(math::clamp(c.g * 63.f / 255.f + 0.5f, 0.f, 63.f));
+        const u32 b = static_cast<u32>(math::clamp(c.b * 31.f / 255.f + 0.5f, 0.f, 31.f));
+        return static_cast<u16>((r << 11u) | (g << 5u) | b);
+    }
+
+    void unpack_565(u16 c, i32& r, i32& g, i32& b) noexcept {
+        const i32 r5 = (c >> 11u) & 0x1F;
+        const i32 g6 = (c >> 5u) & 0x3F;
+        const i32 b5 = c & 0x1F;
+        r = (r5 << 3) | (r5 >> 2);
+        g = (g6 << 2) | (g6 >> 4);
+        b = (b5 << 3) | (b5 >> 2);
+    }
+
+    //
+    // bc1 color block
+    //
+
+    rgb_palette make_bc1_palette(u16 c0, u16 c1, bool three_color) noexcept {
+        i32 r[4], g[4], b[4];
+        unpack_565(c0, r[0], g[0], b[0]);
+        unpack_565(c1, r[1], g[1], b[1]);
+        u32 count = 4u;
+        if ( three_color ) {
+            r[2] = (r[0] + r[1]) / 2;
+            g[2] = (g[0] + g[1]) / 2;
+            b[2] = (b[0] + b[1]) / 2;
+            r[3] = g[3] = b[3] = 0;
+            count = 3u;
+        } else {
+            r[2] = (2 * r[0] + r[1]) / 3;
+            g[2] = (2 * g[0] + g[1]) / 3;
+            b[2] = (2 * b[0] + b[1]) / 3;
+            r[3] = (r[0] + 2 * r[1]) / 3;
+            g[3] = (g[0] + 2 * g[1]) / 3;
+            b[3] = (b[0] + 2 * b[1]) / 3;
+        }
+        rgb_palette p;
+        for ( std::size_t i = 0; i < 4; ++i ) {
+            p.r[i] = static_cast<i16>(r[i]);
+            p.g[i] = static_cast<i16>(g[i]);
+            p.b[i] = static_cast<i16>(b[i]);
+        }
+        p.count = count;
+        return p;
+    }
+
+    // returns the total squared error, transparent pixels get index 3
+    u32 select_bc1_indices(
+        const block_pixels& src,
+        const bool* transparent,
+        const rgb_palette& palette,
+        u8* indices) noexcept
+    {
+        i16 r[16], g[16], b[16];
+        for ( std::size_t i = 0; i < src.size(); ++i ) {
+            r[i] = src[i].r;
+            g[i] = src[i].g;
+            b[i] = src[i].b;
+        }
+
+        u32 errors[16];
+        find_nearest_colors8(r, g, b, palette, errors, indices);
+        find_nearest_colors8(r + 8, g + 8, b + 8, palette, errors + 8, indices + 8);
+
+        u32 total_error = 0u;
+        for ( std::size_t i = 0; i < src.size(); ++i ) {
+            if ( transparent[i] ) {
+                indices[i] = 3u;
+            } else {
+                total_error += errors[i];
+            }
+        }
+        return total_error;
+    }
+
+    void find_principal_endpoints(
+        const rgb_f* colors,
+        std::size_t count,
+        image_compression_quality quality,
+        rgb_f& e0,
+        rgb_f& e1) noexcept
+    {
+        rgb_f min_c = colors[0];
+        rgb_f max_c = colors[0];
+        rgb_f mean;
+        for ( std::size_t i = 0; i < count; ++i ) {
+            min_c = {math::min(min_c.r, colors[i].r), math::min(min_c.g, colors[i].g), math::min(min_c.b, colors[i].b)};
+            max_c = {math::max(max_c.r, colors[i].r), math::max(max_c.g, colors[i].g), math::max(max_c.b, colors[i].b)};
+            mean = mean + colors[i];
+        }
+        mean = mean * (1.f / f32(count));
+
+        if ( quality == image_compression_quality::fast ) {
+            // bounding box diagonal with a small inset, red and blue
+            // are flipped when they are anti-correlated with green
+            f32 cov_rg = 0.f, cov_bg = 0.f;
+            for ( std::size_t i = 0; i < count; ++i ) {
+                const rgb_f d = colors[i] - mean;
+                cov_rg += d.r * d.g;
+                cov_bg += d.b * d.g;
+            }
+            if ( cov_rg < 0.f ) {
+                std::swap(min_c.r, max_c.r);
+            }
+            if ( cov_bg < 0.f ) {
+                std::swap(min_c.b, max_c.b);
+            }
+            const rgb_f inset = (max_c - min_c) * (1.f / 16.f);
+            e0 = max_c - inset;
+            e1 = min_c + inset;
+            return;
+        }
+
+        f32 cov[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+        for ( std::size_t i = 0; i < count; ++i ) {
+            const rgb_f d = colors[i] - mean;
+            cov[0] += d.r * d.r;
+            cov[1] += d.r * d.g;
+            cov[2] += d.r * d.b;
+            cov[3] += d.g * d.g;
+            cov[4] += d.g * d.b;
+            cov[5] += d.b * d.b;
+        }
+
+        // power iteration for the principal axis of the colors
+        rgb_f axis = max_c - min_c;
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            const rgb_f next = {
+                axis.r * cov[0] + axis.g * cov[1] + axis.b * cov[2],
+                axis.r * cov[1] + axis.g * cov[3] + axis.b * cov[4],
+                axis.r * cov[2] + axis.g * cov[4] + axis.b * cov[5]};
+            const f32 len = math::max(math::abs(next.r), math::abs(next.g), math::abs(next.b));
+            if ( len < 1e-6f ) {
+                break;
+            }
+            axis = next * (1.f / len);
+        }
+
+        const f32 axis_len2 = dot(axis, axis);
+        if ( axis_len2 < 1e-6f ) {
+            e0 = e1 = mean;
+            return;
+        }
+
+        f32 min_t = std::numeric_limits<f32>::max();
+        f32 max_t = std::numeric_limits<f32>::lowest();
+        for ( std::size_t i = 0; i < count; ++i ) {
+            const f32 t = dot(colors[i] - mean, axis) / axis_len2;
+            min_t = math::min(min_t, t);
+            max_t = math::max(max_t, t);
+        }
+
+        e0 = mean + axis * max_t;
+        e1 = mean + axis * min_t;
+    }
+
+    // least squares endpoints for the given four color indices
+    bool refine_bc1_endpoints(
+        const block_pixels& src,
+        const bool* transparent,
+        const u8* indices,
+        rgb_f& e0,
+        rgb_f& e1) noexcept
+    {
+        const f32 weights[4] = {1.f, 0.f, 2.f / 3.f, 1.f / 3.f};
+
+        f32 aa = 0.f, bb = 0.f, ab = 0.f;
+        rgb_f ax, bx;
+        for ( std::size_t i = 0; i < src.size(); ++i ) {
+            if ( transparent[i] ) {
+                continue;
+            }
+            const f32 a = weights[indices[i]];
+            const f32 b = 1.f - a;
+            const rgb_f x = to_rgb_f(src[i]);
+            aa += a * a;
+            bb += b * b;
+            ab += a * b;
+            ax = ax + x * a;
+            bx = bx + x * b;
+        }
+
+        const f32 det = aa * bb - ab * ab;
+        if ( math::abs(det) < 1e-6f ) {
+            return false;
+        }
+
+        const f32 inv_det = 1.f / det;
+        e0 = (ax * bb - bx * ab) * inv_det;
+        e1 = (bx * aa - ax * ab) * inv_det;
+        return true;
+    }
+
+    void write_bc1_block(u16 c0, u16 c1, const u8* indices, u8* dst) noexcept {
+        u32 bits = 0u;
+        for ( std::size_t i = 0; i < 16; ++i ) {
+            bits |= u32(indices[i] & 0x3u) << (i * 2u);
+        }
+        dst[0] = static_cast<u8>(c0 & 0xFFu);
+        dst[1] = static_cast<u8>(c0 >> 8u);
+        dst[2] = static_cast<u8>(c1 & 0xFFu);
+        dst[3] = static_cast<u8>(c1 >> 8u);
+        dst[4] = static_cast<u8>(bits & 0xFFu);
+        dst[5] = static_cast<u8>((bits >> 8u) & 0xFFu);
+        dst[6] = static_cast<u8>((bits >> 16u) & 0xFFu);
+        dst[7] = static_cast<u8>((bits >> 24u) & 0xFFu);
+    }
+
+    //
+    // bc3 alpha block
+    //
+
+    u32 select_bc3_indices(
+        const block_pixels& src,
+        u8 a0,
+        u8 a1,
+        u8* indices) noexcept
+    {
+        u8 palette[8];
+        palette[0] = a0;
+        palette[1] = a1;
+        if ( a0 > a1 ) {
+            for ( i32 i = 2; i < 8; ++i ) {
+                palette[i] = static_cast<u8>(((8 - i) * a0 + (i - 1) * a1) / 7);
+            }
+        } else {
+            for ( i32 i = 2; i < 6; ++i ) {
+                palette[i] = static_cast<u8>(((6 - i) * a0 + (i - 1) * a1) / 5);
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        u8 alphas[16];
+        for ( std::size_t i = 0; i < src.size(); ++i ) {
+            alphas[i] = src[i].a;
+        }
+
+        u32 errors[16];
+        find_nearest_alphas16(alphas, palette, errors, indices);
+
+        u32 total_error = 0u;
+        for ( u32 error : errors ) {
+            total_error += error;
+        }
+        return total_error;
+    }
+}
+
+namespace e2d::images::impl::compress
+{
+    void encode_bc1_block(
+        const block_pixels& src,
+        bool punch_through_alpha,
+        image_compression_quality quality,
+        u8* dst) noexcept
+    {
+        bool transparent[16] = {false};
+        rgb_f colors[16];
+        std::size_t color_count = 0u;
+
+        for ( std::size_t i = 0; i < src.size(); ++i ) {
+            transparent[i] = punch_through_alpha && src[i].a < bc1_alpha_threshold;
+            if ( !transparent[i] ) {
+                colors[color_count++] = to_rgb_f(src[i]);
+            }
+        }
+
+        u8 indices[16] = {0u};
+
+        if ( color_count == 0u ) {
+            std::fill(std::begin(indices), std::end(indices), u8(3u));
+            write_bc1_block(0x0000u, 0xFFFFu, indices, dst);
+            return;
+        }
+
+        // the three color mode is the only one with transparent texels
+        const bool three_color = color_count < src.size();
+
+        rgb_f e0, e1;
+        find_principal_endpoints(colors, color_count, quality, e0, e1);
+
+        u16 c0 = pack_565(e0);
+        u16 c1 = pack_565(e1);
+        if ( three_color ? c0 > c1 : c0 < c1 ) {
+            std::swap(c0, c1);
+        }
+
+        u32 error = select_bc1_indices(src, transparent, make_bc1_palette(c0, c1, three_color), indices);
+
+        if ( quality == image_compression_quality::best && !three_color ) {
+            for ( std::size_t iter = 0; iter < 2 && error > 0u; ++iter ) {
+                rgb_f r0, r1;
+                if ( !refine_bc1_endpoints(src, transparent, indices, r0, r1) ) {
+                    break;
+                }
+
+                u16 rc0 = pack_565(r0);
+                u16 rc1 = pack_565(r1);
+                if ( rc0 < rc1 ) {
+                    std::swap(rc0, rc1);
+                }
+
+                u8 refined_indices[16];
+                const u32 refined_error = select_bc1_indices(
+                    src, transparent, make_bc1_palette(rc0, rc1, false), refined_indices);
+                if ( refined_error >= error ) {
+                    break;
+                }
+
+                c0 = rc0;
+                c1 = rc1;
+                error = refined_error;
+                std::copy(std::begin(refined_indices), std::end(refined_indices), std::begin(indices));
+            }
+        }
+
+        if ( !three_color && c0 == c1 ) {
+            // equal endpoints switch decoders to the three color mode,
+            // where only the first index is safe to use
+            std::fill(std::begin(indices), std::end(indices), u8(0u));
+        }
+
+        write_bc1_block(c0, c1, indices, dst);
+    }
+
+    void encode_bc2_alpha_block(
+        const block_pixels& src,
+        u8* dst) noexcept
+    {
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            const u32 lo = (src[i * 2 + 0].a * 15u + 127u) / 255u;
+            const u32 hi = (src[i * 2 + 1].a * 15u + 127u) / 255u;
+            dst[i] = static_cast<u8>(lo | (hi << 4u));
+        }
+    }
+
+    void encode_bc3_alpha_block(
+        const block_pixels& src,
+        image_compression_quality quality,
+        u8* dst) noexcept
+    {
+        u8 min_a = 255u, max_a = 0u;
+        u8 min_inner_a = 255u, max_inner_a = 0u;
+        for ( const color32& c : src ) {
+            min_a = math::min(min_a, c.a);
+            max_a = math::max(max_a, c.a);
+            if ( c.a != 0u && c.a != 255u ) {
+                min_inner_a = math::min(min_inner_a, c.a);
+                max_inner_a = math::max(max_inner_a, c.a);
+            }
+        }
+
+        u8 a0 = max_a;
+        u8 a1 = min_a;
+        u8 indices[16] = {0u};
+        u32 error = select_bc3_indices(src, a0, a1, indices);
+
+        // six alpha mode keeps exact 0 and 255 values,
+        // which is usually better for cutout edges
+        if ( error > 0u && quality != image_compression_quality::fast ) {
+            const u8 six_a0 = min_inner_a <= max_inner_a ? min_inner_a : min_a;
+            const u8 six_a1 = min_inner_a <= max_inner_a ? max_inner_a : min_a;
+            u8 six_indices[16];
+            const u32 six_error = select_bc3_indices(src, six_a0, six_a1, six_indices);
+            if ( six_error < error ) {
+                a0 = six_a0;
+                a1 = six_a1;
+                error = six_error;
+                std::copy(std::begin(six_indices), std::end(six_indices), std::begin(indices));
+            }
+        }
+
+        u64 bits = 0u;
+        for ( std::size_t i = 0; i < 16; ++i ) {
+            bits |= u64(indices[i] & 0x7u) << (i * 3u);
+        }
+
+        dst[0] = a0;
+        dst[1] = a1;
+        for ( std::size_t i = 0; i < 6; ++i ) {
+            dst[2 + i] = static_cast<u8>((bits >> (i * 8u)) & 0xFFu);
+        }
+    }
+}
@@ -0,0 +1,375 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "image_impl_compress.hpp"
+
+namespace
+{
+    using namespace e2d;
+    using namespace e2d::images::impl::compress;
+
+    i32 clamp_byte(i32 v) noexcept {
+        return math::clamp(v, 0, 255);
+    }
+
+    void write_u64_be(u64 bits, u8* dst) noexcept {
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            dst[i] = static_cast<u8>((bits >> (56u - i * 8u)) & 0xFFu);
+        }
+    }
+
+    // pixel indices of both sub-blocks for both flip modes
+    struct etc1_subblocks {
+        u8 pixels[2][8];
+    };
+
+    etc1_subblocks make_etc1_subblocks(bool flip) noexcept {
+        etc1_subblocks result;
+        std::size_t counts[2] = {0u, 0u};
+        for ( u8 y = 0; y < 4u; ++y ) {
+            for ( u8 x = 0; x < 4u; ++x ) {
+                const std::size_t sub = flip ? (y >= 2u) : (x >= 2u);
+                result.pixels[sub][counts[sub]++] = static_cast<u8>(y * 4u + x);
+            }
+        }
+        return result;
+    }
+
+    struct etc1_subblock_fit {
+        u32 error{std::numeric_limits<u32>::max()};
+        u8 table{0u};
+        u8 indices[8] = {0u};
+    };
+
+    etc1_subblock_fit fit_etc1_subblock(
+        const block_pixels& src,
+        const u8* pixels,
+        i32 base_r, i32 base_g, i32 base_b) noexcept
+    {
+        i16 r[8], g[8], b[8];
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            const color32& c = src[pixels[i]];
+            r[i] = c.r;
+            g[i] = c.g;
+            b[i] = c.b;
+        }
+
+        etc1_subblock_fit best;
+        for ( u8 t = 0; t < 8u; ++t ) {
+            rgb_palette palette;
+            for ( std::size_t j = 0; j < 4; ++j ) {
+                const i32 m = etc1_modifier_table[t][j];
+                palette.r[j] = static_cast<i16>(clamp_byte(base_r + m));
+                palette.g[j] = static_cast<i16>(clamp_byte(base_g + m));
+                palette.b[j] = static_cast<i16>(clamp_byte(base_b + m));
+            }
+
+            etc1_subblock_fit fit;
+            fit.error = 0u;
+            fit.table = t;
+
+            u32 errors[8];
+            find_nearest_colors8(r, g, b, palette, errors, fit.indices);
+            for ( u32 error : errors ) {
+                fit.error += error;
+            }
+
+            if ( fit.error < best.error ) {
+                best = fit;
+            }
+        }
+        return best;
+    }
+
+    struct etc1_candidate {
+        u32 error{std::numeric_limits<u32>::max()};
+        bool flip{false};
+        bool differential{false};
+        i32 base[2][3] = {{0}};
+        etc1_subblock_fit fits[2];
+    };
+
+    i32 expand_4(i32 v) noexcept {
+        return (v << 4) | v;
+    }
+
+    i32 expand_5(i32 v) noexcept {
+        return (v << 3) | (v >> 2);
+    }
+
+    void average_subblock(const block_pixels& src, const u8* pixels, f32* avg) noexcept {
+        avg[0] = avg[1] = avg[2] = 0.f;
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            avg[0] += src[pixels[i]].r;
+            avg[1] += src[pixels[i]].g;
+            avg[2] += src[pixels[i]].b;
+        }
+        avg[0] /= 8.f;
+        avg[1] /= 8.f;
+        avg[2] /= 8.f;
+    }
+
+    // fits a sub-block with its quantized base color and, for better quality,
+    // with the base color shifted by one quantization step in luminance
+    etc1_subblock_fit fit_etc1_quantized(
+        const block_pixels& src,
+        const u8* pixels,
+        i32* base,
+        i32 max_value,
+        bool five_bits,
+        image_compression_quality quality) noexcept
+    {
+        const auto expand = [five_bits](i32 v){
+            return five_bits ? expand_5(v) : expand_4(v);
+        };
+
+        etc1_subblock_fit best = fit_etc1_subblock(
+            src, pixels, expand(base[0]), expand(base[1]), expand(base[2]));
+
+        if ( quality == image_compression_quality::best ) {
+            i32 best_base[3] = {base[0], base[1], base[2]};
+            for ( i32 shift : {-1, 1} ) {
+                const i32 r = math::clamp(base[0] + shift, 0, max_value);
+                const i32 g = math::clamp(base[1] + shift, 0, max_value);
+                const i32 b = math::clamp(base[2] + shift, 0, max_value);
+                const etc1_subblock_fit fit = fit_etc1_subblock(
+                    src, pixels, expand(r), expand(g), expand(b));
+                if ( fit.error < best.error ) {
+                    best = fit;
+                    best_base[0] = r;
+                    best_base[1] = g;
+                    best_base[2] = b;
+                }
+            }
+            base[0] = best_base[0];
+            base[1] = best_base[1];
+            base[2] = best_base[2];
+        }
+
+        return best;
+    }
+
+    void try_etc1_candidate(
+        const block_pixels& src,
+        bool flip,
+        image_compression_quality quality,
+        etc1_candidate& best) noexcept
+    {
+        const etc1_subblocks subblocks = make_etc1_subblocks(flip);
+
+        f32 avg[2][3];
+        average_subblock(src, subblocks.pixels[0], avg[0]);
+        average_subblock(src, subblocks.pixels[1], avg[1]);
+
+        // differential mode: 555 base and 333 signed delta
+        {
+            etc1_candidate c;
+            c.flip = flip;
+            c.differential = true;
+            for ( std::size_t s = 0; s < 2; ++s ) {
+                for ( std::size_t ch = 0; ch < 3; ++ch ) {
+                    c.base[s][ch] = math::clamp(i32(avg[s][ch] * 31.f / 255.f + 0.5f), 0, 31);
+                }
+            }
+
+            bool in_range = true;
+            for ( std::size_t ch = 0; ch < 3; ++ch ) {
+                const i32 d = c.base[1][ch] - c.base[0][ch];
+                in_range = in_range && d >= -4 && d <= 3;
+            }
+
+            if ( in_range ) {
+                c.fits[0] = fit_etc1_quantized(src, subblocks.pixels[0], c.base[0], 31, true, quality);
+                c.fits[1] = fit_etc1_quantized(src, subblocks.pixels[1], c.base[1], 31, true, quality);
+
+                for ( std::size_t ch = 0; ch < 3 && in_range; ++ch ) {
+                    const i32 d = c.base[1][ch] - c.base[0][ch];
+                    in_range = d >= -4 && d <= 3;
+                }
+
+                if ( !in_range ) {
+                    // luminance shifts broke the delta range, refit with plain bases
+                    for ( std::size_t s = 0; s < 2; ++s ) {
+                        for ( std::size_t ch = 0; ch < 3; ++ch ) {
+                            c.base[s][ch] = math::clamp(i32(avg[s][ch] * 31.f / 255.f + 0.5f), 0, 31);
+                        }
+                    }
+                    c.fits[0] = fit_etc1_quantized(
+                        src, subblocks.pixels[0], c.base[0], 31, true, image_compression_quality::normal);
+                    c.fits[1] = fit_etc1_quantized(
+                        src, subblocks.pixels[1], c.base[1], 31, true, image_compression_quality::normal);
+                }
+
+                c.error = c.fits[0].error + c.fits[1].error;
+                if ( c.error < best.error ) {
+                    best = c;
+                }
+            }
+        }
+
+        // individual mode: two 444 base colors
+        if ( quality != image_compression_quality::fast || best.error == std::numeric_limits<u32>::max() ) {
+            etc1_candidate c;
+            c.flip = flip;
+            c.differential = false;
+            for ( std::size_t s = 0; s < 2; ++s ) {
+                for ( std::size_t ch = 0; ch < 3; ++ch ) {
+                    c.base[s][ch] = math::clamp(i32(avg[s][ch] * 15.f / 255.f + 0.5f), 0, 15);
+                }
+                c.fits[s] = fit_etc1_quantized(src, subblocks.pixels[s], c.base[s], 15, false, quality);
+            }
+            c.error = c.fits[0].error + c.fits[1].error;
+            if ( c.error < best.error ) {
+                best = c;
+            }
+        }
+    }
+
+    void write_etc1_block(const etc1_candidate& c, u8* dst) noexcept {
+        u64 bits = 0u;
+        if ( c.differential ) {
+            bits |= u64(c.base[0][0]) << 59u;
+            bits |= u64((c.base[1][0] - c.base[0][0]) & 0x7) << 56u;
+            bits |= u64(c.base[0][1]) << 51u;
+            bits |= u64((c.base[1][1] - c.base[0][1]) & 0x7) << 48u;
+            bits |= u64(c.base[0][2]) << 43u;
+            bits |= u64((c.base[1][2] - c.base[0][2]) & 0x7) << 40u;
+            bits |= u64(1u) << 33u;
+        } else {
+            bits |= u64(c.base[0][0]) << 60u;
+            bits |= u64(c.base[1][0]) << 56u;
+            bits |= u64(c.base[0][1]) << 52u;
+            bits |= u64(c.base[1][1]) << 48u;
+            bits |= u64(c.base[0][2]) << 44u;
+            bits |= u64(c.base[1][2]) << 40u;
+        }
+
+        bits |= u64(c.fits[0].table) << 37u;
+        bits |= u64(c.fits[1].table) << 34u;
+        bits |= u64(c.flip ? 1u : 0u) << 32u;
+
+        const etc1_subblocks subblocks = make_etc1_subblocks(c.flip);
+        for ( std::size_t s = 0; s < 2; ++s ) {
+            for ( std::size_t i = 0; i < 8; ++i ) {
+                const u8 pixel = subblocks.pixels[s][i];
+                const u32 k = (pixel % 4u) * 4u + pixel / 4u;
+                const u8 index = c.fits[s].indices[i];
+                bits |= u64(index >> 1u) << (16u + k);
+                bits |= u64(index & 1u) << k;
+            }
+        }
+
+        write_u64_be(bits, dst);
+    }
+
+    //
+    // eac alpha block
+    //
+
+    u32 fit_eac(
+        const block_pixels& src,
+        i32 base,
+        i32 multiplier,
+        std::size_t table,
+        u8* indices) noexcept
+    {
+        u8 alphas[16];
+        for ( std::size_t i = 0; i < src.size(); ++i ) {
+            alphas[i] = src[i].a;
+        }
+
+        u8 palette[8];
+        for ( std::size_t j = 0; j < 8; ++j ) {
+            palette[j] = static_cast<u8>(clamp_byte(base + eac_modifier_table[table][j] * multiplier));
+        }
+
+        u32 errors[16];
+        find_nearest_alphas16(alphas, palette, errors, indices);
+
+        u32 total_error = 0u;
+        for ( u32 error : errors ) {
+            total_error += error;
+        }
+        return total_error;
+    }
+}
+
+namespace e2d::images::impl::compress
+{
+    void encode_etc1_block(
+        const block_pixels& src,
+        image_compression_quality quality,
+        u8* dst) noexcept
+    {
+        etc1_candidate best;
+        try_etc1_candidate(src, false, quality, best);
+        if ( best.error > 0u ) {
+            try_etc1_candidate(src, true, quality, best);
+        }
+        write_etc1_block(best, dst);
+    }
+
+    void encode_eac_alpha_block(
+        const block_pixels& src,
+        image_compression_quality quality,
+        u8* dst) noexcept
+    {
+        i32 min_a = 255, max_a = 0;
+        for ( const color32& c : src ) {
+            min_a = math::min(min_a, i32(c.a));
+            max_a = math::max(max_a, i32(c.a));
+        }
+
+        // table 13 has the zero modifier at index 4, so constant alpha is exact
+        i32 best_base = min_a;
+        i32 best_multiplier = 1;
+        std::size_t best_table = 13u;
+        u8 best_indices[16];
+        u32 best_error = fit_eac(src, best_base, best_multiplier, best_table, best_indices);
+
+        const i32 base_spread = quality == image_compression_quality::best ? 2 : 0;
+        const i32 multiplier_spread = quality == image_compression_quality::fast ? 0 : 1;
+
+        for ( std::size_t t = 0; t < 16u && best_error > 0u; ++t ) {
+            const i32 min_m = eac_modifier_table[t][3];
+            const i32 max_m = eac_modifier_table[t][7];
+            const i32 ideal_multiplier = math::clamp(
+                (max_a - min_a + (max_m - min_m) / 2) / (max_m - min_m), 1, 15);
+
+            for ( i32 dm = -multiplier_spread; dm <= multiplier_spread; ++dm ) {
+                const i32 multiplier = ideal_multiplier + dm;
+                if ( multiplier < 1 || multiplier > 15 ) {
+                    continue;
+                }
+
+                const i32 ideal_base = clamp_byte(min_a - min_m * multiplier);
+                for ( i32 db = -base_spread; db <= base_spread; ++db ) {
+                    const i32 base = clamp_byte(ideal_base + db);
+                    u8 indices[16];
+                    const u32 error = fit_eac(src, base, multiplier, t, indices);
+                    if ( error < best_error ) {
+                        best_error = error;
+                        best_base = base;
+                        best_multiplier = multiplier;
+                        best_table = t;
+                        std::copy(std::begin(indices), std::end(indices), std::begin(best_indices));
+                    }
+                }
+            }
+        }
+
+        u64 bits = 0u;
+        bits |= u64(best_base) << 56u;
+        bits |= u64(best_multiplier) << 52u;
+        bits |= u64(best_table) << 48u;
+        for ( u32 i = 0; i < 16u; ++i ) {
+            const u32 k = (i % 4u) * 4u + i / 4u;
+            bits |= u64(best_indices[i] & 0x7u) << (45u - k * 3u);
+        }
+
+        write_u64_be(bits, dst);
+    }
+}
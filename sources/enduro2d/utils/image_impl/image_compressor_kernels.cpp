@@ -0,0 +1,197 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "image_impl_compress.hpp"
+
+namespace
+{
+    using namespace e2d;
+
+#if defined(E2D_IMAGE_IMPL_SSE2)
+    __m128i select_si128(__m128i mask, __m128i l, __m128i r) noexcept {
+        return _mm_or_si128(_mm_and_si128(mask, l), _mm_andnot_si128(mask, r));
+    }
+#endif
+}
+
+namespace e2d::images::impl::compress
+{
+    void find_nearest_colors8(
+        const i16* r,
+        const i16* g,
+        const i16* b,
+        const rgb_palette& palette,
+        u32* errors,
+        u8* indices) noexcept
+    {
+    #if defined(E2D_IMAGE_IMPL_NEON)
+        const int16x8_t vr = vld1q_s16(r);
+        const int16x8_t vg = vld1q_s16(g);
+        const int16x8_t vb = vld1q_s16(b);
+
+        int32x4_t best_lo = vdupq_n_s32(std::numeric_limits<i32>::max());
+        int32x4_t best_hi = best_lo;
+        uint32x4_t index_lo = vdupq_n_u32(0u);
+        uint32x4_t index_hi = index_lo;
+
+        for ( u32 j = 0; j < palette.count; ++j ) {
+            const int16x8_t dr = vsubq_s16(vr, vdupq_n_s16(palette.r[j]));
+            const int16x8_t dg = vsubq_s16(vg, vdupq_n_s16(palette.g[j]));
+            const int16x8_t db = vsubq_s16(vb, vdupq_n_s16(palette.b[j]));
+
+            int32x4_t error_lo = vmull_s16(vget_low_s16(dr), vget_low_s16(dr));
+            error_lo = vmlal_s16(error_lo, vget_low_s16(dg), vget_low_s16(dg));
+            error_lo = vmlal_s16(error_lo, vget_low_s16(db), vget_low_s16(db));
+
+            int32x4_t error_hi = vmull_s16(vget_high_s16(dr), vget_high_s16(dr));
+            error_hi = vmlal_s16(error_hi, vget_high_s16(dg), vget_high_s16(dg));
+            error_hi = vmlal_s16(error_hi, vget_high_s16(db), vget_high_s16(db));
+
+            const uint32x4_t less_lo = vcltq_s32(error_lo, best_lo);
+            const uint32x4_t less_hi = vcltq_s32(error_hi, best_hi);
+            best_lo = vbslq_s32(less_lo, error_lo, best_lo);
+            best_hi = vbslq_s32(less_hi, error_hi, best_hi);
+            index_lo = vbslq_u32(less_lo, vdupq_n_u32(j), index_lo);
+            index_hi = vbslq_u32(less_hi, vdupq_n_u32(j), index_hi);
+        }
+
+        i32 best[8];
+        u32 index[8];
+        vst1q_s32(best, best_lo);
+        vst1q_s32(best + 4, best_hi);
+        vst1q_u32(index, index_lo);
+        vst1q_u32(index + 4, index_hi);
+
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            errors[i] = static_cast<u32>(best[i]);
+            indices[i] = static_cast<u8>(index[i]);
+        }
+    #elif defined(E2D_IMAGE_IMPL_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i vr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r));
+        const __m128i vg = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+
+        __m128i best_lo = _mm_set1_epi32(std::numeric_limits<i32>::max());
+        __m128i best_hi = best_lo;
+        __m128i index_lo = zero;
+        __m128i index_hi = zero;
+
+        for ( u32 j = 0; j < palette.count; ++j ) {
+            const __m128i dr = _mm_sub_epi16(vr, _mm_set1_epi16(palette.r[j]));
+            const __m128i dg = _mm_sub_epi16(vg, _mm_set1_epi16(palette.g[j]));
+            const __m128i db = _mm_sub_epi16(vb, _mm_set1_epi16(palette.b[j]));
+
+            // madd sums the squares of the interleaved pairs into 32 bits
+            const __m128i rg_lo = _mm_unpacklo_epi16(dr, dg);
+            const __m128i rg_hi = _mm_unpackhi_epi16(dr, dg);
+            const __m128i b_lo = _mm_unpacklo_epi16(db, zero);
+            const __m128i b_hi = _mm_unpackhi_epi16(db, zero);
+
+            const __m128i error_lo = _mm_add_epi32(
+                _mm_madd_epi16(rg_lo, rg_lo),
+                _mm_madd_epi16(b_lo, b_lo));
+            const __m128i error_hi = _mm_add_epi32(
+                _mm_madd_epi16(rg_hi, rg_hi),
+                _mm_madd_epi16(b_hi, b_hi));
+
+            const __m128i less_lo = _mm_cmplt_epi32(error_lo, best_lo);
+            const __m128i less_hi = _mm_cmplt_epi32(error_hi, best_hi);
+            const __m128i index = _mm_set1_epi32(static_cast<int>(j));
+            best_lo = select_si128(less_lo, error_lo, best_lo);
+            best_hi = select_si128(less_hi, error_hi, best_hi);
+            index_lo = select_si128(less_lo, index, index_lo);
+            index_hi = select_si128(less_hi, index, index_hi);
+        }
+
+        alignas(16) i32 best[8];
+        alignas(16) i32 index[8];
+        _mm_store_si128(reinterpret_cast<__m128i*>(best), best_lo);
+        _mm_store_si128(reinterpret_cast<__m128i*>(best + 4), best_hi);
+        _mm_store_si128(reinterpret_cast<__m128i*>(index), index_lo);
+        _mm_store_si128(reinterpret_cast<__m128i*>(index + 4), index_hi);
+
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            errors[i] = static_cast<u32>(best[i]);
+            indices[i] = static_cast<u8>(index[i]);
+        }
+    #else
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            u32 best_error = std::numeric_limits<u32>::max();
+            u8 best_index = 0u;
+            for ( u32 j = 0; j < palette.count; ++j ) {
+                const i32 dr = i32(r[i]) - palette.r[j];
+                const i32 dg = i32(g[i]) - palette.g[j];
+                const i32 db = i32(b[i]) - palette.b[j];
+                const u32 error = u32(dr * dr + dg * dg + db * db);
+                if ( error < best_error ) {
+                    best_error = error;
+                    best_index = static_cast<u8>(j);
+                }
+            }
+            errors[i] = best_error;
+            indices[i] = best_index;
+        }
+    #endif
+    }
+
+    void find_nearest_alphas16(
+        const u8* alphas,
+        const u8* palette,
+        u32* errors,
+        u8* indices) noexcept
+    {
+        // absolute differences order the same as squared ones and fit in bytes
+        u8 distances[16];
+    #if defined(E2D_IMAGE_IMPL_NEON)
+        const uint8x16_t a = vld1q_u8(alphas);
+        uint8x16_t best = vdupq_n_u8(0xFF);
+        uint8x16_t best_index = vdupq_n_u8(0u);
+        for ( u8 j = 0; j < 8u; ++j ) {
+            const uint8x16_t d = vabdq_u8(a, vdupq_n_u8(palette[j]));
+            const uint8x16_t less = vcltq_u8(d, best);
+            best = vbslq_u8(less, d, best);
+            best_index = vbslq_u8(less, vdupq_n_u8(j), best_index);
+        }
+        vst1q_u8(distances, best);
+        vst1q_u8(indices, best_index);
+    #elif defined(E2D_IMAGE_IMPL_SSE2)
+        // there is no unsigned byte comparison, so the sign bits are flipped
+        const __m128i sign = _mm_set1_epi8(static_cast<char>(0x80));
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alphas));
+        __m128i best = _mm_set1_epi8(static_cast<char>(0xFF));
+        __m128i best_index = _mm_setzero_si128();
+        for ( u8 j = 0; j < 8u; ++j ) {
+            const __m128i p = _mm_set1_epi8(static_cast<char>(palette[j]));
+            const __m128i d = _mm_or_si128(_mm_subs_epu8(a, p), _mm_subs_epu8(p, a));
+            const __m128i less = _mm_cmplt_epi8(
+                _mm_xor_si128(d, sign),
+                _mm_xor_si128(best, sign));
+            best = select_si128(less, d, best);
+            best_index = select_si128(less, _mm_set1_epi8(static_cast<char>(j)), best_index);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(distances), best);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices), best_index);
+    #else
+        for ( std::size_t i = 0; i < 16; ++i ) {
+            distances[i] = 0xFF;
+            indices[i] = 0u;
+            for ( u8 j = 0; j < 8u; ++j ) {
+                const u8 d = alphas[i] > palette[j]
+                    ? static_cast<u8>(alphas[i] - palette[j])
+                    : static_cast<u8>(palette[j] - alphas[i]);
+                if ( d < distances[i] ) {
+                    distances[i] = d;
+                    indices[i] = j;
+                }
+            }
+        }
+    #endif
+        for ( std::size_t i = 0; i < 16; ++i ) {
+            errors[i] = u32(distances[i]) * distances[i];
+        }
+    }
+}
@@ -0,0 +1,376 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "image_impl.hpp"
+
+namespace
+{
+    using namespace e2d;
+
+    // pixels per intermediate rgba8 chunk
+    constexpr std::size_t chunk_pixel_count = 256u;
+
+    std::size_t get_bytes_per_pixel(image_data_format format) noexcept {
+        switch ( format ) {
+            case image_data_format::a8:
+            case image_data_format::l8:
+                return 1u;
+            case image_data_format::la8:
+                return 2u;
+            case image_data_format::rgb8:
+                return 3u;
+            case image_data_format::rgba8:
+                return 4u;
+            default:
+                return 0u;
+        }
+    }
+
+    u8 mul_div_255(u32 x, u32 y) noexcept {
+        const u32 t = x * y + 128u;
+        return static_cast<u8>((t + (t >> 8u)) >> 8u);
+    }
+
+    u8 rgb_to_luminance(u32 r, u32 g, u32 b) noexcept {
+        return static_cast<u8>((r * 77u + g * 150u + b * 29u + 128u) >> 8u);
+    }
+
+    //
+    // lookup tables
+    //
+
+    struct conversion_tables {
+        std::array<u8, 256> srgb_to_linear;
+        std::array<u8, 256> linear_to_srgb;
+        std::array<u32, 256> unpremultiply;
+    };
+
+    const conversion_tables& get_conversion_tables() noexcept {
+        static const conversion_tables tables = [](){
+            conversion_tables t;
+            for ( u32 i = 0; i < 256u; ++i ) {
+                const f64 v = i / 255.0;
+                const f64 linear = v <= 0.04045
+                    ? v / 12.92
+                    : std::pow((v + 0.055) / 1.055, 2.4);
+                const f64 srgb = v <= 0.0031308
+                    ? v * 12.92
+                    : 1.055 * std::pow(v, 1.0 / 2.4) - 0.055;
+                t.srgb_to_linear[i] = static_cast<u8>(linear * 255.0 + 0.5);
+                t.linear_to_srgb[i] = static_cast<u8>(srgb * 255.0 + 0.5);
+                // 16.16 fixed point 255 / alpha
+                t.unpremultiply[i] = i > 0u
+                    ? (255u * 65536u + i / 2u) / i
+                    : 0u;
+            }
+            return t;
+        }();
+        return tables;
+    }
+
+    //
+    // rgb8 <-> rgba8 kernels
+    //
+
+    void expand_rgb8_to_rgba8(const u8* src, u8* dst, std::size_t count) noexcept {
+        std::size_t i = 0;
+    #if defined(E2D_IMAGE_IMPL_NEON)
+        for ( ; i + 16u <= count; i += 16u ) {
+            const uint8x16x3_t rgb = vld3q_u8(src + i * 3u);
+            uint8x16x4_t rgba;
+            rgba.val[0] = rgb.val[0];
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = rgb.val[2];
+            rgba.val[3] = vdupq_n_u8(0xFF);
+            vst4q_u8(dst + i * 4u, rgba);
+        }
+    #elif defined(E2D_IMAGE_IMPL_SSSE3)
+        const __m128i mask = _mm_setr_epi8(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1);
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        // each load reads 16 bytes but consumes only 12 of them
+        for ( ; i + 6u <= count; i += 4u ) {
+            const __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3u));
+            const __m128i rgba = _mm_or_si128(_mm_shuffle_epi8(rgb, mask), alpha);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4u), rgba);
+        }
+    #endif
+        for ( ; i < count; ++i ) {
+            dst[i * 4u + 0u] = src[i * 3u + 0u];
+            dst[i * 4u + 1u] = src[i * 3u + 1u];
+            dst[i * 4u + 2u] = src[i * 3u + 2u];
+            dst[i * 4u + 3u] = 0xFF;
+        }
+    }
+
+    void shrink_rgba8_to_rgb8(const u8* src, u8* dst, std::size_t count) noexcept {
+        std::size_t i = 0;
+    #if defined(E2D_IMAGE_IMPL_NEON)
+        for ( ; i + 16u <= count; i += 16u ) {
+            const uint8x16x4_t rgba = vld4q_u8(src + i * 4u);
+            uint8x16x3_t rgb;
+            rgb.val[0] = rgba.val[0];
+            rgb.val[1] = rgba.val[1];
+            rgb.val[2] = rgba.val[2];
+            vst3q_u8(dst + i * 3u, rgb);
+        }
+    #elif defined(E2D_IMAGE_IMPL_SSSE3)
+        const __m128i mask = _mm_setr_epi8(0,1,2, 4,5,6, 8,9,10, 12,13,14, -1,-1,-1,-1);
+        // each store writes 16 bytes but only 12 of them are meaningful
+        for ( ; i + 6u <= count; i += 4u ) {
+            const __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4u));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 3u), _mm_shuffle_epi8(rgba, mask));
+        }
+    #endif
+        for ( ; i < count; ++i ) {
+            dst[i * 3u + 0u] = src[i * 4u + 0u];
+            dst[i * 3u + 1u] = src[i * 4u + 1u];
+            dst[i * 3u + 2u] = src[i * 4u + 2u];
+        }
+    }
+
+    //
+    // in-place rgba8 kernels
+    //
+
+    void premultiply_rgba8(u8* pixels, std::size_t count) noexcept {
+        std::size_t i = 0;
+    #if defined(E2D_IMAGE_IMPL_NEON)
+        for ( ; i + 16u <= count; i += 16u ) {
+            uint8x16x4_t rgba = vld4q_u8(pixels + i * 4u);
+            for ( std::size_t c = 0; c < 3u; ++c ) {
+                const uint16x8_t lo = vmull_u8(vget_low_u8(rgba.val[c]), vget_low_u8(rgba.val[3]));
+                const uint16x8_t hi = vmull_u8(vget_high_u8(rgba.val[c]), vget_high_u8(rgba.val[3]));
+                rgba.val[c] = vcombine_u8(
+                    vrshrn_n_u16(vrsraq_n_u16(lo, lo, 8), 8),
+                    vrshrn_n_u16(vrsraq_n_u16(hi, hi, 8), 8));
+            }
+            vst4q_u8(pixels + i * 4u, rgba);
+        }
+    #elif defined(E2D_IMAGE_IMPL_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bias = _mm_set1_epi16(128);
+        const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        const auto mul_div_255_epi16 = [&bias](__m128i c, __m128i a) noexcept {
+            const __m128i t = _mm_add_epi16(_mm_mullo_epi16(c, a), bias);
+            return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        };
+        for ( ; i + 4u <= count; i += 4u ) {
+            __m128i* p = reinterpret_cast<__m128i*>(pixels + i * 4u);
+            const __m128i rgba = _mm_loadu_si128(p);
+            const __m128i lo = _mm_unpacklo_epi8(rgba, zero);
+            const __m128i hi = _mm_unpackhi_epi8(rgba, zero);
+            const __m128i lo_a = _mm_shufflehi_epi16(
+                _mm_shufflelo_epi16(lo, _MM_SHUFFLE(3,3,3,3)), _MM_SHUFFLE(3,3,3,3));
+            const __m128i hi_a = _mm_shufflehi_epi16(
+                _mm_shufflelo_epi16(hi, _MM_SHUFFLE(3,3,3,3)), _MM_SHUFFLE(3,3,3,3));
+            const __m128i result = _mm_packus_epi16(
+                mul_div_255_epi16(lo, lo_a),
+                mul_div_255_epi16(hi, hi_a));
+            _mm_storeu_si128(p, _mm_or_si128(
+                _mm_andnot_si128(alpha_mask, result),
+                _mm_and_si128(alpha_mask, rgba)));
+        }
+    #endif
+        for ( ; i < count; ++i ) {
+            u8* p = pixels + i * 4u;
+            p[0] = mul_div_255(p[0], p[3]);
+            p[1] = mul_div_255(p[1], p[3]);
+            p[2] = mul_div_255(p[2], p[3]);
+        }
+    }
+
+    void unpremultiply_rgba8(u8* pixels, std::size_t count) noexcept {
+        const std::array<u32, 256>& table = get_conversion_tables().unpremultiply;
+        for ( std::size_t i = 0; i < count; ++i ) {
+            u8* p = pixels + i * 4u;
+            const u32 k = table[p[3]];
+            p[0] = static_cast<u8>(math::min((p[0] * k + 32768u) >> 16u, 255u));
+            p[1] = static_cast<u8>(math::min((p[1] * k + 32768u) >> 16u, 255u));
+            p[2] = static_cast<u8>(math::min((p[2] * k + 32768u) >> 16u, 255u));
+        }
+    }
+
+    void swap_red_blue_rgba8(u8* pixels, std::size_t count) noexcept {
+        std::size_t i = 0;
+    #if defined(E2D_IMAGE_IMPL_NEON)
+        for ( ; i + 16u <= count; i += 16u ) {
+            uint8x16x4_t rgba = vld4q_u8(pixels + i * 4u);
+            std::swap(rgba.val[0], rgba.val[2]);
+            vst4q_u8(pixels + i * 4u, rgba);
+        }
+    #elif defined(E2D_IMAGE_IMPL_SSE2)
+        const __m128i ga_mask = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+        const __m128i c_mask = _mm_set1_epi32(0x000000FF);
+        for ( ; i + 4u <= count; i += 4u ) {
+            __m128i* p = reinterpret_cast<__m128i*>(pixels + i * 4u);
+            const __m128i rgba = _mm_loadu_si128(p);
+            const __m128i r = _mm_slli_epi32(_mm_and_si128(rgba, c_mask), 16);
+            const __m128i b = _mm_and_si128(_mm_srli_epi32(rgba, 16), c_mask);
+            _mm_storeu_si128(p, _mm_or_si128(
+                _mm_and_si128(rgba, ga_mask),
+                _mm_or_si128(r, b)));
+        }
+    #endif
+        for ( ; i < count; ++i ) {
+            u8* p = pixels + i * 4u;
+            std::swap(p[0], p[2]);
+        }
+    }
+
+    void apply_table_rgba8(u8* pixels, std::size_t count, const std::array<u8, 256>& table) noexcept {
+        for ( std::size_t i = 0; i < count; ++i ) {
+            u8* p = pixels + i * 4u;
+            p[0] = table[p[0]];
+            p[1] = table[p[1]];
+            p[2] = table[p[2]];
+        }
+    }
+
+    //
+    // format to rgba8 and back
+    //
+
+    void load_rgba8(image_data_format format, const u8* src, u8* dst, std::size_t count) noexcept {
+        switch ( format ) {
+            case image_data_format::a8:
+                for ( std::size_t i = 0; i < count; ++i, dst += 4u ) {
+                    dst[0] = dst[1] = dst[2] = 0xFF;
+                    dst[3] = src[i];
+                }
+                break;
+            case image_data_format::l8:
+                for ( std::size_t i = 0; i < count; ++i, dst += 4u ) {
+                    dst[0] = dst[1] = dst[2] = src[i];
+                    dst[3] = 0xFF;
+                }
+                break;
+            case image_data_format::la8:
+                for ( std::size_t i = 0; i < count; ++i, dst += 4u ) {
+                    dst[0] = dst[1] = dst[2] = src[i * 2u + 0u];
+                    dst[3] = src[i * 2u + 1u];
+                }
+                break;
+            case image_data_format::rgb8:
+                expand_rgb8_to_rgba8(src, dst, count);
+                break;
+            case image_data_format::rgba8:
+                std::memcpy(dst, src, count * 4u);
+                break;
+            default:
+                E2D_ASSERT_MSG(false, "unexpected image data format");
+                break;
+        }
+    }
+
+    void store_rgba8(image_data_format format, const u8* src, u8* dst, std::size_t count) noexcept {
+        switch ( format ) {
+            case image_data_format::a8:
+                for ( std::size_t i = 0; i < count; ++i, src += 4u ) {
+                    dst[i] = src[3];
+                }
+                break;
+            case image_data_format::l8:
+                for ( std::size_t i = 0; i < count; ++i, src += 4u ) {
+                    dst[i] = rgb_to_luminance(src[0], src[1], src[2]);
+                }
+                break;
+            case image_data_format::la8:
+                for ( std::size_t i = 0; i < count; ++i, src += 4u ) {
+                    dst[i * 2u + 0u] = rgb_to_luminance(src[0], src[1], src[2]);
+                    dst[i * 2u + 1u] = src[3];
+                }
+                break;
+            case image_data_format::rgb8:
+                shrink_rgba8_to_rgb8(src, dst, count);
+                break;
+            case image_data_format::rgba8:
+                if ( src != dst ) {
+                    std::memcpy(dst, src, count * 4u);
+                }
+                break;
+            default:
+                E2D_ASSERT_MSG(false, "unexpected image data format");
+                break;
+        }
+    }
+
+    void apply_options_rgba8(
+        u8* pixels,
+        std::size_t count,
+        const image_conversion_options& options) noexcept
+    {
+        if ( options.unpremultiply_alpha() ) {
+            unpremultiply_rgba8(pixels, count);
+        }
+        if ( options.srgb_to_linear() ) {
+            apply_table_rgba8(pixels, count, get_conversion_tables().srgb_to_linear);
+        }
+        if ( options.linear_to_srgb() ) {
+            apply_table_rgba8(pixels, count, get_conversion_tables().linear_to_srgb);
+        }
+        if ( options.swap_red_blue() ) {
+            swap_red_blue_rgba8(pixels, count);
+        }
+        if ( options.premultiply_alpha() ) {
+            premultiply_rgba8(pixels, count);
+        }
+    }
+}
+
+namespace e2d::images::impl
+{
+    bool check_convert_image(
+        const image& src,
+        image_data_format format) noexcept
+    {
+        const std::size_t src_bpp = get_bytes_per_pixel(src.format());
+        const std::size_t dst_bpp = get_bytes_per_pixel(format);
+        return !src.empty()
+            && src_bpp > 0u
+            && dst_bpp > 0u
+            && src.data().size() == std::size_t(src.size().x) * src.size().y * src_bpp;
+    }
+
+    bool convert_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        const image_conversion_options& options)
+    {
+        if ( !check_convert_image(src, format) ) {
+            return false;
+        }
+
+        if ( src.format() == format && options.empty() ) {
+            dst.assign(src);
+            return true;
+        }
+
+        const std::size_t src_bpp = get_bytes_per_pixel(src.format());
+        const std::size_t dst_bpp = get_bytes_per_pixel(format);
+        const std::size_t pixel_count = std::size_t(src.size().x) * src.size().y;
+
+        buffer data(pixel_count * dst_bpp);
+        std::array<u8, chunk_pixel_count * 4u> chunk;
+
+        const u8* src_ptr = src.data().data();
+        u8* dst_ptr = data.data();
+
+        for ( std::size_t i = 0; i < pixel_count; i += chunk_pixel_count ) {
+            const std::size_t count = math::min(chunk_pixel_count, pixel_count - i);
+            // rgba8 destinations are processed in place without the intermediate chunk
+            u8* rgba = format == image_data_format::rgba8
+                ? dst_ptr + i * dst_bpp
+                : chunk.data();
+            load_rgba8(src.format(), src_ptr + i * src_bpp, rgba, count);
+            apply_options_rgba8(rgba, count, options);
+            store_rgba8(format, rgba, dst_ptr + i * dst_bpp, count);
+        }
+
+        dst.assign(src.size(), format, std::move(data));
+        return true;
+    }
+}
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "image_impl_compress.hpp"
+
+namespace
+{
+    using namespace e2d;
+    using namespace e2d::images::impl::compress;
+
+    bool has_alpha_channel(image_data_format format) noexcept {
+        return format != image_data_format::rgb_etc1
+            && format != image_data_format::rgb_etc2;
+    }
+
+    void decode_block(const u8* src, image_data_format format, block_pixels& dst) noexcept {
+        switch ( format ) {
+            case image_data_format::rgba_dxt1:
+                decode_bc1_block(src, true, dst);
+                break;
+            case image_data_format::rgba_dxt3:
+                decode_bc1_block(src + 8u, false, dst);
+                decode_bc2_alpha_block(src, dst);
+                break;
+            case image_data_format::rgba_dxt5:
+                decode_bc1_block(src + 8u, false, dst);
+                decode_bc3_alpha_block(src, dst);
+                break;
+            case image_data_format::rgb_etc1:
+            case image_data_format::rgb_etc2:
+                decode_etc2_block(src, false, dst);
+                break;
+            case image_data_format::rgba_etc2:
+                decode_etc2_block(src + 8u, false, dst);
+                decode_eac_alpha_block(src, dst);
+                break;
+            case image_data_format::rgb_a1_etc2:
+                decode_etc2_block(src, true, dst);
+                break;
+            default:
+                E2D_ASSERT_MSG(false, "unexpected compressed image format");
+                break;
+        }
+    }
+}
+
+namespace e2d::images::impl
+{
+    bool check_decompress_image(const image& src) noexcept {
+        const std::size_t block_size = get_block_size(src.format());
+        const std::size_t block_count =
+            std::size_t((src.size().x + 3u) / 4u) *
+            std::size_t((src.size().y + 3u) / 4u);
+        return !src.empty()
+            && block_size > 0u
+            && src.data().size() >= block_count * block_size;
+    }
+
+    bool decompress_image(image& dst, const image& src) {
+        if ( !check_decompress_image(src) ) {
+            return false;
+        }
+
+        const image_data_format dst_format = has_alpha_channel(src.format())
+            ? image_data_format::rgba8
+            : image_data_format::rgb8;
+        const std::size_t bytes_per_pixel = dst_format == image_data_format::rgba8 ? 4u : 3u;
+
+        const v2u size = src.size();
+        const std::size_t block_size = get_block_size(src.format());
+        const u32 blocks_x = (size.x + 3u) / 4u;
+        const u32 blocks_y = (size.y + 3u) / 4u;
+
+        buffer data(std::size_t(size.x) * size.y * bytes_per_pixel);
+        u8* const data_ptr = data.data();
+        const u8* const src_ptr = src.data().data();
+        const image_data_format src_format = src.format();
+
+        for_each_block_row(blocks_y, [=](u32 by){
+            block_pixels pixels;
+            for ( u32 bx = 0; bx < blocks_x; ++bx ) {
+                decode_block(
+                    src_ptr + (std::size_t(by) * blocks_x + bx) * block_size,
+                    src_format,
+                    pixels);
+
+                const u32 w = math::min(4u, size.x - bx * 4u);
+                const u32 h = math::min(4u, size.y - by * 4u);
+                for ( u32 y = 0; y < h; ++y ) {
+                    u8* row = data_ptr
+                        + ((std::size_t(by) * 4u + y) * size.x + bx * 4u) * bytes_per_pixel;
+                    for ( u32 x = 0; x < w; ++x, row += bytes_per_pixel ) {
+                        const color32& c = pixels[y * 4u + x];
+                        row[0] = c.r;
+                        row[1] = c.g;
+                        row[2] = c.b;
+                        if ( bytes_per_pixel == 4u ) {
+                            row[3] = c.a;
+                        }
+                    }
+                }
+            }
+        });
+
+        dst.assign(size, dst_format, std::move(data));
+        return true;
+    }
+
+    bool transcode_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        image_compression_quality quality)
+    {
+        if ( src.format() == format ) {
+            dst.assign(src);
+            return true;
+        }
+
+        // etc2 decoders accept etc1 blocks as is
+        if ( src.format() == image_data_format::rgb_etc1 && format == image_data_format::rgb_etc2 ) {
+            dst.assign(src.size(), format, src.data());
+            return true;
+        }
+
+        image decompressed;
+        if ( !decompress_image(decompressed, src) ) {
+            return false;
+        }
+
+        if ( decompressed.format() == format ) {
+            dst.assign(std::move(decompressed));
+            return true;
+        }
+
+        return compress_image(dst, decompressed, format, quality);
+    }
+}
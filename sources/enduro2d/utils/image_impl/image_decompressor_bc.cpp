@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "image_impl_compress.hpp"
+
+namespace
+{
+    using namespace e2d;
+
+    color32 unpack_565(u16 c) noexcept {
+        const u32 r5 = (c >> 11u) & 0x1Fu;
+        const u32 g6 = (c >> 5u) & 0x3Fu;
+        const u32 b5 = c & 0x1Fu;
+        return color32(
+            static_cast<u8>((r5 << 3u) | (r5 >> 2u)),
+            static_cast<u8>((g6 << 2u) | (g6 >> 4u)),
+            static_cast<u8>((b5 << 3u) | (b5 >> 2u)),
+            255u);
+    }
+
+    color32 mix_colors(const color32& c0, const color32& c1, u32 w0, u32 w1) noexcept {
+        const u32 sum = w0 + w1;
+        return color32(
+            static_cast<u8>((c0.r * w0 + c1.r * w1) / sum),
+            static_cast<u8>((c0.g * w0 + c1.g * w1) / sum),
+            static_cast<u8>((c0.b * w0 + c1.b * w1) / sum),
+            255u);
+    }
+}
+
+namespace e2d::images::impl::compress
+{
+    void decode_bc1_block(
+        const u8* src,
+        bool three_color_mode_allowed,
+        block_pixels& dst) noexcept
+    {
+        const u16 c0 = static_cast<u16>(src[0] | (src[1] << 8u));
+        const u16 c1 = static_cast<u16>(src[2] | (src[3] << 8u));
+        const u32 bits =
+            u32(src[4]) |
+            (u32(src[5]) << 8u) |
+            (u32(src[6]) << 16u) |
+            (u32(src[7]) << 24u);
+
+        color32 palette[4];
+        palette[0] = unpack_565(c0);
+        palette[1] = unpack_565(c1);
+        if ( c0 > c1 || !three_color_mode_allowed ) {
+            palette[2] = mix_colors(palette[0], palette[1], 2u, 1u);
+            palette[3] = mix_colors(palette[0], palette[1], 1u, 2u);
+        } else {
+            palette[2] = mix_colors(palette[0], palette[1], 1u, 1u);
+            palette[3] = color32(0u, 0u, 0u, 0u);
+        }
+
+        for ( std::size_t i = 0; i < 16; ++i ) {
+            dst[i] = palette[(bits >> (i * 2u)) & 0x3u];
+        }
+    }
+
+    void decode_bc2_alpha_block(
+        const u8* src,
+        block_pixels& dst) noexcept
+    {
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            const u32 lo = src[i] & 0x0Fu;
+            const u32 hi = src[i] >> 4u;
+            dst[i * 2 + 0].a = static_cast<u8>(lo * 17u);
+            dst[i * 2 + 1].a = static_cast<u8>(hi * 17u);
+        }
+    }
+
+    void decode_bc3_alpha_block(
+        const u8* src,
+        block_pixels& dst) noexcept
+    {
+        const u32 a0 = src[0];
+        const u32 a1 = src[1];
+
+        u8 palette[8];
+        palette[0] = static_cast<u8>(a0);
+        palette[1] = static_cast<u8>(a1);
+        if ( a0 > a1 ) {
+            for ( u32 i = 2; i < 8; ++i ) {
+                palette[i] = static_cast<u8>(((8u - i) * a0 + (i - 1u) * a1) / 7u);
+            }
+        } else {
+            for ( u32 i = 2; i < 6; ++i ) {
+                palette[i] = static_cast<u8>(((6u - i) * a0 + (i - 1u) * a1) / 5u);
+            }
+            palette[6] = 0u;
+            palette[7] = 255u;
+        }
+
+        u64 bits = 0u;
+        for ( std::size_t i = 0; i < 6; ++i ) {
+            bits |= u64(src[2 + i]) << (i * 8u);
+        }
+
+        for ( std::size_t i = 0; i < 16; ++i ) {
+            dst[i].a = palette[(bits >> (i * 3u)) & 0x7u];
+        }
+    }
+}
@@ -0,0 +1,234 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "image_impl_compress.hpp"
+
+namespace
+{
+    using namespace e2d;
+    using namespace e2d::images::impl::compress;
+
+    const i32 etc2_distance_table[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+    u64 read_u64_be(const u8* src) noexcept {
+        u64 bits = 0u;
+        for ( std::size_t i = 0; i < 8; ++i ) {
+            bits = (bits << 8u) | src[i];
+        }
+        return bits;
+    }
+
+    u32 get_bits(u64 bits, u32 first, u32 count) noexcept {
+        return static_cast<u32>((bits >> first) & ((u64(1u) << count) - 1u));
+    }
+
+    i32 extend_bits(u32 v, u32 from) noexcept {
+        return i32((v << (8u - from)) | (v >> (2u * from - 8u)));
+    }
+
+    i32 sign_extend_3(u32 v) noexcept {
+        return v >= 4u ? i32(v) - 8 : i32(v);
+    }
+
+    u8 clamp_byte(i32 v) noexcept {
+        return static_cast<u8>(math::clamp(v, 0, 255));
+    }
+
+    color32 make_color(i32 r, i32 g, i32 b) noexcept {
+        return color32(clamp_byte(r), clamp_byte(g), clamp_byte(b), 255u);
+    }
+
+    color32 offset_color(const color32& c, i32 d) noexcept {
+        return make_color(c.r + d, c.g + d, c.b + d);
+    }
+
+    // pixel index of a pixel in the row-major order
+    u32 pixel_index(u64 bits, u32 x, u32 y) noexcept {
+        const u32 k = x * 4u + y;
+        return (get_bits(bits, 16u + k, 1u) << 1u) | get_bits(bits, k, 1u);
+    }
+
+    void decode_etc1_mode(
+        u64 bits,
+        const color32* bases,
+        bool punch_through_alpha,
+        bool opaque,
+        block_pixels& dst) noexcept
+    {
+        const u32 tables[2] = { get_bits(bits, 37u, 3u), get_bits(bits, 34u, 3u) };
+        const bool flip = get_bits(bits, 32u, 1u) != 0u;
+
+        for ( u32 y = 0; y < 4u; ++y ) {
+            for ( u32 x = 0; x < 4u; ++x ) {
+                const u32 sub = flip ? (y >= 2u) : (x >= 2u);
+                const u32 index = pixel_index(bits, x, y);
+                color32& c = dst[y * 4u + x];
+                if ( punch_through_alpha && !opaque ) {
+                    if ( index == 2u ) {
+                        c = color32(0u, 0u, 0u, 0u);
+                        continue;
+                    }
+                    c = index == 0u
+                        ? bases[sub]
+                        : offset_color(bases[sub], etc1_modifier_table[tables[sub]][index]);
+                    continue;
+                }
+                c = offset_color(bases[sub], etc1_modifier_table[tables[sub]][index]);
+            }
+        }
+    }
+
+    void decode_paint_mode(
+        u64 bits,
+        const color32* paints,
+        bool punch_through_alpha,
+        bool opaque,
+        block_pixels& dst) noexcept
+    {
+        for ( u32 y = 0; y < 4u; ++y ) {
+            for ( u32 x = 0; x < 4u; ++x ) {
+                const u32 index = pixel_index(bits, x, y);
+                dst[y * 4u + x] = punch_through_alpha && !opaque && index == 2u
+                    ? color32(0u, 0u, 0u, 0u)
+                    : paints[index];
+            }
+        }
+    }
+
+    void decode_t_mode(u64 bits, bool punch_through_alpha, bool opaque, block_pixels& dst) noexcept {
+        const color32 c0 = make_color(
+            extend_bits((get_bits(bits, 59u, 2u) << 2u) | get_bits(bits, 56u, 2u), 4u),
+            extend_bits(get_bits(bits, 52u, 4u), 4u),
+            extend_bits(get_bits(bits, 48u, 4u), 4u));
+        const color32 c1 = make_color(
+            extend_bits(get_bits(bits, 44u, 4u), 4u),
+            extend_bits(get_bits(bits, 40u, 4u), 4u),
+            extend_bits(get_bits(bits, 36u, 4u), 4u));
+        const i32 d = etc2_distance_table[(get_bits(bits, 34u, 2u) << 1u) | get_bits(bits, 32u, 1u)];
+
+        const color32 paints[4] = { c0, offset_color(c1, d), c1, offset_color(c1, -d) };
+        decode_paint_mode(bits, paints, punch_through_alpha, opaque, dst);
+    }
+
+    void decode_h_mode(u64 bits, bool punch_through_alpha, bool opaque, block_pixels& dst) noexcept {
+        const u32 r0 = get_bits(bits, 59u, 4u);
+        const u32 g0 = (get_bits(bits, 56u, 3u) << 1u) | get_bits(bits, 52u, 1u);
+        const u32 b0 = (get_bits(bits, 51u, 1u) << 3u) | get_bits(bits, 47u, 3u);
+        const u32 r1 = get_bits(bits, 43u, 4u);
+        const u32 g1 = get_bits(bits, 39u, 4u);
+        const u32 b1 = get_bits(bits, 35u, 4u);
+
+        const u32 v0 = (r0 << 8u) | (g0 << 4u) | b0;
+        const u32 v1 = (r1 << 8u) | (g1 << 4u) | b1;
+        const u32 d_index =
+            (get_bits(bits, 34u, 1u) << 2u) |
+            (get_bits(bits, 32u, 1u) << 1u) |
+            (v0 >= v1 ? 1u : 0u);
+        const i32 d = etc2_distance_table[d_index];
+
+        const color32 c0 = make_color(extend_bits(r0, 4u), extend_bits(g0, 4u), extend_bits(b0, 4u));
+        const color32 c1 = make_color(extend_bits(r1, 4u), extend_bits(g1, 4u), extend_bits(b1, 4u));
+
+        const color32 paints[4] = {
+            offset_color(c0, d), offset_color(c0, -d),
+            offset_color(c1, d), offset_color(c1, -d) };
+        decode_paint_mode(bits, paints, punch_through_alpha, opaque, dst);
+    }
+
+    void decode_planar_mode(u64 bits, block_pixels& dst) noexcept {
+        const i32 ro = extend_bits(get_bits(bits, 57u, 6u), 6u);
+        const i32 go = extend_bits((get_bits(bits, 56u, 1u) << 6u) | get_bits(bits, 49u, 6u), 7u);
+        const i32 bo = extend_bits(
+            (get_bits(bits, 48u, 1u) << 5u) |
+            (get_bits(bits, 43u, 2u) << 3u) |
+            get_bits(bits, 39u, 3u), 6u);
+
+        const i32 rh = extend_bits((get_bits(bits, 34u, 5u) << 1u) | get_bits(bits, 32u, 1u), 6u);
+        const i32 gh = extend_bits(get_bits(bits, 25u, 7u), 7u);
+        const i32 bh = extend_bits(get_bits(bits, 19u, 6u), 6u);
+
+        const i32 rv = extend_bits(get_bits(bits, 13u, 6u), 6u);
+        const i32 gv = extend_bits(get_bits(bits, 6u, 7u), 7u);
+        const i32 bv = extend_bits(get_bits(bits, 0u, 6u), 6u);
+
+        for ( i32 y = 0; y < 4; ++y ) {
+            for ( i32 x = 0; x < 4; ++x ) {
+                dst[std::size_t(y * 4 + x)] = make_color(
+                    (x * (rh - ro) + y * (rv - ro) + 4 * ro + 2) >> 2,
+                    (x * (gh - go) + y * (gv - go) + 4 * go + 2) >> 2,
+                    (x * (bh - bo) + y * (bv - bo) + 4 * bo + 2) >> 2);
+            }
+        }
+    }
+}
+
+namespace e2d::images::impl::compress
+{
+    void decode_etc2_block(
+        const u8* src,
+        bool punch_through_alpha,
+        block_pixels& dst) noexcept
+    {
+        const u64 bits = read_u64_be(src);
+
+        // punch-through blocks reuse the differential bit as the opaque flag
+        const bool diff_bit = get_bits(bits, 33u, 1u) != 0u;
+        const bool differential = punch_through_alpha || diff_bit;
+        const bool opaque = !punch_through_alpha || diff_bit;
+
+        if ( !differential ) {
+            const color32 bases[2] = {
+                make_color(
+                    extend_bits(get_bits(bits, 60u, 4u), 4u),
+                    extend_bits(get_bits(bits, 52u, 4u), 4u),
+                    extend_bits(get_bits(bits, 44u, 4u), 4u)),
+                make_color(
+                    extend_bits(get_bits(bits, 56u, 4u), 4u),
+                    extend_bits(get_bits(bits, 48u, 4u), 4u),
+                    extend_bits(get_bits(bits, 40u, 4u), 4u))};
+            decode_etc1_mode(bits, bases, false, true, dst);
+            return;
+        }
+
+        const i32 r = i32(get_bits(bits, 59u, 5u));
+        const i32 g = i32(get_bits(bits, 51u, 5u));
+        const i32 b = i32(get_bits(bits, 43u, 5u));
+        const i32 r2 = r + sign_extend_3(get_bits(bits, 56u, 3u));
+        const i32 g2 = g + sign_extend_3(get_bits(bits, 48u, 3u));
+        const i32 b2 = b + sign_extend_3(get_bits(bits, 40u, 3u));
+
+        if ( r2 < 0 || r2 > 31 ) {
+            decode_t_mode(bits, punch_through_alpha, opaque, dst);
+        } else if ( g2 < 0 || g2 > 31 ) {
+            decode_h_mode(bits, punch_through_alpha, opaque, dst);
+        } else if ( b2 < 0 || b2 > 31 ) {
+            decode_planar_mode(bits, dst);
+        } else {
+            const color32 bases[2] = {
+                make_color(extend_bits(u32(r), 5u), extend_bits(u32(g), 5u), extend_bits(u32(b), 5u)),
+                make_color(extend_bits(u32(r2), 5u), extend_bits(u32(g2), 5u), extend_bits(u32(b2), 5u))};
+            decode_etc1_mode(bits, bases, punch_through_alpha, opaque, dst);
+        }
+    }
+
+    void decode_eac_alpha_block(
+        const u8* src,
+        block_pixels& dst) noexcept
+    {
+        const u64 bits = read_u64_be(src);
+        const i32 base = i32(get_bits(bits, 56u, 8u));
+        const i32 multiplier = i32(get_bits(bits, 52u, 4u));
+        const u32 table = get_bits(bits, 48u, 4u);
+
+        for ( u32 y = 0; y < 4u; ++y ) {
+            for ( u32 x = 0; x < 4u; ++x ) {
+                const u32 k = x * 4u + y;
+                const u32 index = get_bits(bits, 45u - k * 3u, 3u);
+                dst[y * 4u + x].a = clamp_byte(base + eac_modifier_table[table][index] * multiplier);
+            }
+        }
+    }
+}
@@ -10,6 +10,18 @@
 #include <enduro2d/utils/buffer.hpp>
 #include <enduro2d/utils/buffer_view.hpp>
 
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#  define E2D_IMAGE_IMPL_NEON
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define E2D_IMAGE_IMPL_SSE2
+#  if defined(__SSSE3__) || defined(__AVX__)
+#    include <tmmintrin.h>
+#    define E2D_IMAGE_IMPL_SSSE3
+#  endif
+#endif
+
 namespace e2d::images::impl
 {
     bool load_image_dds(image& dst, buffer_view src);
@@ -27,6 +39,40 @@ namespace e2d::images::impl
     bool check_save_image_png(const image& src) noexcept;
     bool check_save_image_pvr(const image& src) noexcept;
     bool check_save_image_tga(const image& src) noexcept;
+
+    bool compress_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        image_compression_quality quality);
+
+    bool check_compress_image(
+        const image& src,
+        image_data_format format) noexcept;
+
+    bool decompress_image(image& dst, const image& src);
+    bool check_decompress_image(const image& src) noexcept;
+
+    bool transcode_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        image_compression_quality quality);
+
+    // runs the jobs through the installed block jobs executor
+    void run_block_jobs(
+        std::size_t count,
+        const std::function<void(std::size_t)>& job);
+
+    bool convert_image(
+        image& dst,
+        const image& src,
+        image_data_format format,
+        const image_conversion_options& options);
+
+    bool check_convert_image(
+        const image& src,
+        image_data_format format) noexcept;
 }
 
 namespace e2d::images::impl
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#pragma once
+
+#include "image_impl.hpp"
+
+namespace e2d::images::impl::compress
+{
+    // 4x4 pixels in row-major order
+    using block_pixels = std::array<color32, 16>;
+
+    // modifiers in the order of pixel index values: +a, +b, -a, -b
+    inline constexpr i32 etc1_modifier_table[8][4] = {
+        {  2,   8,  -2,   -8 },
+        {  5,  17,  -5,  -17 },
+        {  9,  29,  -9,  -29 },
+        { 13,  42, -13,  -42 },
+        { 18,  60, -18,  -60 },
+        { 24,  80, -24,  -80 },
+        { 33, 106, -33, -106 },
+        { 47, 183, -47, -183 }
+    };
+
+    inline constexpr i32 eac_modifier_table[16][8] = {
+        { -3, -6,  -9, -15, 2, 5, 8, 14 },
+        { -3, -7, -10, -13, 2, 6, 9, 12 },
+        { -2, -5,  -8, -13, 1, 4, 7, 12 },
+        { -2, -4,  -6, -13, 1, 3, 5, 12 },
+        { -3, -6,  -8, -12, 2, 5, 7, 11 },
+        { -3, -7,  -9, -11, 2, 6, 8, 10 },
+        { -4, -7,  -8, -11, 3, 6, 7, 10 },
+        { -3, -5,  -8, -11, 2, 4, 7, 10 },
+        { -2, -6,  -8, -10, 1, 5, 7,  9 },
+        { -2, -5,  -8, -10, 1, 4, 7,  9 },
+        { -2, -4,  -8, -10, 1, 3, 7,  9 },
+        { -2, -5,  -7, -10, 1, 4, 6,  9 },
+        { -3, -4,  -7, -10, 2, 3, 6,  9 },
+        { -1, -2,  -3, -10, 0, 1, 2,  9 },
+        { -4, -6,  -8,  -9, 3, 5, 7,  8 },
+        { -3, -5,  -7,  -9, 2, 4, 6,  8 }
+    };
+
+    inline std::size_t get_block_size(image_data_format format) noexcept {
+        switch ( format ) {
+            case image_data_format::rgba_dxt1:
+            case image_data_format::rgb_etc1:
+            case image_data_format::rgb_etc2:
+            case image_data_format::rgb_a1_etc2:
+                return 8u;
+            case image_data_format::rgba_dxt3:
+            case image_data_format::rgba_dxt5:
+            case image_data_format::rgba_etc2:
+                return 16u;
+            default:
+                return 0u;
+        }
+    }
+
+    // calls f(row) for every row of blocks, the rows are grouped
+    // into the jobs of the block jobs executor
+    template < typename F >
+    void for_each_block_row(u32 row_count, F&& f) {
+        constexpr u32 rows_per_job = 4u;
+        run_block_jobs(
+            (row_count + rows_per_job - 1u) / rows_per_job,
+            [row_count, &f](std::size_t job){
+                const u32 first_row = static_cast<u32>(job) * rows_per_job;
+                const u32 last_row = math::min(row_count, first_row + rows_per_job);
+                for ( u32 row = first_row; row < last_row; ++row ) {
+                    f(row);
+                }
+            });
+    }
+
+    // up to four colors to match pixels against
+    struct rgb_palette {
+        i16 r[4] = {0};
+        i16 g[4] = {0};
+        i16 b[4] = {0};
+        u32 count{4u};
+    };
+
+    // squared errors and indices of the nearest palette colors for 8 pixels
+    // given by their channels, ties go to the lowest palette index
+    void find_nearest_colors8(
+        const i16* r,
+        const i16* g,
+        const i16* b,
+        const rgb_palette& palette,
+        u32* errors,
+        u8* indices) noexcept;
+
+    // squared errors and indices of the nearest of 8 palette alphas
+    // for 16 pixels, ties go to the lowest palette index
+    void find_nearest_alphas16(
+        const u8* alphas,
+        const u8* palette,
+        u32* errors,
+        u8* indices) noexcept;
+
+    // bc1 (dxt1) color block, 8 bytes
+    void encode_bc1_block(
+        const block_pixels& src,
+        bool punch_through_alpha,
+        image_compression_quality quality,
+        u8* dst) noexcept;
+
+    // bc2 (dxt3) explicit alpha block, 8 bytes
+    void encode_bc2_alpha_block(
+        const block_pixels& src,
+        u8* dst) noexcept;
+
+    // bc3 (dxt5) interpolated alpha block, 8 bytes
+    void encode_bc3_alpha_block(
+        const block_pixels& src,
+        image_compression_quality quality,
+        u8* dst) noexcept;
+
+    // etc1 color block, 8 bytes (also a valid etc2 rgb block)
+    void encode_etc1_block(
+        const block_pixels& src,
+        image_compression_quality quality,
+        u8* dst) noexcept;
+
+    // etc2 eac alpha block, 8 bytes
+    void encode_eac_alpha_block(
+        const block_pixels& src,
+        image_compression_quality quality,
+        u8* dst) noexcept;
+
+    // bc1 color block, bc2 and bc3 color blocks are always in the four color mode
+    void decode_bc1_block(
+        const u8* src,
+        bool three_color_mode_allowed,
+        block_pixels& dst) noexcept;
+
+    void decode_bc2_alpha_block(
+        const u8* src,
+        block_pixels& dst) noexcept;
+
+    void decode_bc3_alpha_block(
+        const u8* src,
+        block_pixels& dst) noexcept;
+
+    // etc1 and etc2 (individual, differential, t, h and planar modes) color block
+    void decode_etc2_block(
+        const u8* src,
+        bool punch_through_alpha,
+        block_pixels& dst) noexcept;
+
+    void decode_eac_alpha_block(
+        const u8* src,
+        block_pixels& dst) noexcept;
+}
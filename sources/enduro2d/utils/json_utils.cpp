@@ -214,20 +214,45 @@ namespace
     })json";
 
     const rapidjson::Value& common_schema_definitions() {
-        static std::mutex mutex;
-        static std::unique_ptr<rapidjson::Document> defs_doc;
-
-        std::lock_guard<std::mutex> guard(mutex);
-        if ( !defs_doc ) {
-            rapidjson::Document doc;
-            if ( doc.Parse(common_schema_definitions_source).HasParseError() ) {
+        static const std::unique_ptr<rapidjson::Document> defs_doc = [](){
+            auto doc = std::make_unique<rapidjson::Document>();
+            if ( doc->Parse(common_schema_definitions_source).HasParseError() ) {
                 throw json_utils_exception();
             }
-            defs_doc = std::make_unique<rapidjson::Document>(std::move(doc));
-        }
-
+            return doc;
+        }();
         return *defs_doc;
     }
+
+    //
+    // insitu_document
+    //
+
+    class insitu_document final : private noncopyable {
+    public:
+        explicit insitu_document(str content)
+        : buffer_(std::move(content))
+        , allocator_(math::max(
+            buffer_.size(),
+            std::size_t(RAPIDJSON_ALLOCATOR_DEFAULT_CHUNK_CAPACITY)))
+        , document_(&allocator_) {}
+
+        rapidjson::Document& document() noexcept {
+            return document_;
+        }
+
+        bool parse() {
+            return !document_
+                .ParseInsitu(buffer_.data())
+                .HasParseError();
+        }
+    private:
+        // the document references both the buffer (strings)
+        // and the allocator (values), so they must outlive it
+        str buffer_;
+        rapidjson::MemoryPoolAllocator<> allocator_;
+        rapidjson::Document document_;
+    };
 }
 
 namespace
@@ -568,6 +593,18 @@ namespace e2d::json_utils
     }
 }
 
+namespace e2d::json_utils
+{
+    std::shared_ptr<rapidjson::Document> parse_insitu(str content) {
+        auto holder = std::make_shared<insitu_document>(std::move(content));
+        if ( !holder->parse() ) {
+            return nullptr;
+        }
+        rapidjson::Document* document = &holder->document();
+        return std::shared_ptr<rapidjson::Document>(std::move(holder), document);
+    }
+}
+
 namespace e2d::json_utils
 {
     bool try_parse_value(const rapidjson::Value& root, v2i& v) noexcept {
@@ -0,0 +1,213 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/rect_packer.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    bool is_rect_contained(const b2u& inner, const b2u& outer) noexcept {
+        return inner.position.x >= outer.position.x
+            && inner.position.y >= outer.position.y
+            && inner.position.x + inner.size.x <= outer.position.x + outer.size.x
+            && inner.position.y + inner.size.y <= outer.position.y + outer.size.y;
+    }
+
+    bool is_rect_intersected(const b2u& l, const b2u& r) noexcept {
+        return l.position.x < r.position.x + r.size.x
+            && r.position.x < l.position.x + l.size.x
+            && l.position.y < r.position.y + r.size.y
+            && r.position.y < l.position.y + l.size.y;
+    }
+}
+
+namespace e2d
+{
+    rect_packer::rect_packer(const v2u& size, u32 padding) {
+        reset(size, padding);
+    }
+
+    void rect_packer::clear() noexcept {
+        free_rects_.clear();
+        if ( size_.x > 0u && size_.y > 0u ) {
+            // the bin is virtually enlarged by padding, so rects
+            // can touch the right and the bottom borders
+            free_rects_.push_back(b2u(size_ + v2u(padding_)));
+        }
+        rect_count_ = 0u;
+        used_area_ = 0u;
+    }
+
+    void rect_packer::reset(const v2u& size, u32 padding) {
+        size_ = size;
+        padding_ = padding;
+        free_rects_.reserve(64u);
+        split_rects_.reserve(64u);
+        clear();
+    }
+
+    bool rect_packer::insert(const v2u& size, b2u& result) {
+        if ( size.x == 0u || size.y == 0u ) {
+            return false;
+        }
+
+        b2u used;
+        if ( !find_position_(size + v2u(padding_), used) ) {
+            return false;
+        }
+
+        split_free_rects_(used);
+        prune_free_rects_();
+
+        result = b2u(used.position, size);
+        rect_count_ += 1u;
+        used_area_ += u64(size.x) * size.y;
+        return true;
+    }
+
+    bool rect_packer::pack(const vector<v2u>& sizes, vector<b2u>& results) {
+        vector<std::size_t> order(sizes.size());
+        for ( std::size_t i = 0; i < order.size(); ++i ) {
+            order[i] = i;
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t l, std::size_t r){
+            const u32 l_max = math::max(sizes[l].x, sizes[l].y);
+            const u32 r_max = math::max(sizes[r].x, sizes[r].y);
+            return l_max != r_max
+                ? l_max > r_max
+                : u64(sizes[l].x) * sizes[l].y > u64(sizes[r].x) * sizes[r].y;
+        });
+
+        rect_packer packer(*this);
+        vector<b2u> packed(sizes.size());
+        for ( std::size_t index : order ) {
+            if ( !packer.insert(sizes[index], packed[index]) ) {
+                return false;
+            }
+        }
+
+        *this = std::move(packer);
+        results = std::move(packed);
+        return true;
+    }
+
+    const v2u& rect_packer::size() const noexcept {
+        return size_;
+    }
+
+    u32 rect_packer::padding() const noexcept {
+        return padding_;
+    }
+
+    std::size_t rect_packer::rect_count() const noexcept {
+        return rect_count_;
+    }
+
+    u64 rect_packer::used_area() const noexcept {
+        return used_area_;
+    }
+
+    f32 rect_packer::occupancy() const noexcept {
+        const u64 area = u64(size_.x) * size_.y;
+        return area > 0u
+            ? static_cast<f32>(static_cast<f64>(used_area_) / static_cast<f64>(area))
+            : 0.f;
+    }
+
+    bool rect_packer::find_position_(const v2u& size, b2u& result) const noexcept {
+        bool found = false;
+        u32 best_short_side = std::numeric_limits<u32>::max();
+        u32 best_long_side = std::numeric_limits<u32>::max();
+
+        for ( const b2u& free : free_rects_ ) {
+            if ( free.size.x < size.x || free.size.y < size.y ) {
+                continue;
+            }
+
+            const u32 leftover_x = free.size.x - size.x;
+            const u32 leftover_y = free.size.y - size.y;
+            const u32 short_side = math::min(leftover_x, leftover_y);
+            const u32 long_side = math::max(leftover_x, leftover_y);
+
+            if ( short_side < best_short_side ||
+                (short_side == best_short_side && long_side < best_long_side) )
+            {
+                found = true;
+                result = b2u(free.position, size);
+                best_short_side = short_side;
+                best_long_side = long_side;
+            }
+        }
+
+        return found;
+    }
+
+    void rect_packer::split_free_rects_(const b2u& used) {
+        split_rects_.clear();
+
+        for ( std::size_t i = 0; i < free_rects_.size(); ) {
+            const b2u free = free_rects_[i];
+            if ( !is_rect_intersected(free, used) ) {
+                ++i;
+                continue;
+            }
+
+            const u32 free_r = free.position.x + free.size.x;
+            const u32 free_b = free.position.y + free.size.y;
+            const u32 used_r = used.position.x + used.size.x;
+            const u32 used_b = used.position.y + used.size.y;
+
+            if ( used.position.x > free.position.x ) {
+                split_rects_.push_back(b2u(
+                    free.position.x, free.position.y,
+                    used.position.x - free.position.x, free.size.y));
+            }
+
+            if ( used_r < free_r ) {
+                split_rects_.push_back(b2u(
+                    used_r, free.position.y,
+                    free_r - used_r, free.size.y));
+            }
+
+            if ( used.position.y > free.position.y ) {
+                split_rects_.push_back(b2u(
+                    free.position.x, free.position.y,
+                    free.size.x, used.position.y - free.position.y));
+            }
+
+            if ( used_b < free_b ) {
+                split_rects_.push_back(b2u(
+                    free.position.x, used_b,
+                    free.size.x, free_b - used_b));
+            }
+
+            free_rects_[i] = free_rects_.back();
+            free_rects_.pop_back();
+        }
+
+        free_rects_.insert(free_rects_.end(), split_rects_.begin(), split_rects_.end());
+    }
+
+    void rect_packer::prune_free_rects_() {
+        for ( std::size_t i = 0; i < free_rects_.size(); ++i ) {
+            for ( std::size_t j = i + 1; j < free_rects_.size(); ) {
+                if ( is_rect_contained(free_rects_[j], free_rects_[i]) ) {
+                    free_rects_[j] = free_rects_.back();
+                    free_rects_.pop_back();
+                } else if ( is_rect_contained(free_rects_[i], free_rects_[j]) ) {
+                    free_rects_[i] = free_rects_[j];
+                    free_rects_[j] = free_rects_.back();
+                    free_rects_.pop_back();
+                    j = i + 1;
+                } else {
+                    ++j;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,619 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/sound_mixer.hpp>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#  define E2D_SOUND_MIXER_NEON
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#  include <xmmintrin.h>
+#  define E2D_SOUND_MIXER_SSE
+#endif
+
+namespace
+{
+    using namespace e2d;
+
+    // dst[i] += src[i] * gains[i % 2], for count interleaved stereo frames
+    void accumulate_stereo(f32* dst, const f32* src, std::size_t count, f32 gain_l, f32 gain_r) noexcept {
+        const std::size_t sample_count = count * 2u;
+        std::size_t i = 0;
+    #if defined(E2D_SOUND_MIXER_NEON)
+        const f32 gains_data[4] = {gain_l, gain_r, gain_l, gain_r};
+        const float32x4_t gains = vld1q_f32(gains_data);
+        for ( ; i + 4u <= sample_count; i += 4u ) {
+            vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), gains));
+        }
+    #elif defined(E2D_SOUND_MIXER_SSE)
+        const __m128 gains = _mm_setr_ps(gain_l, gain_r, gain_l, gain_r);
+        for ( ; i + 4u <= sample_count; i += 4u ) {
+            _mm_storeu_ps(dst + i, _mm_add_ps(
+                _mm_loadu_ps(dst + i),
+                _mm_mul_ps(_mm_loadu_ps(src + i), gains)));
+        }
+    #endif
+        for ( ; i < sample_count; i += 2u ) {
+            dst[i + 0u] += src[i + 0u] * gain_l;
+            dst[i + 1u] += src[i + 1u] * gain_r;
+        }
+    }
+
+    void scale_samples(f32* dst, std::size_t count, f32 scale) noexcept {
+        std::size_t i = 0;
+    #if defined(E2D_SOUND_MIXER_NEON)
+        for ( ; i + 4u <= count; i += 4u ) {
+            vst1q_f32(dst + i, vmulq_n_f32(vld1q_f32(dst + i), scale));
+        }
+    #elif defined(E2D_SOUND_MIXER_SSE)
+        const __m128 s = _mm_set1_ps(scale);
+        for ( ; i + 4u <= count; i += 4u ) {
+            _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), s));
+        }
+    #endif
+        for ( ; i < count; ++i ) {
+            dst[i] *= scale;
+        }
+    }
+
+    constexpr u32 voice_index_bits = 16u;
+    constexpr u32 voice_index_mask = (1u << voice_index_bits) - 1u;
+    constexpr u32 max_voice_count = voice_index_mask - 1u;
+
+    struct voice final {
+        sound_decoder_uptr decoder;
+        u32 channels{0u};
+        u32 generation{0u};
+        f64 rate_ratio{1.0};
+
+        // decoded frames [window_begin, window_begin + window_size) of the
+        // virtual timeline, looping passes continue it past the frame count
+        vector<f32> window;
+        std::size_t window_capacity{0u};
+        std::size_t window_begin{0u};
+        std::size_t window_size{0u};
+        std::size_t loop_begin{0u};
+        std::size_t end_frame{std::numeric_limits<std::size_t>::max()};
+        f64 cursor{0.0};
+
+        bool playing{false};
+        bool looping{false};
+        f32 volume{1.f};
+        f32 pan{0.f};
+        f32 pitch{1.f};
+
+        bool alive() const noexcept {
+            return !!decoder;
+        }
+
+        bool finished() const noexcept {
+            return cursor >= static_cast<f64>(end_frame);
+        }
+
+        std::size_t window_end() const noexcept {
+            return window_begin + window_size;
+        }
+
+        void rewind(std::size_t frame) {
+            frame = math::min(frame, decoder->frame_count());
+            decoder->seek(frame);
+            window_begin = frame;
+            window_size = 0u;
+            loop_begin = 0u;
+            end_frame = std::numeric_limits<std::size_t>::max();
+            cursor = static_cast<f64>(frame);
+        }
+    };
+}
+
+namespace e2d
+{
+    //
+    // sound_mixer::parameters
+    //
+
+    sound_mixer::parameters& sound_mixer::parameters::sample_rate(u32 value) noexcept {
+        sample_rate_ = value;
+        return *this;
+    }
+
+    sound_mixer::parameters& sound_mixer::parameters::block_frames(u32 value) noexcept {
+        block_frames_ = value;
+        return *this;
+    }
+
+    sound_mixer::parameters& sound_mixer::parameters::window_frames(u32 value) noexcept {
+        window_frames_ = value;
+        return *this;
+    }
+
+    sound_mixer::parameters& sound_mixer::parameters::max_voices(u32 value) noexcept {
+        max_voices_ = value;
+        return *this;
+    }
+
+    u32 sound_mixer::parameters::sample_rate() const noexcept {
+        return sample_rate_;
+    }
+
+    u32 sound_mixer::parameters::block_frames() const noexcept {
+        return block_frames_;
+    }
+
+    u32 sound_mixer::parameters::window_frames() const noexcept {
+        return window_frames_;
+    }
+
+    u32 sound_mixer::parameters::max_voices() const noexcept {
+        return max_voices_;
+    }
+
+    //
+    // sound_mixer::internal_state
+    //
+
+    class sound_mixer::internal_state final : private noncopyable {
+    public:
+        internal_state(const parameters& params)
+        : params_(params) {
+            params_.sample_rate(math::max(params_.sample_rate(), 1u));
+            params_.block_frames(math::max(params_.block_frames(), 1u));
+            params_.window_frames(math::max(params_.window_frames(), 4u));
+            params_.max_voices(math::min(params_.max_voices(), max_voice_count));
+            voices_.resize(params_.max_voices());
+            block_.resize(std::size_t(params_.block_frames()) * 2u);
+        }
+        ~internal_state() noexcept = default;
+    public:
+        const parameters& params() const noexcept {
+            return params_;
+        }
+
+        statistics stats() const noexcept {
+            std::lock_guard<std::mutex> guard(mutex_);
+            statistics result = stats_;
+            for ( const voice& v : voices_ ) {
+                result.voices += v.alive() ? 1u : 0u;
+                result.playing_voices += v.alive() && v.playing ? 1u : 0u;
+            }
+            return result;
+        }
+
+        voice_id create_voice(sound_decoder_uptr decoder) {
+            if ( !decoder || decoder->channels() < 1u || decoder->channels() > 2u ) {
+                return invalid_voice;
+            }
+
+            std::lock_guard<std::mutex> guard(mutex_);
+            for ( std::size_t i = 0; i < voices_.size(); ++i ) {
+                voice& v = voices_[i];
+                if ( v.alive() ) {
+                    continue;
+                }
+
+                const u32 generation = (v.generation + 1u) & voice_index_mask;
+                v = voice();
+                v.generation = generation;
+                v.channels = decoder->channels();
+                v.rate_ratio = static_cast<f64>(decoder->sample_rate()) / params_.sample_rate();
+                v.window_capacity = params_.window_frames();
+                v.window.resize(v.window_capacity * v.channels);
+                v.decoder = std::move(decoder);
+                v.rewind(0u);
+
+                return (generation << voice_index_bits)
+                    | static_cast<u32>(i + 1u);
+            }
+
+            ++stats_.rejected_voices;
+            return invalid_voice;
+        }
+
+        void destroy_voice(voice_id id) noexcept {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if ( voice* v = find_voice_(id) ) {
+                const u32 generation = v->generation;
+                *v = voice();
+                v->generation = generation;
+            }
+        }
+
+        template < typename F >
+        auto with_voice(voice_id id, F&& f) noexcept {
+            std::lock_guard<std::mutex> guard(mutex_);
+            voice* v = find_voice_(id);
+            return f(v);
+        }
+
+        template < typename F >
+        auto with_voice(voice_id id, F&& f) const noexcept {
+            std::lock_guard<std::mutex> guard(mutex_);
+            const voice* v = find_voice_(id);
+            return f(v);
+        }
+
+        void master_volume(f32 value) noexcept {
+            std::lock_guard<std::mutex> guard(mutex_);
+            master_volume_ = value;
+        }
+
+        f32 master_volume() const noexcept {
+            std::lock_guard<std::mutex> guard(mutex_);
+            return master_volume_;
+        }
+
+        void mix(f32* dst, std::size_t frame_count) noexcept {
+            std::lock_guard<std::mutex> guard(mutex_);
+            std::fill(dst, dst + frame_count * 2u, 0.f);
+
+            for ( voice& v : voices_ ) {
+                if ( !v.alive() || !v.playing || v.volume <= 0.f ) {
+                    continue;
+                }
+                const f32 pan = math::clamp(v.pan, -1.f, 1.f);
+                const f32 gain_l = v.volume * (pan > 0.f ? 1.f - pan : 1.f);
+                const f32 gain_r = v.volume * (pan < 0.f ? 1.f + pan : 1.f);
+
+                std::size_t offset = 0u;
+                while ( offset < frame_count && v.playing ) {
+                    const std::size_t count = math::min(
+                        frame_count - offset,
+                        std::size_t(params_.block_frames()));
+                    const std::size_t resampled = resample_voice_(v, block_.data(), count);
+                    accumulate_stereo(dst + offset * 2u, block_.data(), resampled, gain_l, gain_r);
+                    offset += count;
+                }
+            }
+
+            if ( master_volume_ != 1.f ) {
+                scale_samples(dst, frame_count * 2u, master_volume_);
+            }
+
+            stats_.mixed_frames += frame_count;
+        }
+    private:
+        voice* find_voice_(voice_id id) noexcept {
+            const std::size_t index = (id & voice_index_mask);
+            if ( index == 0u || index > voices_.size() ) {
+                return nullptr;
+            }
+            voice& v = voices_[index - 1u];
+            return v.alive() && v.generation == (id >> voice_index_bits)
+                ? &v
+                : nullptr;
+        }
+
+        const voice* find_voice_(voice_id id) const noexcept {
+            return const_cast<internal_state*>(this)->find_voice_(id);
+        }
+
+        // moves the window to the cursor and decodes frames into the free space
+        void refill_voice_(voice& v) {
+            const std::size_t frame_count = v.decoder->frame_count();
+            const std::size_t first = static_cast<std::size_t>(v.cursor);
+
+            if ( first >= v.window_end() ) {
+                // the cursor jumped over the window, skip frames in the decoder
+                if ( v.looping && frame_count > 0u ) {
+                    v.loop_begin = first / frame_count * frame_count;
+                }
+                v.decoder->seek(first - v.loop_begin);
+                v.window_begin = first;
+                v.window_size = 0u;
+            } else if ( first > v.window_begin ) {
+                const std::size_t drop = first - v.window_begin;
+                std::memmove(
+                    v.window.data(),
+                    v.window.data() + drop * v.channels,
+                    (v.window_size - drop) * v.channels * sizeof(f32));
+                v.window_begin = first;
+                v.window_size -= drop;
+            }
+
+            while ( v.window_size < v.window_capacity && v.window_end() < v.end_frame ) {
+                const std::size_t decoded = v.decoder->read(
+                    v.window.data() + v.window_size * v.channels,
+                    v.window_capacity - v.window_size);
+                v.window_size += decoded;
+                stats_.decoded_frames += decoded;
+
+                if ( decoded == 0u ) {
+                    // an empty pass would loop forever, so it ends the voice too
+                    if ( v.looping && frame_count > 0u && v.loop_begin != v.window_end() ) {
+                        v.loop_begin = v.window_end();
+                        v.decoder->seek(0u);
+                    } else {
+                        v.end_frame = v.window_end();
+                    }
+                }
+            }
+        }
+
+        // produces count stereo frames by linear interpolation,
+        // the tail is filled by silence when the voice finishes
+        std::size_t resample_voice_(voice& v, f32* dst, std::size_t count) noexcept {
+            const f64 step = v.rate_ratio * v.pitch;
+            std::size_t produced = 0u;
+
+            try {
+                while ( produced < count ) {
+                    if ( v.finished() ) {
+                        v.playing = false;
+                        break;
+                    }
+
+                    refill_voice_(v);
+
+                    const f32* window = v.window.data();
+                    const std::size_t window_end = v.window_end();
+
+                    std::size_t chunk = 0u;
+                    for ( ; produced + chunk < count; ++chunk ) {
+                        const std::size_t index = static_cast<std::size_t>(v.cursor);
+                        if ( index >= v.end_frame || index >= window_end ) {
+                            break;
+                        }
+                        // the next frame is required for interpolation unless it is the last one
+                        if ( index + 1u >= window_end && index + 1u != v.end_frame ) {
+                            break;
+                        }
+
+                        const f32 t = static_cast<f32>(v.cursor - static_cast<f64>(index));
+                        const std::size_t i0 = (index - v.window_begin) * v.channels;
+                        const std::size_t i1 = index + 1u < window_end
+                            ? i0 + v.channels
+                            : i0;
+
+                        f32* out = dst + (produced + chunk) * 2u;
+                        if ( v.channels == 1u ) {
+                            const f32 s = window[i0] + (window[i1] - window[i0]) * t;
+                            out[0] = s;
+                            out[1] = s;
+                        } else {
+                            out[0] = window[i0 + 0u] + (window[i1 + 0u] - window[i0 + 0u]) * t;
+                            out[1] = window[i0 + 1u] + (window[i1 + 1u] - window[i0 + 1u]) * t;
+                        }
+
+                        v.cursor += step;
+                    }
+
+                    if ( chunk == 0u ) {
+                        // nothing can be decoded anymore
+                        v.end_frame = math::min(v.end_frame, window_end);
+                        v.playing = false;
+                        break;
+                    }
+
+                    produced += chunk;
+                }
+            } catch (...) {
+                v.playing = false;
+            }
+
+            std::fill(dst + produced * 2u, dst + count * 2u, 0.f);
+            return count;
+        }
+    private:
+        parameters params_;
+        statistics stats_;
+        vector<voice> voices_;
+        vector<f32> block_;
+        f32 master_volume_{1.f};
+        mutable std::mutex mutex_;
+    };
+
+    //
+    // sound_mixer
+    //
+
+    sound_mixer::sound_mixer()
+    : sound_mixer(parameters()) {}
+
+    sound_mixer::sound_mixer(const parameters& params)
+    : state_(new internal_state(params)) {}
+
+    sound_mixer::~sound_mixer() noexcept = default;
+
+    const sound_mixer::parameters& sound_mixer::params() const noexcept {
+        return state_->params();
+    }
+
+    sound_mixer::statistics sound_mixer::stats() const noexcept {
+        return state_->stats();
+    }
+
+    sound_mixer::voice_id sound_mixer::create_voice(sound_decoder_uptr decoder) {
+        return state_->create_voice(std::move(decoder));
+    }
+
+    void sound_mixer::destroy_voice(voice_id voice) noexcept {
+        state_->destroy_voice(voice);
+    }
+
+    bool sound_mixer::valid_voice(voice_id voice) const noexcept {
+        return state_->with_voice(voice, [](const auto* v){
+            return !!v;
+        });
+    }
+
+    void sound_mixer::play(voice_id voice) noexcept {
+        state_->with_voice(voice, [](auto* v){
+            if ( v ) {
+                try {
+                    v->rewind(0u);
+                    v->playing = true;
+                } catch (...) {
+                    v->playing = false;
+                }
+            }
+        });
+    }
+
+    void sound_mixer::stop(voice_id voice) noexcept {
+        state_->with_voice(voice, [](auto* v){
+            if ( v ) {
+                v->playing = false;
+            }
+        });
+    }
+
+    void sound_mixer::pause(voice_id voice) noexcept {
+        stop(voice);
+    }
+
+    void sound_mixer::resume(voice_id voice) noexcept {
+        state_->with_voice(voice, [](auto* v){
+            if ( v && !v->finished() ) {
+                v->playing = true;
+            }
+        });
+    }
+
+    bool sound_mixer::playing(voice_id voice) const noexcept {
+        return state_->with_voice(voice, [](const auto* v){
+            return v && v->playing;
+        });
+    }
+
+    void sound_mixer::looping(voice_id voice, bool value) noexcept {
+        state_->with_voice(voice, [value](auto* v){
+            if ( v ) {
+                v->looping = value;
+                if ( !value && v->loop_begin > v->cursor ) {
+                    // the next pass is already decoded, finish the current one
+                    v->end_frame = math::min(v->end_frame, v->loop_begin);
+                }
+            }
+        });
+    }
+
+    bool sound_mixer::looping(voice_id voice) const noexcept {
+        return state_->with_voice(voice, [](const auto* v){
+            return v && v->looping;
+        });
+    }
+
+    void sound_mixer::volume(voice_id voice, f32 value) noexcept {
+        state_->with_voice(voice, [value](auto* v){
+            if ( v ) {
+                v->volume = value;
+            }
+        });
+    }
+
+    f32 sound_mixer::volume(voice_id voice) const noexcept {
+        return state_->with_voice(voice, [](const auto* v){
+            return v ? v->volume : 0.f;
+        });
+    }
+
+    void sound_mixer::pan(voice_id voice, f32 value) noexcept {
+        state_->with_voice(voice, [value](auto* v){
+            if ( v ) {
+                v->pan = math::clamp(value, -1.f, 1.f);
+            }
+        });
+    }
+
+    f32 sound_mixer::pan(voice_id voice) const noexcept {
+        return state_->with_voice(voice, [](const auto* v){
+            return v ? v->pan : 0.f;
+        });
+    }
+
+    void sound_mixer::pitch(voice_id voice, f32 value) noexcept {
+        state_->with_voice(voice, [value](auto* v){
+            if ( v ) {
+                v->pitch = math::max(value, 0.f);
+            }
+        });
+    }
+
+    f32 sound_mixer::pitch(voice_id voice) const noexcept {
+        return state_->with_voice(voice, [](const auto* v){
+            return v ? v->pitch : 0.f;
+        });
+    }
+
+    void sound_mixer::position(voice_id voice, f32 value) noexcept {
+        state_->with_voice(voice, [value](auto* v){
+            if ( v ) {
+                try {
+                    const f64 frame = math::max(0.0, static_cast<f64>(value) * v->decoder->sample_rate());
+                    v->rewind(static_cast<std::size_t>(frame));
+                } catch (...) {
+                    v->playing = false;
+                }
+            }
+        });
+    }
+
+    f32 sound_mixer::position(voice_id voice) const noexcept {
+        return state_->with_voice(voice, [](const auto* v){
+            if ( !v || v->decoder->frame_count() == 0u ) {
+                return 0.f;
+            }
+            const f64 frame_count = static_cast<f64>(v->decoder->frame_count());
+            const f64 frame = v->finished()
+                ? frame_count
+                : std::fmod(v->cursor, frame_count);
+            return static_cast<f32>(frame / v->decoder->sample_rate());
+        });
+    }
+
+    f32 sound_mixer::duration(voice_id voice) const noexcept {
+        return state_->with_voice(voice, [](const auto* v){
+            return v
+                ? static_cast<f32>(static_cast<f64>(v->decoder->frame_count()) / v->decoder->sample_rate())
+                : 0.f;
+        });
+    }
+
+    void sound_mixer::master_volume(f32 value) noexcept {
+        state_->master_volume(value);
+    }
+
+    f32 sound_mixer::master_volume() const noexcept {
+        return state_->master_volume();
+    }
+
+    void sound_mixer::mix(f32* dst, std::size_t frame_count) noexcept {
+        state_->mix(dst, frame_count);
+    }
+
+    void sound_mixer::render(sound_sink& sink, std::size_t frame_count) {
+        const std::size_t block_frames = state_->params().block_frames();
+        vector<f32> block(block_frames * 2u);
+        while ( frame_count > 0u ) {
+            const std::size_t count = math::min(frame_count, block_frames);
+            mix(block.data(), count);
+            sink.write(block.data(), count);
+            frame_count -= count;
+        }
+    }
+
+    sound_decoder_uptr make_sound_decoder(input_stream_uptr stream) noexcept {
+        try {
+            u8 magic[4];
+            if ( !stream || stream->read(magic, sizeof(magic)) != sizeof(magic) ) {
+                return nullptr;
+            }
+            stream->seek(0, false);
+
+            if ( std::memcmp(magic, "RIFF", 4) == 0 ) {
+                return make_wav_sound_decoder(std::move(stream));
+            }
+
+            if ( std::memcmp(magic, "OggS", 4) == 0 ) {
+                return make_vorbis_sound_decoder(std::move(stream));
+            }
+
+            return nullptr;
+        } catch (...) {
+            return nullptr;
+        }
+    }
+}
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/sound_mixer.hpp>
+
+#if defined(E2D_BUILD_WITH_VORBIS)
+
+// the implementation is compiled from the same file as a separate unit
+#define STB_VORBIS_HEADER_ONLY
+#include <3rdparty/stb/stb_vorbis.c>
+
+namespace
+{
+    using namespace e2d;
+
+    struct vorbis_closer {
+        void operator()(stb_vorbis* v) const noexcept {
+            stb_vorbis_close(v);
+        }
+    };
+
+    using vorbis_uptr = std::unique_ptr<stb_vorbis, vorbis_closer>;
+
+    class vorbis_sound_decoder final : public sound_decoder {
+    public:
+        vorbis_sound_decoder(buffer data, vorbis_uptr vorbis)
+        : data_(std::move(data))
+        , vorbis_(std::move(vorbis))
+        {
+            const stb_vorbis_info info = stb_vorbis_get_info(vorbis_.get());
+            channels_ = math::numeric_cast<u32>(info.channels);
+            sample_rate_ = info.sample_rate;
+            frame_count_ = stb_vorbis_stream_length_in_samples(vorbis_.get());
+        }
+
+        u32 channels() const noexcept final {
+            return channels_;
+        }
+
+        u32 sample_rate() const noexcept final {
+            return sample_rate_;
+        }
+
+        std::size_t frame_count() const noexcept final {
+            return frame_count_;
+        }
+
+        std::size_t read(f32* dst, std::size_t frames) final {
+            std::size_t result = 0u;
+            while ( result < frames && frame_ != frame_count_ ) {
+                const std::size_t chunk_frames = math::min(
+                    frames - result,
+                    frame_count_ - frame_,
+                    std::size_t(std::numeric_limits<int>::max()) / channels_);
+                const int read_frames = stb_vorbis_get_samples_float_interleaved(
+                    vorbis_.get(),
+                    math::numeric_cast<int>(channels_),
+                    dst + result * channels_,
+                    math::numeric_cast<int>(chunk_frames * channels_));
+
+                result += math::numeric_cast<std::size_t>(read_frames);
+                frame_ += math::numeric_cast<std::size_t>(read_frames);
+
+                if ( read_frames == 0 ) {
+                    // the last granule position overstated the length
+                    frame_count_ = frame_;
+                    break;
+                }
+            }
+            return result;
+        }
+
+        void seek(std::size_t frame) final {
+            frame_ = math::min(frame, frame_count_);
+            if ( !stb_vorbis_seek(vorbis_.get(), math::numeric_cast<unsigned int>(frame_)) ) {
+                stb_vorbis_seek_start(vorbis_.get());
+                frame_ = 0u;
+            }
+        }
+    private:
+        buffer data_;
+        vorbis_uptr vorbis_;
+        u32 channels_{0u};
+        u32 sample_rate_{0u};
+        std::size_t frame_count_{0u};
+        std::size_t frame_{0u};
+    };
+
+    sound_decoder_uptr create_vorbis_sound_decoder(input_stream_uptr stream) {
+        // stb_vorbis pulls from memory, compressed data is small enough to keep
+        buffer data;
+        if ( !streams::try_read_tail(data, stream) || data.size() < 4u ) {
+            return nullptr;
+        }
+
+        if ( std::memcmp(data.data(), "OggS", 4) != 0 ) {
+            return nullptr;
+        }
+
+        int error = VORBIS__no_error;
+        vorbis_uptr vorbis(stb_vorbis_open_memory(
+            data.data(),
+            math::numeric_cast<int>(data.size()),
+            &error,
+            nullptr));
+        if ( !vorbis ) {
+            return nullptr;
+        }
+
+        const stb_vorbis_info info = stb_vorbis_get_info(vorbis.get());
+        if ( info.channels < 1 || info.channels > 2 || info.sample_rate == 0u ) {
+            return nullptr;
+        }
+
+        return std::make_unique<vorbis_sound_decoder>(
+            std::move(data), std::move(vorbis));
+    }
+}
+
+namespace e2d
+{
+    sound_decoder_uptr make_vorbis_sound_decoder(input_stream_uptr stream) noexcept {
+        try {
+            return stream
+                ? create_vorbis_sound_decoder(std::move(stream))
+                : nullptr;
+        } catch (...) {
+            return nullptr;
+        }
+    }
+}
+
+#else
+
+namespace e2d
+{
+    sound_decoder_uptr make_vorbis_sound_decoder(input_stream_uptr stream) noexcept {
+        E2D_UNUSED(stream);
+        return nullptr;
+    }
+}
+
+#endif
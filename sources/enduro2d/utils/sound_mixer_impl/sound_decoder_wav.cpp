@@ -0,0 +1,241 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/sound_mixer.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    constexpr u16 wav_format_pcm = 0x0001;
+    constexpr u16 wav_format_float = 0x0003;
+    constexpr u16 wav_format_extensible = 0xFFFE;
+
+    // raw bytes converted per stream read
+    constexpr std::size_t wav_scratch_size = 4096u;
+
+    u16 read_u16_le(const u8* p) noexcept {
+        return static_cast<u16>(p[0] | (p[1] << 8u));
+    }
+
+    u32 read_u32_le(const u8* p) noexcept {
+        return static_cast<u32>(p[0])
+            | (static_cast<u32>(p[1]) << 8u)
+            | (static_cast<u32>(p[2]) << 16u)
+            | (static_cast<u32>(p[3]) << 24u);
+    }
+
+    bool read_exact(input_stream& stream, void* dst, std::size_t size) {
+        return stream.read(dst, size) == size;
+    }
+
+    struct wav_format {
+        u16 format{0u};
+        u16 channels{0u};
+        u32 sample_rate{0u};
+        u16 block_align{0u};
+        u16 bits_per_sample{0u};
+    };
+
+    bool is_supported_wav_format(const wav_format& fmt) noexcept {
+        if ( fmt.channels < 1u || fmt.channels > 2u || fmt.sample_rate == 0u ) {
+            return false;
+        }
+        if ( fmt.block_align != fmt.channels * fmt.bits_per_sample / 8u ) {
+            return false;
+        }
+        switch ( fmt.format ) {
+            case wav_format_pcm:
+                return fmt.bits_per_sample == 8u
+                    || fmt.bits_per_sample == 16u
+                    || fmt.bits_per_sample == 24u
+                    || fmt.bits_per_sample == 32u;
+            case wav_format_float:
+                return fmt.bits_per_sample == 32u;
+            default:
+                return false;
+        }
+    }
+
+    class wav_sound_decoder final : public sound_decoder {
+    public:
+        wav_sound_decoder(
+            input_stream_uptr stream,
+            const wav_format& fmt,
+            std::size_t data_offset,
+            std::size_t data_size)
+        : stream_(std::move(stream))
+        , format_(fmt)
+        , data_offset_(data_offset)
+        , frame_count_(data_size / fmt.block_align) {}
+
+        u32 channels() const noexcept final {
+            return format_.channels;
+        }
+
+        u32 sample_rate() const noexcept final {
+            return format_.sample_rate;
+        }
+
+        std::size_t frame_count() const noexcept final {
+            return frame_count_;
+        }
+
+        std::size_t read(f32* dst, std::size_t frames) final {
+            const std::size_t frame_size = format_.block_align;
+            const std::size_t scratch_frames = wav_scratch_size / frame_size;
+
+            std::size_t result = 0u;
+            while ( result < frames && frame_ != frame_count_ ) {
+                const std::size_t chunk_frames = math::min(
+                    frames - result,
+                    scratch_frames,
+                    frame_count_ - frame_);
+                const std::size_t chunk_size = chunk_frames * frame_size;
+                const std::size_t read_size = stream_->read(scratch_.data(), chunk_size);
+                const std::size_t read_frames = read_size / frame_size;
+
+                convert_samples_(
+                    scratch_.data(),
+                    dst + result * format_.channels,
+                    read_frames * format_.channels);
+
+                result += read_frames;
+                frame_ += read_frames;
+
+                if ( read_size != chunk_size ) {
+                    // truncated data chunk
+                    frame_count_ = frame_;
+                    break;
+                }
+            }
+            return result;
+        }
+
+        void seek(std::size_t frame) final {
+            frame_ = math::min(frame, frame_count_);
+            stream_->seek(
+                math::numeric_cast<std::ptrdiff_t>(data_offset_ + frame_ * format_.block_align),
+                false);
+        }
+    private:
+        void convert_samples_(const u8* src, f32* dst, std::size_t count) const noexcept {
+            switch ( format_.bits_per_sample ) {
+                case 8u:
+                    for ( std::size_t i = 0; i < count; ++i ) {
+                        dst[i] = (static_cast<f32>(src[i]) - 128.f) * (1.f / 128.f);
+                    }
+                    break;
+                case 16u:
+                    for ( std::size_t i = 0; i < count; ++i, src += 2u ) {
+                        dst[i] = static_cast<i16>(read_u16_le(src)) * (1.f / 32768.f);
+                    }
+                    break;
+                case 24u:
+                    for ( std::size_t i = 0; i < count; ++i, src += 3u ) {
+                        const i32 v = static_cast<i32>(
+                            (static_cast<u32>(src[0]) << 8u) |
+                            (static_cast<u32>(src[1]) << 16u) |
+                            (static_cast<u32>(src[2]) << 24u)) >> 8;
+                        dst[i] = v * (1.f / 8388608.f);
+                    }
+                    break;
+                case 32u:
+                    for ( std::size_t i = 0; i < count; ++i, src += 4u ) {
+                        const u32 v = read_u32_le(src);
+                        if ( format_.format == wav_format_float ) {
+                            f32 f;
+                            std::memcpy(&f, &v, sizeof(f));
+                            dst[i] = f;
+                        } else {
+                            dst[i] = static_cast<f32>(static_cast<i32>(v) * (1.0 / 2147483648.0));
+                        }
+                    }
+                    break;
+                default:
+                    E2D_ASSERT_MSG(false, "unexpected bits per sample");
+                    break;
+            }
+        }
+    private:
+        input_stream_uptr stream_;
+        wav_format format_;
+        std::size_t data_offset_{0u};
+        std::size_t frame_count_{0u};
+        std::size_t frame_{0u};
+        std::array<u8, wav_scratch_size> scratch_;
+    };
+
+    sound_decoder_uptr create_wav_sound_decoder(input_stream_uptr stream) {
+        u8 riff[12];
+        if ( !read_exact(*stream, riff, sizeof(riff))
+            || std::memcmp(riff, "RIFF", 4) != 0
+            || std::memcmp(riff + 8, "WAVE", 4) != 0 )
+        {
+            return nullptr;
+        }
+
+        wav_format fmt;
+        bool has_format = false;
+
+        for ( ;; ) {
+            u8 chunk[8];
+            if ( !read_exact(*stream, chunk, sizeof(chunk)) ) {
+                return nullptr;
+            }
+
+            const u32 chunk_size = read_u32_le(chunk + 4);
+            const std::size_t chunk_offset = stream->tell();
+
+            if ( std::memcmp(chunk, "fmt ", 4) == 0 ) {
+                u8 data[40] = {0};
+                const std::size_t data_size = math::min(std::size_t(chunk_size), sizeof(data));
+                if ( data_size < 16u || !read_exact(*stream, data, data_size) ) {
+                    return nullptr;
+                }
+                fmt.format = read_u16_le(data);
+                fmt.channels = read_u16_le(data + 2);
+                fmt.sample_rate = read_u32_le(data + 4);
+                fmt.block_align = read_u16_le(data + 12);
+                fmt.bits_per_sample = read_u16_le(data + 14);
+                if ( fmt.format == wav_format_extensible && data_size >= 26u ) {
+                    // the first two bytes of the subformat guid are the format tag
+                    fmt.format = read_u16_le(data + 24);
+                }
+                has_format = true;
+            } else if ( std::memcmp(chunk, "data", 4) == 0 ) {
+                if ( !has_format || !is_supported_wav_format(fmt) ) {
+                    return nullptr;
+                }
+                const std::size_t data_size = math::min(
+                    std::size_t(chunk_size),
+                    stream->length() - chunk_offset);
+                return std::make_unique<wav_sound_decoder>(
+                    std::move(stream), fmt, chunk_offset, data_size);
+            }
+
+            // chunks are word aligned
+            const std::size_t next_offset = chunk_offset + chunk_size + (chunk_size & 1u);
+            if ( next_offset >= stream->length() ) {
+                return nullptr;
+            }
+            stream->seek(math::numeric_cast<std::ptrdiff_t>(next_offset), false);
+        }
+    }
+}
+
+namespace e2d
+{
+    sound_decoder_uptr make_wav_sound_decoder(input_stream_uptr stream) noexcept {
+        try {
+            return stream
+                ? create_wav_sound_decoder(std::move(stream))
+                : nullptr;
+        } catch (...) {
+            return nullptr;
+        }
+    }
+}
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include <enduro2d/utils/sound_mixer.hpp>
+
+namespace
+{
+    using namespace e2d;
+
+    constexpr std::size_t wav_header_size = 44u;
+
+    void write_u16_le(u8* p, u16 v) noexcept {
+        p[0] = static_cast<u8>(v);
+        p[1] = static_cast<u8>(v >> 8u);
+    }
+
+    void write_u32_le(u8* p, u32 v) noexcept {
+        p[0] = static_cast<u8>(v);
+        p[1] = static_cast<u8>(v >> 8u);
+        p[2] = static_cast<u8>(v >> 16u);
+        p[3] = static_cast<u8>(v >> 24u);
+    }
+
+    std::array<u8, wav_header_size> make_wav_header(u32 sample_rate, u32 data_size) noexcept {
+        std::array<u8, wav_header_size> hdr{};
+        std::memcpy(hdr.data(), "RIFF", 4);
+        write_u32_le(hdr.data() + 4, 36u + data_size);
+        std::memcpy(hdr.data() + 8, "WAVEfmt ", 8);
+        write_u32_le(hdr.data() + 16, 16u);
+        write_u16_le(hdr.data() + 20, 1u);
+        write_u16_le(hdr.data() + 22, 2u);
+        write_u32_le(hdr.data() + 24, sample_rate);
+        write_u32_le(hdr.data() + 28, sample_rate * 4u);
+        write_u16_le(hdr.data() + 32, 4u);
+        write_u16_le(hdr.data() + 34, 16u);
+        std::memcpy(hdr.data() + 36, "data", 4);
+        write_u32_le(hdr.data() + 40, data_size);
+        return hdr;
+    }
+
+    class null_sound_sink final : public sound_sink {
+    public:
+        void write(const f32* frames, std::size_t frame_count) final {
+            E2D_UNUSED(frames, frame_count);
+        }
+    };
+
+    class wav_sound_sink final : public sound_sink {
+    public:
+        wav_sound_sink(output_stream_uptr stream, u32 sample_rate)
+        : stream_(std::move(stream))
+        , sample_rate_(sample_rate) {
+            const auto hdr = make_wav_header(sample_rate_, 0u);
+            stream_->write(hdr.data(), hdr.size());
+        }
+
+        ~wav_sound_sink() noexcept final {
+            try {
+                const auto hdr = make_wav_header(
+                    sample_rate_,
+                    math::numeric_cast<u32>(data_size_));
+                stream_->seek(0, false);
+                stream_->write(hdr.data(), hdr.size());
+                stream_->flush();
+            } catch (...) {
+                // nothing
+            }
+        }
+
+        void write(const f32* frames, std::size_t frame_count) final {
+            std::array<u8, 1024u> scratch;
+            while ( frame_count > 0u ) {
+                const std::size_t chunk_frames = math::min(frame_count, scratch.size() / 4u);
+                for ( std::size_t i = 0; i < chunk_frames * 2u; ++i ) {
+                    const f32 v = math::clamp(frames[i], -1.f, 1.f);
+                    write_u16_le(
+                        scratch.data() + i * 2u,
+                        static_cast<u16>(static_cast<i16>(v * 32767.f)));
+                }
+                const std::size_t chunk_size = chunk_frames * 4u;
+                if ( stream_->write(scratch.data(), chunk_size) != chunk_size ) {
+                    throw bad_stream_operation();
+                }
+                data_size_ += chunk_size;
+                frames += chunk_frames * 2u;
+                frame_count -= chunk_frames;
+            }
+        }
+    private:
+        output_stream_uptr stream_;
+        u32 sample_rate_{0u};
+        std::size_t data_size_{0u};
+    };
+}
+
+namespace e2d
+{
+    sound_sink_uptr make_null_sound_sink() noexcept {
+        try {
+            return std::make_unique<null_sound_sink>();
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    sound_sink_uptr make_wav_sound_sink(output_stream_uptr stream, u32 sample_rate) noexcept {
+        try {
+            return stream && sample_rate > 0u
+                ? std::make_unique<wav_sound_sink>(std::move(stream), sample_rate)
+                : nullptr;
+        } catch (...) {
+            return nullptr;
+        }
+    }
+}
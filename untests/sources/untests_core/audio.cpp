@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_core.hpp"
+using namespace e2d;
+
+namespace
+{
+    class safe_engine_initializer final : private noncopyable {
+    public:
+        safe_engine_initializer() {
+            modules::initialize<engine>(0, nullptr,
+                engine::parameters("audio_untests", "enduro2d"));
+        }
+
+        ~safe_engine_initializer() noexcept {
+            modules::shutdown<engine>();
+        }
+    };
+
+    // 16 bit mono silence
+    buffer make_silent_wav(u32 sample_rate, u32 frames) {
+        const u32 data_size = frames * 2u;
+        buffer data(44u + data_size);
+        u8* p = data.data();
+
+        const auto put_u16 = [&p](u16 v){
+            *p++ = static_cast<u8>(v);
+            *p++ = static_cast<u8>(v >> 8u);
+        };
+        const auto put_u32 = [&put_u16](u32 v){
+            put_u16(static_cast<u16>(v));
+            put_u16(static_cast<u16>(v >> 16u));
+        };
+        const auto put_tag = [&p](const char* tag){
+            std::memcpy(p, tag, 4u);
+            p += 4u;
+        };
+
+        put_tag("RIFF"); put_u32(36u + data_size); put_tag("WAVE");
+        put_tag("fmt "); put_u32(16u);
+        put_u16(1u); put_u16(1u);
+        put_u32(sample_rate); put_u32(sample_rate * 2u);
+        put_u16(2u); put_u16(16u);
+        put_tag("data"); put_u32(data_size);
+        std::memset(p, 0, data_size);
+        return data;
+    }
+
+    // the mixer runs in its own thread, so sources are polled
+    template < typename F >
+    bool wait_for(F&& f) {
+        for ( std::size_t i = 0; i < 200u; ++i ) {
+            if ( f() ) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+}
+
+TEST_CASE("audio") {
+    safe_engine_initializer initializer;
+    if ( !modules::is_initialized<audio>() ) {
+        return;
+    }
+
+    audio& a = the<audio>();
+    REQUIRE(a.initialized());
+
+#if defined(E2D_AUDIO_MODE) && E2D_AUDIO_MODE == E2D_AUDIO_MODE_SOFT
+    REQUIRE_FALSE(a.create_stream(buffer_view()));
+    REQUIRE_FALSE(a.create_stream(buffer("hello world", 11u)));
+#endif
+
+    // two seconds of silence
+    const buffer sound_data = make_silent_wav(8000u, 16000u);
+
+    SECTION("memory_stream") {
+        const sound_stream_ptr stream = a.create_stream(sound_data);
+        if ( !stream ) {
+            // the backend has no device to create streams
+            return;
+        }
+        REQUIRE(stream->duration() == Approx(2.f));
+
+        // every source of a memory stream is mixed on its own
+        const sound_source_ptr source1 = a.create_source(stream);
+        const sound_source_ptr source2 = a.create_source(stream);
+        REQUIRE(source1);
+        REQUIRE(source2);
+
+        source1->play();
+        REQUIRE(source1->playing());
+        REQUIRE_FALSE(source2->playing());
+        REQUIRE(wait_for([&source1](){
+            return source1->position() > 0.f;
+        }));
+        REQUIRE(source2->position() == Approx(0.f));
+
+        source1->stop();
+        REQUIRE_FALSE(source1->playing());
+    }
+    SECTION("file_stream") {
+        const sound_stream_ptr stream = a.create_stream(make_memory_stream(buffer(sound_data)));
+        if ( !stream ) {
+            return;
+        }
+        REQUIRE(stream->duration() == Approx(2.f));
+
+        const sound_source_ptr source = a.create_source(stream);
+        REQUIRE(source);
+
+        source->volume(0.5f);
+        REQUIRE(source->volume() == Approx(0.5f));
+
+        // playing starts from the beginning, so seek after it
+        source->play();
+        source->position(1.9f);
+        REQUIRE(wait_for([&source](){
+            return !source->playing();
+        }));
+    }
+    SECTION("pause") {
+        const sound_stream_ptr stream = a.create_stream(sound_data);
+        if ( !stream ) {
+            return;
+        }
+
+        const sound_source_ptr source = a.create_source(stream);
+        REQUIRE(source);
+
+        source->looping(true);
+        source->play();
+        REQUIRE(wait_for([&source](){
+            return source->position() > 0.f;
+        }));
+
+        // the block being mixed while pausing may still be finished
+        a.pause();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const f32 paused_position = source->position();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        REQUIRE(source->position() == Approx(paused_position));
+
+        a.resume();
+        REQUIRE(wait_for([&source, paused_position](){
+            return math::abs(source->position() - paused_position) > 0.f;
+        }));
+    }
+}
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_core.hpp"
+using namespace e2d;
+
+namespace
+{
+    class safe_engine_initializer final : private noncopyable {
+    public:
+        safe_engine_initializer(const engine::timer_parameters& timer_params) {
+            modules::initialize<engine>(0, nullptr,
+                engine::parameters("engine_untests", "enduro2d")
+                    .timer_params(timer_params));
+        }
+
+        ~safe_engine_initializer() noexcept {
+            modules::shutdown<engine>();
+        }
+    };
+
+    struct frame_ticks {
+        u32 first_tick{0u};
+        u32 tick_count{0u};
+        f32 alpha{0.f};
+        f32 time{0.f};
+    };
+
+    class ticks_recorder final : public engine::application {
+    public:
+        ticks_recorder(vector<frame_ticks>& frames, std::size_t frame_count)
+        : frames_(frames)
+        , frame_count_(frame_count) {}
+
+        bool frame_tick() final {
+            const engine& e = the<engine>();
+            frames_.push_back({
+                e.tick_count(),
+                e.frame_tick_count(),
+                e.tick_alpha(),
+                e.time()});
+            return frames_.size() < frame_count_;
+        }
+    private:
+        vector<frame_ticks>& frames_;
+        std::size_t frame_count_{0u};
+    };
+
+    vector<frame_ticks> run_frames(std::size_t frame_count) {
+        vector<frame_ticks> frames;
+        REQUIRE(the<engine>().start(std::make_unique<ticks_recorder>(frames, frame_count)));
+        REQUIRE(frames.size() == frame_count);
+        return frames;
+    }
+}
+
+TEST_CASE("engine") {
+    SECTION("variable_update") {
+        safe_engine_initializer initializer(engine::timer_parameters()
+            .deterministic(true)
+            .maximal_framerate(40u));
+        REQUIRE_FALSE(the<engine>().fixed_update());
+
+        const vector<frame_ticks> frames = run_frames(3u);
+        for ( const frame_ticks& f : frames ) {
+            REQUIRE(f.tick_count == 0u);
+            REQUIRE(math::approximately(f.alpha, 1.f));
+        }
+    }
+    SECTION("tick_accumulation") {
+        // 25ms frames with 10ms ticks
+        safe_engine_initializer initializer(engine::timer_parameters()
+            .deterministic(true)
+            .maximal_framerate(40u)
+            .fixed_update_rate(100u));
+        REQUIRE(the<engine>().fixed_update());
+        REQUIRE(math::approximately(the<engine>().fixed_delta_time(), 0.01f));
+
+        const vector<frame_ticks> frames = run_frames(5u);
+
+        // the first frame simulates one tick to have a state to render
+        REQUIRE(frames[0].first_tick == 0u);
+        REQUIRE(frames[0].tick_count == 1u);
+        REQUIRE(math::approximately(frames[0].alpha, 1.f));
+
+        const u32 tick_counts[] = {1u, 2u, 3u, 2u, 3u};
+        const f32 alphas[] = {1.f, 0.5f, 0.f, 0.5f, 0.f};
+        for ( std::size_t i = 0; i < frames.size(); ++i ) {
+            REQUIRE(frames[i].tick_count == tick_counts[i]);
+            REQUIRE(math::approximately(frames[i].alpha, alphas[i]));
+            if ( i > 0u ) {
+                REQUIRE(frames[i].first_tick == frames[i - 1].first_tick + frames[i - 1].tick_count);
+            }
+        }
+    }
+    SECTION("maximal_update_steps") {
+        // 100ms frames with 25ms ticks, but at most three ticks per frame
+        safe_engine_initializer initializer(engine::timer_parameters()
+            .deterministic(true)
+            .maximal_framerate(10u)
+            .fixed_update_rate(40u)
+            .maximal_update_steps(3u));
+
+        const vector<frame_ticks> frames = run_frames(5u);
+        for ( std::size_t i = 1; i < frames.size(); ++i ) {
+            REQUIRE(frames[i].tick_count == 3u);
+            REQUIRE(frames[i].first_tick == 1u + 3u * (i - 1u));
+
+            // the time of the fourth tick is dropped, not accumulated
+            REQUIRE(math::approximately(frames[i].alpha, 0.f));
+            REQUIRE(math::approximately(frames[i].time - frames[i - 1].time, 0.1f));
+        }
+    }
+}
@@ -275,4 +275,75 @@ TEST_CASE("input"){
             REQUIRE(keys[0] == keyboard_key::escape);
         }
     }
+    SECTION("capture"){
+        input_capture capture;
+        {
+            input i;
+            i.post_event(input::move_cursor_event{v2f(10.f,20.f)});
+            i.post_event(input::keyboard_key_event{keyboard_key::a, keyboard_key_action::press});
+
+            i.start_recording();
+            REQUIRE(i.is_recording());
+
+            i.post_event(input::mouse_button_event{mouse_button::left, mouse_button_action::press});
+            i.post_event(input::input_char_event{'e'});
+            REQUIRE(i.frame_delta_time(make_microseconds<u64>(16000u)).value == 16000u);
+            i.frame_tick();
+
+            i.post_event(input::mouse_scroll_event{v2f(0.f,1.f)});
+            i.post_event(input::keyboard_key_event{keyboard_key::a, keyboard_key_action::release});
+            REQUIRE(i.frame_delta_time(make_microseconds<u64>(17000u)).value == 17000u);
+            i.frame_tick();
+
+            REQUIRE(i.stop_recording(capture));
+            REQUIRE_FALSE(i.is_recording());
+            REQUIRE_FALSE(i.stop_recording(capture));
+        }
+        REQUIRE(capture.frame_count() == 2u);
+        REQUIRE(capture.frame_at(0).delta_time.value == 16000u);
+        REQUIRE(capture.frame_at(0).events.size() == 4u);
+        REQUIRE(capture.frame_at(1).delta_time.value == 17000u);
+        REQUIRE(capture.frame_at(1).events.size() == 2u);
+        {
+            buffer file_data;
+            REQUIRE(input_captures::try_save_capture(capture, file_data));
+
+            input_capture capture2;
+            REQUIRE(input_captures::try_load_capture(capture2, file_data));
+            REQUIRE(capture2 == capture);
+
+            file_data.resize(file_data.size() - 1u);
+            REQUIRE_FALSE(input_captures::try_load_capture(capture2, file_data));
+            REQUIRE(capture2 == capture);
+        }
+        {
+            input i;
+            const mouse& m = i.mouse();
+            const keyboard& k = i.keyboard();
+
+            i.post_event(input::keyboard_key_event{keyboard_key::b, keyboard_key_action::press});
+            i.start_replaying(capture);
+            REQUIRE(i.is_replaying());
+
+            REQUIRE_FALSE(k.is_key_pressed(keyboard_key::b));
+            REQUIRE(k.is_key_pressed(keyboard_key::a));
+            REQUIRE(m.is_button_just_pressed(mouse_button::left));
+            REQUIRE(k.input_text() == U"e");
+            REQUIRE(math::approximately(m.cursor_pos(), v2f(10.f,20.f)));
+            REQUIRE(i.frame_delta_time(make_microseconds<u64>(1u)).value == 16000u);
+
+            i.post_event(input::move_cursor_event{v2f(1.f,2.f)});
+            REQUIRE(math::approximately(m.cursor_pos(), v2f(10.f,20.f)));
+
+            i.frame_tick();
+            REQUIRE(i.is_replaying());
+            REQUIRE(k.is_key_just_released(keyboard_key::a));
+            REQUIRE(math::approximately(m.scroll_delta(), v2f(0.f,1.f)));
+            REQUIRE(i.frame_delta_time(make_microseconds<u64>(1u)).value == 17000u);
+
+            i.frame_tick();
+            REQUIRE_FALSE(i.is_replaying());
+            REQUIRE(i.frame_delta_time(make_microseconds<u64>(1u)).value == 1u);
+        }
+    }
 }
@@ -20,6 +20,54 @@ namespace
             modules::shutdown<engine>();
         }
     };
+
+    // collects the operation counts of the frames executed by the render thread
+    class executed_frames_sink final : public profiler::sink {
+    public:
+        void on_event(const profiler::event_info& event) noexcept final {
+            const auto* begin = std::get_if<profiler::begin_scope_info>(&event);
+            if ( begin && begin->name == "render.execute_frame" ) {
+                std::lock_guard<std::mutex> guard(mutex_);
+                const auto iter = begin->args.find("operations");
+                operations_.push_back(iter != begin->args.end() ? iter->second : str());
+            }
+        }
+
+        vector<str> operations() const {
+            std::lock_guard<std::mutex> guard(mutex_);
+            return operations_;
+        }
+    private:
+        mutable std::mutex mutex_;
+        vector<str> operations_;
+    };
+
+    // holds the render thread in the error message of a failed resource creation
+    class render_thread_gate_sink final : public debug::sink {
+    public:
+        std::atomic<bool> entered{false};
+        std::atomic<bool> opened{false};
+
+        bool on_message(debug::level lvl, str_view text) noexcept final {
+            E2D_UNUSED(lvl);
+            const bool creation_failed =
+                text.find("unsupported pixel declaration") != str_view::npos;
+            if ( creation_failed && the<render>().is_in_render_thread() ) {
+                entered = true;
+                while ( !opened ) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+            return true;
+        }
+    };
+
+    bool wait_for(const std::atomic<bool>& flag) {
+        for ( std::size_t i = 0; i < 1000u && !flag; ++i ) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return flag;
+    }
 }
 
 TEST_CASE("render"){
@@ -172,6 +220,17 @@ TEST_CASE("render"){
         vd4 = vd3;
         REQUIRE(vd4 != vd);
         REQUIRE(vd4 == vd3);
+
+        REQUIRE_FALSE(vd.has_per_instance_attributes());
+        auto vd5 = vertex_declaration()
+            .add_attribute<v2f>("hello")
+            .add_attribute<m4f>("world").per_instance(2u);
+        REQUIRE(vd5.has_per_instance_attributes());
+        REQUIRE(vd5.attribute(0).divisor == 0);
+        REQUIRE(vd5.attribute(1).divisor == 2);
+        REQUIRE(vd5 != vertex_declaration()
+            .add_attribute<v2f>("hello")
+            .add_attribute<m4f>("world"));
     }
     SECTION("update_texture"){
         if ( modules::is_initialized<render>() ) {
@@ -256,4 +315,132 @@ TEST_CASE("render"){
             }
         }
     }
+    SECTION("instancing"){
+        if ( modules::is_initialized<render>() ) {
+            render& r = the<render>();
+            const shader_ptr ps = r.create_shader(
+                str_view("attribute vec3 a_position;\n"
+                    "attribute mat4 a_matrix_m;\n"
+                    "void main(){ gl_Position = a_matrix_m * vec4(a_position, 1.0); }"),
+                str_view("void main(){ gl_FragColor = vec4(1.0); }"));
+            REQUIRE(ps != nullptr);
+            REQUIRE(ps->has_attribute(make_hash("a_position")));
+            REQUIRE(ps->has_attribute(make_hash("a_matrix_m")));
+            REQUIRE_FALSE(ps->has_attribute(make_hash("a_vertex_color")));
+
+            const auto instance_decl = vertex_declaration()
+                .add_attribute<m4f>("a_matrix_m").per_instance();
+            REQUIRE(r.is_vertex_supported(instance_decl)
+                == r.device_capabilities().instancing_supported);
+        }
+    }
+    SECTION("render_thread"){
+        if ( modules::is_initialized<render>() ) {
+            render& r = the<render>();
+            REQUIRE_FALSE(r.is_render_thread_active());
+            REQUIRE(r.start_render_thread(2u));
+            REQUIRE(r.is_render_thread_active());
+            REQUIRE_FALSE(r.is_in_render_thread());
+            {
+                texture_ptr tex = r.create_texture(v2u(16,16), pixel_declaration::pixel_type::rgba8);
+                REQUIRE(tex != nullptr);
+
+                buffer src(tex->size().x * tex->size().y * 4u);
+                for ( std::size_t i = 0; i < 8; ++i ) {
+                    REQUIRE_NOTHROW(r.execute(render::clear_command()));
+                    REQUIRE_NOTHROW(r.update_texture(tex, src, b2u(0, 0, 16, 16)));
+                    REQUIRE_NOTHROW(r.submit_frame());
+                }
+            }
+            r.wait_for_render_thread();
+            r.stop_render_thread();
+            REQUIRE_FALSE(r.is_render_thread_active());
+            REQUIRE(r.is_in_render_thread());
+        }
+    }
+    SECTION("render_thread_order"){
+        if ( modules::is_initialized<render>() && modules::is_initialized<profiler>() ) {
+            render& r = the<render>();
+            executed_frames_sink& sink = the<profiler>().register_sink<executed_frames_sink>();
+            REQUIRE(r.start_render_thread(3u));
+            {
+                texture_ptr tex = r.create_texture(v2u(16,16), pixel_declaration::pixel_type::rgba8);
+                REQUIRE(tex != nullptr);
+
+                buffer src(tex->size().x * tex->size().y * 4u);
+                for ( std::size_t i = 0; i < 4; ++i ) {
+                    for ( std::size_t j = 0; j <= i; ++j ) {
+                        r.execute(render::clear_command());
+                    }
+                    r.update_texture(tex, src, b2u(0, 0, 16, 16));
+                    r.submit_frame();
+                }
+            }
+            r.wait_for_render_thread();
+
+            // the frames are executed as they were submitted
+            REQUIRE(sink.operations() == vector<str>{"2", "3", "4", "5"});
+
+            // the last one is seen by the next frame
+            r.submit_frame();
+            REQUIRE(r.frame_statistics().clear_calls == 4u);
+            REQUIRE(r.frame_statistics().texture_updates == 1u);
+
+            r.stop_render_thread();
+            the<profiler>().unregister_sink(sink);
+        }
+    }
+    SECTION("render_thread_statistics"){
+        if ( modules::is_initialized<render>() ) {
+            render& r = the<render>();
+            REQUIRE(r.start_render_thread(1u));
+            for ( u32 i = 0; i < 5; ++i ) {
+                for ( u32 j = 0; j <= i; ++j ) {
+                    r.execute(render::clear_command());
+                }
+                r.submit_frame();
+
+                // one queued frame is completed before the next submission,
+                // so the statistics are of the previous frame exactly
+                REQUIRE(r.frame_statistics().clear_calls == i);
+            }
+            r.stop_render_thread();
+        }
+    }
+    SECTION("render_thread_queue"){
+        if ( modules::is_initialized<render>() ) {
+            render& r = the<render>();
+            render_thread_gate_sink& gate = the<debug>().register_sink<render_thread_gate_sink>();
+            REQUIRE(r.start_render_thread(2u));
+
+            // the render thread is held by a resource creation of another thread
+            texture_ptr failed_tex;
+            std::thread creator([&r, &failed_tex](){
+                failed_tex = r.create_texture(v2u(16,16), pixel_declaration::pixel_type::rgba_dxt1);
+            });
+            REQUIRE(wait_for(gate.entered));
+
+            r.submit_frame();
+            r.submit_frame();
+
+            std::atomic<bool> released{false};
+            std::thread releaser([&gate, &released](){
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                released = true;
+                gate.opened = true;
+            });
+
+            // two frames are queued, the third one waits for the render thread
+            r.submit_frame();
+            REQUIRE(released);
+
+            releaser.join();
+            creator.join();
+            REQUIRE_FALSE(failed_tex);
+
+            r.wait_for_render_thread();
+            r.stop_render_thread();
+            the<debug>().unregister_sink(gate);
+        }
+    }
 }
@@ -7,6 +7,211 @@
 #include "_core.hpp"
 using namespace e2d;
 
+#if defined(E2D_PLATFORM) && E2D_PLATFORM == E2D_PLATFORM_LINUX
+#  include <unistd.h>
+#  include <arpa/inet.h>
+#  include <netinet/in.h>
+#  include <sys/socket.h>
+#endif
+
+namespace
+{
+    class change_counter final : public vfs::change_listener {
+    public:
+        change_counter(vector<url>& changes)
+        : changes_(changes) {}
+
+        void on_change(const url& url) noexcept final {
+            changes_.push_back(url);
+        }
+    private:
+        vector<url>& changes_;
+    };
+
+#if defined(E2D_PLATFORM) && E2D_PLATFORM == E2D_PLATFORM_LINUX
+    //
+    // local_http_server
+    //
+    // Serves files with ETags and single byte ranges, one request per
+    // connection, and counts requests by their methods.
+    //
+
+    class local_http_server final : private noncopyable {
+    public:
+        local_http_server()
+        : fd_(::socket(AF_INET, SOCK_STREAM, 0))
+        {
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = 0;
+            socklen_t addr_len = sizeof(addr);
+
+            if ( fd_ == -1
+                || ::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+                || ::listen(fd_, 16) != 0
+                || ::getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &addr_len) != 0 )
+            {
+                throw std::runtime_error("local_http_server: failed to listen");
+            }
+
+            host_ = strings::rformat("127.0.0.1:%0", ntohs(addr.sin_port));
+            thread_ = std::thread([this](){ serve_(); });
+        }
+
+        ~local_http_server() noexcept {
+            stop();
+        }
+
+        void stop() noexcept {
+            if ( thread_.joinable() ) {
+                ::shutdown(fd_, SHUT_RDWR);
+                thread_.join();
+                ::close(fd_);
+            }
+        }
+
+        const str& host() const noexcept {
+            return host_;
+        }
+
+        void add_file(str path, str content, str etag) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            files_[std::move(path)] = std::make_pair(std::move(content), std::move(etag));
+        }
+
+        void response_delay(std::chrono::milliseconds delay) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            delay_ = delay;
+        }
+
+        std::size_t requests(str_view method) const {
+            std::lock_guard<std::mutex> guard(mutex_);
+            const auto iter = requests_.find(method);
+            return iter != requests_.end() ? iter->second : 0u;
+        }
+    private:
+        void serve_() {
+            vector<std::thread> workers;
+            while ( true ) {
+                const int client = ::accept(fd_, nullptr, nullptr);
+                if ( client == -1 ) {
+                    break;
+                }
+                workers.emplace_back([this, client](){
+                    handle_(client);
+                    ::close(client);
+                });
+            }
+            for ( std::thread& worker : workers ) {
+                worker.join();
+            }
+        }
+
+        void handle_(int client) {
+            str request;
+            char chunk[1024];
+            while ( request.find("\r\n\r\n") == str::npos ) {
+                const ssize_t len = ::recv(client, chunk, sizeof(chunk), 0);
+                if ( len <= 0 ) {
+                    return;
+                }
+                request.append(chunk, math::numeric_cast<std::size_t>(len));
+            }
+
+            const auto header = [&request](str_view name) -> str {
+                const str key = "\r\n" + str(name) + ": ";
+                const std::size_t first = request.find(key);
+                if ( first == str::npos ) {
+                    return str();
+                }
+                const std::size_t value = first + key.size();
+                return request.substr(value, request.find("\r\n", value) - value);
+            };
+
+            const str method = request.substr(0, request.find(' '));
+            const std::size_t path_first = method.size() + 1u;
+            const str path = request.substr(path_first, request.find(' ', path_first) - path_first);
+
+            std::pair<str, str> file;
+            bool found = false;
+            std::chrono::milliseconds delay;
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                ++requests_[method];
+                const auto iter = files_.find(path);
+                if ( iter != files_.end() ) {
+                    file = iter->second;
+                    found = true;
+                }
+                delay = delay_;
+            }
+            std::this_thread::sleep_for(delay);
+
+            str status = "200 OK";
+            str content = file.first;
+            str extra_headers;
+
+            const str range = header("Range");
+            const str if_range = header("If-Range");
+            std::size_t range_first = 0;
+            std::size_t range_last = 0;
+
+            if ( !found ) {
+                status = "404 Not Found";
+                content.clear();
+            } else if ( header("If-None-Match") == file.second ) {
+                status = "304 Not Modified";
+                content.clear();
+            } else if ( !range.empty()
+                && (if_range.empty() || if_range == file.second)
+                && std::sscanf(range.c_str(), "bytes=%zu-%zu", &range_first, &range_last) == 2
+                && range_first <= range_last
+                && range_last < content.size() )
+            {
+                status = "206 Partial Content";
+                extra_headers = strings::rformat("Content-Range: bytes %0-%1/%2\r\n",
+                    range_first, range_last, content.size());
+                content = content.substr(range_first, range_last - range_first + 1u);
+            }
+
+            str response = strings::rformat(
+                "HTTP/1.1 %0\r\n"
+                "Content-Length: %1\r\n"
+                "Accept-Ranges: bytes\r\n"
+                "Connection: close\r\n"
+                "%2",
+                status, content.size(), extra_headers);
+
+            if ( found ) {
+                response += "ETag: " + file.second + "\r\n";
+            }
+
+            response += "\r\n";
+            if ( method != "HEAD" ) {
+                response += content;
+            }
+
+            for ( std::size_t sent = 0; sent < response.size(); ) {
+                const ssize_t len = ::send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+                if ( len <= 0 ) {
+                    return;
+                }
+                sent += math::numeric_cast<std::size_t>(len);
+            }
+        }
+    private:
+        int fd_{-1};
+        str host_;
+        std::thread thread_;
+        mutable std::mutex mutex_;
+        flat_map<str, std::pair<str, str>> files_;
+        flat_map<str, std::size_t> requests_;
+        std::chrono::milliseconds delay_{0};
+    };
+#endif
+}
+
 TEST_CASE("vfs"){
     const str file_path = "vfs_file_name";
     const str nofile_path = "vfs_file_name2";
@@ -48,6 +253,36 @@ TEST_CASE("vfs"){
             REQUIRE(b3 == "hello");
         }
     }
+#if defined(E2D_PLATFORM) && E2D_PLATFORM == E2D_PLATFORM_LINUX
+    {
+        vfs v;
+        REQUIRE(v.register_scheme<filesystem_file_source>("file"));
+
+        vector<url> changes;
+        auto& listener = v.register_change_listener<change_counter>(changes);
+
+        REQUIRE(v.watch({"file", file_path}));
+        REQUIRE(v.watch({"file", file_path}));
+        REQUIRE_FALSE(v.watch({"file2", file_path}));
+
+        v.frame_tick();
+        REQUIRE(changes.empty());
+
+        REQUIRE(filesystem::try_write_all(buffer{"world", 5}, file_path, false));
+        REQUIRE(filesystem::try_write_all(buffer{"hello", 5}, file_path, false));
+        REQUIRE(filesystem::try_write_all(buffer{"hello", 5}, nofile_path, false));
+        REQUIRE(filesystem::remove_file(nofile_path));
+
+        v.frame_tick();
+        REQUIRE(changes.size() == 1u);
+        REQUIRE(changes[0] == url("file", file_path));
+
+        v.unregister_change_listener(listener);
+        REQUIRE(filesystem::try_write_all(buffer{"hello", 5}, file_path, false));
+        v.frame_tick();
+        REQUIRE(changes.size() == 1u);
+    }
+#endif
     {
         vfs v;
         v.register_scheme_alias("home", url("file://~"));
@@ -198,4 +433,128 @@ TEST_CASE("vfs"){
             }
         }
     }
+#if defined(E2D_PLATFORM) && E2D_PLATFORM == E2D_PLATFORM_LINUX
+    SECTION("http"){
+        const bool with_network = !modules::is_initialized<network>();
+        if ( with_network ) {
+            modules::initialize<network>();
+        }
+
+        const str cache_path = "vfs_http_cache";
+        filesystem::remove_directory(cache_path);
+
+        str atlas(600u * 1024u, '\0');
+        for ( std::size_t i = 0; i < atlas.size(); ++i ) {
+            atlas[i] = static_cast<char>(i % 251u);
+        }
+
+        local_http_server server;
+        server.add_file("/dlc/atlas.bin", atlas, "\"a1\"");
+        server.add_file("/dlc/small.txt", "hello", "\"s1\"");
+        server.add_file("/dlc/manifest.txt", "# dlc\natlas.bin\n\nsmall.txt\n", "\"m1\"");
+
+        const url atlas_url("http", server.host() + "/dlc/atlas.bin");
+        const url small_url("http", server.host() + "/dlc/small.txt");
+        const url manifest_url("http", server.host() + "/dlc/manifest.txt");
+        {
+            vfs v;
+            REQUIRE(v.register_scheme<http_file_source>("http", "http", cache_path));
+
+            REQUIRE(v.exists(atlas_url));
+            REQUIRE_FALSE(v.exists(url("http", server.host() + "/dlc/missing.bin")));
+            REQUIRE(v.read(url("http", server.host() + "/dlc/missing.bin")) == input_stream_uptr());
+            {
+                auto stream = v.read(atlas_url);
+                REQUIRE(stream);
+                REQUIRE(stream->length() == atlas.size());
+
+                char data[16] = {0};
+                REQUIRE(stream->seek(300000, false) == 300000u);
+                REQUIRE(stream->read(data, sizeof(data)) == sizeof(data));
+                REQUIRE(str_view(data, sizeof(data)) == str_view(atlas).substr(300000, sizeof(data)));
+                REQUIRE(server.requests("GET") == 1u);
+            }
+            {
+                auto content = v.load_as_string(atlas_url);
+                REQUIRE(content);
+                REQUIRE(*content == atlas);
+                REQUIRE(server.requests("GET") == 4u);
+            }
+            {
+                // cached and validated by the etag
+                auto content = v.load_as_string(atlas_url);
+                REQUIRE(content);
+                REQUIRE(*content == atlas);
+                REQUIRE(server.requests("GET") == 4u);
+            }
+            {
+                // readers of the cached data are not disturbed by its update
+                auto old_stream = v.read(atlas_url);
+                REQUIRE(old_stream);
+
+                server.add_file("/dlc/atlas.bin", "changed", "\"a2\"");
+                auto content = v.load_as_string(atlas_url);
+                REQUIRE(content);
+                REQUIRE(*content == "changed");
+
+                str old_content;
+                REQUIRE(streams::try_read_tail(old_content, old_stream));
+                REQUIRE(old_content == atlas);
+            }
+            {
+                vector<std::pair<str,bool>> cache_files;
+                REQUIRE(filesystem::extract_directory(cache_path, std::back_inserter(cache_files)));
+                REQUIRE(cache_files.size() == 2u);
+                for ( const auto& [name, directory] : cache_files ) {
+                    REQUIRE_FALSE(directory);
+                    REQUIRE(name.size() == 64u + 5u);
+                    REQUIRE((strings::ends_with(name, ".data") || strings::ends_with(name, ".meta")));
+                }
+            }
+            {
+                REQUIRE_NOTHROW(v.prefetch_async(manifest_url).get());
+                REQUIRE_THROWS_AS(
+                    v.prefetch_async(url("http", server.host() + "/dlc/missing.txt")).get(),
+                    vfs_load_async_exception);
+            }
+        }
+        {
+            http_file_source source("http", str());
+            server.response_delay(std::chrono::milliseconds(200));
+
+            const std::size_t heads = server.requests("HEAD");
+            std::atomic<std::size_t> found{0u};
+            vector<std::thread> readers;
+            for ( std::size_t i = 0; i < 4; ++i ) {
+                readers.emplace_back([&source, &small_url, &found](){
+                    if ( source.exists(small_url.path()) ) {
+                        ++found;
+                    }
+                });
+            }
+            for ( std::thread& reader : readers ) {
+                reader.join();
+            }
+            REQUIRE(found == 4u);
+            REQUIRE(server.requests("HEAD") - heads < 4u);
+            server.response_delay(std::chrono::milliseconds(0));
+        }
+        {
+            server.stop();
+
+            vfs v;
+            REQUIRE(v.register_scheme<http_file_source>("http", "http", cache_path));
+
+            auto content = v.load_as_string(small_url);
+            REQUIRE(content);
+            REQUIRE(*content == "hello");
+            REQUIRE_FALSE(v.exists(url("http", server.host() + "/dlc/missing.bin")));
+        }
+
+        filesystem::remove_directory(cache_path);
+        if ( with_network ) {
+            modules::shutdown<network>();
+        }
+    }
+#endif
 }
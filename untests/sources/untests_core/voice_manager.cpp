@@ -0,0 +1,231 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_core.hpp"
+using namespace e2d;
+
+namespace
+{
+    class safe_engine_initializer final : private noncopyable {
+    public:
+        safe_engine_initializer() {
+            modules::initialize<engine>(0, nullptr,
+                engine::parameters("voice_manager_untests", "enduro2d"));
+        }
+
+        ~safe_engine_initializer() noexcept {
+            modules::shutdown<engine>();
+        }
+    };
+
+    // 16 bit mono silence
+    buffer make_silent_wav(u32 sample_rate, u32 frames) {
+        const u32 data_size = frames * 2u;
+        buffer data(44u + data_size);
+        u8* p = data.data();
+
+        const auto put_u16 = [&p](u16 v){
+            *p++ = static_cast<u8>(v);
+            *p++ = static_cast<u8>(v >> 8u);
+        };
+        const auto put_u32 = [&put_u16](u32 v){
+            put_u16(static_cast<u16>(v));
+            put_u16(static_cast<u16>(v >> 16u));
+        };
+        const auto put_tag = [&p](const char* tag){
+            std::memcpy(p, tag, 4u);
+            p += 4u;
+        };
+
+        put_tag("RIFF"); put_u32(36u + data_size); put_tag("WAVE");
+        put_tag("fmt "); put_u32(16u);
+        put_u16(1u); put_u16(1u);
+        put_u32(sample_rate); put_u32(sample_rate * 2u);
+        put_u16(2u); put_u16(16u);
+        put_tag("data"); put_u32(data_size);
+        std::memset(p, 0, data_size);
+        return data;
+    }
+
+    sound_voice_ptr play_voice(
+        voice_manager& vm,
+        const sound_stream_ptr& stream,
+        str_hash category = str_hash(),
+        i32 priority = 0)
+    {
+        sound_voice_ptr v = vm.create_voice(stream, category, priority);
+        v->play();
+        return v;
+    }
+}
+
+TEST_CASE("voice_manager") {
+    safe_engine_initializer initializer;
+    if ( !modules::is_initialized<voice_manager>() ) {
+        return;
+    }
+
+    voice_manager& vm = the<voice_manager>();
+
+    // two seconds of silence
+    const sound_stream_ptr stream = the<audio>().create_stream(make_silent_wav(8000u, 16000u));
+    if ( !stream ) {
+        // the backend has no device to create streams
+        return;
+    }
+    REQUIRE(stream->duration() == Approx(2.f));
+
+    SECTION("ranking") {
+        sound_voice_ptr low = play_voice(vm, stream, "sfx", 0);
+        sound_voice_ptr high = play_voice(vm, stream, "sfx", 10);
+        sound_voice_ptr loud = play_voice(vm, stream, "sfx", 0);
+        low->volume(0.5f);
+        high->volume(0.1f);
+
+        vm.max_real_voices(2u);
+        vm.frame_tick(0.f);
+
+        // priority goes first, then audibility
+        REQUIRE(high->audible());
+        REQUIRE(loud->audible());
+        REQUIRE_FALSE(low->audible());
+        REQUIRE(low->is_virtual());
+        REQUIRE(low->audibility() == Approx(0.5f));
+        REQUIRE(high->audibility() == Approx(0.1f));
+
+        REQUIRE(vm.stats().voices == 3u);
+        REQUIRE(vm.stats().audible_voices == 2u);
+        REQUIRE(vm.stats().real_voices + vm.stats().virtual_voices == 3u);
+
+        // voices below the threshold give their slots away
+        loud->volume(0.f);
+        vm.frame_tick(0.f);
+        REQUIRE(high->audible());
+        REQUIRE(low->audible());
+        REQUIRE_FALSE(loud->audible());
+        REQUIRE(loud->is_virtual());
+
+        // paused voices are not ranked at all
+        high->pause();
+        loud->volume(1.f);
+        vm.frame_tick(0.f);
+        REQUIRE_FALSE(high->audible());
+        REQUIRE_FALSE(high->is_virtual());
+        REQUIRE(low->audible());
+        REQUIRE(loud->audible());
+    }
+    SECTION("category_caps") {
+        vm.register_category("music", voice_manager::category()
+            .max_voices(1u));
+        vm.register_category("steps", voice_manager::category()
+            .volume(0.5f)
+            .max_distance(100.f));
+
+        sound_voice_ptr music1 = play_voice(vm, stream, "music", 1);
+        sound_voice_ptr music2 = play_voice(vm, stream, "music", 2);
+        sound_voice_ptr near_step = play_voice(vm, stream, "steps");
+        sound_voice_ptr far_step = play_voice(vm, stream, "steps");
+        sound_voice_ptr sfx = play_voice(vm, stream);
+        near_step->distance(50.f);
+        far_step->distance(150.f);
+
+        vm.frame_tick(0.f);
+
+        REQUIRE(music2->audible());
+        REQUIRE_FALSE(music1->audible());
+
+        REQUIRE(near_step->audible());
+        REQUIRE(near_step->audibility() == Approx(0.25f));
+        REQUIRE_FALSE(far_step->audible());
+        REQUIRE(far_step->audibility() == Approx(0.f));
+
+        REQUIRE(sfx->audible());
+        REQUIRE(vm.find_category(str_hash()).max_voices() == 16u);
+        REQUIRE(vm.stats().audible_voices == 3u);
+
+        // a freed category slot goes to the next voice of the category
+        music2->stop();
+        vm.frame_tick(0.f);
+        REQUIRE(music1->audible());
+        REQUIRE_FALSE(music2->audible());
+    }
+    SECTION("max_real_voices") {
+        vector<sound_voice_ptr> voices;
+        for ( i32 i = 0; i < 5; ++i ) {
+            voices.push_back(play_voice(vm, stream, str_hash(), i));
+        }
+
+        vm.max_real_voices(3u);
+        vm.frame_tick(0.f);
+        REQUIRE(vm.stats().audible_voices == 3u);
+        REQUIRE_FALSE(voices[0]->audible());
+        REQUIRE_FALSE(voices[1]->audible());
+        REQUIRE(voices[2]->audible());
+        REQUIRE(voices[3]->audible());
+        REQUIRE(voices[4]->audible());
+
+        vm.max_real_voices(0u);
+        vm.frame_tick(0.f);
+        REQUIRE(vm.stats().audible_voices == 0u);
+        REQUIRE(vm.stats().real_voices == 0u);
+        REQUIRE(vm.stats().virtual_voices == 5u);
+        for ( const sound_voice_ptr& v : voices ) {
+            REQUIRE(v->is_virtual());
+        }
+    }
+    SECTION("virtual_time") {
+        // muted voices stay virtual, so only their time is tracked
+        sound_voice_ptr once = play_voice(vm, stream);
+        sound_voice_ptr looped = play_voice(vm, stream);
+        once->volume(0.f);
+        looped->volume(0.f);
+        looped->looping(true);
+
+        vm.frame_tick(0.5f);
+        REQUIRE(once->is_virtual());
+        REQUIRE(once->position() == Approx(0.5f));
+        REQUIRE(looped->position() == Approx(0.5f));
+
+        vm.frame_tick(1.f);
+        REQUIRE(once->position() == Approx(1.5f));
+        REQUIRE(once->playing());
+
+        vm.frame_tick(1.f);
+        REQUIRE_FALSE(once->playing());
+        REQUIRE(once->state() == sound_voice::states::stopped);
+        REQUIRE(once->position() == Approx(0.f));
+        REQUIRE(looped->playing());
+        REQUIRE(looped->position() == Approx(0.5f));
+
+        // paused voices keep their time
+        looped->pause();
+        vm.frame_tick(1.f);
+        REQUIRE(looped->position() == Approx(0.5f));
+        looped->resume();
+        vm.frame_tick(0.25f);
+        REQUIRE(looped->position() == Approx(0.75f));
+    }
+    SECTION("dropped_voices") {
+        {
+            sound_voice_ptr once = play_voice(vm, stream);
+            sound_voice_ptr looped = play_voice(vm, stream);
+            once->volume(0.f);
+            looped->volume(0.f);
+            looped->looping(true);
+            vm.frame_tick(0.f);
+            REQUIRE(vm.stats().voices == 2u);
+        }
+
+        // looping voices without handles would play forever
+        vm.frame_tick(1.f);
+        REQUIRE(vm.stats().voices == 1u);
+
+        // one-shot voices play to the end
+        vm.frame_tick(1.5f);
+        vm.frame_tick(0.f);
+        REQUIRE(vm.stats().voices == 0u);
+    }
+}
@@ -86,4 +86,40 @@ TEST_CASE("asset") {
             REQUIRE_FALSE(l.load_asset<fake_asset, fake_nested_asset>("42:/21:/none:/2"));
         }
     }
+    SECTION("json_asset_validation") {
+        rapidjson::Document schema_doc;
+        REQUIRE_FALSE(schema_doc.Parse(R"json({
+            "type" : "object",
+            "required" : [ "name" ],
+            "properties" : {
+                "name" : { "type" : "string" }
+            }
+        })json").HasParseError());
+        const rapidjson::SchemaDocument schema(schema_doc);
+
+        const str valid_source = R"json({ "name" : "hello" })json";
+        const str invalid_source = R"json({ "name" : 42 })json";
+
+        auto valid = json_asset::create(
+            json_utils::parse_insitu(valid_source),
+            digests::sha256(valid_source));
+        REQUIRE(valid->content_digest() == digests::sha256(valid_source));
+        REQUIRE(valid->validate(schema, "valid.json"));
+
+        auto invalid = json_asset::create(
+            json_utils::parse_insitu(invalid_source),
+            digests::sha256(invalid_source));
+        REQUIRE_FALSE(invalid->validate(schema, "invalid.json"));
+        REQUIRE_FALSE(invalid->validate(schema, "invalid.json"));
+
+        auto unhashed = json_asset::create(
+            json_utils::parse_insitu(valid_source));
+        REQUIRE_FALSE(unhashed->content_digest());
+        REQUIRE(unhashed->validate(schema, "unhashed.json"));
+
+        auto reloaded = json_asset::create(
+            json_utils::parse_insitu(valid_source),
+            digests::sha256(valid_source));
+        REQUIRE(reloaded->validate(schema, "reloaded.json"));
+    }
 }
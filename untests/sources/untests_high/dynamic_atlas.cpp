@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    class safe_starter_initializer final : private noncopyable {
+    public:
+        safe_starter_initializer() {
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters("dynamic_atlas_untests", "enduro2d")));
+        }
+
+        ~safe_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+
+    image make_image(const v2u& size, image_data_format format = image_data_format::rgba8) {
+        const std::size_t bpp = format == image_data_format::rgba8 ? 4u : 3u;
+        return image(size, format, buffer(std::size_t(size.x) * size.y * bpp));
+    }
+}
+
+TEST_CASE("dynamic_atlas") {
+    safe_starter_initializer initializer;
+    if ( !modules::is_initialized<render>() ) {
+        return;
+    }
+
+    modules::shutdown<dynamic_atlas>();
+    modules::initialize<dynamic_atlas>(dynamic_atlas::parameters()
+        .page_size(v2u(64u,64u))
+        .max_pages(1u)
+        .max_image_size(v2u(32u,32u))
+        .padding(0u));
+    dynamic_atlas& a = the<dynamic_atlas>();
+    {
+        REQUIRE_FALSE(a.is_suitable(image()));
+        REQUIRE_FALSE(a.is_suitable(make_image(v2u(33u,8u))));
+        REQUIRE(a.is_suitable(make_image(v2u(32u,32u))));
+        REQUIRE(a.is_suitable(make_image(v2u(8u,8u), image_data_format::rgb8)));
+    }
+    {
+        sprite s1, s2, s3;
+        REQUIRE(a.try_insert(make_hash("image1"), make_image(v2u(32u,32u)), s1));
+        REQUIRE(a.try_insert(make_hash("image2"), make_image(v2u(16u,16u), image_data_format::rgb8),
+            b2f(2.f,2.f,4.f,4.f), b2f(0.f,0.f,16.f,16.f), s2));
+        REQUIRE(s1.texture());
+        REQUIRE(s1.texture() == s2.texture());
+        REQUIRE(s1.outer_texrect().size == v2f(32.f,32.f));
+        REQUIRE(s2.outer_texrect().size == v2f(16.f,16.f));
+        REQUIRE(s2.inner_texrect().position == s2.outer_texrect().position + v2f(2.f,2.f));
+
+        REQUIRE(a.find(make_hash("image1"), s3));
+        REQUIRE(s3 == s1);
+        REQUIRE(a.stats().pages == 1u);
+        REQUIRE(a.stats().images == 2u);
+
+        sprite s4;
+        REQUIRE(a.try_insert(make_hash("image1"), make_image(v2u(32u,32u)), s4));
+        REQUIRE(s4 == s1);
+        REQUIRE(a.stats().images == 2u);
+
+        REQUIRE(a.try_insert(make_hash("image3"), make_image(v2u(32u,32u)), s4));
+        REQUIRE(a.try_insert(make_hash("image4"), make_image(v2u(32u,32u)), s4));
+        sprite s5;
+        REQUIRE_FALSE(a.try_insert(make_hash("image5"), make_image(v2u(32u,32u)), s5));
+        REQUIRE(a.stats().rejections == 1u);
+        REQUIRE(a.stats().evictions == 0u);
+    }
+    {
+        sprite s;
+        REQUIRE(a.try_insert(make_hash("image5"), make_image(v2u(32u,32u)), s));
+        REQUIRE(a.stats().evictions == 1u);
+        REQUIRE(a.stats().images == 1u);
+        REQUIRE_FALSE(a.find(make_hash("image1"), s));
+        REQUIRE(a.find(make_hash("image5"), s));
+    }
+    modules::shutdown<dynamic_atlas>();
+    modules::initialize<dynamic_atlas>(dynamic_atlas::parameters()
+        .page_size(v2u(64u,64u))
+        .max_pages(1u)
+        .max_image_size(v2u(64u,64u))
+        .padding(2u));
+    {
+        dynamic_atlas& pa = the<dynamic_atlas>();
+        REQUIRE(pa.is_suitable(make_image(v2u(60u,8u))));
+        REQUIRE_FALSE(pa.is_suitable(make_image(v2u(61u,8u))));
+        REQUIRE_FALSE(pa.is_suitable(make_image(v2u(8u,61u))));
+
+        sprite s1, s2, s3;
+        REQUIRE(pa.try_insert(make_hash("image1"), make_image(v2u(28u,28u)), s1));
+        REQUIRE(pa.try_insert(make_hash("image2"), make_image(v2u(28u,28u), image_data_format::rgb8), s2));
+        REQUIRE(s1.outer_texrect() == b2f(2.f,2.f,28.f,28.f));
+        REQUIRE(s2.outer_texrect().size == v2f(28.f,28.f));
+
+        // extruded borders of the neighbours don't overlap
+        const v2f delta = s2.outer_texrect().position - s1.outer_texrect().position;
+        REQUIRE((math::abs(delta.x) >= 32.f || math::abs(delta.y) >= 32.f));
+
+        REQUIRE(pa.find(make_hash("image2"), s3));
+        REQUIRE(s3 == s2);
+        REQUIRE(pa.stats().images == 2u);
+    }
+    modules::shutdown<dynamic_atlas>();
+}
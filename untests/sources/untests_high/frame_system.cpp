@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    class safe_starter_initializer final : private noncopyable {
+    public:
+        safe_starter_initializer() {
+            // 25ms frames with 10ms ticks
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters("frame_system_untests", "enduro2d")
+                        .timer_params(engine::timer_parameters()
+                            .deterministic(true)
+                            .maximal_framerate(40u)
+                            .fixed_update_rate(100u))));
+        }
+
+        ~safe_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+
+    struct frame_records {
+        vector<systems::update_event> updates;
+        vector<f32> rendered_x;
+    };
+
+    // moves the node by one unit per tick
+    class mover_system final : public systems::update_system {
+    public:
+        mover_system(frame_records& records, node_iptr node)
+        : records_(records)
+        , node_(std::move(node)) {}
+
+        void process(
+            ecs::registry& owner,
+            const systems::update_event& event) override
+        {
+            E2D_UNUSED(owner);
+            records_.updates.push_back(event);
+            node_->translation(node_->translation() + v2f(1.f, 0.f));
+        }
+    private:
+        frame_records& records_;
+        node_iptr node_;
+    };
+
+    class observer_system final : public systems::render_system {
+    public:
+        observer_system(frame_records& records, node_iptr node)
+        : records_(records)
+        , node_(std::move(node)) {}
+
+        void process(
+            ecs::registry& owner,
+            const systems::render_event& event) override
+        {
+            E2D_UNUSED(owner, event);
+            records_.rendered_x.push_back(node_->translation().x);
+        }
+    private:
+        frame_records& records_;
+        node_iptr node_;
+    };
+
+    class game final : public starter::application {
+    public:
+        game(frame_records& records, std::size_t frame_count)
+        : records_(records)
+        , frame_count_(frame_count) {}
+
+        bool initialize() final {
+            world& w = the<world>();
+
+            gobject camera_i = w.instantiate();
+            camera_i.component<camera>().assign();
+
+            gobject mover_i = w.instantiate();
+            const node_iptr& mover_n = mover_i.component<actor>()->node();
+
+            ecs::registry_filler(w.registry())
+            .feature<struct frame_system_untests_feature>(ecs::feature()
+                .add_system<mover_system>(records_, mover_n)
+                .add_system<observer_system>(records_, mover_n));
+
+            mover_ = mover_n;
+            the<window>().set_should_close(true);
+            return true;
+        }
+
+        bool on_should_close() final {
+            return ++frames_ >= frame_count_;
+        }
+
+        const node_iptr& mover() const noexcept {
+            return mover_;
+        }
+    private:
+        frame_records& records_;
+        std::size_t frame_count_{0u};
+        std::size_t frames_{0u};
+        node_iptr mover_;
+    };
+}
+
+TEST_CASE("frame_system") {
+    safe_starter_initializer initializer;
+
+    frame_records records;
+    node_iptr mover;
+    {
+        auto app = std::make_unique<game>(records, 4u);
+        game& app_ref = *app;
+        REQUIRE(the<starter>().start(std::move(app)));
+        mover = app_ref.mover();
+    }
+
+    SECTION("ticks") {
+        // frames run 1, 2, 3 and 2 ticks, the rest of the time is the alpha
+        const u32 ticks[] = {0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u};
+        const f32 alphas[] = {1.f, 0.5f, 0.5f, 0.f, 0.f, 0.f, 0.5f, 0.5f};
+        REQUIRE(records.updates.size() == std::size(ticks));
+        for ( std::size_t i = 0; i < records.updates.size(); ++i ) {
+            const systems::update_event& evt = records.updates[i];
+            REQUIRE(evt.tick == ticks[i]);
+            REQUIRE(math::approximately(evt.alpha, alphas[i]));
+            REQUIRE(math::approximately(evt.dt, 0.01f));
+            REQUIRE(math::approximately(evt.time, 0.01f * f32(ticks[i] + 1u)));
+        }
+    }
+    SECTION("interpolation") {
+        REQUIRE(mover);
+        REQUIRE(math::approximately(mover->translation().x, 8.f));
+
+        if ( the<window>().enabled() ) {
+            // frames are rendered between the last two simulated states,
+            // the last frame is closed before rendering
+            const f32 rendered_x[] = {1.f, 2.5f, 5.f};
+            REQUIRE(records.rendered_x.size() == std::size(rendered_x));
+            for ( std::size_t i = 0; i < records.rendered_x.size(); ++i ) {
+                REQUIRE(math::approximately(records.rendered_x[i], rendered_x[i]));
+            }
+        }
+    }
+}
@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    class safe_starter_initializer final : private noncopyable {
+    public:
+        safe_starter_initializer() {
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters("layout_untests", "enduro2d")));
+        }
+
+        ~safe_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+
+    gobject make_layout(world& w, const node_iptr& parent, const v2f& size) {
+        gobject inst = w.instantiate(parent);
+        inst.component<widget>().assign().size(size);
+        inst.component<layout>().assign()
+            .flex_direction(layout::flex_directions::row);
+        return inst;
+    }
+
+    gobject make_item(world& w, const node_iptr& parent, const v2f& size) {
+        gobject inst = w.instantiate(parent);
+        inst.component<widget>().assign().size(size);
+        return inst;
+    }
+
+    v2f translation_of(const gobject& inst) {
+        return inst.component<actor>()->node()->translation();
+    }
+}
+
+TEST_CASE("layout") {
+    safe_starter_initializer initializer;
+    world& w = the<world>();
+
+    const auto update = [&w](){
+        w.registry().process_event(systems::update_event{0.f});
+    };
+
+    // changed widgets mark their layouts in the same update phase,
+    // so the layouts may pick them up only in the next update
+    const auto update_changed = [&update](){
+        update();
+        update();
+    };
+
+    SECTION("incremental_tree") {
+        gobject root = make_layout(w, nullptr, v2f(100.f, 100.f));
+        const node_iptr& root_n = root.component<actor>()->node();
+
+        gobject item1 = make_item(w, root_n, v2f(10.f, 10.f));
+        gobject item2 = make_item(w, root_n, v2f(20.f, 10.f));
+        gobject item3 = make_item(w, root_n, v2f(30.f, 10.f));
+
+        update();
+        REQUIRE(translation_of(item1) == v2f(0.f, 0.f));
+        REQUIRE(translation_of(item2) == v2f(10.f, 0.f));
+        REQUIRE(translation_of(item3) == v2f(30.f, 0.f));
+        REQUIRE_FALSE(layouts::is_dirty(root.component<layout>()));
+
+        // resizing an item relayouts its siblings
+        widgets::change_size(item1.component<widget>(), v2f(15.f, 10.f));
+        update_changed();
+        REQUIRE(translation_of(item2) == v2f(15.f, 0.f));
+        REQUIRE(translation_of(item3) == v2f(35.f, 0.f));
+
+        // removed items leave the yoga tree
+        w.destroy_instance(item2);
+        w.finalize_instances();
+        update();
+        REQUIRE(translation_of(item1) == v2f(0.f, 0.f));
+        REQUIRE(translation_of(item3) == v2f(15.f, 0.f));
+
+        // added items are inserted in the order of the scene graph
+        gobject item4 = w.instantiate();
+        item4.component<widget>().assign().size(v2f(5.f, 10.f));
+        REQUIRE(root_n->add_child_to_back(item4.component<actor>()->node()));
+        update();
+        REQUIRE(translation_of(item4) == v2f(0.f, 0.f));
+        REQUIRE(translation_of(item1) == v2f(5.f, 0.f));
+        REQUIRE(translation_of(item3) == v2f(20.f, 0.f));
+
+        // disabled widgets are detached as well
+        item1.component<disabled<widget>>().assign();
+        update();
+        REQUIRE(translation_of(item4) == v2f(0.f, 0.f));
+        REQUIRE(translation_of(item3) == v2f(5.f, 0.f));
+
+        w.destroy_instance(root);
+        w.finalize_instances();
+    }
+    SECTION("outermost_first") {
+        gobject outer = make_layout(w, nullptr, v2f(200.f, 100.f));
+        const node_iptr& outer_n = outer.component<actor>()->node();
+
+        gobject spacer = make_item(w, outer_n, v2f(40.f, 10.f));
+
+        // the inner layout is created detached, so it comes first in the registry
+        gobject inner = w.instantiate();
+        inner.component<widget>().assign().size(v2f(50.f, 50.f));
+        inner.component<layout>().assign()
+            .flex_direction(layout::flex_directions::column);
+        const node_iptr& inner_n = inner.component<actor>()->node();
+
+        gobject inner_item1 = make_item(w, inner_n, v2f(10.f, 10.f));
+        gobject inner_item2 = make_item(w, inner_n, v2f(10.f, 20.f));
+
+        REQUIRE(outer_n->add_child(inner_n));
+
+        // one update settles the whole tree
+        update();
+        REQUIRE(translation_of(spacer) == v2f(0.f, 0.f));
+        REQUIRE(translation_of(inner) == v2f(40.f, 0.f));
+        REQUIRE(translation_of(inner_item1) == v2f(0.f, 0.f));
+        REQUIRE(translation_of(inner_item2) == v2f(0.f, 10.f));
+        REQUIRE_FALSE(layouts::is_dirty(outer.component<layout>()));
+        REQUIRE_FALSE(layouts::is_dirty(inner.component<layout>()));
+
+        // a change of the outer layout moves the inner one only
+        widgets::change_size(spacer.component<widget>(), v2f(60.f, 10.f));
+        update_changed();
+        REQUIRE(translation_of(inner) == v2f(60.f, 0.f));
+        REQUIRE(translation_of(inner_item1) == v2f(0.f, 0.f));
+        REQUIRE(translation_of(inner_item2) == v2f(0.f, 10.f));
+
+        w.destroy_instance(outer);
+        w.finalize_instances();
+    }
+    SECTION("clean_root_skip") {
+        gobject root = make_layout(w, nullptr, v2f(100.f, 100.f));
+        const node_iptr& root_n = root.component<actor>()->node();
+
+        gobject item1 = make_item(w, root_n, v2f(10.f, 10.f));
+        gobject item2 = make_item(w, root_n, v2f(10.f, 10.f));
+
+        update();
+        REQUIRE(translation_of(item2) == v2f(10.f, 0.f));
+
+        // clean roots are not recalculated, so manual moves survive
+        item2.component<actor>()->node()->translation(v2f(50.f, 50.f));
+        update();
+        REQUIRE(translation_of(item2) == v2f(50.f, 50.f));
+
+        // explicitly marked roots place their children again,
+        // even when yoga itself has nothing to recalculate
+        layouts::mark_dirty(root.component<layout>());
+        update();
+        REQUIRE(translation_of(item1) == v2f(0.f, 0.f));
+        REQUIRE(translation_of(item2) == v2f(10.f, 0.f));
+        REQUIRE_FALSE(layouts::is_dirty(root.component<layout>()));
+
+        w.destroy_instance(root);
+        w.finalize_instances();
+    }
+}
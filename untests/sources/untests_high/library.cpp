@@ -11,10 +11,12 @@ namespace
 {
     class safe_starter_initializer final : private noncopyable {
     public:
-        safe_starter_initializer() {
+        safe_starter_initializer(bool hot_reload = false) {
             modules::initialize<starter>(0, nullptr,
                 starter::parameters(
-                    engine::parameters("library_untests", "enduro2d")));
+                    engine::parameters("library_untests", "enduro2d"))
+                .library_params(starter::library_parameters()
+                    .hot_reload(hot_reload)));
         }
 
         ~safe_starter_initializer() noexcept {
@@ -42,6 +44,70 @@ namespace
             });
         }
     };
+
+    class gated_asset final : public content_asset<gated_asset, str> {
+    public:
+        static const char* type_name() noexcept { return "gated_asset"; }
+        static load_async_result load_async(const library& library, str_view address) {
+            E2D_UNUSED(library);
+            load_async_result p;
+            loads().emplace_back(address, p);
+            return p;
+        }
+
+        static vector<std::pair<str, load_async_result>>& loads() {
+            static vector<std::pair<str, load_async_result>> loads;
+            return loads;
+        }
+
+        static void resolve(str_view address) {
+            // resolving can start queued loadings and grow the list
+            for ( std::size_t i = 0; i < loads().size(); ++i ) {
+                if ( loads()[i].first == address ) {
+                    load_async_result p = loads()[i].second;
+                    p.resolve(create(str(address)));
+                }
+            }
+        }
+    };
+
+    class gated_user_asset final : public content_asset<gated_user_asset, str> {
+    public:
+        static const char* type_name() noexcept { return "gated_user_asset"; }
+        static load_async_result load_async(const library& library, str_view address) {
+            E2D_UNUSED(address);
+            return library.load_asset_async<gated_asset>("dependency")
+            .then([](const gated_asset::load_result& dependency){
+                return gated_user_asset::create(dependency->content());
+            });
+        }
+    };
+
+    std::atomic<int> counter_asset_loads{0};
+
+    class counter_asset final : public content_asset<counter_asset, int> {
+    public:
+        static const char* type_name() noexcept { return "counter_asset"; }
+        static load_async_result load_async(const library& library, str_view address) {
+            E2D_UNUSED(library, address);
+            return stdex::make_resolved_promise(counter_asset::create(++counter_asset_loads));
+        }
+    };
+
+    class counter_user_asset final : public content_asset<counter_user_asset, int> {
+    public:
+        static const char* type_name() noexcept { return "counter_user_asset"; }
+        static load_async_result load_async(const library& library, str_view address) {
+            E2D_UNUSED(address);
+            return the<deferrer>().do_in_worker_thread([](){})
+            .then([&library](){
+                return library.load_asset_async<counter_asset>("counter");
+            })
+            .then([](const counter_asset::load_result& counter){
+                return counter_user_asset::create(counter->content() * 10);
+            });
+        }
+    };
 }
 
 TEST_CASE("library"){
@@ -409,3 +475,122 @@ TEST_CASE("asset_dependencies") {
         }
     }
 }
+
+TEST_CASE("library_hot_reload") {
+    safe_starter_initializer initializer(true);
+    library& l = the<library>();
+
+    const auto wait_all_loading_assets = [&l](){
+        while ( l.loading_asset_count() > 0 ) {
+            the<deferrer>().frame_tick();
+            std::this_thread::yield();
+        }
+    };
+
+    counter_asset_loads = 0;
+    auto user = l.load_asset<counter_user_asset>("user");
+    auto counter = l.load_asset<counter_asset>("counter");
+    REQUIRE(user);
+    REQUIRE(counter);
+    REQUIRE(user->content() == 10);
+    REQUIRE(counter->content() == 1);
+    {
+        REQUIRE(1u == l.reload_assets("user"));
+        wait_all_loading_assets();
+        REQUIRE(user->content() == 10);
+        REQUIRE(counter->content() == 1);
+    }
+    {
+        REQUIRE(2u == l.reload_assets("counter"));
+        wait_all_loading_assets();
+        REQUIRE(user->content() == 20);
+        REQUIRE(counter->content() == 2);
+        REQUIRE(l.load_asset<counter_user_asset>("user") == user);
+        REQUIRE(l.load_asset<counter_asset>("counter") == counter);
+    }
+    {
+        REQUIRE(0u == l.reload_assets("none"));
+    }
+}
+
+TEST_CASE("library_loading_queue") {
+    safe_starter_initializer initializer;
+    library& l = the<library>();
+    gated_asset::loads().clear();
+
+    const auto rejected = [](const auto& p){
+        the<deferrer>().active_safe_wait_promise(p);
+        try {
+            p.get();
+        } catch ( const library_cancelled_exception& ) {
+            return true;
+        } catch (...) {
+        }
+        return false;
+    };
+
+    REQUIRE(l.max_loading_assets<gated_asset>() == 0u);
+    l.max_loading_assets<gated_asset>(1u);
+    REQUIRE(l.max_loading_assets<gated_asset>() == 1u);
+    {
+        auto tb = make_intrusive<loading_token>(1);
+        auto tc = make_intrusive<loading_token>(5);
+        auto td = make_intrusive<loading_token>(1);
+
+        auto pa = l.load_asset_async<gated_asset>("a");
+        auto pb = l.load_asset_async<gated_asset>("b", tb);
+        auto pc = l.load_asset_async<gated_asset>("c", tc);
+        auto pd = l.load_asset_async<gated_asset>("d", td);
+        auto pd2 = l.load_asset_async<gated_asset>("d");
+
+        REQUIRE(l.loading_asset_count() == 4u);
+        REQUIRE(gated_asset::loads().size() == 1u);
+        REQUIRE(gated_asset::loads().back().first == "a");
+
+        td->priority(10);
+        gated_asset::resolve("a");
+        REQUIRE(pa.get()->content() == "a");
+        REQUIRE(gated_asset::loads().size() == 2u);
+        REQUIRE(gated_asset::loads().back().first == "d");
+
+        tc->cancel();
+        l.frame_tick();
+        REQUIRE(rejected(pc));
+        REQUIRE(l.loading_asset_count() == 2u);
+
+        // other requesters keep the loading alive
+        td->cancel();
+        l.frame_tick();
+        REQUIRE(l.loading_asset_count() == 2u);
+
+        gated_asset::resolve("d");
+        REQUIRE(pd.get()->content() == "d");
+        REQUIRE(pd2.get()->content() == "d");
+        REQUIRE(gated_asset::loads().size() == 3u);
+        REQUIRE(gated_asset::loads().back().first == "b");
+
+        gated_asset::resolve("b");
+        REQUIRE(pb.get()->content() == "b");
+        REQUIRE(l.loading_asset_count() == 0u);
+    }
+    {
+        // dependencies are not queued and are cancelled with their dependents
+        auto pa = l.load_asset_async<gated_asset>("e");
+        REQUIRE(gated_asset::loads().back().first == "e");
+
+        auto tu = make_intrusive<loading_token>();
+        auto pu = l.load_asset_async<gated_user_asset>("user", tu);
+        REQUIRE(gated_asset::loads().back().first == "dependency");
+        REQUIRE(l.loading_asset_count() == 3u);
+
+        tu->cancel();
+        l.frame_tick();
+        REQUIRE(rejected(pu));
+        REQUIRE(l.loading_asset_count() == 1u);
+
+        gated_asset::resolve("dependency");
+        gated_asset::resolve("e");
+        REQUIRE(pa.get()->content() == "e");
+        REQUIRE(l.loading_asset_count() == 0u);
+    }
+}
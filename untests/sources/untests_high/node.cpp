@@ -923,4 +923,32 @@ TEST_CASE("node") {
             REQUIRE(fake_node::s_dtor_count == 2);
         }
     }
+    SECTION("hierarchy_version") {
+        auto p = node::create();
+        auto n1 = node::create();
+        auto n2 = node::create();
+
+        u32 version = node::hierarchy_version();
+
+        REQUIRE(p->add_child(n1));
+        REQUIRE(p->add_child(n2));
+        REQUIRE(node::hierarchy_version() != version);
+        version = node::hierarchy_version();
+
+        REQUIRE(p->add_child(n2)); // already last
+        REQUIRE_FALSE(p->add_child(node_iptr()));
+        n1->translation(v2f(1.f, 2.f));
+        REQUIRE(node::hierarchy_version() == version);
+
+        REQUIRE(p->swap_children(n1, n2));
+        REQUIRE(node::hierarchy_version() != version);
+        version = node::hierarchy_version();
+
+        REQUIRE(n1->remove_from_parent());
+        REQUIRE(node::hierarchy_version() != version);
+        version = node::hierarchy_version();
+
+        REQUIRE_FALSE(n1->remove_from_parent());
+        REQUIRE(node::hierarchy_version() == version);
+    }
 }
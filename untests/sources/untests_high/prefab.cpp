@@ -191,4 +191,34 @@ TEST_CASE("prefab"){
             REQUIRE(child3_node->child_count() == 0u);
         }
     }
+
+    {
+        // large enough to be parsed by several worker jobs
+        auto prefab_large_res = l.load_asset<prefab_asset>("prefab_large.json");
+        REQUIRE(prefab_large_res);
+
+        const prefab& prefab_large = prefab_large_res->content();
+        REQUIRE(prefab_large.children().size() == 2u);
+        REQUIRE(prefab_large.children()[0].children().size() == 260u);
+        REQUIRE(prefab_large.children()[1].children().size() == 260u);
+
+        auto go = the<world>().instantiate(prefab_large);
+        REQUIRE(go.component<named>());
+        REQUIRE(go.component<named>()->name() == "large");
+
+        const_node_iptr go_node = go.component<actor>()->node();
+        REQUIRE(go_node->child_count() == 2u);
+
+        for ( std::size_t g = 0; g < go_node->child_count(); ++g ) {
+            const_node_iptr group_node = go_node->child_at(g);
+            gobject group_go = group_node->owner();
+            REQUIRE(group_go.component<named>()->name() == strings::rformat("group_%0", g));
+            REQUIRE(group_node->child_count() == 260u);
+
+            for ( std::size_t i = 0; i < group_node->child_count(); ++i ) {
+                gobject child_go = group_node->child_at(i)->owner();
+                REQUIRE(child_go.component<named>()->name() == strings::rformat("node_%0_%1", g, i));
+            }
+        }
+    }
 }
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    class safe_starter_initializer final : private noncopyable {
+    public:
+        safe_starter_initializer() {
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters("render_system_untests", "enduro2d")));
+        }
+
+        ~safe_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+
+    material_asset::ptr make_material(bool instanced) {
+        const str_view vertex_source = instanced
+            ? "attribute vec3 a_position;\n"
+              "attribute mat4 a_matrix_m;\n"
+              "void main(){ gl_Position = a_matrix_m * vec4(a_position, 1.0); }"
+            : "attribute vec3 a_position;\n"
+              "uniform mat4 u_matrix_m;\n"
+              "void main(){ gl_Position = u_matrix_m * vec4(a_position, 1.0); }";
+        const shader_ptr ps = the<render>().create_shader(
+            vertex_source,
+            str_view("void main(){ gl_FragColor = vec4(1.0); }"));
+        REQUIRE(ps);
+        return material_asset::create(render::material()
+            .add_pass(render::pass_state().shader(ps)));
+    }
+}
+
+TEST_CASE("render_system") {
+    safe_starter_initializer initializer;
+    if ( !modules::is_initialized<render>() ) {
+        return;
+    }
+
+    library& l = the<library>();
+    world& w = the<world>();
+
+    // systems are registered by the starter only when it starts
+    ecs::registry_filler(w.registry())
+        .feature<struct render_system_untests_feature>(ecs::feature()
+            .add_system<render_system>());
+
+    auto model_res = l.load_asset<model_asset>("model.json");
+    REQUIRE(model_res);
+    REQUIRE(model_res->content().mesh()->content().indices_submesh_count() == 1u);
+
+    gobject camera_i = w.instantiate();
+    camera_i.component<camera>().assign();
+
+    gobject scene_i = w.instantiate();
+    scene_i.component<scene>().assign();
+    const node_iptr& scene_n = scene_i.component<actor>()->node();
+
+    const auto add_model = [&w, &scene_n, &model_res](
+        const material_asset::ptr& mat,
+        const render::property_block& props = render::property_block())
+    {
+        gobject inst = w.instantiate(scene_n);
+        inst.component<renderer>().assign()
+            .materials({mat})
+            .properties(props);
+        inst.component<model_renderer>().assign(model_res);
+        return inst;
+    };
+
+    const auto draw_frame = [&w, &camera_i](){
+        the<render>().reset_frame_statistics();
+        w.registry().process_event(systems::render_event{camera_i.raw_entity()});
+        return the<render>().frame_statistics();
+    };
+
+    const bool instancing = the<render>().device_capabilities().instancing_supported;
+
+    SECTION("same_model_and_material") {
+        const material_asset::ptr mat = make_material(true);
+        for ( std::size_t i = 0; i < 4; ++i ) {
+            add_model(mat);
+        }
+
+        const render::statistics stats = draw_frame();
+        REQUIRE(stats.draw_calls == (instancing ? 1u : 4u));
+        REQUIRE(stats.drawn_instances == (instancing ? 4u : 0u));
+    }
+    SECTION("different_properties") {
+        const material_asset::ptr mat = make_material(true);
+        const auto tinted = render::property_block()
+            .property(make_hash("u_tint"), v4f(1.f, 0.f, 0.f, 1.f));
+
+        // runs of the same properties are grouped: [0,1], [2], [3]
+        add_model(mat);
+        add_model(mat);
+        add_model(mat, tinted);
+        add_model(mat);
+
+        const render::statistics stats = draw_frame();
+        REQUIRE(stats.draw_calls == (instancing ? 3u : 4u));
+        REQUIRE(stats.drawn_instances == (instancing ? 4u : 0u));
+    }
+    SECTION("different_materials") {
+        const material_asset::ptr mat1 = make_material(true);
+        const material_asset::ptr mat2 = make_material(true);
+
+        add_model(mat1);
+        add_model(mat1);
+        add_model(mat2);
+        add_model(mat2);
+        add_model(mat1);
+
+        const render::statistics stats = draw_frame();
+        REQUIRE(stats.draw_calls == (instancing ? 3u : 5u));
+        REQUIRE(stats.drawn_instances == (instancing ? 5u : 0u));
+    }
+    SECTION("not_instanceable_material") {
+        // materials without the per-instance matrix are drawn one by one
+        const material_asset::ptr mat = make_material(false);
+        for ( std::size_t i = 0; i < 3; ++i ) {
+            add_model(mat);
+        }
+
+        const render::statistics stats = draw_frame();
+        REQUIRE(stats.draw_calls == 3u);
+        REQUIRE(stats.drawn_instances == 0u);
+    }
+}
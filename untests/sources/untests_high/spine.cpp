@@ -0,0 +1,291 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    class safe_starter_initializer final : private noncopyable {
+    public:
+        safe_starter_initializer() {
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters("spine_untests", "enduro2d")));
+        }
+
+        ~safe_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+
+    bool wait_for_bakes(const spine_pose_cache& cache) {
+        for ( std::size_t i = 0; i < 1000u && cache.stats().pending_animations; ++i ) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return !cache.stats().pending_animations;
+    }
+}
+
+TEST_CASE("spine") {
+    safe_starter_initializer initializer;
+    library& l = the<library>();
+    world& w = the<world>();
+
+    auto spine_res = l.load_asset<spine_asset>("spine.json");
+    REQUIRE(spine_res);
+
+    const spine::pose_cache_ptr& cache = spine_res->content().pose_cache();
+    REQUIRE(cache);
+
+    SECTION("pose_cache") {
+        auto move_30 = cache->find_or_bake("move", "", 30.f);
+        REQUIRE(move_30);
+        REQUIRE(move_30 == cache->find_or_bake("move", "", 30.f));
+        REQUIRE(math::approximately(move_30->duration(), 1.f));
+        REQUIRE(math::approximately(move_30->sample_rate(), 30.f));
+        REQUIRE(move_30->pose_count() == 31u);
+
+        auto move_10 = cache->find_or_bake("move", "", 10.f);
+        REQUIRE(move_10);
+        REQUIRE(move_10 != move_30);
+        REQUIRE(move_10->pose_count() == 11u);
+
+        auto idle_30 = cache->find_or_bake("idle", "default", 30.f);
+        REQUIRE(idle_30);
+        REQUIRE(idle_30 != move_30);
+        REQUIRE(idle_30->pose_count() == 1u);
+
+        REQUIRE_FALSE(cache->find_or_bake("jump", "", 30.f));
+        REQUIRE_FALSE(cache->find_or_bake("move", "skin", 30.f));
+        REQUIRE_FALSE(cache->find_or_bake("move", "", 0.f));
+
+        const spine_pose_cache::statistics stats = cache->stats();
+        REQUIRE(stats.baked_animations == 3u);
+        REQUIRE(stats.baked_poses == 43u);
+        REQUIRE(stats.pending_animations == 0u);
+        REQUIRE(stats.memory_usage ==
+            move_30->memory_usage() +
+            move_10->memory_usage() +
+            idle_30->memory_usage());
+
+        const spine_pose_cache::pose& first = move_30->pose_at(0.f);
+        const spine_pose_cache::pose& middle = move_30->pose_at(0.5f);
+        const spine_pose_cache::pose& last = move_30->pose_at(1.f);
+        REQUIRE(&first == &move_30->pose_at(-1.f));
+        REQUIRE(&last == &move_30->pose_at(2.f));
+
+        for ( const spine_pose_cache::pose* p : {&first, &middle, &last} ) {
+            REQUIRE(p->meshes.size() == 1u);
+            REQUIRE(p->meshes[0].page);
+            REQUIRE(p->meshes[0].vertex_count == 4u);
+            REQUIRE(p->meshes[0].index_count == 6u);
+            REQUIRE(p->vertices.size() == 4u);
+            REQUIRE(p->uvs == first.uvs);
+            REQUIRE(p->indices == first.indices);
+        }
+
+        for ( std::size_t i = 0; i < first.vertices.size(); ++i ) {
+            REQUIRE(math::approximately(middle.vertices[i], first.vertices[i] + v2f(15.f, 0.f)));
+            REQUIRE(math::approximately(last.vertices[i], first.vertices[i] + v2f(30.f, 0.f)));
+        }
+    }
+    SECTION("baked_pose") {
+        gobject inst = w.instantiate();
+        inst.component<spine_player>().assign(spine_res)
+            .use_pose_cache(true);
+        inst.component<commands<spine_player_commands::command>>().assign()
+            .add(spine_player_commands::set_anim_cmd(0, "move").loop(true));
+
+        const_gcomponent<spine_player> player{inst};
+
+        // the first update schedules the bake and poses the skeleton live
+        w.registry().process_event(systems::update_event{0.5f});
+        REQUIRE_FALSE(player->baked_pose());
+        REQUIRE(cache->stats().evaluated_updates == 1u);
+
+        REQUIRE(wait_for_bakes(*cache));
+        REQUIRE(cache->stats().baked_animations == 1u);
+
+        w.registry().process_event(systems::update_event{0.f});
+        REQUIRE(player->baked_pose());
+        REQUIRE(player->baked_pose() == &cache->find_or_bake("move", "", 30.f)->pose_at(0.5f));
+        REQUIRE(cache->stats().cached_updates == 1u);
+        REQUIRE(cache->stats().baked_animations == 1u);
+
+        inst.component<spine_player>()->use_pose_cache(false);
+        w.registry().process_event(systems::update_event{0.f});
+        REQUIRE_FALSE(player->baked_pose());
+        REQUIRE(cache->stats().cached_updates == 1u);
+
+        w.destroy_instance(inst);
+        w.finalize_instances();
+    }
+    SECTION("events") {
+        // the first instance consumes its events through the component view
+        gobject viewed = w.instantiate();
+        viewed.component<spine_player>().assign(spine_res);
+        viewed.component<events<spine_player_events::event>>().assign();
+        viewed.component<commands<spine_player_commands::command>>().assign()
+            .add(spine_player_commands::set_anim_cmd(0, "move")
+                .complete_message("done"));
+
+        gobject streamed = w.instantiate();
+        streamed.component<spine_player>().assign(spine_res);
+        streamed.component<commands<spine_player_commands::command>>().assign()
+            .add(spine_player_commands::set_anim_cmd(0, "move")
+                .complete_message("done"));
+
+        const auto is_done = [](const spine_player_events::event& evt){
+            const auto* complete = std::get_if<spine_player_events::complete_evt>(&evt);
+            return complete && complete->message() == "done";
+        };
+
+        w.registry().process_event(systems::update_event{1.5f});
+
+        const auto& viewed_events = viewed.component<events<spine_player_events::event>>()->get();
+        REQUIRE(viewed_events.size() == 1u);
+        REQUIRE(is_done(viewed_events[0]));
+
+        // the view is not created for the targets without it
+        REQUIRE_FALSE(streamed.component<events<spine_player_events::event>>().exists());
+
+        std::size_t streamed_events = 0u;
+        w.stream<spine_player_events::event>().for_each_by_target(
+            streamed.raw_entity(),
+            [&streamed_events, &is_done](const ecs::entity&, const spine_player_events::event& evt){
+                REQUIRE(is_done(evt));
+                ++streamed_events;
+            });
+        REQUIRE(streamed_events == 1u);
+        REQUIRE(w.stream<spine_player_events::event>().size() == 2u);
+
+        // the next update clears the stream and the views
+        w.registry().process_event(systems::update_event{0.f});
+        REQUIRE(viewed.component<events<spine_player_events::event>>()->empty());
+        REQUIRE(w.stream<spine_player_events::event>().empty());
+
+        w.destroy_instance(viewed);
+        w.destroy_instance(streamed);
+        w.finalize_instances();
+    }
+    SECTION("baked_events") {
+        gobject inst = w.instantiate();
+        inst.component<spine_player>().assign(spine_res)
+            .use_pose_cache(true);
+        inst.component<commands<spine_player_commands::command>>().assign()
+            .add(spine_player_commands::set_anim_cmd(0, "step")
+                .loop(true)
+                .complete_message("loop"));
+
+        const auto collect_events = [&w, &inst](){
+            vector<spine_player_events::event> result;
+            w.stream<spine_player_events::event>().for_each_by_target(
+                inst.raw_entity(),
+                [&result](const ecs::entity&, const spine_player_events::event& evt){
+                    result.push_back(evt);
+                });
+            return result;
+        };
+
+        const auto is_footstep = [](const spine_player_events::event& evt, i32 value){
+            const auto* custom = std::get_if<spine_player_events::custom_evt>(&evt);
+            return custom && custom->name() == "footstep" && custom->int_value() == value;
+        };
+
+        const auto is_loop = [](const spine_player_events::event& evt){
+            const auto* complete = std::get_if<spine_player_events::complete_evt>(&evt);
+            return complete && complete->message() == "loop";
+        };
+
+        // the first update applies timelines while the bake is pending
+        w.registry().process_event(systems::update_event{0.1f});
+        REQUIRE(collect_events().empty());
+        REQUIRE(wait_for_bakes(*cache));
+
+        auto baked = cache->find_or_bake("step", "", 30.f);
+        REQUIRE(baked);
+        REQUIRE(baked->events().size() == 2u);
+
+        // the next ones fire events from the baked list
+        w.registry().process_event(systems::update_event{0.2f});
+        REQUIRE(inst.component<spine_player>()->baked_pose());
+        {
+            const auto evts = collect_events();
+            REQUIRE(evts.size() == 1u);
+            REQUIRE(is_footstep(evts[0], 1));
+        }
+
+        w.registry().process_event(systems::update_event{0.5f});
+        {
+            const auto evts = collect_events();
+            REQUIRE(evts.size() == 1u);
+            REQUIRE(is_footstep(evts[0], 2));
+        }
+
+        // wrapping completes the loop before the events of the next one
+        w.registry().process_event(systems::update_event{0.5f});
+        {
+            const auto evts = collect_events();
+            REQUIRE(evts.size() == 2u);
+            REQUIRE(is_loop(evts[0]));
+            REQUIRE(is_footstep(evts[1], 1));
+        }
+
+        REQUIRE(cache->stats().cached_updates == 3u);
+        REQUIRE(cache->stats().evaluated_updates == 1u);
+
+        w.destroy_instance(inst);
+        w.finalize_instances();
+    }
+    SECTION("baked_pose_drawing") {
+        if ( modules::is_initialized<render>() ) {
+            auto material_res = l.load_asset<material_asset>("material.json");
+            REQUIRE(material_res);
+
+            gobject camera_i = w.instantiate();
+            camera_i.component<camera>().assign();
+
+            gobject scene_i = w.instantiate();
+            scene_i.component<scene>().assign();
+
+            gobject spine_i = w.instantiate(scene_i.component<actor>()->node());
+            spine_i.component<renderer>().assign();
+            spine_i.component<spine_player>().assign(spine_res)
+                .materials({{"normal"_hash, material_res}})
+                .use_pose_cache(true);
+            spine_i.component<commands<spine_player_commands::command>>().assign()
+                .add(spine_player_commands::set_anim_cmd(0, "move").loop(true));
+
+            const auto draw_frame = [&w, &camera_i](){
+                the<render>().reset_frame_statistics();
+                w.registry().process_event(systems::render_event{camera_i.raw_entity()});
+                return the<render>().frame_statistics();
+            };
+
+            w.registry().process_event(systems::update_event{0.5f});
+            REQUIRE(wait_for_bakes(*cache));
+            w.registry().process_event(systems::update_event{0.f});
+            REQUIRE(spine_i.component<spine_player>()->baked_pose());
+
+            const render::statistics baked_stats = draw_frame();
+            REQUIRE(baked_stats.draw_calls > 0u);
+
+            spine_i.component<spine_player>()->use_pose_cache(false);
+            w.registry().process_event(systems::update_event{0.f});
+            REQUIRE_FALSE(spine_i.component<spine_player>()->baked_pose());
+
+            const render::statistics live_stats = draw_frame();
+            REQUIRE(live_stats.draw_calls == baked_stats.draw_calls);
+            REQUIRE(live_stats.drawn_indices == baked_stats.drawn_indices);
+
+            w.destroy_instance(spine_i);
+            w.destroy_instance(scene_i);
+            w.destroy_instance(camera_i);
+            w.finalize_instances();
+        }
+    }
+}
@@ -0,0 +1,247 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+// the dispatcher is not reachable through the public api and the null window
+// has no way to post mouse buttons, so the untest feeds its own one
+#include "../../../sources/enduro2d/high/systems/touch_system_impl/touch_system_dispatcher.hpp"
+
+#include <new>
+#include <cstdlib>
+
+namespace
+{
+    // only allocations of the thread running the frames are counted,
+    // workers and the audio thread are free to allocate
+    thread_local bool allocation_counting{false};
+    thread_local std::size_t allocation_count{0u};
+
+    void* counted_allocate(std::size_t size) {
+        if ( allocation_counting ) {
+            ++allocation_count;
+        }
+        if ( void* ptr = std::malloc(size ? size : 1u) ) {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* counted_allocate(std::size_t size, const std::nothrow_t&) noexcept {
+        try {
+            return counted_allocate(size);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+}
+
+void* operator new(std::size_t size) {
+    return counted_allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return counted_allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept {
+    return counted_allocate(size, tag);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return counted_allocate(size, tag);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace
+{
+    class safe_starter_initializer final : private noncopyable {
+    public:
+        safe_starter_initializer() {
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters("steady_state_untests", "enduro2d")));
+        }
+
+        ~safe_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+
+    class allocation_counter final : private noncopyable {
+    public:
+        allocation_counter() noexcept {
+            allocation_count = 0u;
+            allocation_counting = true;
+        }
+
+        ~allocation_counter() noexcept {
+            allocation_counting = false;
+        }
+
+        std::size_t count() const noexcept {
+            return allocation_count;
+        }
+    };
+
+    material_asset::ptr make_material() {
+        const shader_ptr ps = the<render>().create_shader(
+            str_view(
+                "attribute vec3 a_position;\n"
+                "uniform mat4 u_matrix_m;\n"
+                "void main(){ gl_Position = u_matrix_m * vec4(a_position, 1.0); }"),
+            str_view("void main(){ gl_FragColor = vec4(1.0); }"));
+        REQUIRE(ps);
+        return material_asset::create(render::material()
+            .add_pass(render::pass_state().shader(ps)));
+    }
+
+    font_asset::ptr make_font() {
+        const texture_ptr atlas = the<render>().create_texture(
+            v2u(16u, 16u),
+            pixel_declaration::pixel_type::rgba8);
+        REQUIRE(atlas);
+
+        font::content content;
+        content.info.atlas_file = "steady_state_font.png";
+        content.info.atlas_size = v2u(16u, 16u);
+        content.info.font_size = 8u;
+        content.info.line_height = 8u;
+        content.info.glyph_ascent = 6u;
+        for ( const u32 code_point : {u32(' '), u32('a'), u32('b')} ) {
+            content.glyphs.emplace(code_point, font::glyph_info{
+                v2i::zero(), b2u(0u, 0u, 8u, 8u), 8});
+        }
+
+        return font_asset::create(
+            font(std::move(content)),
+            nested_content{{
+                make_hash("steady_state_font.png"),
+                texture_asset::create(atlas)}});
+    }
+}
+
+TEST_CASE("steady_state") {
+    safe_starter_initializer initializer;
+    if ( !modules::is_initialized<render>() ) {
+        return;
+    }
+
+    library& l = the<library>();
+    world& w = the<world>();
+
+    // systems are registered by the starter only when it starts
+    ecs::registry_filler(w.registry())
+        .feature<struct steady_state_untests_feature>(ecs::feature()
+            .add_system<label_system>()
+            .add_system<render_system>()
+            .add_system<spine_system>()
+            .add_system<touch_system>());
+
+    auto sprite_res = l.load_asset<sprite_asset>("sprite.json");
+    auto spine_res = l.load_asset<spine_asset>("spine.json");
+    REQUIRE(sprite_res);
+    REQUIRE(spine_res);
+
+    const material_asset::ptr mat = make_material();
+    const font_asset::ptr font_res = make_font();
+
+    gobject camera_i = w.instantiate();
+    camera_i.component<camera>().assign();
+    camera_i.component<camera::input>().assign();
+
+    gobject scene_i = w.instantiate();
+    scene_i.component<scene>().assign();
+    const node_iptr& scene_n = scene_i.component<actor>()->node();
+
+    gobject sprite_i = w.instantiate(scene_n);
+    sprite_i.component<renderer>().assign();
+    sprite_i.component<sprite_renderer>().assign(sprite_res)
+        .materials({{"normal"_hash, mat}});
+
+    gobject spine_i = w.instantiate(scene_n);
+    spine_i.component<renderer>().assign();
+    spine_i.component<spine_player>().assign(spine_res)
+        .materials({{"normal"_hash, mat}});
+    spine_i.component<commands<spine_player_commands::command>>().assign()
+        .add(spine_player_commands::set_anim_cmd(0, "move").loop(true));
+
+    gobject label_i = w.instantiate(scene_n);
+    label_i.component<renderer>().assign()
+        .materials({mat});
+    label_i.component<model_renderer>().assign();
+    label_i.component<label>().assign(font_res)
+        .text("ab ba");
+    labels::mark_dirty(label_i.component<label>());
+
+    // the collider covers the whole viewport of the default camera
+    gobject touch_i = w.instantiate(scene_n);
+    touch_i.component<touchable>().assign();
+    touch_i.component<rect_collider>().assign()
+        .size(v2f(4.f, 4.f));
+
+    the<input>().post_event(input::move_cursor_event(
+        the<window>().real_size().cast_to<f32>() * 0.5f));
+
+    touch_system_impl::dispatcher touches;
+    const auto run_frame = [&w, &camera_i, &touches](){
+        const f32 dt = 1.f / 60.f;
+        w.registry().process_event(systems::pre_update_event{dt});
+        w.registry().process_event(systems::update_event{dt});
+        w.registry().process_event(systems::post_update_event{dt});
+
+        window::event_listener& listener = touches;
+        listener.on_mouse_button(mouse_button::left, mouse_button_action::press);
+        listener.on_mouse_button(mouse_button::left, mouse_button_action::release);
+        touches.dispatch_all_events(w.registry());
+
+        the<render>().reset_frame_statistics();
+        w.registry().process_event(systems::pre_render_event{camera_i.raw_entity()});
+        w.registry().process_event(systems::render_event{camera_i.raw_entity()});
+        w.registry().process_event(systems::post_render_event{camera_i.raw_entity()});
+
+        frame_arena::next_frame();
+    };
+
+    // the first frames build labels and grow the frame arenas,
+    // the batcher and the event streams up to their steady sizes
+    for ( std::size_t i = 0; i < 4u; ++i ) {
+        run_frame();
+    }
+
+    REQUIRE_FALSE(label_i.component<label::dirty>().exists());
+    REQUIRE(w.stream<touchable_events::event>().size() == 2u);
+    REQUIRE(the<render>().frame_statistics().draw_calls > 0u);
+
+    std::size_t allocations = 0u;
+    {
+        allocation_counter counter;
+        for ( std::size_t i = 0; i < 8u; ++i ) {
+            run_frame();
+        }
+        allocations = counter.count();
+    }
+    REQUIRE(allocations == 0u);
+
+    REQUIRE(w.stream<touchable_events::event>().size() == 2u);
+    REQUIRE(the<render>().frame_statistics().draw_calls > 0u);
+}
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_high.hpp"
+using namespace e2d;
+
+namespace
+{
+    class safe_starter_initializer final : private noncopyable {
+    public:
+        safe_starter_initializer() {
+            modules::initialize<starter>(0, nullptr,
+                starter::parameters(
+                    engine::parameters("streamer_untests", "enduro2d")));
+        }
+
+        ~safe_starter_initializer() noexcept {
+            modules::shutdown<starter>();
+        }
+    };
+
+    class streamed_asset final : public content_asset<streamed_asset, str> {
+    public:
+        static const char* type_name() noexcept { return "streamed_asset"; }
+        static load_async_result load_async(const library& library, str_view address) {
+            E2D_UNUSED(library);
+            return stdex::make_resolved_promise(streamed_asset::create(str(address)));
+        }
+    };
+
+    class broken_asset final : public content_asset<broken_asset, str> {
+    public:
+        static const char* type_name() noexcept { return "broken_asset"; }
+        static load_async_result load_async(const library& library, str_view address) {
+            E2D_UNUSED(library, address);
+            return stdex::make_rejected_promise<load_result>(asset_loading_exception());
+        }
+    };
+
+    streamer::group make_region_group(str_view address, const v2f& center) {
+        return streamer::group()
+            .assets(asset_dependencies()
+                .add_dependency<streamed_asset>(address))
+            .region(center, 10.f)
+            .release_radius(30.f)
+            .memory_size(10u);
+    }
+}
+
+TEST_CASE("streamer") {
+    safe_starter_initializer initializer;
+    streamer& s = the<streamer>();
+    {
+        s.add_group("near", make_region_group("a", v2f(0.f, 0.f)));
+        s.add_group("far", make_region_group("b", v2f(100.f, 0.f)));
+        REQUIRE(s.has_group("near"));
+        REQUIRE_FALSE(s.has_group("none"));
+
+        s.focus({v2f(5.f, 0.f)}).frame_tick();
+        REQUIRE(s.group_state("near") == streamer::group_states::loaded);
+        REQUIRE(s.group_state("far") == streamer::group_states::unloaded);
+        REQUIRE(s.group_assets("near").find_asset<streamed_asset>("a"));
+        REQUIRE_FALSE(s.group_assets("far").find_asset<streamed_asset>("b"));
+        REQUIRE(s.stats().resident_groups == 1u);
+        REQUIRE(s.stats().resident_memory == 10u);
+
+        // kept inside the release radius
+        s.focus({v2f(20.f, 0.f)}).frame_tick();
+        REQUIRE(s.group_state("near") == streamer::group_states::loaded);
+
+        s.focus({v2f(40.f, 0.f)}).frame_tick();
+        REQUIRE(s.group_state("near") == streamer::group_states::unloaded);
+        REQUIRE_FALSE(s.group_assets("near").find_asset<streamed_asset>("a"));
+        REQUIRE(s.stats().released_groups == 1u);
+
+        REQUIRE(s.remove_group("near"));
+        REQUIRE(s.remove_group("far"));
+        REQUIRE_FALSE(s.remove_group("far"));
+    }
+    {
+        s.add_group("menu", streamer::group()
+            .assets(asset_dependencies()
+                .add_dependency<streamed_asset>("menu"))
+            .scene("menu"));
+
+        s.frame_tick();
+        REQUIRE(s.group_state("menu") == streamer::group_states::unloaded);
+
+        s.activate_scene("menu").frame_tick();
+        REQUIRE(s.is_scene_active("menu"));
+        REQUIRE(s.group_state("menu") == streamer::group_states::loaded);
+
+        s.deactivate_scene("menu").frame_tick();
+        REQUIRE(s.group_state("menu") == streamer::group_states::unloaded);
+        REQUIRE(s.remove_group("menu"));
+    }
+    {
+        s.memory_budget(10u);
+        s.add_group("a", make_region_group("a", v2f(0.f, 0.f)));
+        s.add_group("b", make_region_group("b", v2f(30.f, 0.f)));
+
+        s.focus({v2f(0.f, 0.f)}).frame_tick();
+        REQUIRE(s.group_state("a") == streamer::group_states::loaded);
+
+        // "a" is kept by the hysteresis only and gives its memory to "b"
+        s.focus({v2f(20.f, 0.f)}).frame_tick();
+        REQUIRE(s.group_state("a") == streamer::group_states::unloaded);
+        REQUIRE(s.group_state("b") == streamer::group_states::loaded);
+        REQUIRE(s.stats().resident_memory == 10u);
+
+        s.add_group("c", make_region_group("c", v2f(20.f, 0.f)).priority(1));
+        s.frame_tick();
+        REQUIRE(s.group_state("c") == streamer::group_states::unloaded);
+
+        s.memory_budget(0u).frame_tick();
+        REQUIRE(s.group_state("c") == streamer::group_states::loaded);
+
+        REQUIRE(s.remove_group("a"));
+        REQUIRE(s.remove_group("b"));
+        REQUIRE(s.remove_group("c"));
+    }
+    {
+        s.add_group("broken", streamer::group()
+            .assets(asset_dependencies()
+                .add_dependency<broken_asset>("broken"))
+            .region(v2f(0.f, 0.f), 10.f));
+
+        s.focus({v2f(0.f, 0.f)}).frame_tick();
+        REQUIRE(s.group_state("broken") == streamer::group_states::failed);
+
+        s.frame_tick();
+        REQUIRE(s.group_state("broken") == streamer::group_states::failed);
+        REQUIRE(s.remove_group("broken"));
+    }
+}
@@ -9,6 +9,10 @@ using namespace e2d;
 
 namespace
 {
+    struct test_event {
+        i32 value{0};
+    };
+
     class safe_starter_initializer final : private noncopyable {
     public:
         safe_starter_initializer() {
@@ -34,4 +38,138 @@ TEST_CASE("world") {
         w.registry().destroy_entity(e);
         REQUIRE_FALSE(cw.registry().valid_entity(e));
     }
+    SECTION("structure_version") {
+        const u32 named_version = gobject::structure_version<named>();
+        const u32 renderer_version = gobject::structure_version<renderer>();
+
+        gobject inst = w.instantiate();
+        REQUIRE(gobject::structure_version<named>() != named_version);
+        REQUIRE(gobject::structure_version<renderer>() != renderer_version);
+
+        {
+            const u32 version = gobject::structure_version<renderer>();
+            inst.component<named>().ensure();
+            REQUIRE(gobject::structure_version<renderer>() == version);
+            inst.component<renderer>().ensure();
+            REQUIRE(gobject::structure_version<renderer>() != version);
+        }
+        {
+            const u32 version = gobject::structure_version<renderer>();
+            inst.component<renderer>().ensure();
+            inst.component<renderer>()->transform(t3f::identity());
+            REQUIRE(gobject::structure_version<renderer>() == version);
+            REQUIRE(inst.component<renderer>().remove());
+            REQUIRE(gobject::structure_version<renderer>() != version);
+        }
+        {
+            const u32 version = gobject::structure_version<renderer>();
+            REQUIRE_FALSE(inst.component<renderer>().remove());
+            REQUIRE(gobject::structure_version<renderer>() == version);
+            w.destroy_instance(inst);
+            w.finalize_instances();
+            REQUIRE(gobject::structure_version<renderer>() != version);
+        }
+    }
+    SECTION("component_cache") {
+        gobject inst = w.instantiate();
+        gcomponent<renderer> r = inst.component<renderer>();
+        const_gcomponent<renderer> cr = r;
+        REQUIRE_FALSE(r);
+        REQUIRE_FALSE(cr);
+
+        inst.component<renderer>().assign();
+        REQUIRE(r);
+        REQUIRE(cr);
+        REQUIRE(r.find() == inst.raw_component<renderer>().find());
+        REQUIRE(cr.find() == inst.raw_component<renderer>().find());
+
+        REQUIRE(inst.component<renderer>().remove());
+        REQUIRE_FALSE(r);
+        REQUIRE_FALSE(cr);
+
+        inst.raw_entity().assign_component<renderer>();
+        gobject::mark_structure_changed<renderer>();
+        REQUIRE(r);
+        REQUIRE(cr.find() == inst.raw_component<renderer>().find());
+
+        // ecsex wrappers mark their changes
+        REQUIRE(ecsex::remove_component<renderer>(inst.raw_entity()));
+        REQUIRE_FALSE(r);
+        REQUIRE_FALSE(cr);
+        REQUIRE_FALSE(ecsex::remove_component<renderer>(inst.raw_entity()));
+
+        renderer& er = ecsex::ensure_component<renderer>(inst.raw_entity());
+        REQUIRE(r.find() == &er);
+        REQUIRE(&ecsex::ensure_component<renderer>(inst.raw_entity()) == &er);
+
+        ecsex::remove_all_components<renderer>(w.registry());
+        REQUIRE_FALSE(r);
+        REQUIRE_FALSE(cr);
+
+        ecsex::assign_component<renderer>(inst.raw_entity());
+        REQUIRE(r);
+        REQUIRE(cr.find() == inst.raw_component<renderer>().find());
+
+        w.destroy_instance(inst);
+        w.finalize_instances();
+        REQUIRE_FALSE(r.valid());
+        REQUIRE_FALSE(r.find());
+        REQUIRE_FALSE(cr.find());
+    }
+    SECTION("event_stream") {
+        event_stream<test_event>& stream = w.stream<test_event>();
+        REQUIRE(&stream == &w.stream<test_event>());
+        REQUIRE(stream.empty());
+
+        auto e1 = w.registry().create_entity();
+        auto e2 = w.registry().create_entity();
+        e2.assign_component<events<test_event>>();
+
+        stream
+            .add(e1, {1})
+            .add(e2, {2})
+            .add(e1, {3});
+        REQUIRE(stream.size() == 3);
+
+        {
+            vector<i32> values;
+            stream.for_each([&values](const ecs::entity&, const test_event& evt){
+                values.push_back(evt.value);
+            });
+            REQUIRE(values == vector<i32>{1, 2, 3});
+        }
+        {
+            vector<i32> values;
+            stream.for_each([&values](const ecs::entity&, const test_event& evt){
+                values.push_back(evt.value);
+            }, ecs::exists<events<test_event>>());
+            REQUIRE(values == vector<i32>{2});
+        }
+        {
+            vector<i32> values;
+            stream.for_each_by_target(e1, [&values,&e1](const ecs::entity& e, const test_event& evt){
+                REQUIRE(e == e1);
+                values.push_back(evt.value);
+            });
+            REQUIRE(values == vector<i32>{1, 3});
+        }
+
+        REQUIRE(e2.get_component<events<test_event>>().size() == 1);
+        REQUIRE(e2.get_component<events<test_event>>().get()[0].value == 2);
+        REQUIRE_FALSE(e1.exists_component<events<test_event>>());
+
+        w.registry().destroy_entity(e1);
+        {
+            vector<i32> values;
+            stream.for_each([&values](const ecs::entity&, const test_event& evt){
+                values.push_back(evt.value);
+            });
+            REQUIRE(values == vector<i32>{2});
+        }
+
+        stream.clear();
+        REQUIRE(stream.empty());
+        REQUIRE(e2.get_component<events<test_event>>().empty());
+        w.registry().destroy_entity(e2);
+    }
 }
@@ -109,4 +109,25 @@ TEST_CASE("trs2") {
             math::make_translation_trs2(v2i{1,4}),
             1));
     }
+    {
+        const auto t1 = make_trs2(v2f(1.f,2.f), 2.f, v2f(1.f,1.f));
+        const auto t2 = make_trs2(v2f(3.f,6.f), 4.f, v2f(2.f,3.f));
+        REQUIRE(math::lerp(t1, t2, 0.f) == t1);
+        REQUIRE(math::lerp(t1, t2, 1.f) == t2);
+        REQUIRE(math::approximately(
+            math::lerp(t1, t2, 0.5f),
+            make_trs2(v2f(2.f,4.f), 3.f, v2f(1.5f,2.f))));
+    }
+    {
+        const f32 two_pi = math::two_pi<f32>().value;
+        const auto t1 = math::make_rotation_trs2(6.2f);
+        const auto t2 = math::make_rotation_trs2(0.1f);
+        const f32 arc = 0.1f + two_pi - 6.2f;
+        REQUIRE(math::approximately(math::lerp(t1, t2, 0.5f).rotation, 6.2f + arc * 0.5f));
+        REQUIRE(math::approximately(math::lerp(t2, t1, 0.5f).rotation, 0.1f - arc * 0.5f));
+        REQUIRE(math::approximately(math::lerp(t1, t2, 1.f).rotation, 0.1f + two_pi));
+        REQUIRE(math::approximately(
+            math::lerp(math::make_rotation_trs2(1.f), math::make_rotation_trs2(1.f + two_pi), 0.5f).rotation,
+            1.f));
+    }
 }
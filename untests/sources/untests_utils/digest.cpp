@@ -0,0 +1,40 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_utils.hpp"
+using namespace e2d;
+
+namespace
+{
+    str to_hex(const sha256_digest& digest) {
+        const char* hex_digits = "0123456789abcdef";
+        str result;
+        for ( u8 b : digest ) {
+            result += hex_digits[b >> 4];
+            result += hex_digits[b & 0x0F];
+        }
+        return result;
+    }
+}
+
+TEST_CASE("digest") {
+    SECTION("sha256") {
+        REQUIRE(to_hex(digests::sha256(str_view(""))) ==
+            "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+        REQUIRE(to_hex(digests::sha256(str_view("abc"))) ==
+            "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+        // the length doesn't fit the first padding block
+        REQUIRE(to_hex(digests::sha256(str_view(str(56, 'b')))) ==
+            "a5fc6e203a4c2b657d0d153885932414b2ffc6a93f0f8bf8b3183315e5a7212c");
+        REQUIRE(to_hex(digests::sha256(str_view(str(1000, 'a')))) ==
+            "41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3");
+    }
+    SECTION("buffer") {
+        const buffer src("hello", 5);
+        REQUIRE(digests::sha256(src) == digests::sha256(str_view("hello")));
+        REQUIRE(digests::sha256(src) != digests::sha256(str_view("world")));
+    }
+}
@@ -93,6 +93,17 @@ TEST_CASE("filesystem") {
                 REQUIRE(filesystem::try_read_all(d1, child_dir_name));
                 REQUIRE(data == d1);
             }
+            {
+                const str_view other_name = "test_filesystem_other_file_name";
+                REQUIRE(filesystem::try_write_all(buffer("other", 5), other_name, false));
+                REQUIRE(filesystem::rename_file(other_name, child_dir_name));
+                REQUIRE_FALSE(filesystem::exists(other_name));
+
+                buffer d1;
+                REQUIRE(filesystem::try_read_all(d1, child_dir_name));
+                REQUIRE(d1 == buffer("other", 5));
+                REQUIRE_FALSE(filesystem::rename_file(other_name, child_dir_name));
+            }
             REQUIRE(filesystem::remove_file(child_dir_name));
             REQUIRE_FALSE(filesystem::exists(child_dir_name));
         }
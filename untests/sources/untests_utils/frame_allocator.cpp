@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_utils.hpp"
+using namespace e2d;
+
+namespace
+{
+    struct alignas(32) overaligned_value {
+        u8 data[32];
+    };
+
+    std::size_t simulate_frame(std::size_t frame) {
+        std::size_t result = 0u;
+        for ( std::size_t i = 0; i < 10; ++i ) {
+            frame_vector<v2f> points;
+            points.reserve(64u + (frame + i) % 16u);
+            for ( std::size_t j = 0; j < points.capacity(); ++j ) {
+                points.push_back(v2f(1.f, 2.f));
+            }
+
+            frame_vector<u32> indices(128u + i);
+            for ( std::size_t j = 0; j < 100u + i * 10u; ++j ) {
+                indices.push_back(static_cast<u32>(j));
+            }
+
+            result += points.size() + indices.size();
+        }
+        return result;
+    }
+}
+
+TEST_CASE("frame_allocator") {
+    {
+        frame_arena arena(64u);
+        REQUIRE(arena.stats().capacity_bytes == 0u);
+
+        void* p1 = arena.allocate(10u, 1u);
+        REQUIRE(p1);
+        REQUIRE(arena.stats().used_bytes == 10u);
+        REQUIRE(arena.stats().block_allocations == 1u);
+
+        void* p2 = arena.allocate(8u, 8u);
+        REQUIRE(p2);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p2) % 8u == 0u);
+
+        arena.deallocate(p2, 8u);
+        REQUIRE(arena.allocate(8u, 8u) == p2);
+
+        void* p3 = arena.allocate(100u, 16u);
+        REQUIRE(p3);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p3) % 16u == 0u);
+        REQUIRE(arena.stats().block_allocations == 2u);
+
+        const std::size_t peak = arena.stats().frame_peak_bytes;
+        REQUIRE(peak >= 118u);
+
+        REQUIRE(arena.stats().live_allocations == 3u);
+        arena.deallocate(p1, 10u);
+        arena.deallocate(p2, 8u);
+        arena.deallocate(p3, 100u);
+        REQUIRE(arena.stats().live_allocations == 0u);
+
+        arena.reset();
+        REQUIRE(arena.stats().used_bytes == 0u);
+        REQUIRE(arena.stats().frame_peak_bytes == 0u);
+        REQUIRE(arena.stats().peak_bytes == peak);
+        REQUIRE(arena.stats().block_allocations == 3u);
+
+        const std::size_t capacity = arena.stats().capacity_bytes;
+        REQUIRE(arena.allocate(10u, 1u));
+        REQUIRE(arena.allocate(8u, 8u));
+        REQUIRE(arena.allocate(100u, 16u));
+        REQUIRE(arena.stats().block_allocations == 3u);
+        REQUIRE(arena.stats().capacity_bytes == capacity);
+    }
+    {
+        frame_arena arena;
+        frame_vector<overaligned_value> v{frame_allocator<overaligned_value>(arena)};
+        v.resize(3u);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(v.data()) % alignof(overaligned_value) == 0u);
+        REQUIRE(&v.get_allocator().arena() == &arena);
+    }
+    {
+        frame_arena::next_frame();
+        frame_arena& arena = frame_arena::thread_local_arena();
+        REQUIRE(&arena == &frame_arena::thread_local_arena());
+        {
+            frame_vector<int> v;
+            v.push_back(42);
+            REQUIRE(&v.get_allocator().arena() == &arena);
+            REQUIRE(arena.stats().used_bytes > 0u);
+        }
+        REQUIRE(arena.stats().used_bytes == 0u);
+
+        // only the most recent allocation is rewound
+        void* p1 = arena.allocate(16u, 4u);
+        void* p2 = arena.allocate(16u, 4u);
+        REQUIRE(p1);
+        REQUIRE(p2);
+        arena.deallocate(p1, 16u);
+        arena.deallocate(p2, 16u);
+        REQUIRE(arena.stats().used_bytes > 0u);
+
+        const u64 frame_number = frame_arena::frame_number();
+        frame_arena::next_frame();
+        REQUIRE(frame_arena::frame_number() == frame_number + 1u);
+
+        // the arena is reset on the first use in the next frame
+        REQUIRE(&frame_arena::thread_local_arena() == &arena);
+        REQUIRE(arena.stats().used_bytes == 0u);
+        REQUIRE(arena.stats().live_allocations == 0u);
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_RELEASE
+        {
+            // the frame boundary doesn't wait for the leaked allocation
+            const std::size_t outlived = arena.stats().outlived_allocations;
+            void* leaked = frame_arena::thread_local_arena().allocate(16u, 4u);
+            REQUIRE(leaked);
+            frame_arena::next_frame();
+            REQUIRE(&frame_arena::thread_local_arena() == &arena);
+            REQUIRE(arena.stats().used_bytes == 0u);
+            REQUIRE(arena.stats().live_allocations == 0u);
+            REQUIRE(arena.stats().outlived_allocations == outlived + 1u);
+
+            arena.deallocate(leaked, 16u);
+            REQUIRE(arena.stats().live_allocations == 0u);
+        }
+    #endif
+    }
+    SECTION("steady_state") {
+        // heap allocations of the real frame paths are measured
+        // by the benchmarks, here only the arena blocks are checked
+        for ( std::size_t frame = 0; frame < 4u; ++frame ) {
+            simulate_frame(frame);
+            frame_arena::next_frame();
+        }
+
+        const frame_arena& arena = frame_arena::thread_local_arena();
+        const std::size_t blocks_before = arena.stats().block_allocations;
+        std::size_t result = 0u;
+        for ( std::size_t frame = 0; frame < 16u; ++frame ) {
+            result += simulate_frame(frame);
+            frame_arena::next_frame();
+        }
+        const std::size_t blocks_after = frame_arena::thread_local_arena().stats().block_allocations;
+
+        REQUIRE(result > 0u);
+        REQUIRE(blocks_after == blocks_before);
+        REQUIRE(arena.stats().live_allocations == 0u);
+    }
+}
@@ -410,4 +410,375 @@ TEST_CASE("images") {
             REQUIRE(img == img2);
         }
     }
+
+    SECTION("compression") {
+        {
+            const image_data_format formats[] = {
+                image_data_format::rgba_dxt1,
+                image_data_format::rgba_dxt3,
+                image_data_format::rgba_dxt5,
+                image_data_format::rgb_etc1,
+                image_data_format::rgb_etc2,
+                image_data_format::rgba_etc2};
+            const std::size_t block_sizes[] = {8, 16, 16, 8, 8, 16};
+
+            buffer data(std::size_t(70) * 38 * 4);
+            for ( std::size_t i = 0; i < data.size(); ++i ) {
+                data.data()[i] = static_cast<u8>(i * 7);
+            }
+            const image src(v2u(70,38), image_data_format::rgba8, std::move(data));
+
+            for ( std::size_t i = 0; i < std::size(formats); ++i ) {
+                REQUIRE(images::check_compress_image_support(src, formats[i]));
+                for ( image_compression_quality q : {
+                    image_compression_quality::fast,
+                    image_compression_quality::normal,
+                    image_compression_quality::best })
+                {
+                    image dst;
+                    REQUIRE(images::try_compress_image(dst, src, formats[i], q));
+                    REQUIRE(dst.size() == src.size());
+                    REQUIRE(dst.format() == formats[i]);
+                    REQUIRE(dst.data().size() == 18u * 10u * block_sizes[i]);
+                }
+            }
+        }
+        {
+            const u8 red[] = {255, 0, 0, 255, 0, 0, 255, 0, 0, 255, 0, 0};
+            const image src(v2u(2,2), image_data_format::rgb8, {red, 12});
+
+            image dst;
+            REQUIRE(images::try_compress_image(dst, src, image_data_format::rgba_dxt1));
+            REQUIRE(dst.data().size() == 8u);
+            const u8* block = dst.data().data();
+            REQUIRE(block[0] == 0x00);
+            REQUIRE(block[1] == 0xF8);
+
+            REQUIRE(images::try_compress_image(dst, src, image_data_format::rgb_etc1));
+            REQUIRE(dst.data().size() == 8u);
+
+            image dst2;
+            REQUIRE(images::try_compress_image(dst2, src, image_data_format::rgb_etc1));
+            REQUIRE(dst == dst2);
+        }
+        {
+            buffer data(std::size_t(70) * 38 * 4);
+            for ( std::size_t i = 0; i < data.size(); ++i ) {
+                data.data()[i] = static_cast<u8>(i * 13 + i / 280);
+            }
+            const image src(v2u(70,38), image_data_format::rgba8, std::move(data));
+
+            vector<image> serial;
+            for ( image_data_format format : {
+                image_data_format::rgba_dxt1,
+                image_data_format::rgba_dxt5,
+                image_data_format::rgba_etc2 })
+            {
+                image dst;
+                REQUIRE(images::try_compress_image(dst, src, format, image_compression_quality::best));
+                serial.push_back(std::move(dst));
+            }
+
+            // runs the jobs backwards to catch any dependency between rows
+            vector<std::size_t> executed_jobs;
+            images::set_block_jobs_executor([&executed_jobs](
+                std::size_t count,
+                const std::function<void(std::size_t)>& job)
+            {
+                for ( std::size_t i = count; i > 0; --i ) {
+                    executed_jobs.push_back(i - 1u);
+                    job(i - 1u);
+                }
+            });
+
+            vector<image> decompressed;
+            for ( const image& expected : serial ) {
+                executed_jobs.clear();
+                image dst;
+                REQUIRE(images::try_compress_image(dst, src, expected.format(), image_compression_quality::best));
+                REQUIRE(dst == expected);
+                // ten rows of blocks by four rows a job
+                REQUIRE(executed_jobs == vector<std::size_t>{2, 1, 0});
+
+                image pixels;
+                REQUIRE(images::try_decompress_image(pixels, dst));
+                decompressed.push_back(std::move(pixels));
+            }
+
+            images::set_block_jobs_executor(nullptr);
+            executed_jobs.clear();
+
+            for ( std::size_t i = 0; i < serial.size(); ++i ) {
+                image pixels;
+                REQUIRE(images::try_decompress_image(pixels, serial[i]));
+                REQUIRE(pixels == decompressed[i]);
+            }
+            REQUIRE(executed_jobs.empty());
+        }
+        {
+            image src(v2u(4,4), image_data_format::rgba8, buffer(64));
+            REQUIRE_FALSE(images::check_compress_image_support(src, image_data_format::rgba8));
+            REQUIRE_FALSE(images::check_compress_image_support(src, image_data_format::rgba_pvrtc4));
+            REQUIRE_FALSE(images::check_compress_image_support(image(), image_data_format::rgba_dxt1));
+
+            image dxt;
+            REQUIRE(images::try_compress_image(dxt, src, image_data_format::rgba_dxt5));
+            REQUIRE_FALSE(images::check_compress_image_support(dxt, image_data_format::rgba_dxt1));
+
+            image dst;
+            REQUIRE_FALSE(images::try_compress_image(dst, dxt, image_data_format::rgba_dxt1));
+            REQUIRE(dst.empty());
+        }
+    }
+    SECTION("decompression") {
+        {
+            buffer data(std::size_t(37) * 29 * 4);
+            for ( u32 y = 0; y < 29; ++y ) {
+                for ( u32 x = 0; x < 37; ++x ) {
+                    u8* p = data.data() + (y * 37 + x) * 4;
+                    p[0] = static_cast<u8>(x * 6);
+                    p[1] = static_cast<u8>(y * 8);
+                    p[2] = static_cast<u8>((x + y) * 3);
+                    p[3] = 255;
+                }
+            }
+            const image src(v2u(37,29), image_data_format::rgba8, std::move(data));
+
+            const std::pair<image_data_format, image_data_format> formats[] = {
+                {image_data_format::rgba_dxt1, image_data_format::rgba8},
+                {image_data_format::rgba_dxt3, image_data_format::rgba8},
+                {image_data_format::rgba_dxt5, image_data_format::rgba8},
+                {image_data_format::rgb_etc1, image_data_format::rgb8},
+                {image_data_format::rgb_etc2, image_data_format::rgb8},
+                {image_data_format::rgba_etc2, image_data_format::rgba8}};
+
+            for ( const auto& [format, decoded_format] : formats ) {
+                image compressed;
+                REQUIRE(images::try_compress_image(compressed, src, format));
+                REQUIRE(images::check_decompress_image_support(compressed));
+
+                image dst;
+                REQUIRE(images::try_decompress_image(dst, compressed));
+                REQUIRE(dst.size() == src.size());
+                REQUIRE(dst.format() == decoded_format);
+
+                const std::size_t bpp = decoded_format == image_data_format::rgba8 ? 4u : 3u;
+                REQUIRE(dst.data().size() == std::size_t(37) * 29 * bpp);
+
+                u32 max_error = 0;
+                for ( std::size_t i = 0; i < std::size_t(37) * 29; ++i ) {
+                    for ( std::size_t c = 0; c < bpp; ++c ) {
+                        const u8 l = src.data().data()[i * 4 + c];
+                        const u8 r = dst.data().data()[i * bpp + c];
+                        max_error = math::max(max_error, u32(l > r ? l - r : r - l));
+                    }
+                }
+                REQUIRE(max_error < 32u);
+            }
+        }
+        {
+            const u8 red[] = {255, 0, 0, 255, 0, 0, 255, 0, 0, 255, 0, 0};
+            const image src(v2u(2,2), image_data_format::rgb8, {red, 12});
+
+            image etc1;
+            REQUIRE(images::try_compress_image(etc1, src, image_data_format::rgb_etc1));
+
+            image etc2;
+            REQUIRE(images::try_transcode_image(etc2, etc1, image_data_format::rgb_etc2));
+            REQUIRE(etc2.format() == image_data_format::rgb_etc2);
+            REQUIRE(etc2.data() == etc1.data());
+
+            image dxt1;
+            REQUIRE(images::try_transcode_image(dxt1, etc1, image_data_format::rgba_dxt1));
+            REQUIRE(dxt1.format() == image_data_format::rgba_dxt1);
+            REQUIRE(dxt1.data().size() == 8u);
+
+            image rgb;
+            REQUIRE(images::try_transcode_image(rgb, etc1, image_data_format::rgb8));
+            REQUIRE(rgb.format() == image_data_format::rgb8);
+            REQUIRE(rgb.data().data()[0] > 240u);
+            REQUIRE(rgb.data().data()[1] < 16u);
+        }
+        {
+            image img;
+            REQUIRE(images::try_load_image(
+                img,
+                make_read_file(path::combine(resources, "bin/images/dds/ship_dxt1.dds"))));
+
+            image dst;
+            REQUIRE(images::try_decompress_image(dst, img));
+            REQUIRE(dst.size() == v2u(64,128));
+            REQUIRE(dst.format() == image_data_format::rgba8);
+        }
+        {
+            image dst;
+            REQUIRE_FALSE(images::check_decompress_image_support(image()));
+            REQUIRE_FALSE(images::check_decompress_image_support(
+                image(v2u(4,4), image_data_format::rgba8, buffer(64))));
+            REQUIRE_FALSE(images::check_decompress_image_support(
+                image(v2u(4,4), image_data_format::rgba_astc4x4, buffer(16))));
+            REQUIRE_FALSE(images::check_decompress_image_support(
+                image(v2u(8,8), image_data_format::rgba_dxt5, buffer(16))));
+            REQUIRE_FALSE(images::try_decompress_image(
+                dst, image(v2u(4,4), image_data_format::rgba8, buffer(64))));
+            REQUIRE(dst.empty());
+        }
+    }
+    SECTION("conversion") {
+        {
+            const u8 pixels[] = {
+                10, 20, 30, 255,
+                200, 100, 50, 128,
+                255, 255, 255, 0,
+                40, 80, 120, 64,
+                1, 2, 3, 4};
+            const image src(v2u(5,1), image_data_format::rgba8, {pixels, sizeof(pixels)});
+
+            image dst;
+            REQUIRE(images::try_convert_image(dst, src, image_data_format::rgba8));
+            REQUIRE(dst == src);
+
+            REQUIRE(images::try_convert_image(dst, src, image_data_format::rgb8));
+            REQUIRE(dst.format() == image_data_format::rgb8);
+            REQUIRE(dst.data().size() == 15u);
+            REQUIRE(dst.pixel32(1,0) == color32(200,100,50,255));
+
+            REQUIRE(images::try_convert_image(dst, src, image_data_format::a8));
+            REQUIRE(dst.data().size() == 5u);
+            REQUIRE(dst.data().data()[1] == 128u);
+
+            REQUIRE(images::try_convert_image(dst, src, image_data_format::la8));
+            REQUIRE(dst.data().data()[4] == 255u);
+            REQUIRE(dst.data().data()[5] == 0u);
+
+            REQUIRE(images::try_convert_image(
+                dst, src, image_data_format::rgba8,
+                image_conversion_options().premultiply_alpha(true)));
+            REQUIRE(dst.pixel32(0,0) == color32(10,20,30,255));
+            REQUIRE(dst.pixel32(1,0) == color32(100,50,25,128));
+            REQUIRE(dst.pixel32(2,0) == color32(0,0,0,0));
+            REQUIRE(dst.pixel32(3,0) == color32(10,20,30,64));
+
+            image restored;
+            REQUIRE(images::try_convert_image(
+                restored, dst, image_data_format::rgba8,
+                image_conversion_options().unpremultiply_alpha(true)));
+            REQUIRE(restored.pixel32(0,0) == color32(10,20,30,255));
+            REQUIRE(restored.pixel32(1,0) == color32(199,100,50,128));
+            REQUIRE(restored.pixel32(3,0) == color32(40,80,120,64));
+
+            REQUIRE(images::try_convert_image(
+                dst, src, image_data_format::rgba8,
+                image_conversion_options().swap_red_blue(true)));
+            REQUIRE(dst.pixel32(0,0) == color32(30,20,10,255));
+            REQUIRE(dst.pixel32(4,0) == color32(3,2,1,4));
+
+            REQUIRE(images::try_convert_image(
+                dst, src, image_data_format::rgba8,
+                image_conversion_options().srgb_to_linear(true)));
+            REQUIRE(dst.pixel32(1,0) == color32(147,32,8,128));
+            REQUIRE(dst.pixel32(2,0) == color32(255,255,255,0));
+            REQUIRE(images::try_convert_image(
+                restored, dst, image_data_format::rgba8,
+                image_conversion_options().linear_to_srgb(true)));
+            REQUIRE(restored.pixel32(1,0) == color32(200,99,50,128));
+        }
+        {
+            buffer data(std::size_t(67) * 13 * 3);
+            for ( std::size_t i = 0; i < data.size(); ++i ) {
+                data.data()[i] = static_cast<u8>(i * 13);
+            }
+            const image src(v2u(67,13), image_data_format::rgb8, data);
+
+            image rgba;
+            REQUIRE(images::try_convert_image(rgba, src, image_data_format::rgba8));
+            REQUIRE(rgba.format() == image_data_format::rgba8);
+            REQUIRE(rgba.data().size() == std::size_t(67) * 13 * 4);
+
+            image rgb;
+            REQUIRE(images::try_convert_image(rgb, rgba, image_data_format::rgb8));
+            REQUIRE(rgb == src);
+
+            for ( u32 y = 0; y < 13; ++y ) {
+                for ( u32 x = 0; x < 67; ++x ) {
+                    REQUIRE(rgba.pixel32(x,y) == src.pixel32(x,y));
+                }
+            }
+
+            image l8;
+            REQUIRE(images::try_convert_image(l8, src, image_data_format::l8));
+            REQUIRE(images::try_convert_image(rgba, l8, image_data_format::rgba8));
+            REQUIRE(rgba.pixel32(5,5).a == 255u);
+            REQUIRE(rgba.pixel32(5,5).r == rgba.pixel32(5,5).b);
+        }
+        {
+            image dst;
+            REQUIRE_FALSE(images::check_convert_image_support(image(), image_data_format::rgba8));
+            REQUIRE_FALSE(images::check_convert_image_support(
+                image(v2u(4,4), image_data_format::rgba_dxt1, buffer(8)),
+                image_data_format::rgba8));
+            REQUIRE_FALSE(images::check_convert_image_support(
+                image(v2u(4,4), image_data_format::rgba8, buffer(64)),
+                image_data_format::rgba_dxt5));
+            REQUIRE_FALSE(images::try_convert_image(
+                dst,
+                image(v2u(4,4), image_data_format::rgb8, buffer(64)),
+                image_data_format::rgba8));
+            REQUIRE(dst.empty());
+        }
+    }
+    SECTION("conversion_performance") {
+        std::printf("-= images::conversion performance tests =-\n");
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
+        const std::size_t task_n = 2;
+    #else
+        const std::size_t task_n = 20;
+    #endif
+        const image rgb(v2u(1024,1024), image_data_format::rgb8, buffer(1024u * 1024u * 3u));
+        const image rgba(v2u(1024,1024), image_data_format::rgba8, buffer(1024u * 1024u * 4u));
+        {
+            std::size_t result = 0;
+            e2d_untests::verbose_profiler_ms p("convert(rgb8 -> rgba8) 1024x1024");
+            for ( std::size_t i = 0; i < task_n; ++i ) {
+                image dst;
+                REQUIRE(images::try_convert_image(dst, rgb, image_data_format::rgba8));
+                result += dst.data().size();
+            }
+            p.done(result);
+        }
+        {
+            std::size_t result = 0;
+            e2d_untests::verbose_profiler_ms p("convert(rgba8 -> rgb8) 1024x1024");
+            for ( std::size_t i = 0; i < task_n; ++i ) {
+                image dst;
+                REQUIRE(images::try_convert_image(dst, rgba, image_data_format::rgb8));
+                result += dst.data().size();
+            }
+            p.done(result);
+        }
+        {
+            std::size_t result = 0;
+            e2d_untests::verbose_profiler_ms p("convert(premultiply) 1024x1024");
+            for ( std::size_t i = 0; i < task_n; ++i ) {
+                image dst;
+                REQUIRE(images::try_convert_image(
+                    dst, rgba, image_data_format::rgba8,
+                    image_conversion_options().premultiply_alpha(true)));
+                result += dst.data().size();
+            }
+            p.done(result);
+        }
+        {
+            std::size_t result = 0;
+            e2d_untests::verbose_profiler_ms p("convert(swap_red_blue) 1024x1024");
+            for ( std::size_t i = 0; i < task_n; ++i ) {
+                image dst;
+                REQUIRE(images::try_convert_image(
+                    dst, rgba, image_data_format::rgba8,
+                    image_conversion_options().swap_red_blue(true)));
+                result += dst.data().size();
+            }
+            p.done(result);
+        }
+    }
 }
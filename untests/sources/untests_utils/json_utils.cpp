@@ -443,3 +443,23 @@ TEST_CASE("json_utils") {
         REQUIRE(e1 == image_data_format::rgb_etc1);
     }
 }
+
+TEST_CASE("json_utils_insitu") {
+    {
+        auto doc = json_utils::parse_insitu(json_source);
+        REQUIRE(doc);
+        REQUIRE(doc->IsObject());
+
+        str s0;
+        REQUIRE(json_utils::try_parse_value((*doc)["s0"], s0));
+        REQUIRE(s0 == "hello");
+
+        v4i v6;
+        REQUIRE(json_utils::try_parse_value((*doc)["v6"], v6));
+        REQUIRE(v6 == v4i(1,-2,3,-4));
+    }
+    {
+        REQUIRE_FALSE(json_utils::parse_insitu(""));
+        REQUIRE_FALSE(json_utils::parse_insitu("{ \"hello\" : }"));
+    }
+}
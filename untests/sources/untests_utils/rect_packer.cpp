@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_utils.hpp"
+using namespace e2d;
+
+namespace
+{
+    bool is_rect_inside(const b2u& r, const v2u& size) {
+        return r.position.x + r.size.x <= size.x
+            && r.position.y + r.size.y <= size.y;
+    }
+
+    bool is_rects_overlapped(const b2u& l, const b2u& r, u32 padding) {
+        return l.position.x < r.position.x + r.size.x + padding
+            && r.position.x < l.position.x + l.size.x + padding
+            && l.position.y < r.position.y + r.size.y + padding
+            && r.position.y < l.position.y + l.size.y + padding;
+    }
+
+    bool is_valid_packing(const vector<b2u>& rects, const v2u& size, u32 padding) {
+        for ( std::size_t i = 0; i < rects.size(); ++i ) {
+            if ( !is_rect_inside(rects[i], size) ) {
+                return false;
+            }
+            for ( std::size_t j = i + 1; j < rects.size(); ++j ) {
+                if ( is_rects_overlapped(rects[i], rects[j], padding) ) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE("rect_packer") {
+    {
+        rect_packer p;
+        b2u r;
+        REQUIRE_FALSE(p.insert(v2u(1u,1u), r));
+        REQUIRE(p.rect_count() == 0u);
+        REQUIRE(math::approximately(p.occupancy(), 0.f));
+    }
+    {
+        rect_packer p(v2u(64u,64u));
+        b2u r;
+        REQUIRE_FALSE(p.insert(v2u(0u,10u), r));
+        REQUIRE_FALSE(p.insert(v2u(65u,1u), r));
+
+        REQUIRE(p.insert(v2u(64u,64u), r));
+        REQUIRE(r == b2u(0u,0u,64u,64u));
+        REQUIRE(p.rect_count() == 1u);
+        REQUIRE(math::approximately(p.occupancy(), 1.f));
+        REQUIRE_FALSE(p.insert(v2u(1u,1u), r));
+
+        p.clear();
+        REQUIRE(p.rect_count() == 0u);
+        REQUIRE(p.used_area() == 0u);
+        REQUIRE(p.insert(v2u(32u,32u), r));
+    }
+    {
+        rect_packer p(v2u(64u,64u));
+        vector<b2u> rects;
+        for ( std::size_t i = 0; i < 16; ++i ) {
+            b2u r;
+            REQUIRE(p.insert(v2u(16u,16u), r));
+            rects.push_back(r);
+        }
+        REQUIRE(is_valid_packing(rects, p.size(), 0u));
+        REQUIRE(math::approximately(p.occupancy(), 1.f));
+
+        b2u r;
+        REQUIRE_FALSE(p.insert(v2u(1u,1u), r));
+    }
+    {
+        rect_packer p(v2u(66u,66u), 2u);
+        vector<b2u> rects;
+        for ( std::size_t i = 0; i < 9; ++i ) {
+            b2u r;
+            REQUIRE(p.insert(v2u(20u,20u), r));
+            rects.push_back(r);
+        }
+        REQUIRE(is_valid_packing(rects, p.size(), 2u));
+
+        b2u r;
+        REQUIRE_FALSE(p.insert(v2u(20u,20u), r));
+    }
+    {
+        vector<v2u> sizes;
+        for ( u32 i = 0; i < 100u; ++i ) {
+            sizes.push_back(v2u(4u + (i * 7u) % 29u, 4u + (i * 13u) % 23u));
+        }
+
+        rect_packer p(v2u(256u,256u), 1u);
+        vector<b2u> rects;
+        REQUIRE(p.pack(sizes, rects));
+        REQUIRE(rects.size() == sizes.size());
+        for ( std::size_t i = 0; i < sizes.size(); ++i ) {
+            REQUIRE(rects[i].size == sizes[i]);
+        }
+        REQUIRE(is_valid_packing(rects, p.size(), 1u));
+        REQUIRE(p.rect_count() == sizes.size());
+
+        rect_packer small(v2u(32u,32u));
+        REQUIRE_FALSE(small.pack(sizes, rects));
+        REQUIRE(small.rect_count() == 0u);
+        REQUIRE(rects.size() == sizes.size());
+    }
+}
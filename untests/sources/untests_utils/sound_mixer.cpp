@@ -0,0 +1,322 @@
+/*******************************************************************************
+ * This file is part of the "Enduro2D"
+ * For conditions of distribution and use, see copyright notice in LICENSE.md
+ * Copyright (C) 2018-2020, by Matvey Cherevko (blackmatov@gmail.com)
+ ******************************************************************************/
+
+#include "_utils.hpp"
+using namespace e2d;
+
+namespace
+{
+#if defined(E2D_BUILD_WITH_VORBIS)
+    const bool vorbis_supported = true;
+#else
+    const bool vorbis_supported = false;
+#endif
+
+    template < typename F >
+    buffer make_wav(u16 channels, u32 sample_rate, std::size_t frames, F&& f) {
+        const u32 data_size = static_cast<u32>(frames * channels * 2u);
+        buffer data(44u + data_size);
+        u8* p = data.data();
+
+        const auto put_u16 = [&p](u16 v){
+            *p++ = static_cast<u8>(v);
+            *p++ = static_cast<u8>(v >> 8u);
+        };
+        const auto put_u32 = [&put_u16](u32 v){
+            put_u16(static_cast<u16>(v));
+            put_u16(static_cast<u16>(v >> 16u));
+        };
+        const auto put_tag = [&p](const char* tag){
+            std::memcpy(p, tag, 4u);
+            p += 4u;
+        };
+
+        put_tag("RIFF"); put_u32(36u + data_size); put_tag("WAVE");
+        put_tag("fmt "); put_u32(16u);
+        put_u16(1u); put_u16(channels);
+        put_u32(sample_rate); put_u32(sample_rate * channels * 2u);
+        put_u16(static_cast<u16>(channels * 2u)); put_u16(16u);
+        put_tag("data"); put_u32(data_size);
+
+        for ( std::size_t i = 0; i < frames; ++i ) {
+            for ( u16 c = 0; c < channels; ++c ) {
+                put_u16(static_cast<u16>(static_cast<i16>(f(i, c) * 32767.f)));
+            }
+        }
+        return data;
+    }
+
+    sound_decoder_uptr make_decoder(buffer data) {
+        return make_wav_sound_decoder(make_memory_stream(std::move(data)));
+    }
+
+    sound_decoder_uptr make_constant_decoder(u32 sample_rate, std::size_t frames, f32 value) {
+        return make_decoder(make_wav(1u, sample_rate, frames, [value](std::size_t, u16){
+            return value;
+        }));
+    }
+}
+
+TEST_CASE("sound_mixer") {
+    SECTION("wav_decoder") {
+        REQUIRE_FALSE(make_wav_sound_decoder(nullptr));
+        REQUIRE_FALSE(make_decoder(buffer("hello world, it is not a wave", 29u)));
+
+        sound_decoder_uptr d = make_decoder(make_wav(2u, 22050u, 100u, [](std::size_t i, u16 c){
+            return c == 0u ? 0.5f : -static_cast<f32>(i) / 100.f;
+        }));
+        REQUIRE(d);
+        REQUIRE(d->channels() == 2u);
+        REQUIRE(d->sample_rate() == 22050u);
+        REQUIRE(d->frame_count() == 100u);
+
+        f32 frames[400] = {0.f};
+        REQUIRE(d->read(frames, 10u) == 10u);
+        REQUIRE(frames[0] == Approx(0.5f).margin(0.001f));
+        REQUIRE(frames[19] == Approx(-0.09f).margin(0.001f));
+        REQUIRE(d->read(frames, 200u) == 90u);
+        REQUIRE(d->read(frames, 200u) == 0u);
+
+        d->seek(50u);
+        REQUIRE(d->read(frames, 1u) == 1u);
+        REQUIRE(frames[1] == Approx(-0.5f).margin(0.001f));
+    }
+    SECTION("vorbis_decoder") {
+        REQUIRE_FALSE(make_vorbis_sound_decoder(nullptr));
+        REQUIRE_FALSE(make_vorbis_sound_decoder(make_memory_stream(buffer("OggS, but not a vorbis stream", 29u))));
+        REQUIRE_FALSE(make_vorbis_sound_decoder(make_memory_stream(make_wav(1u, 22050u, 10u, [](std::size_t, u16){
+            return 0.f;
+        }))));
+
+        str resources;
+        REQUIRE(filesystem::extract_predef_path(resources, filesystem::predef_path::resources));
+        sound_decoder_uptr d = make_vorbis_sound_decoder(
+            make_read_file(path::combine(resources, "bin/library/sound.ogg")));
+        if ( !vorbis_supported ) {
+            REQUIRE_FALSE(d);
+            return;
+        }
+        REQUIRE(d);
+        REQUIRE((d->channels() == 1u || d->channels() == 2u));
+        REQUIRE(d->sample_rate() > 0u);
+        REQUIRE(d->frame_count() > 0u);
+
+        vector<f32> frames((d->frame_count() + 1u) * d->channels());
+        const std::size_t read_frames = d->read(frames.data(), d->frame_count() + 1u);
+        REQUIRE(read_frames > 0u);
+        REQUIRE(read_frames == d->frame_count());
+        REQUIRE(d->read(frames.data(), 1u) == 0u);
+
+        const std::size_t half = d->frame_count() / 2u;
+        d->seek(half);
+        REQUIRE(d->read(frames.data(), d->frame_count()) == d->frame_count() - half);
+    }
+    SECTION("sound_decoder") {
+        REQUIRE_FALSE(make_sound_decoder(nullptr));
+        REQUIRE_FALSE(make_sound_decoder(make_memory_stream(buffer("hello world", 11u))));
+
+        sound_decoder_uptr wav = make_sound_decoder(make_memory_stream(make_wav(2u, 22050u, 10u, [](std::size_t, u16){
+            return 0.f;
+        })));
+        REQUIRE(wav);
+        REQUIRE(wav->channels() == 2u);
+        REQUIRE(wav->frame_count() == 10u);
+
+        str resources;
+        REQUIRE(filesystem::extract_predef_path(resources, filesystem::predef_path::resources));
+        // without vorbis support ogg files are recognized, but not decoded
+        REQUIRE(vorbis_supported == !!make_sound_decoder(
+            make_read_file(path::combine(resources, "bin/library/sound.ogg"))));
+    }
+    SECTION("mixing") {
+        sound_mixer mixer(sound_mixer::parameters()
+            .sample_rate(44100u)
+            .block_frames(64u));
+
+        const auto v = mixer.create_voice(make_constant_decoder(44100u, 1000u, 0.5f));
+        REQUIRE(mixer.valid_voice(v));
+        REQUIRE_FALSE(mixer.playing(v));
+        REQUIRE(mixer.duration(v) == Approx(1000.f / 44100.f));
+
+        vector<f32> out(450u * 2u);
+        mixer.mix(out.data(), 200u);
+        REQUIRE(out[0] == 0.f);
+
+        mixer.play(v);
+        REQUIRE(mixer.playing(v));
+        mixer.mix(out.data(), 200u);
+        REQUIRE(out[0] == Approx(0.5f).margin(0.001f));
+        REQUIRE(out[399] == Approx(0.5f).margin(0.001f));
+
+        mixer.pan(v, 1.f);
+        mixer.volume(v, 0.5f);
+        mixer.mix(out.data(), 200u);
+        REQUIRE(out[0] == Approx(0.f).margin(0.001f));
+        REQUIRE(out[1] == Approx(0.25f).margin(0.001f));
+
+        mixer.master_volume(0.5f);
+        mixer.mix(out.data(), 200u);
+        REQUIRE(out[1] == Approx(0.125f).margin(0.001f));
+
+        mixer.mix(out.data(), 450u);
+        REQUIRE(out[1] == Approx(0.125f).margin(0.001f));
+        REQUIRE(out[2u * 399u + 1u] == Approx(0.125f).margin(0.001f));
+        REQUIRE(out[2u * 400u + 1u] == 0.f);
+        REQUIRE_FALSE(mixer.playing(v));
+        REQUIRE(mixer.position(v) == Approx(mixer.duration(v)));
+
+        mixer.destroy_voice(v);
+        REQUIRE_FALSE(mixer.valid_voice(v));
+        REQUIRE(mixer.stats().mixed_frames == 1250u);
+        REQUIRE(mixer.stats().decoded_frames == 1000u);
+    }
+    SECTION("resampling") {
+        sound_mixer mixer(sound_mixer::parameters()
+            .sample_rate(44100u)
+            .window_frames(16u));
+
+        const auto v = mixer.create_voice(make_decoder(make_wav(1u, 22050u, 1000u, [](std::size_t i, u16){
+            return static_cast<f32>(i) / 1000.f;
+        })));
+        mixer.play(v);
+
+        vector<f32> out(4000u * 2u);
+        mixer.mix(out.data(), 1999u);
+        REQUIRE(mixer.playing(v));
+        REQUIRE(out[2u * 1u] == Approx(0.0005f).margin(0.0001f));
+        REQUIRE(out[2u * 1000u] == Approx(0.5f).margin(0.0001f));
+        REQUIRE(mixer.position(v) == Approx(999.5f / 22050.f));
+
+        mixer.mix(out.data(), 100u);
+        REQUIRE(out[0] == Approx(0.999f).margin(0.0001f));
+        REQUIRE(out[2u * 2u] == 0.f);
+        REQUIRE_FALSE(mixer.playing(v));
+
+        mixer.pitch(v, 2.f);
+        mixer.play(v);
+        mixer.mix(out.data(), 999u);
+        REQUIRE(mixer.playing(v));
+        mixer.mix(out.data(), 2u);
+        REQUIRE_FALSE(mixer.playing(v));
+    }
+    SECTION("looping") {
+        sound_mixer mixer(sound_mixer::parameters()
+            .window_frames(64u));
+
+        const auto v = mixer.create_voice(make_decoder(make_wav(1u, 44100u, 100u, [](std::size_t i, u16){
+            return static_cast<f32>(i) / 100.f;
+        })));
+        mixer.looping(v, true);
+        mixer.play(v);
+
+        vector<f32> out(1000u * 2u);
+        mixer.mix(out.data(), 1000u);
+        REQUIRE(mixer.playing(v));
+        REQUIRE(out[2u * 150u] == Approx(0.5f).margin(0.001f));
+        REQUIRE(out[2u * 999u] == Approx(0.99f).margin(0.001f));
+        REQUIRE(mixer.position(v) == Approx(0.f).margin(0.0001f));
+
+        mixer.position(v, 50.f / 44100.f);
+        mixer.mix(out.data(), 1u);
+        REQUIRE(out[0] == Approx(0.5f).margin(0.001f));
+
+        mixer.looping(v, false);
+        mixer.mix(out.data(), 100u);
+        REQUIRE_FALSE(mixer.playing(v));
+    }
+    SECTION("voice_limit") {
+        sound_mixer mixer(sound_mixer::parameters()
+            .max_voices(2u));
+
+        const auto v1 = mixer.create_voice(make_constant_decoder(44100u, 10u, 0.1f));
+        const auto v2 = mixer.create_voice(make_constant_decoder(44100u, 10u, 0.1f));
+        REQUIRE(v1 != sound_mixer::invalid_voice);
+        REQUIRE(v2 != sound_mixer::invalid_voice);
+        REQUIRE(mixer.create_voice(make_constant_decoder(44100u, 10u, 0.1f)) == sound_mixer::invalid_voice);
+        REQUIRE(mixer.create_voice(nullptr) == sound_mixer::invalid_voice);
+        REQUIRE(mixer.stats().voices == 2u);
+        REQUIRE(mixer.stats().rejected_voices == 1u);
+
+        mixer.destroy_voice(v1);
+        const auto v3 = mixer.create_voice(make_constant_decoder(44100u, 10u, 0.1f));
+        REQUIRE(v3 != sound_mixer::invalid_voice);
+        REQUIRE(v3 != v1);
+        REQUIRE_FALSE(mixer.valid_voice(v1));
+        REQUIRE(mixer.valid_voice(v3));
+
+        mixer.play(v2);
+        mixer.play(v3);
+        REQUIRE(mixer.stats().playing_voices == 2u);
+
+        vector<f32> out(10u * 2u);
+        mixer.mix(out.data(), 10u);
+        REQUIRE(out[0] == Approx(0.2f).margin(0.001f));
+    }
+    SECTION("sinks") {
+        E2D_DEFER([](){
+            filesystem::remove_file("sound_mixer_test.wav");
+        });
+
+        REQUIRE(make_null_sound_sink());
+        REQUIRE_FALSE(make_wav_sound_sink(nullptr, 44100u));
+
+        sound_mixer mixer;
+        const auto v = mixer.create_voice(make_constant_decoder(44100u, 300u, 0.25f));
+        mixer.play(v);
+        {
+            sound_sink_uptr sink = make_wav_sound_sink(
+                make_write_file("sound_mixer_test.wav", false),
+                mixer.params().sample_rate());
+            REQUIRE(sink);
+            mixer.render(*sink, 1000u);
+        }
+
+        sound_decoder_uptr d = make_wav_sound_decoder(make_read_file("sound_mixer_test.wav"));
+        REQUIRE(d);
+        REQUIRE(d->channels() == 2u);
+        REQUIRE(d->sample_rate() == 44100u);
+        REQUIRE(d->frame_count() == 1000u);
+
+        f32 frames[2] = {0.f};
+        REQUIRE(d->read(frames, 1u) == 1u);
+        REQUIRE(frames[0] == Approx(0.25f).margin(0.001f));
+        REQUIRE(frames[1] == Approx(0.25f).margin(0.001f));
+    }
+    SECTION("performance") {
+        std::printf("-= sound_mixer::performance tests =-\n");
+    #if defined(E2D_BUILD_MODE) && E2D_BUILD_MODE == E2D_BUILD_MODE_DEBUG
+        const std::size_t seconds = 1;
+    #else
+        const std::size_t seconds = 10;
+    #endif
+        const buffer mono = make_wav(1u, 22050u, 22050u, [](std::size_t i, u16){
+            return static_cast<f32>(std::sin(i * 0.05));
+        });
+        const buffer stereo = make_wav(2u, 44100u, 44100u, [](std::size_t i, u16 c){
+            return static_cast<f32>(std::sin(i * (c ? 0.03 : 0.02)));
+        });
+
+        sound_mixer mixer(sound_mixer::parameters()
+            .max_voices(32u));
+        for ( std::size_t i = 0; i < 32u; ++i ) {
+            const auto v = mixer.create_voice(make_decoder(i % 2u ? mono : stereo));
+            mixer.looping(v, true);
+            mixer.pitch(v, 0.75f + static_cast<f32>(i % 4u) * 0.25f);
+            mixer.pan(v, static_cast<f32>(i % 3u) - 1.f);
+            mixer.volume(v, 1.f / 32.f);
+            mixer.play(v);
+        }
+
+        sound_sink_uptr sink = make_null_sound_sink();
+        {
+            e2d_untests::verbose_profiler_ms p(
+                strings::rformat("mix(32 voices, %0 seconds)", seconds));
+            mixer.render(*sink, seconds * mixer.params().sample_rate());
+            p.done(mixer.stats().mixed_frames);
+        }
+        REQUIRE(mixer.stats().playing_voices == 32u);
+    }
+}
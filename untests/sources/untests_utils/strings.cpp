@@ -57,6 +57,36 @@ TEST_CASE("strings") {
             REQUIRE(s1 == make_hash("world"));
         }
     }
+    {
+        static_assert(""_hash == str_hash());
+        static_assert("hello"_hash != "world"_hash);
+        static_assert("hello"_hash.hash() == utils::sdbm_hash("hello"));
+
+        constexpr str_hash hello = "hello"_hash;
+        REQUIRE(hello == make_hash("hello"));
+        REQUIRE(L"hello"_hash == make_hash(L"hello"));
+        REQUIRE(u"hello"_hash == make_hash(u"hello"));
+        REQUIRE(U"hello"_hash == make_hash(U"hello"));
+        REQUIRE("u_matrix_m"_hash == str_hash("u_matrix_m"));
+        REQUIRE(str_hash::make_constexpr("world") == make_hash("world"));
+    }
+    {
+        vector<std::thread> threads;
+        vector<vector<str_hash>> results(4);
+        for ( std::size_t i = 0; i < results.size(); ++i ) {
+            threads.emplace_back([&results, i](){
+                for ( std::size_t j = 0; j < 1000; ++j ) {
+                    results[i].push_back(make_hash(std::to_string(j)));
+                }
+            });
+        }
+        for ( std::thread& t : threads ) {
+            t.join();
+        }
+        for ( std::size_t i = 1; i < results.size(); ++i ) {
+            REQUIRE(results[i] == results[0]);
+        }
+    }
     {
         REQUIRE(make_utf8("hello") == "hello");
         REQUIRE(make_utf8(L"hello") == "hello");